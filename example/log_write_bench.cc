@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/// \brief Example that measures the write rate of a log using each of the
+/// predefined write profiles.
+/// Usage: log_write_bench OUTPUT_DIR [NUM_MESSAGES] [MESSAGE_SIZE]
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gz/transport/log/Log.hh>
+#include <gz/transport/log/WriteProfile.hh>
+
+//////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  if (argc < 2 || argc > 4)
+  {
+    std::cerr << "Usage: " << argv[0]
+              << " OUTPUT_DIR [NUM_MESSAGES] [MESSAGE_SIZE]\n";
+    return -1;
+  }
+
+  const std::string dir = argv[1];
+  const std::size_t numMessages = argc > 2 ? std::stoul(argv[2]) : 100000u;
+  const std::size_t messageSize = argc > 3 ? std::stoul(argv[3]) : 1024u;
+  const std::string data(messageSize, 'x');
+
+  const std::vector<std::pair<std::string, gz::transport::log::WriteProfile>>
+    profiles =
+  {
+    {"safe", gz::transport::log::WriteProfile::Safe()},
+    {"fast", gz::transport::log::WriteProfile::Fast()},
+    {"fastest", gz::transport::log::WriteProfile::Fastest()},
+  };
+
+  for (const auto &profile : profiles)
+  {
+    const std::string file = dir + "/bench_" + profile.first + ".tlog";
+    std::remove(file.c_str());
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+      gz::transport::log::Log log;
+      log.SetWriteProfile(profile.second);
+      if (!log.Open(file, std::ios_base::out))
+      {
+        std::cerr << "Failed to open [" << file << "]\n";
+        return -2;
+      }
+
+      for (std::size_t i = 0; i < numMessages; ++i)
+      {
+        if (!log.InsertMessage(std::chrono::nanoseconds(i), "/bench",
+              "gz.msgs.Bytes", data.data(), data.size()))
+        {
+          std::cerr << "Failed to insert message " << i << "\n";
+          return -3;
+        }
+      }
+      // The last transaction is committed when the log is closed.
+    }
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    const double msgsPerSec = numMessages / elapsed.count();
+    std::cout << profile.first << ": " << elapsed.count() << " s, "
+              << msgsPerSec << " msgs/s, "
+              << msgsPerSec * messageSize / (1024.0 * 1024.0) << " MB/s\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/// \brief Example that measures the cost of a node advertising many topics:
+/// the time to advertise them one by one and in bulk, the memory used per
+/// topic and the discovery traffic generated by every heartbeat.
+/// Usage: many_topics_bench [NUM_TOPICS]
+
+#include <gz/msgs/bytes.pb.h>
+#include <gz/msgs/discovery.pb.h>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <gz/transport/AdvertiseOptions.hh>
+#include <gz/transport/Node.hh>
+#include <gz/transport/Publisher.hh>
+
+//////////////////////////////////////////////////
+/// \brief Resident memory of the process.
+/// \return Resident memory in bytes, or 0 if it is not available.
+std::size_t residentMemory()
+{
+  // Only available on Linux.
+  std::ifstream statm("/proc/self/statm");
+  std::size_t pages = 0;
+  std::size_t resident = 0;
+  if (!(statm >> pages >> resident))
+    return 0;
+  return resident * 4096u;
+}
+
+//////////////////////////////////////////////////
+/// \brief Generate topic names.
+/// \param[in] _prefix Prefix of the names.
+/// \param[in] _count Number of names.
+/// \return The topic names.
+std::vector<std::string> topicNames(const std::string &_prefix,
+                                    const std::size_t _count)
+{
+  std::vector<std::string> topics;
+  topics.reserve(_count);
+  for (std::size_t i = 0; i < _count; ++i)
+    topics.push_back(_prefix + std::to_string(i));
+  return topics;
+}
+
+//////////////////////////////////////////////////
+/// \brief Print the time and memory used to advertise some topics.
+/// \param[in] _label Name of the method.
+/// \param[in] _count Number of topics.
+/// \param[in] _start Time when the advertisement started.
+/// \param[in] _memBefore Resident memory before the advertisement.
+void report(const std::string &_label, const std::size_t _count,
+            const std::chrono::steady_clock::time_point &_start,
+            const std::size_t _memBefore)
+{
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::steady_clock::now() - _start);
+  const std::size_t memAfter = residentMemory();
+
+  std::cout << _label << ": " << elapsed.count() << " ms";
+  if (_memBefore && memAfter >= _memBefore)
+  {
+    std::cout << ", " << (memAfter - _memBefore) / _count
+              << " bytes per topic";
+  }
+  std::cout << std::endl;
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char *argv[])
+{
+  if (argc > 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " [NUM_TOPICS]\n";
+    return -1;
+  }
+
+  const std::size_t numTopics = argc > 1 ? std::stoul(argv[1]) : 10000u;
+  const std::string msgType = gz::msgs::Bytes().GetTypeName();
+
+  gz::transport::Node node;
+  std::cout << "Advertising " << numTopics << " topics" << std::endl;
+
+  {
+    const auto topics = topicNames("/bench/single/", numTopics);
+    std::vector<gz::transport::Node::Publisher> pubs;
+    pubs.reserve(numTopics);
+
+    const std::size_t memBefore = residentMemory();
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto &topic : topics)
+      pubs.push_back(node.Advertise<gz::msgs::Bytes>(topic));
+    report("Advertise()", numTopics, start, memBefore);
+  }
+
+  std::vector<gz::transport::Node::Publisher> pubs;
+  {
+    const auto topics = topicNames("/bench/many/", numTopics);
+    const std::size_t memBefore = residentMemory();
+    const auto start = std::chrono::steady_clock::now();
+    pubs = node.AdvertiseMany<gz::msgs::Bytes>(topics);
+    report("AdvertiseMany()", numTopics, start, memBefore);
+  }
+
+  // Every heartbeat re-advertises each topic with one discovery message,
+  // except the topics with Scope_t::PROCESS. Estimate the traffic from the
+  // size of those messages.
+  std::size_t bytes = 0;
+  for (const auto &topic : topicNames("/bench/many/", numTopics))
+  {
+    gz::transport::MessagePublisher publisher(topic,
+      "tcp://127.0.0.1:12345", "unused",
+      "00000000-0000-0000-0000-000000000000",
+      "00000000-0000-0000-0000-000000000000", msgType,
+      gz::transport::AdvertiseMessageOptions());
+    gz::msgs::Discovery msg;
+    msg.set_type(gz::msgs::Discovery::ADVERTISE);
+    msg.set_process_uuid(publisher.PUuid());
+    publisher.FillDiscovery(msg);
+
+    // Each datagram starts with a 16 bit length.
+    bytes += msg.ByteSizeLong() + sizeof(uint16_t);
+  }
+
+  std::cout << "Discovery traffic per heartbeat: " << numTopics
+            << " datagrams, " << bytes / 1024 << " KiB" << std::endl;
+
+  return 0;
+}
@@ -176,6 +176,13 @@ namespace gz
         }
         else
           _out << "\tThrottled? No" << std::endl;
+        if (_other.Multicast())
+          _out << "\tMulticast? Yes" << std::endl;
+        if (_other.DeltaKeyframeInterval() > 0)
+        {
+          _out << "\tDelta keyframe interval: "
+               << _other.DeltaKeyframeInterval() << std::endl;
+        }
 
         return _out;
       }
@@ -197,6 +204,39 @@ namespace gz
       /// \param[in] _newMsgsPerSec Maximum number of messages per second.
       public: void SetMsgsPerSec(const uint64_t _newMsgsPerSec);
 
+      /// \brief Whether the messages are sent to the remote subscribers with
+      /// UDP multicast, so each message is sent once whatever the number of
+      /// subscribers. Subscribers that can't receive multicast (e.g. older
+      /// versions or a different GZ_TRANSPORT_MULTICAST_PORT) get the
+      /// messages through the regular TCP connection. The delivery through
+      /// multicast is best effort: messages with a lost datagram are dropped.
+      /// \return True if multicast is requested.
+      /// \sa SetMulticast
+      public: bool Multicast() const;
+
+      /// \brief Request sending the messages with UDP multicast.
+      /// \param[in] _multicast True to use multicast.
+      /// \sa Multicast
+      public: void SetMulticast(const bool _multicast);
+
+      /// \brief Get the keyframe interval of the delta encoding. When it's
+      /// positive, the messages sent to the remote subscribers through TCP
+      /// are a full message (keyframe) every DeltaKeyframeInterval()
+      /// messages, and binary differences against the previous message
+      /// in between. The subscribers reconstruct the full messages. This
+      /// saves bandwidth on large messages that change slowly. Deltas are
+      /// only sent while all the remote subscribers support them.
+      /// \return The interval, or 0 if the delta encoding is disabled
+      /// (default).
+      /// \sa SetDeltaKeyframeInterval
+      public: uint32_t DeltaKeyframeInterval() const;
+
+      /// \brief Set the keyframe interval of the delta encoding.
+      /// \param[in] _interval Number of messages between keyframes, or 0
+      /// to disable the delta encoding.
+      /// \sa DeltaKeyframeInterval
+      public: void SetDeltaKeyframeInterval(const uint32_t _interval);
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -251,9 +291,48 @@ namespace gz
                                           const AdvertiseServiceOptions &_other)
       {
         _out << static_cast<AdvertiseOptions>(_other);
+        if (_other.Cacheable())
+        {
+          _out << "\tCacheable? Yes" << std::endl;
+          _out << "\tCache TTL: " << _other.CacheTtl() << " ms" << std::endl;
+          _out << "\tCache version: " << _other.CacheVersion() << std::endl;
+        }
+
         return _out;
       }
 
+      /// \brief Whether the responses of the service can be cached by the
+      /// requesters. A service is cacheable when it always returns the same
+      /// response for the same request, until its cache version changes.
+      /// \return True if the service is cacheable.
+      /// \sa SetCacheable
+      public: bool Cacheable() const;
+
+      /// \brief Set whether the responses of the service can be cached by
+      /// the requesters. Only successful responses are cached.
+      /// \param[in] _cacheable True if the service is cacheable.
+      public: void SetCacheable(const bool _cacheable);
+
+      /// \brief Get the time that a cached response remains valid.
+      /// \return Time in milliseconds. Zero means that the cached responses
+      /// are valid until the cache version changes.
+      public: uint64_t CacheTtl() const;
+
+      /// \brief Set the time that a cached response remains valid.
+      /// \param[in] _ttl Time in milliseconds. Zero means that the cached
+      /// responses are valid until the cache version changes.
+      public: void SetCacheTtl(const uint64_t _ttl);
+
+      /// \brief Get the version of the service responses. Requesters discard
+      /// the responses cached with a different version.
+      /// \return The cache version.
+      /// \sa Node::InvalidateServiceCache
+      public: uint64_t CacheVersion() const;
+
+      /// \brief Set the version of the service responses.
+      /// \param[in] _version The cache version.
+      public: void SetCacheVersion(const uint64_t _version);
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_BUFFERPOOL_HH_
+#define GZ_TRANSPORT_BUFFERPOOL_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class BufferPool BufferPool.hh gz/transport/BufferPool.hh
+    /// \brief Process wide pool of the buffers that hold serialized messages.
+    ///
+    /// Buffers are grouped in power of two size classes, from kMinSize to
+    /// kMaxSize bytes. Released buffers are kept in a small per thread cache
+    /// and then in a shared list of each class, up to kMaxIdleBytes in
+    /// total, so publishing messages of similar sizes doesn't allocate.
+    /// Larger buffers are not pooled.
+    ///
+    /// The pool can be disabled with GZ_TRANSPORT_BUFFER_POOL=0. With
+    /// GZ_TRANSPORT_HUGE_PAGES=1, buffers of kHugePageSize bytes or more are
+    /// backed by transparent huge pages (Linux only).
+    ///
+    /// All the functions are thread safe, and a buffer can be released from
+    /// a thread other than the one that allocated it.
+    class GZ_TRANSPORT_VISIBLE BufferPool
+    {
+      /// \brief Size of the smallest class.
+      public: static constexpr std::size_t kMinSize = 64u;
+
+      /// \brief Size of the largest class. Larger buffers are not pooled.
+      public: static constexpr std::size_t kMaxSize = 64u * 1024u * 1024u;
+
+      /// \brief Maximum bytes kept in the shared lists of all the classes.
+      /// Released buffers that don't fit are returned to the system.
+      public: static constexpr std::size_t kMaxIdleBytes =
+        64u * 1024u * 1024u;
+
+      /// \brief Minimum size of the buffers backed by huge pages.
+      public: static constexpr std::size_t kHugePageSize = 2u * 1024u * 1024u;
+
+      /// \brief Statistics of the pool.
+      public: struct Stats
+      {
+        /// \brief Allocations served with a pooled buffer.
+        uint64_t hits = 0;
+
+        /// \brief Allocations of a poolable size that needed a new buffer.
+        uint64_t misses = 0;
+
+        /// \brief Allocations too large to be pooled (or with the pool
+        /// disabled).
+        uint64_t unpooled = 0;
+
+        /// \brief Bytes kept in the shared lists for future allocations.
+        /// Buffers in the per thread caches are not included.
+        uint64_t idleBytes = 0;
+
+        /// \brief Fraction of the poolable allocations served with a pooled
+        /// buffer.
+        /// \return The hit rate in [0, 1], or 0 if there were no
+        /// allocations.
+        double HitRate() const
+        {
+          const uint64_t total = this->hits + this->misses;
+          return total == 0 ? 0.0 :
+            static_cast<double>(this->hits) / static_cast<double>(total);
+        }
+      };
+
+      /// \brief Deleter to hold pooled buffers in smart pointers.
+      public: struct Deleter
+      {
+        /// \brief Release a buffer.
+        /// \param[in] _buffer The buffer.
+        void operator()(char *_buffer) const
+        {
+          BufferPool::Free(_buffer);
+        }
+      };
+
+      /// \brief A pooled buffer owned by a smart pointer.
+      public: using Ptr = std::unique_ptr<char[], Deleter>;
+
+      /// \brief Get a buffer.
+      /// \param[in] _size Minimum size of the buffer.
+      /// \return The buffer, which must be released with Free().
+      public: static char *Allocate(const std::size_t _size);
+
+      /// \brief Release a buffer returned by Allocate().
+      /// \param[in] _buffer The buffer. Nothing happens if it's null.
+      public: static void Free(void *_buffer);
+
+      /// \brief Release a buffer returned by Allocate(). Its signature matches
+      /// DeallocFunc, so it can be given to ZeroMQ to release the buffer of a
+      /// zero copy message. Unlike Free(), the buffer goes to the shared free
+      /// lists, since the thread releasing it doesn't allocate buffers.
+      /// \param[in] _buffer The buffer. Nothing happens if it's null.
+      /// \param[in] _hint Unused.
+      public: static void ZmqFree(void *_buffer, void *_hint);
+
+      /// \brief Get the statistics of the pool.
+      /// \return The statistics.
+      public: static Stats Statistics();
+
+      /// \brief Release the buffers of the shared lists to the system.
+      public: static void Trim();
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_BUFFERPOOL_HH_
+#endif
@@ -77,6 +77,7 @@
 #include "gz/transport/Publisher.hh"
 #include "gz/transport/TopicStorage.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -130,6 +131,7 @@ namespace gz
           port(_port),
           hostAddr(determineHost()),
           pUuid(_pUuid),
+          pUuidKey(Uuid::FromIdentifier(_pUuid)),
           silenceInterval(kDefSilenceInterval),
           activityInterval(kDefActivityInterval),
           heartbeatInterval(kDefHeartbeatInterval),
@@ -262,6 +264,31 @@ namespace gz
           this->PrintCurrentState();
       }
 
+      /// \brief Constructor of a discovery limited to this process. It
+      /// doesn't use the network: no discovery messages are sent or
+      /// received, it only keeps the information of the local publishers.
+      /// \param[in] _pUuid This discovery instance will run inside a
+      /// transport process. This parameter is the transport process' UUID.
+      public: explicit Discovery(const std::string &_pUuid)
+        : port(0),
+          hostAddr("127.0.0.1"),
+          pUuid(_pUuid),
+          pUuidKey(Uuid::FromIdentifier(_pUuid)),
+          silenceInterval(kDefSilenceInterval),
+          activityInterval(kDefActivityInterval),
+          heartbeatInterval(kDefHeartbeatInterval),
+          connectionCb(nullptr),
+          disconnectionCb(nullptr),
+          verbose(false),
+          initialized(true),
+          numHeartbeatsUninitialized(0),
+          exit(false),
+          enabled(false),
+          local(true)
+      {
+        memset(&this->mcastAddr, 0, sizeof(this->mcastAddr));
+      }
+
       /// \brief Destructor.
       public: virtual ~Discovery()
       {
@@ -306,6 +333,10 @@ namespace gz
           this->enabled = true;
         }
 
+        // There's nothing to receive without the network.
+        if (this->local)
+          return;
+
         auto now = std::chrono::steady_clock::now();
         this->timeNextHeartbeat = now;
         this->timeNextActivity = now;
@@ -314,6 +345,19 @@ namespace gz
         this->threadReception = std::thread(&Discovery::RecvMessages, this);
       }
 
+      /// \brief Get the native handle of the thread that receives discovery
+      /// information, e.g. to configure its scheduling.
+      /// \param[out] _handle The handle.
+      /// \return False if the thread is not running (see Start()).
+      public: bool ReceptionThreadHandle(
+                  std::thread::native_handle_type &_handle)
+      {
+        if (!this->threadReception.joinable())
+          return false;
+        _handle = this->threadReception.native_handle();
+        return true;
+      }
+
       /// \brief Advertise a new message.
       /// \param[in] _publisher Publisher's information to advertise.
       /// \return True if the method succeed or false otherwise
@@ -340,6 +384,71 @@ namespace gz
         return true;
       }
 
+      /// \brief Advertise many messages at once. The discovery information
+      /// is updated under a single lock and then the announcements are sent.
+      /// \param[in] _publishers Publishers' information to advertise.
+      /// \param[out] _advertised For each publisher, whether it was
+      /// advertised. A publisher is not advertised if it was already
+      /// registered.
+      /// \return True if the method succeed or false otherwise
+      /// (e.g. if the discovery has not been started).
+      public: bool Advertise(const std::vector<Pub> &_publishers,
+                             std::vector<bool> &_advertised)
+      {
+        _advertised.assign(_publishers.size(), false);
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+
+          if (!this->enabled)
+            return false;
+
+          // Add the addressing information (local publishers).
+          for (std::size_t i = 0; i < _publishers.size(); ++i)
+            _advertised[i] = this->info.AddPublisher(_publishers[i]);
+        }
+
+        // Only advertise a message outside this process if the scope
+        // is not 'Process'
+        for (std::size_t i = 0; i < _publishers.size(); ++i)
+        {
+          if (_advertised[i] &&
+              _publishers[i].Options().Scope() != Scope_t::PROCESS)
+          {
+            this->SendMsg(DestinationType::ALL, msgs::Discovery::ADVERTISE,
+                _publishers[i]);
+          }
+        }
+
+        return true;
+      }
+
+      /// \brief Update the information of a publisher already advertised
+      /// and announce the new information.
+      /// \param[in] _publisher Publisher's updated information.
+      /// \return True if the method succeed or false otherwise
+      /// (e.g. if the discovery has not been started or the publisher was
+      /// not advertised).
+      public: bool UpdateAdvertisement(const Pub &_publisher)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+
+          if (!this->enabled)
+            return false;
+
+          if (!this->info.UpdatePublisher(_publisher))
+            return false;
+        }
+
+        // Only advertise a message outside this process if the scope
+        // is not 'Process'
+        if (_publisher.Options().Scope() != Scope_t::PROCESS)
+          this->SendMsg(DestinationType::ALL, msgs::Discovery::ADVERTISE,
+              _publisher);
+
+        return true;
+      }
+
       /// \brief Request discovery information about a topic.
       /// When using this method, the user might want to use
       /// SetConnectionsCb() and SetDisconnectionCb(), that registers callbacks
@@ -433,6 +542,17 @@ namespace gz
         return this->info.Publishers(_topic, _publishers);
       }
 
+      /// \brief Check if a process has publishers of a topic.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _pUuid Process UUID.
+      /// \return True if the process has at least one publisher of the topic.
+      public: bool HasAnyPublishers(const std::string &_topic,
+                                    const Uuid &_pUuid) const
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->info.HasAnyPublishers(_topic, _pUuid);
+      }
+
       /// \brief Unadvertise a new message. Broadcast a discovery
       /// message that will cancel all the discovery information for the topic
       /// advertised by a specific node.
@@ -442,6 +562,19 @@ namespace gz
       /// (e.g. if the discovery has not been started).
       public: bool Unadvertise(const std::string &_topic,
                                const std::string &_nUuid)
+      {
+        return this->Unadvertise(_topic, Uuid::FromIdentifier(_nUuid));
+      }
+
+      /// \brief Unadvertise a new message. Broadcast a discovery
+      /// message that will cancel all the discovery information for the topic
+      /// advertised by a specific node.
+      /// \param[in] _topic Topic name to be unadvertised.
+      /// \param[in] _nUuid Node UUID.
+      /// \return True if the method succeeded or false otherwise
+      /// (e.g. if the discovery has not been started).
+      public: bool Unadvertise(const std::string &_topic,
+                               const Uuid &_nUuid)
       {
         Pub inf;
         {
@@ -451,11 +584,11 @@ namespace gz
             return false;
 
           // Don't do anything if the topic is not advertised by any of my nodes
-          if (!this->info.Publisher(_topic, this->pUuid, _nUuid, inf))
+          if (!this->info.Publisher(_topic, this->pUuidKey, _nUuid, inf))
             return true;
 
           // Remove the topic information.
-          this->info.DelPublisherByNode(_topic, this->pUuid, _nUuid);
+          this->info.DelPublisherByNode(_topic, this->pUuidKey, _nUuid);
         }
 
         // Only unadvertise a message outside this process if the scope
@@ -604,9 +737,9 @@ namespace gz
           for (auto &proc : this->activity)
           {
             // Elapsed time since the last update from this publisher.
-            std::chrono::duration<double> elapsed = now - proc.second;
+            std::chrono::duration<double> elapsed = now - proc.second.time;
 
-            std::cout << "\t" << proc.first << std::endl;
+            std::cout << "\t" << proc.second.pUuid << std::endl;
             std::cout << "\t\t" << "Since: " << std::chrono::duration_cast<
               std::chrono::milliseconds>(elapsed).count() << " ms. ago. "
               << std::endl;
@@ -660,7 +793,7 @@ namespace gz
           for (auto it = this->activity.cbegin(); it != this->activity.cend();)
           {
             // Elapsed time since the last update from this publisher.
-            auto elapsed = now - it->second;
+            auto elapsed = now - it->second.time;
 
             // This publisher has expired.
             if (std::chrono::duration_cast<std::chrono::milliseconds>
@@ -669,7 +802,7 @@ namespace gz
               // Remove all the info entries for this process UUID.
               this->info.DelPublishersByProc(it->first);
 
-              uuids.push_back(it->first);
+              uuids.push_back(it->second.pUuid);
 
               // Remove the activity entry.
               this->activity.erase(it++);
@@ -716,13 +849,18 @@ namespace gz
           std::lock_guard<std::mutex> lock(this->mutex);
 
           // Re-advertise topics that are advertised inside this process.
-          this->info.PublishersByProc(this->pUuid, nodes);
+          this->info.PublishersByProc(this->pUuidKey, nodes);
         }
 
         for (const auto &topic : nodes)
         {
           for (const auto &node : topic.second)
           {
+            // Process scoped topics are never announced outside this process
+            // (see Advertise()), so don't re-advertise them either.
+            if (node.Options().Scope() == Scope_t::PROCESS)
+              continue;
+
             this->SendMsg(DestinationType::ALL,
                 msgs::Discovery::ADVERTISE, node);
           }
@@ -880,9 +1018,10 @@ namespace gz
           return;
 
         std::string recvPUuid = msg.process_uuid();
+        const Uuid recvPUuidKey = Uuid::FromIdentifier(recvPUuid);
 
         // Discard our own discovery messages.
-        if (recvPUuid == this->pUuid)
+        if (recvPUuidKey == this->pUuidKey)
           return;
 
         // Forwarding summary:
@@ -928,7 +1067,10 @@ namespace gz
         DiscoveryCallback<Pub> unregisterCb;
         {
           std::lock_guard<std::mutex> lock(this->mutex);
-          this->activity[recvPUuid] = std::chrono::steady_clock::now();
+          auto &procActivity = this->activity[recvPUuidKey];
+          if (procActivity.pUuid.empty())
+            procActivity.pUuid = recvPUuid;
+          procActivity.time = std::chrono::steady_clock::now();
           connectCb = this->connectionCb;
           disconnectCb = this->disconnectionCb;
           registerCb = this->registrationCb;
@@ -956,6 +1098,11 @@ namespace gz
             {
               std::lock_guard<std::mutex> lock(this->mutex);
               added = this->info.AddPublisher(publisher);
+
+              // A known publisher might have changed its options (e.g. the
+              // version of a cacheable service).
+              if (!added)
+                this->info.UpdatePublisher(publisher);
             }
 
             if (added && connectCb)
@@ -985,7 +1132,7 @@ namespace gz
             Addresses_M<Pub> addresses;
             {
               std::lock_guard<std::mutex> lock(this->mutex);
-              if (!this->info.HasAnyPublishers(recvTopic, this->pUuid))
+              if (!this->info.HasAnyPublishers(recvTopic, this->pUuidKey))
               {
                 break;
               }
@@ -1043,7 +1190,7 @@ namespace gz
             // Remove the activity entry for this publisher.
             {
               std::lock_guard<std::mutex> lock(this->mutex);
-              this->activity.erase(recvPUuid);
+              this->activity.erase(recvPUuidKey);
             }
 
             if (disconnectCb)
@@ -1057,7 +1204,7 @@ namespace gz
             // Remove the address entry for this topic.
             {
               std::lock_guard<std::mutex> lock(this->mutex);
-              this->info.DelPublishersByProc(recvPUuid);
+              this->info.DelPublishersByProc(recvPUuidKey);
             }
 
             break;
@@ -1086,7 +1233,7 @@ namespace gz
             {
               std::lock_guard<std::mutex> lock(this->mutex);
               this->info.DelPublisherByNode(publisher.Topic(),
-                publisher.PUuid(), publisher.NUuid());
+                publisher.ProcessKey(), publisher.NodeKey());
             }
 
             break;
@@ -1110,6 +1257,9 @@ namespace gz
                    const msgs::Discovery::Type _type,
                    const T &_pub) const
       {
+        if (this->local)
+          return;
+
         gz::msgs::Discovery discoveryMsg;
         discoveryMsg.set_version(this->Version());
         discoveryMsg.set_type(_type);
@@ -1423,6 +1573,9 @@ namespace gz
       /// \brief Process UUID.
       private: std::string pUuid;
 
+      /// \brief Process UUID as the key used by the storages.
+      private: Uuid pUuidKey;
+
       /// \brief Silence interval value (ms.).
       /// \sa MaxSilenceInterval.
       /// \sa SetMaxSilenceInterval.
@@ -1453,11 +1606,21 @@ namespace gz
       /// \brief Addressing information.
       private: TopicStorage<Pub> info;
 
+      /// \brief Activity of a remote process.
+      protected: struct ProcessActivity
+      {
+        /// \brief Process UUID in string format, as it was received.
+        public: std::string pUuid;
+
+        /// \brief Time of the last message received from the process.
+        public: Timestamp time;
+      };
+
       /// \brief Activity information. Every time there is a message from a
       /// remote node, its activity information is updated. If we do not hear
       /// from a node in a while, its entries in 'info' will be invalided. The
       /// key is the process uuid.
-      protected: std::map<std::string, Timestamp> activity;
+      protected: std::map<Uuid, ProcessActivity> activity;
 
       /// \brief Print discovery information to stdout.
       private: bool verbose;
@@ -1503,6 +1666,9 @@ namespace gz
 
       /// \brief When true, the service is enabled.
       private: bool enabled;
+
+      /// \brief When true, the network is not used.
+      private: bool local = false;
     };
 
     /// \def MsgDiscovery
@@ -18,13 +18,22 @@
 #ifndef GZ_TRANSPORT_HANDLERSTORAGE_HH_
 #define GZ_TRANSPORT_HANDLERSTORAGE_HH_
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gz/transport/config.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -36,41 +45,136 @@ namespace gz
     /// \class HandlerStorage HandlerStorage.hh
     /// gz/transport/HandlerStorage.hh
     /// \brief Class to store and manage service call handlers.
+    ///
+    /// The handlers are kept in an immutable snapshot that is replaced
+    /// every time a handler is added or removed, which also increments a
+    /// version counter. Each thread keeps the last snapshot it read, and
+    /// only loads the current one, under a lock, when the version has
+    /// changed. In the steady state, the lookups performed for every message
+    /// or service call neither allocate nor lock. A consequence is that a
+    /// removed handler may be destroyed only when the threads that read it
+    /// look up the handlers of this storage again. Writers are serialized
+    /// between them and copy the parts of the snapshot that change. The
+    /// handlers are keyed by the 16 byte value of their node and handler
+    /// UUIDs. Each function that takes UUID strings has an overload that
+    /// takes the parsed UUIDs, see Uuid::FromIdentifier.
     template<typename T> class HandlerStorage
     {
-      /// \brief Stores all the service call data for each topic. The key of
-      /// _data is the topic name. The value is another map, where the key is
-      /// the node UUID and the value is a smart pointer to the handler.
-      /// \TODO(Carlos) review this names and fix them
-      using UUIDHandler_M = std::map<std::string, std::shared_ptr<T>>;
-      using UUIDHandler_Collection_M = std::map<std::string, UUIDHandler_M>;
+      /// \brief A handler registered for a topic.
+      public: struct Entry
+      {
+        /// \brief UUID of the node that registered the handler.
+        public: Uuid nUuid;
+
+        /// \brief UUID of the handler.
+        public: Uuid hUuid;
+
+        /// \brief The handler.
+        public: std::shared_ptr<T> handler;
+      };
+
+      /// \brief The handlers of a topic, sorted by node UUID and handler UUID.
+      public: using HandlerList = std::vector<Entry>;
+
+      /// \brief Shared pointer to an immutable list of handlers. The list
+      /// remains valid after the storage is modified.
+      public: using HandlerListPtr = std::shared_ptr<const HandlerList>;
+
+      /// \brief The handlers of a topic.
+      private: struct TopicData
+      {
+        /// \brief Topic name.
+        public: std::string topic;
+
+        /// \brief Handlers of the topic. Never empty.
+        public: HandlerList handlers;
+      };
+
+      /// \brief Entry of the topic index.
+      private: struct TopicSlot
+      {
+        /// \brief Hash of the topic name.
+        public: std::size_t hash;
+
+        /// \brief The handlers of the topic.
+        public: std::shared_ptr<const TopicData> data;
+      };
 
-      /// \brief key is a topic name and value is UUIDHandler_M
-      using TopicServiceCalls_M =
-        std::map<std::string, UUIDHandler_Collection_M>;
+      /// \brief Index of all the topics, sorted by hash. Copying it only
+      /// copies the hashes and the pointers to the handler lists.
+      private: using Snapshot = std::vector<TopicSlot>;
+
+      /// \brief Snapshot read by a thread.
+      private: struct CachedSnapshot
+      {
+        /// \brief Identifier of the storage, or 0 if the entry is unused.
+        public: uint64_t storageId = 0;
+
+        /// \brief Version of the storage when the snapshot was read.
+        public: uint64_t version = 0;
+
+        /// \brief The snapshot.
+        public: std::shared_ptr<const Snapshot> snapshot;
+      };
+
+      /// \brief Number of storages whose snapshot is kept by each thread.
+      private: static constexpr std::size_t kCachedSnapshots = 8u;
 
       /// \brief Constructor.
-      public: HandlerStorage() = default;
+      public: HandlerStorage()
+        : snapshot(std::make_shared<const Snapshot>()),
+          id(NextId())
+      {
+      }
 
       /// \brief Destructor.
       public: virtual ~HandlerStorage() = default;
 
+      /// \brief Get the handlers for a topic. This function does not allocate
+      /// and it is safe to call while other threads modify the storage.
+      /// \param[in] _topic Topic name.
+      /// \return The handlers of the topic, or nullptr if there are none.
+      public: HandlerListPtr TopicHandlers(const std::string &_topic) const
+      {
+        const TopicSlot *slot = Find(*this->Read(), _topic);
+        if (!slot)
+          return nullptr;
+
+        // Share the ownership of the topic data.
+        return HandlerListPtr(slot->data, &slot->data->handlers);
+      }
+
+      /// \brief Get the version of the storage. It changes every time a
+      /// handler is added or removed, so it can be used to check if a handler
+      /// chosen earlier is still current without loading the handlers.
+      /// \return The version of the storage.
+      public: uint64_t Version() const
+      {
+        return this->version.load(std::memory_order_acquire);
+      }
+
       /// \brief Get the data handlers for a topic. A request
       /// handler stores the callback and types associated to a service call
       /// request.
       /// \param[in] _topic Topic name.
       /// \param[out] _handlers Request handlers. The key of _handlers is the
-      /// topic name. The value is another map, where the key is the node
-      /// UUID and the value is a smart pointer to the handler.
+      /// node UUID in string format. The value is another map, where the key
+      /// is the handler UUID and the value is a smart pointer to the handler.
       /// \return true if the topic contains at least one request.
       public: bool Handlers(const std::string &_topic,
         std::map<std::string,
           std::map<std::string, std::shared_ptr<T> >> &_handlers) const
       {
-        if (this->data.find(_topic) == this->data.end())
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
           return false;
 
-        _handlers = this->data.at(_topic);
+        _handlers.clear();
+        for (const Entry &entry : *list)
+        {
+          _handlers[entry.nUuid.ToString()][entry.handler->HandlerUuid()] =
+            entry.handler;
+        }
         return true;
       }
 
@@ -86,20 +190,35 @@ namespace gz
                                 const std::string &_repTypeName,
                                 std::shared_ptr<T> &_handler) const
       {
-        if (this->data.find(_topic) == this->data.end())
+        return this->FirstHandler(_topic, msgTypeId(_reqTypeName),
+          msgTypeId(_repTypeName), _handler);
+      }
+
+      /// \brief Get the first handler for a topic that matches a specific pair
+      /// of request/response type identifiers. A generic response type, on
+      /// either side, matches any response type.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _reqTypeId Type identifier of the service request.
+      /// \param[in] _repTypeId Type identifier of the service response.
+      /// \param[out] _handler handler.
+      /// \return true if a handler was found.
+      public: bool FirstHandler(const std::string &_topic,
+                                const MsgTypeId _reqTypeId,
+                                const MsgTypeId _repTypeId,
+                                std::shared_ptr<T> &_handler) const
+      {
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
           return false;
 
-        const auto &m = this->data.at(_topic);
-        for (const auto &node : m)
+        for (const Entry &entry : *list)
         {
-          for (const auto &handler : node.second)
+          if (_reqTypeId == entry.handler->ReqTypeId() &&
+              (_repTypeId == kGenericMsgTypeId ||
+               msgTypeMatches(entry.handler->RepTypeId(), _repTypeId)))
           {
-            if (_reqTypeName == handler.second->ReqTypeName() &&
-                _repTypeName == handler.second->RepTypeName())
-            {
-              _handler = handler.second;
-              return true;
-            }
+            _handler = entry.handler;
+            return true;
           }
         }
         return false;
@@ -115,25 +234,60 @@ namespace gz
                                 const std::string &_msgTypeName,
                                 std::shared_ptr<T> &_handler) const
       {
-        if (this->data.find(_topic) == this->data.end())
+        return this->FirstHandler(_topic, msgTypeId(_msgTypeName), _handler);
+      }
+
+      /// \brief Get the first handler for a topic that matches a specific
+      /// message type identifier.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _msgTypeId Type identifier of the msg.
+      /// \param[out] _handler handler.
+      /// \return true if a handler was found.
+      public: bool FirstHandler(const std::string &_topic,
+                                const MsgTypeId _msgTypeId,
+                                std::shared_ptr<T> &_handler) const
+      {
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
           return false;
 
-        const auto &m = this->data.at(_topic);
-        for (const auto &node : m)
+        for (const Entry &entry : *list)
         {
-          for (const auto &handler : node.second)
+          if (entry.handler->AcceptsType(_msgTypeId))
           {
-            if (_msgTypeName == handler.second->TypeName() ||
-                handler.second->TypeName() == kGenericMessageType)
-            {
-              _handler = handler.second;
-              return true;
-            }
+            _handler = entry.handler;
+            return true;
           }
         }
         return false;
       }
 
+      /// \brief Get the handlers for a topic that accept a message type.
+      /// Unlike Handlers(const std::string&, std::map&), the handlers of all
+      /// the nodes are flattened into a single list that only contains the
+      /// handlers that should receive the message.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _msgTypeId Type identifier of the msg.
+      /// \param[out] _handlers The matching handlers. Handlers are appended.
+      /// \return true if at least one handler was found.
+      /// \sa TopicHandlers
+      public: bool Handlers(const std::string &_topic,
+                            const MsgTypeId _msgTypeId,
+                            std::vector<std::shared_ptr<T>> &_handlers) const
+      {
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
+          return false;
+
+        const std::size_t initialSize = _handlers.size();
+        for (const Entry &entry : *list)
+        {
+          if (entry.handler->AcceptsType(_msgTypeId))
+            _handlers.push_back(entry.handler);
+        }
+        return _handlers.size() > initialSize;
+      }
+
       /// \brief Get a specific handler.
       /// \param[in] _topic Topic name.
       /// \param[in] _nUuid Node UUID of the handler.
@@ -145,17 +299,30 @@ namespace gz
                            const std::string &_hUuid,
                            std::shared_ptr<T> &_handler) const
       {
-        if (this->data.find(_topic) == this->data.end())
-          return false;
+        return this->Handler(_topic, Uuid::FromIdentifier(_nUuid),
+          Uuid::FromIdentifier(_hUuid), _handler);
+      }
 
-        auto const &m = this->data.at(_topic);
-        if (m.find(_nUuid) == m.end())
+      /// \brief Get a specific handler.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _nUuid Node UUID of the handler.
+      /// \param[in] _hUuid Handler UUID.
+      /// \param[out] _handler Handler requested.
+      /// \return true if the handler was found.
+      public: bool Handler(const std::string &_topic,
+                           const Uuid &_nUuid,
+                           const Uuid &_hUuid,
+                           std::shared_ptr<T> &_handler) const
+      {
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
           return false;
 
-        if (m.at(_nUuid).find(_hUuid) == m.at(_nUuid).end())
+        auto it = LowerBound(*list, _nUuid, _hUuid);
+        if (it == list->end() || it->nUuid != _nUuid || it->hUuid != _hUuid)
           return false;
 
-        _handler = m.at(_nUuid).at(_hUuid);
+        _handler = it->handler;
         return true;
       }
 
@@ -168,17 +335,29 @@ namespace gz
                               const std::string &_nUuid,
                               const std::shared_ptr<T> &_handler)
       {
-        // Create the topic entry.
-        if (this->data.find(_topic) == this->data.end())
-          this->data[_topic] = UUIDHandler_Collection_M();
+        this->AddHandler(_topic, Uuid::FromIdentifier(_nUuid), _handler);
+      }
 
-        // Create the Node UUID entry.
-        if (this->data[_topic].find(_nUuid) == this->data[_topic].end())
-          this->data[_topic][_nUuid] = UUIDHandler_M();
+      /// \brief Add a request handler to a topic. A request handler stores
+      /// the callback and types associated to a service call request.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _nUuid Node's unique identifier.
+      /// \param[in] _handler Request handler.
+      public: void AddHandler(const std::string &_topic,
+                              const Uuid &_nUuid,
+                              const std::shared_ptr<T> &_handler)
+      {
+        const Uuid &hUuid = _handler->HandlerKey();
+        this->Modify(_topic, [&](HandlerList &_list)
+        {
+          // A handler that is already registered is not replaced.
+          auto it = LowerBound(_list, _nUuid, hUuid);
+          if (it != _list.end() && it->nUuid == _nUuid && it->hUuid == hUuid)
+            return false;
 
-        // Add/Replace the Req handler.
-        this->data[_topic][_nUuid].insert(
-          std::make_pair(_handler->HandlerUuid(), _handler));
+          _list.insert(it, Entry{_nUuid, hUuid, _handler});
+          return true;
+        });
       }
 
       /// \brief Return true if we have stored at least one request for the
@@ -187,10 +366,7 @@ namespace gz
       /// \return true if we have stored at least one request for the topic.
       public: bool HasHandlersForTopic(const std::string &_topic) const
       {
-        if (this->data.find(_topic) == this->data.end())
-          return false;
-
-        return !this->data.at(_topic).empty();
+        return this->TopicHandlers(_topic) != nullptr;
       }
 
       /// \brief Check if a node has at least one handler.
@@ -200,11 +376,22 @@ namespace gz
       public: bool HasHandlersForNode(const std::string &_topic,
                                       const std::string &_nUuid) const
       {
-        if (this->data.find(_topic) == this->data.end())
+        return this->HasHandlersForNode(_topic, Uuid::FromIdentifier(_nUuid));
+      }
+
+      /// \brief Check if a node has at least one handler.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _nUuid Node's unique identifier.
+      /// \return true if the node has at least one handler registered.
+      public: bool HasHandlersForNode(const std::string &_topic,
+                                      const Uuid &_nUuid) const
+      {
+        HandlerListPtr list = this->TopicHandlers(_topic);
+        if (!list)
           return false;
 
-        return this->data.at(_topic).find(_nUuid) !=
-               this->data.at(_topic).end();
+        auto it = LowerBound(*list, _nUuid);
+        return it != list->end() && it->nUuid == _nUuid;
       }
 
       /// \brief Remove a request handler. The node's uuid is used as a key to
@@ -217,20 +404,32 @@ namespace gz
                                  const std::string &_nUuid,
                                  const std::string &_reqUuid)
       {
-        size_t counter = 0;
-        if (this->data.find(_topic) != this->data.end())
+        return this->RemoveHandler(_topic, Uuid::FromIdentifier(_nUuid),
+          Uuid::FromIdentifier(_reqUuid));
+      }
+
+      /// \brief Remove a request handler. The node's uuid is used as a key to
+      /// remove the appropriate request handler.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _nUuid Node's unique identifier.
+      /// \param[in] _reqUuid Request's UUID to remove.
+      /// \return True when the handler is removed or false otherwise.
+      public: bool RemoveHandler(const std::string &_topic,
+                                 const Uuid &_nUuid,
+                                 const Uuid &_reqUuid)
+      {
+        return this->Modify(_topic, [&](HandlerList &_list)
         {
-          if (this->data[_topic].find(_nUuid) != this->data[_topic].end())
+          auto it = LowerBound(_list, _nUuid, _reqUuid);
+          if (it == _list.end() || it->nUuid != _nUuid ||
+              it->hUuid != _reqUuid)
           {
-            counter = this->data[_topic][_nUuid].erase(_reqUuid);
-            if (this->data[_topic][_nUuid].empty())
-              this->data[_topic].erase(_nUuid);
-            if (this->data[_topic].empty())
-              this->data.erase(_topic);
+            return false;
           }
-        }
 
-        return counter > 0;
+          _list.erase(it);
+          return true;
+        });
       }
 
       /// \brief Remove all the handlers from a given node.
@@ -240,21 +439,212 @@ namespace gz
       public: bool RemoveHandlersForNode(const std::string &_topic,
                                          const std::string &_nUuid)
       {
-        size_t counter = 0;
-        if (this->data.find(_topic) != this->data.end())
+        return this->RemoveHandlersForNode(_topic,
+          Uuid::FromIdentifier(_nUuid));
+      }
+
+      /// \brief Remove all the handlers from a given node.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _nUuid Node's unique identifier.
+      /// \return True when at least one handler was removed or false otherwise.
+      public: bool RemoveHandlersForNode(const std::string &_topic,
+                                         const Uuid &_nUuid)
+      {
+        return this->Modify(_topic, [&](HandlerList &_list)
+        {
+          auto first = LowerBound(_list, _nUuid);
+          auto last = first;
+          while (last != _list.end() && last->nUuid == _nUuid)
+            ++last;
+
+          if (first == last)
+            return false;
+
+          _list.erase(first, last);
+          return true;
+        });
+      }
+
+      /// \brief Load the current snapshot.
+      /// \return The current snapshot.
+      private: std::shared_ptr<const Snapshot> Load() const
+      {
+        return std::atomic_load(&this->snapshot);
+      }
+
+      /// \brief Get the snapshot kept by the current thread, loading the
+      /// current one if the storage has changed since it was read.
+      /// \return The snapshot. It remains valid until the next call from
+      /// the same thread.
+      private: const std::shared_ptr<const Snapshot> &Read() const
+      {
+        thread_local std::array<CachedSnapshot, kCachedSnapshots> cache;
+        thread_local std::size_t next = 0;
+
+        // Read the version first, so the snapshot loaded below is at least
+        // as recent as the version.
+        const uint64_t current = this->Version();
+
+        CachedSnapshot *entry = nullptr;
+        for (CachedSnapshot &cached : cache)
+        {
+          if (cached.storageId == this->id)
+          {
+            entry = &cached;
+            break;
+          }
+        }
+
+        if (!entry)
+        {
+          // Replace the entries in turn, including the ones of storages
+          // that no longer exist.
+          entry = &cache[next];
+          next = (next + 1) % kCachedSnapshots;
+          entry->storageId = this->id;
+        }
+        else if (entry->version == current && entry->snapshot)
+        {
+          return entry->snapshot;
+        }
+
+        entry->version = current;
+        entry->snapshot = this->Load();
+        return entry->snapshot;
+      }
+
+      /// \brief Get a new storage identifier.
+      /// \return The identifier, never 0.
+      private: static uint64_t NextId()
+      {
+        static std::atomic<uint64_t> lastId{0};
+        return ++lastId;
+      }
+
+      /// \brief Find the slot of a topic in a snapshot.
+      /// \param[in] _snapshot The snapshot.
+      /// \param[in] _topic Topic name.
+      /// \return The slot, or nullptr if the topic has no handlers.
+      private: static const TopicSlot *Find(const Snapshot &_snapshot,
+                                            const std::string &_topic)
+      {
+        const std::size_t hash = std::hash<std::string>()(_topic);
+        auto it = LowerBound(_snapshot, hash);
+        for (; it != _snapshot.end() && it->hash == hash; ++it)
         {
-          counter = this->data[_topic].erase(_nUuid);
-          if (this->data[_topic].empty())
-            this->data.erase(_topic);
+          if (it->data->topic == _topic)
+            return &(*it);
         }
+        return nullptr;
+      }
 
-        return counter > 0;
+      /// \brief First slot of a snapshot with a hash not less than _hash.
+      /// \param[in] _snapshot The snapshot.
+      /// \param[in] _hash Topic hash.
+      /// \return Iterator to the slot.
+      private: static typename Snapshot::const_iterator LowerBound(
+                 const Snapshot &_snapshot, const std::size_t _hash)
+      {
+        return std::lower_bound(_snapshot.begin(), _snapshot.end(), _hash,
+          [](const TopicSlot &_slot, const std::size_t _h)
+          {
+            return _slot.hash < _h;
+          });
+      }
+
+      /// \brief First entry of a handler list not ordered before the
+      /// given node and handler UUIDs.
+      /// \param[in] _list The handler list.
+      /// \param[in] _nUuid Node UUID.
+      /// \param[in] _hUuid Handler UUID.
+      /// \return Iterator to the entry.
+      private: template<typename ListT>
+      static auto LowerBound(ListT &_list, const Uuid &_nUuid,
+                             const Uuid &_hUuid)
+        -> decltype(_list.begin())
+      {
+        return std::lower_bound(_list.begin(), _list.end(), _nUuid,
+          [&_hUuid](const Entry &_entry, const Uuid &_n)
+          {
+            return _entry.nUuid < _n ||
+                   (_entry.nUuid == _n && _entry.hUuid < _hUuid);
+          });
       }
 
-      /// \brief Stores all the service call data for each topic. The key of
-      /// _data is the topic name. The value is another map, where the key is
-      /// the node UUID and the value is a smart pointer to the handler.
-      private: TopicServiceCalls_M data;
+      /// \brief First entry of a handler list that belongs to a node.
+      /// \param[in] _list The handler list.
+      /// \param[in] _nUuid Node UUID.
+      /// \return Iterator to the entry.
+      private: template<typename ListT>
+      static auto LowerBound(ListT &_list, const Uuid &_nUuid)
+        -> decltype(_list.begin())
+      {
+        return std::lower_bound(_list.begin(), _list.end(), _nUuid,
+          [](const Entry &_entry, const Uuid &_n)
+          {
+            return _entry.nUuid < _n;
+          });
+      }
+
+      /// \brief Apply a modification to the handlers of a topic and publish
+      /// the result as a new snapshot.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _modify Function that modifies a copy of the handler list
+      /// of the topic. It returns false if nothing was changed.
+      /// \return The value returned by _modify.
+      private: bool Modify(const std::string &_topic,
+                           const std::function<bool(HandlerList &)> &_modify)
+      {
+        std::lock_guard<std::mutex> lk(this->writeMutex);
+
+        std::shared_ptr<const Snapshot> current = this->Load();
+        const std::size_t hash = std::hash<std::string>()(_topic);
+
+        auto newTopic = std::make_shared<TopicData>();
+        newTopic->topic = _topic;
+
+        const TopicSlot *slot = Find(*current, _topic);
+        if (slot)
+          newTopic->handlers = slot->data->handlers;
+
+        if (!_modify(newTopic->handlers))
+          return false;
+
+        auto next = std::make_shared<Snapshot>(*current);
+        if (slot)
+        {
+          auto it = next->begin() + (slot - current->data());
+          if (newTopic->handlers.empty())
+            next->erase(it);
+          else
+            it->data = std::move(newTopic);
+        }
+        else if (!newTopic->handlers.empty())
+        {
+          next->insert(LowerBound(*next, hash),
+            TopicSlot{hash, std::move(newTopic)});
+        }
+
+        std::atomic_store(&this->snapshot,
+          std::shared_ptr<const Snapshot>(std::move(next)));
+        this->version.fetch_add(1, std::memory_order_release);
+        return true;
+      }
+
+      /// \brief Current snapshot of all the handlers. Only accessed with
+      /// std::atomic_load() and std::atomic_store(), when the storage is
+      /// modified or after a thread sees a new version.
+      private: std::shared_ptr<const Snapshot> snapshot;
+
+      /// \brief Identifier of this storage in the snapshots kept by the
+      /// threads. Unlike its address, it's never reused.
+      private: const uint64_t id;
+
+      /// \brief Version of the storage, incremented after every snapshot.
+      private: std::atomic<uint64_t> version{0};
+
+      /// \brief Serializes the writers.
+      private: std::mutex writeMutex;
     };
     }
   }
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_MSGTYPEID_HH_
+#define GZ_TRANSPORT_MSGTYPEID_HH_
+
+#include <cstdint>
+#include <string>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \brief Compact identifier of a message type name. Every type name is
+    /// assigned a unique identifier the first time it is seen, so two
+    /// identifiers obtained in the same process are equal if and only if
+    /// their type names are equal. Identifiers are not meaningful outside of
+    /// the process that created them.
+    using MsgTypeId = uint32_t;
+
+    /// \brief Identifier of the empty type name, used when the type is not
+    /// known.
+    constexpr MsgTypeId kInvalidMsgTypeId = 0;
+
+    /// \brief Identifier of kGenericMessageType.
+    constexpr MsgTypeId kGenericMsgTypeId = 1;
+
+    /// \brief Get the identifier of a message type name, registering the name
+    /// if it has not been seen before. This function is thread safe, and it
+    /// doesn't lock after the first lookup of a name in a thread.
+    /// \param[in] _typeName Fully qualified name of the message type.
+    /// \return The identifier of the type, or kInvalidMsgTypeId if _typeName
+    /// is empty.
+    MsgTypeId GZ_TRANSPORT_VISIBLE msgTypeId(const std::string &_typeName);
+
+    /// \brief Get the message type name of an identifier returned by
+    /// msgTypeId(). The registered names are shared by the whole process, so
+    /// callers can keep the identifier instead of a copy of the name.
+    /// This function is thread safe.
+    /// \param[in] _id Identifier of the type.
+    /// \return The type name, or an empty string if _id is not registered.
+    /// The reference remains valid until the end of the process.
+    GZ_TRANSPORT_VISIBLE const std::string &msgTypeName(const MsgTypeId _id);
+
+    /// \brief Check whether a handler registered for a message type should
+    /// receive a message of another type.
+    /// \param[in] _handlerType Type of the handler.
+    /// \param[in] _msgType Type of the message.
+    /// \return True if the types are equal or the handler accepts any type.
+    inline bool msgTypeMatches(const MsgTypeId _handlerType,
+                               const MsgTypeId _msgType)
+    {
+      return _handlerType == _msgType || _handlerType == kGenericMsgTypeId;
+    }
+    }
+  }
+}
+
+// GZ_TRANSPORT_MSGTYPEID_HH_
+#endif
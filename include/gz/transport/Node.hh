@@ -18,6 +18,8 @@
 #define GZ_TRANSPORT_NODE_HH_
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -29,6 +31,7 @@
 #include "gz/transport/AdvertiseOptions.hh"
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/NodeOptions.hh"
 #include "gz/transport/NodeShared.hh"
 #include "gz/transport/Publisher.hh"
@@ -39,6 +42,7 @@
 #include "gz/transport/TopicStatistics.hh"
 #include "gz/transport/TopicUtils.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -181,6 +185,25 @@ namespace gz
         /// \return True if subscribers have connected to this publisher.
         public: bool HasConnections() const;
 
+        /// \brief Block until a number of subscribers, local or remote, are
+        /// connected to this publisher, or until a timeout expires. Use this
+        /// function instead of sleeping after advertising a topic, to make
+        /// sure that the first messages published reach the subscribers.
+        /// A subscriber is a node subscribed to the topic with a compatible
+        /// message type.
+        /// \param[in] _count Number of subscribers to wait for.
+        /// \param[in] _timeout Maximum time to wait.
+        /// \return True if at least _count subscribers are connected, or
+        /// false if the timeout expired or the publisher is not valid.
+        public: bool WaitForSubscribers(const std::size_t _count,
+                    const std::chrono::milliseconds &_timeout) const;
+
+        /// \brief Get the number of subscribers, local or remote, connected
+        /// to this publisher.
+        /// \return Number of nodes subscribed to the topic with a compatible
+        /// message type.
+        public: std::size_t SubscriberCount() const;
+
         /// \internal
         /// \brief Smart pointer to private data.
         /// This is std::shared_ptr because we want to trigger the destructor
@@ -196,15 +219,198 @@ namespace gz
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
+
+        /// \brief Node attaches the publishers it creates to its transport
+        /// context.
+        private: friend Node;
+      };
+
+      class ServiceClientPrivate;
+
+      /// \brief A class used to call the same service many times. An
+      /// instance of this class is returned from Node::CreateServiceClient.
+      /// The service name is remapped and fully qualified only once, the
+      /// message types are resolved once and the responder within the process
+      /// is cached until the responders of the service change. This makes
+      /// repeated requests much cheaper than calling Node::Request.
+      ///
+      /// ## Pseudo code example ##
+      ///
+      ///    auto client =
+      ///      myNode.CreateServiceClient<RequestT, ReplyT>("service_name");
+      ///    if (client)
+      ///    {
+      ///      RequestT req;
+      ///      ReplyT rep;
+      ///      bool result;
+      ///      client.Request(req, 500, rep, result);
+      ///    }
+      public: class GZ_TRANSPORT_VISIBLE ServiceClient
+      {
+        /// \brief Default constructor. The client is not valid.
+        public: ServiceClient();
+
+        /// \brief Constructor.
+        /// \param[in] _topic Fully qualified service name.
+        /// \param[in] _nUuid UUID of the node making the requests.
+        /// \param[in] _reqTypeName Message type name of the request.
+        /// \param[in] _repTypeName Message type name of the response.
+        public: ServiceClient(const std::string &_topic,
+                              const std::string &_nUuid,
+                              const std::string &_reqTypeName,
+                              const std::string &_repTypeName);
+
+        /// \brief Destructor.
+        public: virtual ~ServiceClient();
+
+        /// \brief Allows this class to be evaluated as a boolean.
+        /// \return True if valid
+        /// \sa Valid
+        public: operator bool() const;
+
+        /// \brief Return true if valid information, such as a non-empty
+        /// service name, is present.
+        /// \return True if this object can be used to make requests.
+        public: bool Valid() const;
+
+        /// \brief Get the service name.
+        /// \return The fully qualified service name.
+        public: const std::string &Service() const;
+
+        /// \brief Request the service using a blocking call.
+        /// \param[in] _request Protobuf message containing the request's
+        /// parameters. Its type must match the type of the client.
+        /// \param[in] _timeout The request will timeout after '_timeout' ms.
+        /// \param[out] _reply Protobuf message containing the response. Its
+        /// type must match the type of the client.
+        /// \param[out] _result Result of the service call.
+        /// \return true when the request was executed or false if the timeout
+        /// expired or the types don't match.
+        public: template<typename RequestT, typename ReplyT>
+        bool Request(const RequestT &_request,
+                     const unsigned int _timeout,
+                     ReplyT &_reply,
+                     bool &_result);
+
+        /// \brief Request the service using a non-blocking call.
+        /// \param[in] _request Protobuf message containing the request's
+        /// parameters. Its type must match the type of the client.
+        /// \param[in] _callback Function executed when the response arrives.
+        /// The callback has the following parameters:
+        ///   * _reply Protobuf message containing the response. If ReplyT is
+        ///   google::protobuf::Message, the response has the response type of
+        ///   the client.
+        ///   * _result Result of the service call. If false, there was
+        ///   a problem executing your request.
+        /// \return true when the service call was succesfully requested.
+        public: template<typename RequestT, typename ReplyT>
+        bool Request(const RequestT &_request,
+                     const std::function<void(const ReplyT &_reply,
+                                              const bool _result)> &_callback);
+
+        /// \brief Request the service without waiting for response. The
+        /// client must have been created with gz::msgs::Empty as the
+        /// response type.
+        /// \param[in] _request Protobuf message containing the request's
+        /// parameters. Its type must match the type of the client.
+        /// \return true when the service call was succesfully requested.
+        public: template<typename RequestT>
+        bool Request(const RequestT &_request);
+
+        /// \brief Check that the client is valid and the message types of a
+        /// request match the types of the client.
+        /// \param[in] _reqTypeId Type identifier of the request.
+        /// \param[in] _repTypeId Type identifier of the response.
+        /// \return True if the request can be made.
+        private: bool CheckTypes(const MsgTypeId _reqTypeId,
+                                 const MsgTypeId _repTypeId) const;
+
+        /// \brief Request the service using a non-blocking call when the
+        /// type of the response is only known at run time. The response is
+        /// created with the response type of the client.
+        /// \param[in] _reqTypeId Type identifier of the request.
+        /// \param[in] _request Protobuf message containing the request's
+        /// parameters.
+        /// \param[in] _callback Function executed when the response arrives.
+        /// \return true when the service call was succesfully requested.
+        private: bool RequestGenericReply(const MsgTypeId _reqTypeId,
+          const google::protobuf::Message &_request,
+          const std::function<void(const google::protobuf::Message &_reply,
+                                   const bool _result)> &_callback) const;
+
+        /// \brief Get the responder of the service within this process.
+        /// \param[out] _handler The responder.
+        /// \return True if there is a responder in this process.
+        private: bool LocalResponder(IRepHandlerPtr &_handler) const;
+
+        /// \brief Send a request to a remote responder.
+        /// \param[in] _handler Handler of the request.
+        /// \return True if the request was sent or is pending until the
+        /// responder is discovered.
+        private: bool SendRequest(const IReqHandlerPtr &_handler) const;
+
+        /// \brief Send a request to a remote responder and wait for the
+        /// response.
+        /// \param[in] _handler Handler of the request.
+        /// \param[in] _timeout Maximum time to wait in milliseconds.
+        /// \return True if the response was received before the timeout.
+        private: bool SendRequestAndWait(const IReqHandlerPtr &_handler,
+                                         const unsigned int _timeout) const;
+
+        /// \brief Get the UUID of the node making the requests.
+        /// \return The node UUID.
+        private: const std::string &NodeUuid() const;
+
+        /// \internal
+        /// \brief Smart pointer to private data, shared between the copies
+        /// of the client.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::shared_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+        private: std::shared_ptr<ServiceClientPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+        /// \brief Node attaches the clients it creates to its transport
+        /// context.
+        private: friend Node;
       };
 
       /// \brief Constructor.
       /// \param[in] _options Node options.
       public: explicit Node(const NodeOptions &_options = NodeOptions());
 
-      /// \brief Destructor.
+      /// \brief Constructor that shares the options with other nodes.
+      /// The options are not copied, which makes it cheap to create many
+      /// nodes with the same options, e.g. one node per component.
+      /// \param[in] _options Node options shared with other nodes. If null,
+      /// the default options are used.
+      /// \sa SharedOptions()
+      public: explicit Node(std::shared_ptr<const NodeOptions> _options);
+
+      /// \brief Destructor. The topics subscribed and the services
+      /// advertised by the node are removed when its last handle is
+      /// destroyed.
+      /// \sa CreateHandle()
       public: virtual ~Node();
 
+      /// \brief Create a lightweight handle to this node. The handle is the
+      /// same node: it shares the UUID, the options, the subscribed topics,
+      /// the advertised services and the handlers of this node. Creating and
+      /// destroying a handle doesn't allocate a UUID, copy the options or lock
+      /// the state shared by all the nodes, which makes it cheap to give one
+      /// node to each of many components.
+      /// The subscriptions and services are removed when the last of the
+      /// node and its handles is destroyed, and the handle can outlive this
+      /// node.
+      /// \return The new handle.
+      /// \sa SharedOptions()
+      public: std::unique_ptr<Node> CreateHandle() const;
+
       /// \brief Advertise a new topic. If a topic is currently advertised,
       /// you cannot advertise it a second time (regardless of its type).
       /// \param[in] _topic Topic name to be advertised.
@@ -234,6 +440,36 @@ namespace gz
           const std::string &_msgTypeName,
           const AdvertiseMessageOptions &_options = AdvertiseMessageOptions());
 
+      /// \brief Advertise many topics of the same message type at once. This
+      /// is equivalent to calling Advertise() for each topic, but the shared
+      /// state is only locked once and the advertised topics of the node are
+      /// not listed for every topic, so it is much faster for nodes that
+      /// advertise thousands of topics.
+      /// \param[in] _topics Topic names to be advertised.
+      /// \param[in] _options Advertise options, used for all the topics.
+      /// \return One publisher per topic, in the same order as _topics. A
+      /// publisher is invalid if its topic could not be advertised (e.g. the
+      /// name is not valid or it was already advertised by this node).
+      /// \sa Advertise
+      public: template<typename MessageT>
+      std::vector<Node::Publisher> AdvertiseMany(
+          const std::vector<std::string> &_topics,
+          const AdvertiseMessageOptions &_options = AdvertiseMessageOptions());
+
+      /// \brief Advertise many topics of the same message type at once.
+      /// \param[in] _topics Topic names to be advertised.
+      /// \param[in] _msgTypeName Name of the message type that will be
+      /// published on the topics.
+      /// \param[in] _options Advertise options, used for all the topics.
+      /// \return One publisher per topic, in the same order as _topics. A
+      /// publisher is invalid if its topic could not be advertised.
+      /// \sa AdvertiseMany(const std::vector<std::string>&,
+      /// const AdvertiseMessageOptions&)
+      public: std::vector<Node::Publisher> AdvertiseMany(
+          const std::vector<std::string> &_topics,
+          const std::string &_msgTypeName,
+          const AdvertiseMessageOptions &_options = AdvertiseMessageOptions());
+
       /// \brief Get the list of topics advertised by this node.
       /// \return A vector containing all the topics advertised by this node.
       public: std::vector<std::string> AdvertisedTopics() const;
@@ -653,6 +889,25 @@ namespace gz
       public: template<typename RequestT>
       bool Request(const std::string &_topic, const RequestT &_request);
 
+      /// \brief Create a client for making many requests to the same service.
+      /// \param[in] _topic Service name.
+      /// \return The client, which is invalid if the service name is not
+      /// valid.
+      /// \sa ServiceClient
+      public: template<typename RequestT, typename ReplyT>
+      ServiceClient CreateServiceClient(const std::string &_topic);
+
+      /// \brief Create a client for making many requests to the same service.
+      /// \param[in] _topic Service name.
+      /// \param[in] _reqTypeName Message type name of the request.
+      /// \param[in] _repTypeName Message type name of the response.
+      /// \return The client, which is invalid if the service name is not
+      /// valid.
+      /// \sa ServiceClient
+      public: ServiceClient CreateServiceClient(const std::string &_topic,
+                                                const std::string &_reqTypeName,
+                                                const std::string &_repTypeName);
+
       /// \brief Request a new service using a blocking call. This request
       /// function expects a serialized protobuf message as the request and
       /// returns a serialized protobuf message as the response.
@@ -678,6 +933,18 @@ namespace gz
       /// \return true if the service was successfully unadvertised.
       public: bool UnadvertiseSrv(const std::string &_topic);
 
+      /// \brief Invalidate the responses of a cacheable service kept by its
+      /// requesters. The cache version of the service is increased and
+      /// advertised again, so every requester discards the responses that
+      /// it received before. Call this function when the responses of the
+      /// service have changed.
+      /// \param[in] _service Service name advertised by this node with
+      /// AdvertiseServiceOptions::SetCacheable(true).
+      /// \return true if the service is advertised by this node and it is
+      /// cacheable.
+      /// \sa AdvertiseServiceOptions::SetCacheable
+      public: bool InvalidateServiceCache(const std::string &_service);
+
       /// \brief Get the list of topics currently advertised in the network.
       /// Note that this function can block for some time if the
       /// discovery is in its initialization phase.
@@ -732,6 +999,12 @@ namespace gz
       /// \return Reference to the current node options.
       public: const NodeOptions &Options() const;
 
+      /// \brief Get the options of this node, which can be used to create
+      /// other nodes that share them.
+      /// \return The options of this node.
+      /// \sa Node(std::shared_ptr<const NodeOptions>)
+      public: std::shared_ptr<const NodeOptions> SharedOptions() const;
+
       /// \brief Turn topic statistics on or off.
       /// \param[in] _topic The name of the topic on which to enable or disable
       /// statistics.
@@ -751,6 +1024,11 @@ namespace gz
       public: std::optional<TopicStatistics> TopicStats(
                   const std::string &_topic) const;
 
+      /// \brief Constructor of a handle sharing the private data of a node.
+      /// \param[in] _dataPtr Private data of the node.
+      /// \sa CreateHandle()
+      private: explicit Node(std::shared_ptr<transport::NodePrivate> _dataPtr);
+
       /// \brief Get a pointer to the shared node (singleton shared by all the
       /// nodes).
       /// \return The pointer to the shared node.
@@ -760,6 +1038,19 @@ namespace gz
       /// \return The node UUID.
       private: const std::string &NodeUuid() const;
 
+      /// \brief Get the parsed UUID of this node, used as the key of its
+      /// handlers and publishers in the storages.
+      /// \return The node UUID.
+      private: const Uuid &NodeKey() const;
+
+      /// \brief Get the interned identifier of a message type. The
+      /// identifier of a concrete protobuf type is only resolved once.
+      /// \param[in] _msg A message, only needed when MessageT is
+      /// google::protobuf::Message.
+      /// \return The type identifier of the message.
+      private: template<typename MessageT>
+      static MsgTypeId TypeId(const MessageT *_msg = nullptr);
+
       /// \brief Get the set of topics subscribed by this node.
       /// \return The set of subscribed topics.
       private: std::unordered_set<std::string> &TopicsSubscribed() const;
@@ -773,15 +1064,32 @@ namespace gz
       /// \return True on success.
       private: bool SubscribeHelper(const std::string &_fullyQualifiedTopic);
 
+      /// \brief Request a service using a non-blocking call when the type of
+      /// the response is only known at run time. The response has the
+      /// response type of the responder that answers the request.
+      /// \param[in] _fullyQualifiedTopic Fully qualified service name.
+      /// \param[in] _reqTypeId Type identifier of the request.
+      /// \param[in] _request Protobuf message containing the request's
+      /// parameters.
+      /// \param[in] _callback Function executed when the response arrives.
+      /// \return true when the service call was succesfully requested.
+      private: bool RequestGenericReply(
+        const std::string &_fullyQualifiedTopic,
+        const MsgTypeId _reqTypeId,
+        const google::protobuf::Message &_request,
+        const std::function<void(const google::protobuf::Message &_reply,
+                                 const bool _result)> &_callback);
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
-// std::unique_ptr
+// std::shared_ptr
 #pragma warning(push)
 #pragma warning(disable: 4251)
 #endif
       /// \internal
-      /// \brief Smart pointer to private data.
-      private: std::unique_ptr<transport::NodePrivate> dataPtr;
+      /// \brief Smart pointer to private data, shared between the handles
+      /// of the node.
+      private: std::shared_ptr<transport::NodePrivate> dataPtr;
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -20,6 +20,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
@@ -33,6 +34,28 @@ namespace gz
     //
     // Forward declarations.
     class NodeOptionsPrivate;
+    class TransportContext;
+
+    /// \brief Threads created by the transport library. They are shared by
+    /// all the nodes of a process, or of a TransportContext.
+    enum class TransportThread
+    {
+      /// \brief Thread that receives messages, service requests and
+      /// service responses.
+      RECEPTION,
+      /// \brief Thread that delivers asynchronous local publications.
+      PUBLISH,
+      /// \brief Thread that authenticates connections, only running when
+      /// GZ_TRANSPORT_USERNAME and GZ_TRANSPORT_PASSWORD are set.
+      ACCESS_CONTROL,
+      /// \brief Thread that receives topic discovery information.
+      MSG_DISCOVERY,
+      /// \brief Thread that receives service discovery information.
+      SRV_DISCOVERY,
+      /// \brief ZeroMQ I/O thread. It starts with the first node, so it can
+      /// only be configured with environment variables.
+      ZMQ_IO
+    };
 
     /// \class NodeOptions NodeOptions.hh gz/transport/NodeOptions.hh
     /// \brief A class for customizing the behavior of the Node.
@@ -126,6 +149,80 @@ namespace gz
       public: bool TopicRemap(const std::string &_fromTopic,
                               std::string &_toTopic) const;
 
+      /// \brief Set the CPUs where a transport thread can run. The threads
+      /// are shared by all the nodes of the process, the configuration is
+      /// applied when a node is created with these options. Values not set
+      /// here are taken from the GZ_TRANSPORT_THREAD_AFFINITY[_<THREAD>]
+      /// environment variables, e.g. GZ_TRANSPORT_THREAD_AFFINITY_RECEPTION.
+      /// Only supported on Linux.
+      /// \param[in] _thread The thread.
+      /// \param[in] _cpus The CPUs.
+      /// \return False if a CPU is negative or if the thread can't be
+      /// configured with node options (TransportThread::ZMQ_IO).
+      /// \sa ThreadAffinity
+      public: bool SetThreadAffinity(const TransportThread _thread,
+                                     const std::vector<int> &_cpus);
+
+      /// \brief Get the CPUs set for a transport thread.
+      /// \param[in] _thread The thread.
+      /// \return The CPUs, or an empty vector if not set.
+      /// \sa SetThreadAffinity
+      public: std::vector<int> ThreadAffinity(
+                  const TransportThread _thread) const;
+
+      /// \brief Run a transport thread with the SCHED_FIFO policy and the
+      /// given priority. This usually requires privileges (CAP_SYS_NICE).
+      /// Values not set here are taken from the
+      /// GZ_TRANSPORT_THREAD_PRIORITY[_<THREAD>] environment variables.
+      /// Only supported on Linux.
+      /// \param[in] _thread The thread.
+      /// \param[in] _priority The priority, in [1, 99].
+      /// \return False if the priority is out of range or if the thread
+      /// can't be configured with node options (TransportThread::ZMQ_IO).
+      /// \sa ThreadPriority
+      public: bool SetThreadPriority(const TransportThread _thread,
+                                     const int _priority);
+
+      /// \brief Get the priority set for a transport thread.
+      /// \param[in] _thread The thread.
+      /// \return The priority, or 0 if not set.
+      /// \sa SetThreadPriority
+      public: int ThreadPriority(const TransportThread _thread) const;
+
+      /// \brief Set the name of a transport thread, as shown by tools like
+      /// top or gdb. Names are truncated to 15 characters. Values not set
+      /// here are taken from the GZ_TRANSPORT_THREAD_NAME_<THREAD>
+      /// environment variables, otherwise a default name is used.
+      /// \param[in] _thread The thread.
+      /// \param[in] _name The name.
+      /// \return False if the name is empty or if the thread can't be
+      /// configured with node options (TransportThread::ZMQ_IO).
+      /// \sa ThreadName
+      public: bool SetThreadName(const TransportThread _thread,
+                                 const std::string &_name);
+
+      /// \brief Get the name set for a transport thread.
+      /// \param[in] _thread The thread.
+      /// \return The name, or an empty string if not set.
+      /// \sa SetThreadName
+      public: std::string ThreadName(const TransportThread _thread) const;
+
+      /// \brief Attach the node to a transport context instead of the
+      /// transport shared by the nodes of the process. The node, its
+      /// publishers and its service clients keep the context alive.
+      /// The thread configuration of these options is applied to the threads
+      /// of the context.
+      /// \param[in] _context The context, or nullptr to use the transport of
+      /// the process.
+      /// \sa Context
+      public: void SetContext(std::shared_ptr<TransportContext> _context);
+
+      /// \brief Get the transport context set for the node.
+      /// \return The context, or nullptr if the node uses the transport of
+      /// the process.
+      /// \sa SetContext
+      public: std::shared_ptr<TransportContext> Context() const;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -38,6 +38,8 @@
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
 #include "gz/transport/HandlerStorage.hh"
+#include "gz/transport/MsgTypeId.hh"
+#include "gz/transport/NodeOptions.hh"
 #include "gz/transport/Publisher.hh"
 #include "gz/transport/RepHandler.hh"
 #include "gz/transport/ReqHandler.hh"
@@ -57,6 +59,7 @@ namespace gz
     // Forward declarations.
     class Node;
     class NodePrivate;
+    class TransportContextPrivate;
 
     /// \brief Private data pointer
     class NodeSharedPrivate;
@@ -97,24 +100,31 @@ namespace gz
       /// \brief HandlerInfo contains information about callback handlers which
       /// is useful for local publishers and message receivers. You should only
       /// retrieve a HandlerInfo by calling
-      /// CheckHandlerInfo(const std::string &_topic) const
+      /// CheckHandlerInfo(const std::string&, MsgTypeId) const
       public: struct HandlerInfo
       {
-        /// \brief This is a map of the standard local callback handlers. The
-        /// key is the topic name, and the value is another map whose key is
-        /// the node UUID and whose value is a smart pointer to the handler.
-        public: std::map<std::string, ISubscriptionHandler_M> localHandlers;
+        /// \brief Snapshot of the standard local callback handlers of a
+        /// topic, or nullptr if there are none. It may contain handlers that
+        /// do not accept msgTypeId.
+        public: HandlerStorage<ISubscriptionHandler>::HandlerListPtr
+                localHandlers;
 
-        /// \brief This is a map of the raw local callback handlers. The key is
-        /// the topic name, and the value is another map whose key is the node
-        /// UUID and whose value is a smart pointer to the handler.
-        public: std::map<std::string, RawSubscriptionHandler_M> rawHandlers;
+        /// \brief Snapshot of the raw local callback handlers of a topic, or
+        /// nullptr if there are none. It may contain handlers that do not
+        /// accept msgTypeId.
+        public: HandlerStorage<RawSubscriptionHandler>::HandlerListPtr
+                rawHandlers;
 
-        /// \brief True iff there are any standard local subscribers.
-        public: bool haveLocal;
+        /// \brief Type of the message that the info was requested for.
+        public: MsgTypeId msgTypeId = kInvalidMsgTypeId;
 
-        /// \brief True iff there are any raw local subscribers
-        public: bool haveRaw;
+        /// \brief True iff there are any standard local subscribers that
+        /// accept msgTypeId.
+        public: bool haveLocal = false;
+
+        /// \brief True iff there are any raw local subscribers that accept
+        /// msgTypeId.
+        public: bool haveRaw = false;
 
         // Friendship. This allows HandlerInfo to be created by
         // CheckHandlerInfo()
@@ -127,13 +137,18 @@ namespace gz
       /// attached to this NodeShared.
       /// \param[in] _topic Information will only be returned for handlers that
       /// are subscribed to the given topic name.
+      /// \param[in] _msgTypeId Type of the message. Only the handlers that
+      /// accept it are considered by HandlerInfo::haveLocal and
+      /// HandlerInfo::haveRaw.
       /// \return Information about local subscription handlers that are held by
-      /// this NodeShared.
-      HandlerInfo CheckHandlerInfo(const std::string &_topic) const;
+      /// this NodeShared. This function does not lock the NodeShared mutex.
+      HandlerInfo CheckHandlerInfo(const std::string &_topic,
+                                   const MsgTypeId _msgTypeId) const;
 
       /// \brief This struct provides information about the Subscribers of a
       /// Publisher. It should only be retrieved using
-      /// CheckSubscriberInfo(const std::string&, const std::string&) const.
+      /// CheckSubscriberInfo(const std::string&, const std::string&,
+      /// MsgTypeId) const.
       /// The relevant subscriber info is a superset of the relevant HandlerInfo
       /// so we extend that struct.
       ///
@@ -143,7 +158,7 @@ namespace gz
       {
         /// \brief True if this Publisher has any remote subscribers
         // cppcheck-suppress unusedStructMember
-        public: bool haveRemote;
+        public: bool haveRemote = false;
 
         // Friendship declaration
         friend class NodeShared;
@@ -158,17 +173,24 @@ namespace gz
       /// \param[in] _msgType If there are no remote subscribers listening for
       /// this message type, then SubscriberInfo::haveRemote will be false in
       /// the return value of this function.
+      /// \param[in] _msgTypeId Identifier of _msgType. Only the local handlers
+      /// that accept this type will be returned.
       /// \return Information about subscribers.
       SubscriberInfo CheckSubscriberInfo(
           const std::string &_topic,
-          const std::string &_msgType) const;
+          const std::string &_msgType,
+          const MsgTypeId _msgTypeId) const;
 
       /// \brief Call the SubscriptionHandler callbacks (local and raw) for this
       /// NodeShared.
       /// \param[in] _info Message information.
       /// \param[in] _msgData The raw serialized data for the message
       /// \param[in] _handlerInfo Information for the handlers of this node,
-      /// as generated by CheckHandlerInfo(const std::string&) const
+      /// as generated by CheckHandlerInfo(const std::string&, MsgTypeId) const.
+      /// Only the handlers that accept HandlerInfo::msgTypeId are triggered.
+      /// Local handlers are asked to
+      /// admit the message first, and the message is only deserialized if at
+      /// least one of them does.
       public: void TriggerCallbacks(
         const MessageInfo &_info,
         const std::string &_msgData,
@@ -194,6 +216,17 @@ namespace gz
                                          const std::string &_reqType,
                                          const std::string &_repType);
 
+      /// \brief Forget a service request that doesn't wait for its response
+      /// anymore, e.g. because its timeout expired. In pipelining mode, its
+      /// slot in the window of the responder is released and the pending
+      /// requests of the service are sent.
+      /// \param[in] _topic Service name.
+      /// \param[in] _nodeUuid UUID of the node that made the request.
+      /// \param[in] _reqUuid UUID of the request.
+      public: void AbandonRequest(const std::string &_topic,
+                                  const Uuid &_nodeUuid,
+                                  const Uuid &_reqUuid);
+
       /// \brief Callback executed when the discovery detects new topics.
       /// \param[in] _pub Information of the publisher in charge of the topic.
       public: void OnNewConnection(const MessagePublisher &_pub);
@@ -268,6 +301,45 @@ namespace gz
       /// If your buffer reaches the maximum capacity data will be dropped.
       public: int SndHwm();
 
+      /// \brief Get the window of pipelined service requests, which is set
+      /// with the GZ_TRANSPORT_SRV_WINDOW environment variable. When it is
+      /// positive, at most this number of requests can wait for a response
+      /// from the responder of a service, and the pending requests are sent
+      /// in batches to the responders that accept them.
+      /// \return The window size, or 0 if pipelining is disabled. The default
+      /// value is contained in the #kDefaultSrvWindow variable.
+      public: int SrvRequestWindow() const;
+
+      /// \brief Apply the thread configuration set in the options of a node
+      /// to the transport threads. Values not set in the options are kept.
+      /// \param[in] _options The node options.
+      /// \sa NodeOptions::SetThreadAffinity
+      /// \sa NodeOptions::SetThreadPriority
+      /// \sa NodeOptions::SetThreadName
+      public: void ConfigureThreads(const NodeOptions &_options);
+
+      /// \brief Initialize the transport of topics: the discovery of topics,
+      /// the sockets used to exchange messages with other processes and the
+      /// threads that serve them. Nothing is done after the first call. The
+      /// nodes call this function the first time they use a topic, so the
+      /// processes that don't use topics don't pay for them. If the sockets
+      /// can't be initialized, an error is printed and the discovery is not
+      /// started, so the operations that need it fail.
+      public: void InitializeMsgTransport();
+
+      /// \brief Initialize the transport of services: the discovery of
+      /// services, the sockets used to send and receive service calls and
+      /// the threads that serve them. Nothing is done after the first call.
+      /// \sa InitializeMsgTransport
+      public: void InitializeSrvTransport();
+
+      /// \brief Whether this process only communicates with itself. It is
+      /// enabled with the GZ_TRANSPORT_INTRA_PROCESS=1 environment variable.
+      /// In this mode no sockets are created and nothing is sent to or
+      /// received from the network.
+      /// \return True if the process is in intra-process mode.
+      public: bool IntraProcess() const;
+
       /// \brief Turn topic statistics on or off.
       /// \param[in] _topic The name of the topic on which to enable or disable
       /// statistics.
@@ -292,10 +364,77 @@ namespace gz
       /// \brief Destructor.
       protected: virtual ~NodeShared();
 
-      /// \brief Initialize all sockets.
+      /// \brief Create and bind the publisher and subscriber sockets.
       /// \return True when success or false otherwise. This function might
       /// return false if any operation on a ZMQ socket triggered an exception.
-      private: bool InitializeSockets();
+      private: bool InitializeMsgSockets();
+
+      /// \brief Create and bind the requester, response receiver and replier
+      /// sockets.
+      /// \return True when success or false otherwise. This function might
+      /// return false if any operation on a ZMQ socket triggered an exception.
+      private: bool InitializeSrvSockets();
+
+      /// \brief Start the reception thread if it's not running yet. It
+      /// polls the sockets that are ready.
+      private: void StartReceptionTask();
+
+      /// \brief Connect the replier socket to a requester, if it is not
+      /// connected yet.
+      /// \param[in] _sender Address of the requester.
+      private: void ConnectToSrvRequester(const std::string &_sender);
+
+      /// \brief Run a batch of service requests and send the responses back
+      /// in a single batch.
+      /// \param[in] _handler Handler of the service.
+      /// \param[in] _topic Service name.
+      /// \param[in] _sender Address of the requester.
+      /// \param[in] _dstId Socket ID of the requester.
+      /// \param[in] _repType Type of the response.
+      /// \param[in] _requests Requests encoded by ServiceBatch.
+      private: void ReplyBatchedSrvRequests(const IRepHandlerPtr &_handler,
+                                            const std::string &_topic,
+                                            const std::string &_sender,
+                                            const std::string &_dstId,
+                                            const std::string &_repType,
+                                            const std::string &_requests);
+
+      /// \brief Prepare a topic to be published with multicast.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return The multicast endpoint to announce in the discovery
+      /// information, or empty if the topic must be published with TCP.
+      private: std::string AdvertiseMulticast(const std::string &_topic);
+
+      /// \brief Send a message of a topic advertised with multicast to its
+      /// group, if a remote subscriber receives through multicast.
+      /// Must be called with the mutex locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _data Serialized data.
+      /// \param[in] _dataSize Size of the data.
+      /// \param[in] _msgType Message type name.
+      /// \return True if the message must also be sent with TCP.
+      private: bool PublishMulticast(const std::string &_topic,
+                                     const char *_data,
+                                     const size_t _dataSize,
+                                     const std::string &_msgType);
+
+      /// \brief Encode a message of a topic advertised with delta encoding,
+      /// if all the remote subscribers that receive through TCP can decode
+      /// it. Must be called with the mutex locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _data Serialized data.
+      /// \param[in] _dataSize Size of the data.
+      /// \param[out] _frame The encoded message.
+      /// \return True if the encoded message must be sent instead of the
+      /// data.
+      private: bool EncodeDelta(const std::string &_topic,
+                                const char *_data,
+                                const size_t _dataSize,
+                                std::string &_frame);
+
+      /// \brief Method in charge of receiving the topic updates sent with
+      /// multicast.
+      private: void RecvMulticastUpdate();
 
       //////////////////////////////////////////////////
       /////// Declare here other member variables //////
@@ -316,6 +455,10 @@ namespace gz
       /// \brief Process UUID.
       public: std::string pUuid;
 
+      /// \brief Process UUID as the 16 byte key used by the storages.
+      /// pUuid is its string representation.
+      public: Uuid pUuidKey;
+
       /// \brief thread in charge of receiving and handling incoming messages.
       public: std::thread threadReception;
 
@@ -395,6 +538,17 @@ namespace gz
             const std::string &_fullyQualifiedTopic,
             const std::string &_nUuid);
 
+        /// \brief Remove the handlers for the given topic name that belong to
+        /// a specific node.
+        /// \param[in] _fullyQualifiedTopic The fully-qualified name of the
+        /// topic whose subscribers should be removed.
+        /// \param[in] _nUuid The UUID of the node whose subscribers should be
+        /// removed.
+        /// \return True if at least one subscriber was removed.
+        public: bool RemoveHandlersForNode(
+            const std::string &_fullyQualifiedTopic,
+            const Uuid &_nUuid);
+
         /// \brief Normal local subscriptions.
         public: HandlerStorage<ISubscriptionHandler> normal;
 
@@ -443,6 +597,7 @@ namespace gz
 #endif
       private: friend Node;
       private: friend NodePrivate;
+      private: friend TransportContextPrivate;
     };
     }
   }
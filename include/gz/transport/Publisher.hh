@@ -26,6 +26,7 @@
 #include "gz/transport/AdvertiseOptions.hh"
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -81,6 +82,21 @@ namespace gz
       /// \sa SetNUuid.
       public: std::string NUuid() const;
 
+      /// \brief Get the process UUID of the publisher as the 16 byte key
+      /// used by the storages. It is parsed once, when the process UUID is
+      /// set.
+      /// \return Process UUID.
+      /// \sa PUuid
+      /// \sa Uuid::FromIdentifier
+      public: const Uuid &ProcessKey() const;
+
+      /// \brief Get the node UUID of the publisher as the 16 byte key used by
+      /// the storages. It is parsed once, when the node UUID is set.
+      /// \return Node UUID.
+      /// \sa NUuid
+      /// \sa Uuid::FromIdentifier
+      public: const Uuid &NodeKey() const;
+
       /// \brief Get the advertised options.
       /// \return The advertised options.
       /// \sa SetOptions.
@@ -173,6 +189,12 @@ namespace gz
       /// \brief Advertised options.
       /// This member is not used when we have a derived publisher.
       private: AdvertiseOptions opts;
+
+      /// \brief Key of the process UUID.
+      private: Uuid pUuidKey = Uuid::FromIdentifier(std::string());
+
+      /// \brief Key of the node UUID.
+      private: Uuid nUuidKey = Uuid::FromIdentifier(std::string());
     };
 
     /// \class MessagePublisher Publisher.hh
@@ -232,6 +254,19 @@ namespace gz
       /// \sa Options.
       public: void SetOptions(const AdvertiseMessageOptions &_opts);
 
+      /// \brief Get the multicast endpoint of the publisher. In the
+      /// registration of a subscriber, it means that the subscriber receives
+      /// the messages through multicast.
+      /// \return The endpoint (e.g. "239.255.12.34:10319"), or an empty
+      /// string if the messages aren't sent with multicast.
+      /// \sa SetMulticastAddr.
+      public: const std::string &MulticastAddr() const;
+
+      /// \brief Set the multicast endpoint of the publisher.
+      /// \param[in] _addr The endpoint, or an empty string.
+      /// \sa MulticastAddr.
+      public: void SetMulticastAddr(const std::string &_addr);
+
       /// \brief Populate a discovery message.
       /// \param[in] _msg Message to fill.
       public: virtual void FillDiscovery(msgs::Discovery &_msg) const final;
@@ -282,6 +317,9 @@ namespace gz
 
       /// \brief Message type advertised by this publisher.
       private: std::string msgTypeName;
+
+      /// \brief Multicast endpoint, empty if not used.
+      private: std::string multicastAddr;
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -359,6 +397,18 @@ namespace gz
       /// \sa Options.
       public: void SetOptions(const AdvertiseServiceOptions &_opts);
 
+      /// \brief Whether the responder accepts several requests batched in a
+      /// single message. Responders built with this version accept them,
+      /// so this is only false for publishers discovered from older peers.
+      /// \return True if the responder accepts batched requests.
+      /// \sa SetAcceptsBatches.
+      public: bool AcceptsBatches() const;
+
+      /// \brief Set whether the responder accepts batched requests.
+      /// \param[in] _accepts True if the responder accepts batched requests.
+      /// \sa AcceptsBatches.
+      public: void SetAcceptsBatches(const bool _accepts);
+
       /// \brief Populate a discovery message.
       /// \param[in] _msg Message to fill.
       public: virtual void FillDiscovery(msgs::Discovery &_msg) const final;
@@ -421,6 +471,9 @@ namespace gz
 
       /// \brief Advertise options.
       private: AdvertiseServiceOptions srvOpts;
+
+      /// \brief Whether the responder accepts batched requests.
+      private: bool acceptsBatches = true;
     };
     }
   }
@@ -38,6 +38,7 @@
 
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/TransportTypes.hh"
 #include "gz/transport/Uuid.hh"
 
@@ -54,7 +55,8 @@ namespace gz
     {
       /// \brief Constructor.
       public: IRepHandler()
-        : hUuid(Uuid().ToString())
+        : hUuid(Uuid().ToString()),
+          hUuidKey(Uuid::FromIdentifier(this->hUuid))
       {
       }
 
@@ -84,6 +86,14 @@ namespace gz
         return this->hUuid;
       }
 
+      /// \brief Get the handler UUID as the 16 byte key used by the storages.
+      /// \return The handler UUID.
+      /// \sa HandlerUuid
+      public: const Uuid &HandlerKey() const
+      {
+        return this->hUuidKey;
+      }
+
       /// \brief Get the message type name used in the service request.
       /// \return Message type name.
       public: virtual std::string ReqTypeName() const = 0;
@@ -92,6 +102,24 @@ namespace gz
       /// \return Message type name.
       public: virtual std::string RepTypeName() const = 0;
 
+      /// \brief Get the interned identifier of the message type used in the
+      /// service request.
+      /// \return Message type identifier.
+      /// \sa msgTypeId
+      public: MsgTypeId ReqTypeId() const
+      {
+        return this->reqTypeId;
+      }
+
+      /// \brief Get the interned identifier of the message type used in the
+      /// service response.
+      /// \return Message type identifier.
+      /// \sa msgTypeId
+      public: MsgTypeId RepTypeId() const
+      {
+        return this->repTypeId;
+      }
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::string
@@ -103,6 +131,17 @@ namespace gz
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
+
+      /// \brief Identifier of the request type. Derived classes set it in
+      /// their constructor.
+      protected: MsgTypeId reqTypeId = kInvalidMsgTypeId;
+
+      /// \brief Identifier of the response type. Derived classes set it in
+      /// their constructor.
+      protected: MsgTypeId repTypeId = kInvalidMsgTypeId;
+
+      /// \brief Key of the handler UUID.
+      private: Uuid hUuidKey;
     };
 
     /// \class RepHandler RepHandler.hh
@@ -115,7 +154,11 @@ namespace gz
       : public IRepHandler
     {
       // Documentation inherited.
-      public: RepHandler() = default;
+      public: RepHandler()
+      {
+        this->reqTypeId = msgTypeId(Req().GetTypeName());
+        this->repTypeId = msgTypeId(Rep().GetTypeName());
+      }
 
       /// \brief Set the callback for this handler.
       /// \param[in] _cb The callback with the following parameters:
@@ -34,6 +34,7 @@
 
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/TransportTypes.hh"
 #include "gz/transport/Uuid.hh"
 
@@ -56,7 +57,9 @@ namespace gz
           nUuid(_nUuid),
           result(false),
           requested(false),
-          repAvailable(false)
+          repAvailable(false),
+          hUuidKey(Uuid::FromIdentifier(this->hUuid)),
+          nUuidKey(Uuid::FromIdentifier(_nUuid))
       {
       }
 
@@ -119,6 +122,23 @@ namespace gz
         return this->hUuid;
       }
 
+      /// \brief Get the node UUID as the 16 byte key used by the storages.
+      /// \return The node UUID.
+      /// \sa NodeUuid
+      /// \sa Uuid::FromIdentifier
+      public: const Uuid &NodeKey() const
+      {
+        return this->nUuidKey;
+      }
+
+      /// \brief Get the handler UUID as the 16 byte key used by the storages.
+      /// \return The handler UUID.
+      /// \sa HandlerUuid
+      public: const Uuid &HandlerKey() const
+      {
+        return this->hUuidKey;
+      }
+
       /// \brief Block the current thread until the response to the
       /// service request is available or until the timeout expires.
       /// This method uses a condition variable to notify when the response is
@@ -146,6 +166,24 @@ namespace gz
       /// \return Message type name.
       public: virtual std::string RepTypeName() const = 0;
 
+      /// \brief Get the interned identifier of the message type used in the
+      /// service request.
+      /// \return Message type identifier.
+      /// \sa msgTypeId
+      public: MsgTypeId ReqTypeId() const
+      {
+        return this->reqTypeId;
+      }
+
+      /// \brief Get the interned identifier of the message type used in the
+      /// service response.
+      /// \return Message type identifier.
+      /// \sa msgTypeId
+      public: MsgTypeId RepTypeId() const
+      {
+        return this->repTypeId;
+      }
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::*
@@ -171,6 +209,14 @@ namespace gz
       /// \brief Stores the result of the service call.
       protected: bool result;
 
+      /// \brief Identifier of the request type. Derived classes set it when
+      /// the type is known.
+      protected: MsgTypeId reqTypeId = kInvalidMsgTypeId;
+
+      /// \brief Identifier of the response type. Derived classes set it when
+      /// the type is known.
+      protected: MsgTypeId repTypeId = kInvalidMsgTypeId;
+
       /// \brief When true, the REQ was already sent and the REP should be on
       /// its way. Used to not resend the same REQ more than one time.
       private: bool requested;
@@ -179,6 +225,12 @@ namespace gz
       /// be unlocked when a service call REP is available. This variable
       /// captures if we have found a node that can satisty our request.
       public: bool repAvailable;
+
+      /// \brief Key of the handler UUID.
+      private: Uuid hUuidKey;
+
+      /// \brief Key of the node UUID.
+      private: Uuid nUuidKey;
     };
 
     /// \class ReqHandler ReqHandler.hh
@@ -193,6 +245,11 @@ namespace gz
       public: explicit ReqHandler(const std::string &_nUuid)
         : IReqHandler(_nUuid)
       {
+        // A handler is created for every request, resolve the types once.
+        static const MsgTypeId kReqTypeId = msgTypeId(Req().GetTypeName());
+        static const MsgTypeId kRepTypeId = msgTypeId(Rep().GetTypeName());
+        this->reqTypeId = kReqTypeId;
+        this->repTypeId = kRepTypeId;
       }
 
       /// \brief Create a specific protobuf message given its serialized data.
@@ -316,6 +373,8 @@ namespace gz
       public: explicit ReqHandler(const std::string &_nUuid)
         : IReqHandler(_nUuid)
       {
+        // Any response type is accepted until SetResponse() is called.
+        this->repTypeId = kGenericMsgTypeId;
       }
 
       /// \brief Set the REQ protobuf message for this handler.
@@ -331,6 +390,7 @@ namespace gz
 
         this->reqMsg = _reqMsg->New();
         this->reqMsg->CopyFrom(*_reqMsg);
+        this->reqTypeId = msgTypeId(this->reqMsg->GetTypeName());
       }
 
       /// \brief Set the REP protobuf message for this handler.
@@ -347,6 +407,19 @@ namespace gz
 
         this->repMsg = _repMsg->New();
         this->repMsg->CopyFrom(*_repMsg);
+        this->repTypeId = msgTypeId(this->repMsg->GetTypeName());
+      }
+
+      /// \brief Set the callback for this handler. The response is created
+      /// with the type of the message passed to SetResponse().
+      /// \param[in] _cb The callback with the following parameters:
+      /// * _rep Protobuf message containing the service response.
+      /// * _result True when the service request was successful or
+      /// false otherwise.
+      public: void SetCallback(const std::function<void(
+        const google::protobuf::Message &_rep, const bool _result)> &_cb)
+      {
+        this->cb = _cb;
       }
 
       // Documentation inherited
@@ -371,8 +444,23 @@ namespace gz
       // Documentation inherited.
       public: void NotifyResult(const std::string &_rep, const bool _result)
       {
-        this->rep = _rep;
-        this->result = _result;
+        // Execute the callback (if existing).
+        if (this->cb && this->repMsg)
+        {
+          std::unique_ptr<google::protobuf::Message> msg(this->repMsg->New());
+          if (!msg->ParseFromString(_rep))
+          {
+            std::cerr << "ReqHandler::NotifyResult() error: ParseFromString "
+                      << "failed" << std::endl;
+          }
+
+          this->cb(*msg, _result);
+        }
+        else
+        {
+          this->rep = _rep;
+          this->result = _result;
+        }
 
         this->repAvailable = true;
         this->condition.notify_one();
@@ -409,6 +497,10 @@ namespace gz
 
       /// \brief Protobuf message containing the response.
       private: google::protobuf::Message *repMsg = nullptr;
+
+      /// \brief Callback to the function registered for this handler.
+      private: std::function<void(const google::protobuf::Message &_rep,
+        const bool _result)> cb;
     };
     }
   }
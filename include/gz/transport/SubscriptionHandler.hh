@@ -34,6 +34,7 @@
 #include <chrono>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
@@ -42,6 +43,7 @@
 #include "gz/transport/config.hh"
 #include "gz/transport/Export.hh"
 #include "gz/transport/MessageInfo.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/SubscribeOptions.hh"
 #include "gz/transport/TransportTypes.hh"
 #include "gz/transport/Uuid.hh"
@@ -72,6 +74,20 @@ namespace gz
       /// \return String representation of the message type.
       public: virtual std::string TypeName() = 0;
 
+      /// \brief Get the interned identifier of the message type from which
+      /// this subscriber handler is subscribed. It is computed once, when the
+      /// handler is created, so it is cheap to compare on every message.
+      /// \return Identifier of the message type.
+      /// \sa msgTypeId
+      public: MsgTypeId TypeId() const;
+
+      /// \brief Check whether this handler should receive messages of a type.
+      /// Handlers that don't set the type identifier are matched by TypeName().
+      /// \param[in] _msgTypeId Identifier of the message type.
+      /// \return True if the handler is subscribed to the type or to any
+      /// type.
+      public: bool AcceptsType(const MsgTypeId _msgTypeId) const;
+
       /// \brief Get the node UUID.
       /// \return The string representation of the node UUID.
       public: std::string NodeUuid() const;
@@ -80,6 +96,26 @@ namespace gz
       /// \return A string representation of the handler UUID.
       public: std::string HandlerUuid() const;
 
+      /// \brief Get the node UUID as the 16 byte key used by the storages.
+      /// \return The node UUID.
+      /// \sa NodeUuid
+      /// \sa Uuid::FromIdentifier
+      public: const Uuid &NodeKey() const;
+
+      /// \brief Get the handler UUID as the 16 byte key used by the storages.
+      /// \return The handler UUID.
+      /// \sa HandlerUuid
+      public: const Uuid &HandlerKey() const;
+
+      /// \brief Decide whether the next message should reach the callback,
+      /// using only the decisions that do not depend on the message content
+      /// (e.g. throttling). When the message is admitted, the throttling
+      /// state is updated as if the message was delivered, so the caller
+      /// is expected to deliver it. This lets callers skip deserializing a
+      /// message that no handler would deliver. This function is thread safe.
+      /// \return true if the message should be delivered or false otherwise.
+      public: bool AdmitMessage();
+
       /// \brief Check if message subscription is throttled. If so, verify
       /// whether the callback should be executed or not.
       /// \return true if the callback should be executed or false otherwise.
@@ -92,6 +128,10 @@ namespace gz
       /// message in nanoseconds.
       protected: double periodNs;
 
+      /// \brief Identifier of the message type. Derived classes set it in
+      /// their constructor.
+      protected: MsgTypeId typeId = kInvalidMsgTypeId;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::*
@@ -104,11 +144,21 @@ namespace gz
       /// \brief Timestamp of the last callback executed.
       protected: Timestamp lastCbTimestamp;
 
+      /// \brief Protects lastCbTimestamp. Messages can be admitted from the
+      /// reception thread and from the publishing threads at the same time.
+      private: std::mutex throttleMutex;
+
       /// \brief Node UUID.
       private: std::string nUuid;
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
+
+      /// \brief Key of the handler UUID.
+      private: Uuid hUuidKey;
+
+      /// \brief Key of the node UUID.
+      private: Uuid nUuidKey;
     };
 
     /// \class ISubscriptionHandler SubscriptionHandler.hh
@@ -132,7 +182,8 @@ namespace gz
       /// \brief Destructor.
       public: virtual ~ISubscriptionHandler() = default;
 
-      /// \brief Executes the local callback registered for this handler.
+      /// \brief Executes the local callback registered for this handler,
+      /// unless the message is dropped by AdmitMessage().
       /// \param[in] _msg Protobuf message received.
       /// \param[in] _info Message information (e.g.: topic name).
       /// \return True when success, false otherwise.
@@ -147,6 +198,26 @@ namespace gz
       public: virtual const std::shared_ptr<ProtoMsg> CreateMsg(
         const std::string &_data,
         const std::string &_type) const = 0;
+
+      /// \brief Whether the messages for this handler are admitted with
+      /// AdmitMessage() before they are deserialized, and then delivered
+      /// with RunAdmittedCallback(). Otherwise they are delivered with
+      /// RunLocalCallback(), which makes its own drop decisions. The default
+      /// is false, so handlers that throttle inside RunLocalCallback() keep
+      /// working.
+      /// \return True if the handler admits messages before decoding them.
+      public: virtual bool AdmitsBeforeDecode() const;
+
+      /// \brief Executes the local callback registered for this handler
+      /// with a message that was already admitted by AdmitMessage(). It is
+      /// only used when AdmitsBeforeDecode() returns true. The default
+      /// implementation calls RunLocalCallback().
+      /// \param[in] _msg Protobuf message received.
+      /// \param[in] _info Message information (e.g.: topic name).
+      /// \return True when success, false otherwise.
+      public: virtual bool RunAdmittedCallback(
+        const ProtoMsg &_msg,
+        const MessageInfo &_info);
     };
 
     /// \class SubscriptionHandler SubscriptionHandler.hh
@@ -161,6 +232,7 @@ namespace gz
         const SubscribeOptions &_opts = SubscribeOptions())
         : ISubscriptionHandler(_nUuid, _opts)
       {
+        this->typeId = msgTypeId(T().GetTypeName());
       }
 
       // Documentation inherited.
@@ -194,22 +266,35 @@ namespace gz
         this->cb = _cb;
       }
 
+      // Documentation inherited.
+      public: bool AdmitsBeforeDecode() const
+      {
+        return true;
+      }
+
       // Documentation inherited.
       public: bool RunLocalCallback(const ProtoMsg &_msg,
                                     const MessageInfo &_info)
+      {
+        // Check the subscription throttling option.
+        if (!this->AdmitMessage())
+          return true;
+
+        return this->RunAdmittedCallback(_msg, _info);
+      }
+
+      // Documentation inherited.
+      public: bool RunAdmittedCallback(const ProtoMsg &_msg,
+                                       const MessageInfo &_info)
       {
         // No callback stored.
         if (!this->cb)
         {
-          std::cerr << "SubscriptionHandler::RunLocalCallback() error: "
+          std::cerr << "SubscriptionHandler::RunAdmittedCallback() error: "
                     << "Callback is NULL" << std::endl;
           return false;
         }
 
-        // Check the subscription throttling option.
-        if (!this->UpdateThrottling())
-          return true;
-
 #if GOOGLE_PROTOBUF_VERSION >= 4022000
         auto msgPtr = google::protobuf::internal::DownCast<const T*>(&_msg);
 #elif GOOGLE_PROTOBUF_VERSION >= 3000000
@@ -236,6 +321,7 @@ namespace gz
         const SubscribeOptions &_opts = SubscribeOptions())
         : ISubscriptionHandler(_nUuid, _opts)
       {
+        this->typeId = kGenericMsgTypeId;
       }
 
       // Documentation inherited.
@@ -288,22 +374,35 @@ namespace gz
         this->cb = _cb;
       }
 
+      // Documentation inherited.
+      public: bool AdmitsBeforeDecode() const
+      {
+        return true;
+      }
+
       // Documentation inherited.
       public: bool RunLocalCallback(const ProtoMsg &_msg,
                                     const MessageInfo &_info)
+      {
+        // Check the subscription throttling option.
+        if (!this->AdmitMessage())
+          return true;
+
+        return this->RunAdmittedCallback(_msg, _info);
+      }
+
+      // Documentation inherited.
+      public: bool RunAdmittedCallback(const ProtoMsg &_msg,
+                                       const MessageInfo &_info)
       {
         // No callback stored.
         if (!this->cb)
         {
-          std::cerr << "SubscriptionHandler::RunLocalCallback() "
+          std::cerr << "SubscriptionHandler::RunAdmittedCallback() "
                     << "error: Callback is NULL" << std::endl;
           return false;
         }
 
-        // Check the subscription throttling option.
-        if (!this->UpdateThrottling())
-          return true;
-
         this->cb(_msg, _info);
         return true;
       }
@@ -27,6 +27,7 @@
 #include "gz/transport/Export.hh"
 #include "gz/transport/Publisher.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -38,6 +39,11 @@ namespace gz
     /// \class TopicStorage TopicStorage.hh gz/transport/TopicStorage.hh
     /// \brief Store address information about topics and provide convenient
     /// methods for adding new topics, removing them, etc.
+    ///
+    /// The publishers of a topic are grouped by the 16 byte value of their
+    /// process UUID, and they are found by the 16 byte value of their node
+    /// UUID. Each function that takes UUID strings has an overload that
+    /// takes the parsed UUIDs, see Uuid::FromIdentifier.
     template<typename T> class TopicStorage
     {
       /// \brief Constructor.
@@ -52,25 +58,18 @@ namespace gz
       /// was already stored).
       public: bool AddPublisher(const T &_publisher)
       {
-        // The topic does not exist.
-        if (this->data.find(_publisher.Topic()) == this->data.end())
-        {
-          // VS2013 is buggy with initializer list here {}
-          this->data[_publisher.Topic()] =
-            std::map<std::string, std::vector<T>>();
-        }
-
         // Check if the process uuid exists.
         auto &m = this->data[_publisher.Topic()];
-        if (m.find(_publisher.PUuid()) != m.end())
+        auto procIt = m.find(_publisher.ProcessKey());
+        if (procIt != m.end())
         {
           // Check that the Publisher does not exist.
-          auto &v = m[_publisher.PUuid()];
+          auto &v = procIt->second;
           auto found = std::find_if(v.begin(), v.end(),
             [&](const T &_pub)
             {
-              return _pub.Addr()  == _publisher.Addr() &&
-                     _pub.NUuid() == _publisher.NUuid();
+              return _pub.NodeKey() == _publisher.NodeKey() &&
+                     _pub.Addr()    == _publisher.Addr();
             });
 
           // The publisher was already existing, just exit.
@@ -79,7 +78,38 @@ namespace gz
         }
 
         // Add a new Publisher entry.
-        m[_publisher.PUuid()].push_back(T(_publisher));
+        m[_publisher.ProcessKey()].push_back(T(_publisher));
+        return true;
+      }
+
+      /// \brief Replace the information of a publisher that is already
+      /// stored, e.g. when its options have changed.
+      /// \param[in] _publisher New publisher's information. The publisher is
+      /// identified by its topic, process UUID, address and node UUID.
+      /// \return true if the publisher was stored and its information was
+      /// different.
+      public: bool UpdatePublisher(const T &_publisher)
+      {
+        auto topicIt = this->data.find(_publisher.Topic());
+        if (topicIt == this->data.end())
+          return false;
+
+        auto procIt = topicIt->second.find(_publisher.ProcessKey());
+        if (procIt == topicIt->second.end())
+          return false;
+
+        auto &v = procIt->second;
+        auto found = std::find_if(v.begin(), v.end(),
+          [&](const T &_pub)
+          {
+            return _pub.NodeKey() == _publisher.NodeKey() &&
+                   _pub.Addr()    == _publisher.Addr();
+          });
+
+        if (found == v.end() || *found == _publisher)
+          return false;
+
+        *found = _publisher;
         return true;
       }
 
@@ -134,11 +164,23 @@ namespace gz
       public: bool HasAnyPublishers(const std::string &_topic,
                                     const std::string &_pUuid) const
       {
-        if (!this->HasTopic(_topic))
+        return this->HasAnyPublishers(_topic, Uuid::FromIdentifier(_pUuid));
+      }
+
+      /// \brief Return if there is any publisher stored for the given topic and
+      /// process UUID.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _pUuid Process UUID of the publisher.
+      /// \return True if there is at least one address stored for the topic and
+      /// process UUID.
+      public: bool HasAnyPublishers(const std::string &_topic,
+                                    const Uuid &_pUuid) const
+      {
+        auto topicIt = this->data.find(_topic);
+        if (topicIt == this->data.end())
           return false;
 
-        return this->data.at(_topic).find(_pUuid) !=
-               this->data.at(_topic).end();
+        return topicIt->second.find(_pUuid) != topicIt->second.end();
       }
 
       /// \brief Return if the requested publisher's address is stored.
@@ -170,24 +212,41 @@ namespace gz
                              const std::string &_pUuid,
                              const std::string &_nUuid,
                              T &_publisher) const
+      {
+        return this->Publisher(_topic, Uuid::FromIdentifier(_pUuid),
+          Uuid::FromIdentifier(_nUuid), _publisher);
+      }
+
+      /// \brief Get the address information for a given topic and node UUID.
+      /// \param[in] _topic Topic name.
+      /// \param[in] _pUuid Process UUID of the publisher.
+      /// \param[in] _nUuid Node UUID of the publisher.
+      /// \param[out] _publisher Publisher's information requested.
+      /// \return true if a publisher is found for the given topic and UUID pair
+      public: bool Publisher(const std::string &_topic,
+                             const Uuid &_pUuid,
+                             const Uuid &_nUuid,
+                             T &_publisher) const
       {
         // Topic not found.
-        if (this->data.find(_topic) == this->data.end())
+        auto topicIt = this->data.find(_topic);
+        if (topicIt == this->data.end())
           return false;
 
         // m is {pUUID=>Publisher}.
-        auto &m = this->data.at(_topic);
+        auto &m = topicIt->second;
 
         // pUuid not found.
-        if (m.find(_pUuid) == m.end())
+        auto procIt = m.find(_pUuid);
+        if (procIt == m.end())
           return false;
 
         // Vector of 0MQ known addresses for a given topic and pUuid.
-        auto &v = m.at(_pUuid);
+        auto &v = procIt->second;
         auto found = std::find_if(v.begin(), v.end(),
           [&](const T &_pub)
           {
-            return _pub.NUuid() == _nUuid;
+            return _pub.NodeKey() == _nUuid;
           });
         // Address found!
         if (found != v.end())
@@ -207,10 +266,15 @@ namespace gz
       public: bool Publishers(const std::string &_topic,
                              std::map<std::string, std::vector<T>> &_info) const
       {
-        if (!this->HasTopic(_topic))
+        auto topicIt = this->data.find(_topic);
+        if (topicIt == this->data.end())
           return false;
 
-        _info = this->data.at(_topic);
+        // The publishers of a process are never empty, and all of them have
+        // the process UUID of the key.
+        _info.clear();
+        for (auto const &proc : topicIt->second)
+          _info[proc.second.front().PUuid()] = proc.second;
         return true;
       }
 
@@ -222,34 +286,49 @@ namespace gz
       public: bool DelPublisherByNode(const std::string &_topic,
                                       const std::string &_pUuid,
                                       const std::string &_nUuid)
+      {
+        return this->DelPublisherByNode(_topic, Uuid::FromIdentifier(_pUuid),
+          Uuid::FromIdentifier(_nUuid));
+      }
+
+      /// \brief Remove a publisher associated to a given topic and UUID pair.
+      /// \param[in] _topic Topic name
+      /// \param[in] _pUuid Process UUID of the publisher.
+      /// \param[in] _nUuid Node UUID of the publisher.
+      /// \return True when the publisher was removed or false otherwise.
+      public: bool DelPublisherByNode(const std::string &_topic,
+                                      const Uuid &_pUuid,
+                                      const Uuid &_nUuid)
       {
         size_t counter = 0;
 
         // Iterate over all the topics.
-        if (this->data.find(_topic) != this->data.end())
+        auto topicIt = this->data.find(_topic);
+        if (topicIt != this->data.end())
         {
           // m is {pUUID=>Publisher}.
-          auto &m = this->data[_topic];
+          auto &m = topicIt->second;
 
           // The pUuid exists.
-          if (m.find(_pUuid) != m.end())
+          auto procIt = m.find(_pUuid);
+          if (procIt != m.end())
           {
             // Vector of 0MQ known addresses for a given topic and pUuid.
-            auto &v = m[_pUuid];
+            auto &v = procIt->second;
             auto priorSize = v.size();
             v.erase(std::remove_if(v.begin(), v.end(),
               [&](const T &_pub)
               {
-                return _pub.NUuid() == _nUuid;
+                return _pub.NodeKey() == _nUuid;
               }),
               v.end());
             counter = priorSize - v.size();
 
             if (v.empty())
-              m.erase(_pUuid);
+              m.erase(procIt);
 
             if (m.empty())
-              this->data.erase(_topic);
+              this->data.erase(topicIt);
           }
         }
 
@@ -260,6 +339,14 @@ namespace gz
       /// \param[in] _pUuid Process' UUID of the publisher.
       /// \return True when at least one address was removed or false otherwise.
       public: bool DelPublishersByProc(const std::string &_pUuid)
+      {
+        return this->DelPublishersByProc(Uuid::FromIdentifier(_pUuid));
+      }
+
+      /// \brief Remove all the publishers associated to a given process.
+      /// \param[in] _pUuid Process' UUID of the publisher.
+      /// \return True when at least one address was removed or false otherwise.
+      public: bool DelPublishersByProc(const Uuid &_pUuid)
       {
         size_t counter = 0;
 
@@ -285,6 +372,17 @@ namespace gz
       /// and the value is its address information.
       public: void PublishersByProc(const std::string &_pUuid,
                              std::map<std::string, std::vector<T>> &_pubs) const
+      {
+        this->PublishersByProc(Uuid::FromIdentifier(_pUuid), _pubs);
+      }
+
+      /// \brief Given a process UUID, the function returns the list of
+      /// publishers contained in this process UUID with its address information
+      /// \param[in] _pUuid Process UUID.
+      /// \param[out] _pubs Map of publishers where the keys are the node UUIDs
+      /// and the value is its address information.
+      public: void PublishersByProc(const Uuid &_pUuid,
+                             std::map<std::string, std::vector<T>> &_pubs) const
       {
         _pubs.clear();
 
@@ -293,10 +391,10 @@ namespace gz
         {
           // m is {pUUID=>Publisher}.
           auto &m = topic.second;
-          if (m.find(_pUuid) != m.end())
+          auto procIt = m.find(_pUuid);
+          if (procIt != m.end())
           {
-            auto &v = m.at(_pUuid);
-            for (auto const &pub : v)
+            for (auto const &pub : procIt->second)
             {
               _pubs[pub.NUuid()].push_back(T(pub));
             }
@@ -312,6 +410,19 @@ namespace gz
       public: void PublishersByNode(const std::string &_pUuid,
                                     const std::string &_nUuid,
                                     std::vector<T> &_pubs) const
+      {
+        this->PublishersByNode(Uuid::FromIdentifier(_pUuid),
+          Uuid::FromIdentifier(_nUuid), _pubs);
+      }
+
+      /// \brief Given a process UUID and the node UUID, the function returns
+      /// the list of publishers contained in the node.
+      /// \param[in] _pUuid Process UUID.
+      /// \param[in] _nUuid Node UUID.
+      /// \param[out] _pubs Vector of publishers.
+      public: void PublishersByNode(const Uuid &_pUuid,
+                                    const Uuid &_nUuid,
+                                    std::vector<T> &_pubs) const
       {
         _pubs.clear();
 
@@ -320,12 +431,12 @@ namespace gz
         {
           // m is {pUUID=>Publisher}.
           auto const &m = topic.second;
-          if (m.find(_pUuid) != m.end())
+          auto procIt = m.find(_pUuid);
+          if (procIt != m.end())
           {
-            auto const &v = m.at(_pUuid);
-            for (auto const &pub : v)
+            for (auto const &pub : procIt->second)
             {
-              if (pub.NUuid() == _nUuid)
+              if (pub.NodeKey() == _nUuid)
               {
                 _pubs.push_back(T(pub));
               }
@@ -352,7 +463,8 @@ namespace gz
           auto &m = topic.second;
           for (auto const &proc : m)
           {
-            std::cout << "\tProc. UUID: " << proc.first << std::endl;
+            std::cout << "\tProc. UUID: " << proc.second.front().PUuid()
+                      << std::endl;
             auto &v = proc.second;
             for (auto const &publisher : v)
             {
@@ -363,9 +475,9 @@ namespace gz
       }
 
       /// \brief The keys are topics. The values are another map, where the key
-      /// is the process UUID and the value a vector of publishers.
+      /// is the process UUID and the value a non-empty vector of publishers.
       private: std::map<std::string,
-                        std::map<std::string, std::vector<T>>> data;
+                        std::map<Uuid, std::vector<T>>> data;
     };
     }
   }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_TRANSPORTCONTEXT_HH_
+#define GZ_TRANSPORT_TRANSPORTCONTEXT_HH_
+
+#include <memory>
+#include <string>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class Node;
+    class NodeShared;
+    class TransportContextPrivate;
+
+    /// \class TransportContext TransportContext.hh
+    /// gz/transport/TransportContext.hh
+    /// \brief An independent instance of the transport layer within a
+    /// process. By default all the nodes of a process share the same ZMQ
+    /// context, sockets, threads and discovery services. The nodes created
+    /// with a TransportContext (see NodeOptions::SetContext) use the ones of
+    /// the context instead, so a group of nodes with heavy traffic doesn't
+    /// compete for the reception and publication threads of the rest.
+    ///
+    /// Each context has its own process UUID. Nodes of different contexts
+    /// communicate as if they were in different processes: messages go
+    /// through the network stack instead of the intra-process path, and they
+    /// can't reach each other when GZ_TRANSPORT_INTRA_PROCESS=1.
+    ///
+    /// The context is kept alive while any node, publisher or service client
+    /// created with it exists.
+    ///
+    /// ## Pseudo code example ##
+    ///
+    ///    auto context = std::make_shared<TransportContext>();
+    ///    NodeOptions opts;
+    ///    opts.SetContext(context);
+    ///    Node node(opts);
+    class GZ_TRANSPORT_VISIBLE TransportContext
+    {
+      /// \brief Constructor. The sockets and the threads are created when
+      /// the first node of the context uses them.
+      public: TransportContext();
+
+      /// \brief Destructor. Stops the threads and the discovery services of
+      /// the context.
+      public: ~TransportContext();
+
+      /// \brief Copy constructor (deleted).
+      public: TransportContext(const TransportContext &) = delete;
+
+      /// \brief Assignment operator (deleted).
+      /// \return A reference to this instance.
+      public: TransportContext &operator=(const TransportContext &) = delete;
+
+      /// \brief Get the UUID that identifies this context in the discovery
+      /// information, as the process UUID of a regular process.
+      /// \return The UUID.
+      public: const std::string &ProcessUuid() const;
+
+      /// \brief Get the transport state of this context.
+      /// \return Pointer to the state shared by the nodes of the context.
+      private: NodeShared *Shared() const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \internal
+      /// \brief Smart pointer to private data.
+      private: std::unique_ptr<TransportContextPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+      private: friend Node;
+    };
+    }
+  }
+}
+#endif
@@ -181,6 +181,11 @@ namespace gz
     /// \brief The high water mark of the send message buffer.
     /// \sa NodeShared::SndHwm
     const int kDefaultSndHwm = 1000;
+
+    /// \brief The window of pipelined service requests per responder. A
+    /// value of 0 disables pipelining.
+    /// \sa NodeShared::SrvRequestWindow
+    const int kDefaultSrvWindow = 0;
     }
   }
 }
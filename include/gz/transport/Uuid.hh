@@ -18,6 +18,8 @@
 #ifndef GZ_TRANSPORT_UUID_HH_
 #define GZ_TRANSPORT_UUID_HH_
 
+#include <cstddef>
+#include <functional>
 #include <iostream>
 #include <string>
 
@@ -42,11 +44,24 @@ namespace gz
     //
     /// \class Uuid Uuid.hh gz/transport/Uuid.hh
     /// \brief A portable class for representing a Universally Unique Identifier
+    ///
+    /// A Uuid is a 16 byte value that can be copied, compared and hashed,
+    /// so it can be used as a key in ordered and unordered containers
+    /// without converting it to its 36 character string representation.
     class GZ_TRANSPORT_VISIBLE Uuid
     {
-      /// \brief Constructor.
+      /// \brief Constructor. A new random UUID is generated.
       public: Uuid();
 
+      /// \brief Copy constructor.
+      /// \param[in] _other UUID to copy.
+      public: Uuid(const Uuid &_other);
+
+      /// \brief Assignment operator.
+      /// \param[in] _other UUID to copy.
+      /// \return Reference to this UUID.
+      public: Uuid &operator=(const Uuid &_other);
+
       /// \brief Destructor.
       public: virtual ~Uuid();
 
@@ -54,6 +69,44 @@ namespace gz
       /// \return the UUID in string format.
       public: std::string ToString() const;
 
+      /// \brief Parse the string representation of a UUID, as returned by
+      /// ToString().
+      /// \param[in] _str UUID in string format.
+      /// \param[out] _uuid The parsed UUID. It is not modified on failure.
+      /// \return True if _str is a valid UUID.
+      public: static bool FromString(const std::string &_str, Uuid &_uuid);
+
+      /// \brief Get the UUID used as the key of an identifier. The process,
+      /// node and handler identifiers are exchanged as strings, while the
+      /// storages are keyed by their 16 byte value. A valid UUID string is
+      /// parsed, and any other identifier is mapped to a UUID derived from
+      /// its bytes, so the same identifier always gets the same key.
+      /// A new UUID is not generated, so this is cheap enough to be called
+      /// for every lookup.
+      /// \param[in] _id The identifier.
+      /// \return The UUID of the identifier.
+      public: static Uuid FromIdentifier(const std::string &_id);
+
+      /// \brief Equality operator.
+      /// \param[in] _other UUID to compare with.
+      /// \return True if both UUIDs are equal.
+      public: bool operator==(const Uuid &_other) const;
+
+      /// \brief Inequality operator.
+      /// \param[in] _other UUID to compare with.
+      /// \return True if the UUIDs are different.
+      public: bool operator!=(const Uuid &_other) const;
+
+      /// \brief Less than operator. The order is the same as the order of
+      /// the bytes of the UUIDs, and it is only meant to be used for sorting.
+      /// \param[in] _other UUID to compare with.
+      /// \return True if this UUID is ordered before _other.
+      public: bool operator<(const Uuid &_other) const;
+
+      /// \brief Hash of the UUID.
+      /// \return The hash value.
+      public: std::size_t Hash() const;
+
       /// \brief Stream insertion operator.
       /// \param[out] _out The output stream.
       /// \param[in] _uuid UUID to write to the stream.
@@ -72,10 +125,31 @@ namespace gz
       /// To summarize: 36 octets + \0 = 37 octets.
       private: static const int UuidStrLen = 37;
 
+      /// \brief Constructor from the 16 bytes of a UUID. No random UUID is
+      /// generated.
+      /// \param[in] _bytes The bytes of the UUID.
+      private: explicit Uuid(const unsigned char *_bytes);
+
       /// \brief Internal representation.
       private: portable_uuid_t data;
     };
     }
   }
 }
+
+namespace std
+{
+  /// \brief Hash specialization so Uuid can be used as the key of unordered
+  /// containers.
+  template<> struct hash<gz::transport::Uuid>
+  {
+    /// \brief Compute the hash of a UUID.
+    /// \param[in] _uuid The UUID.
+    /// \return The hash value.
+    std::size_t operator()(const gz::transport::Uuid &_uuid) const
+    {
+      return _uuid.Hash();
+    }
+  };
+}
 #endif
@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace gz
@@ -37,6 +38,15 @@ namespace gz
       return this->Advertise(_topic, MessageT().GetTypeName(), _options);
     }
 
+    //////////////////////////////////////////////////
+    template<typename MessageT>
+    std::vector<Node::Publisher> Node::AdvertiseMany(
+        const std::vector<std::string> &_topics,
+        const AdvertiseMessageOptions &_options)
+    {
+      return this->AdvertiseMany(_topics, MessageT().GetTypeName(), _options);
+    }
+
     //////////////////////////////////////////////////
     template<typename MessageT>
     bool Node::Subscribe(
@@ -141,7 +151,7 @@ namespace gz
       // it will recover the subscription handler associated to the topic and
       // will invoke the callback.
       this->Shared()->localSubscribers.normal.AddHandler(
-        fullyQualifiedTopic, this->NodeUuid(), subscrHandlerPtr);
+        fullyQualifiedTopic, this->NodeKey(), subscrHandlerPtr);
 
       return this->SubscribeHelper(fullyQualifiedTopic);
     }
@@ -250,6 +260,10 @@ namespace gz
       // Insert the callback into the handler.
       repHandlerPtr->SetCallback(_cb);
 
+      // The address of the replier is known once the transport of services
+      // is initialized.
+      this->Shared()->InitializeSrvTransport();
+
       std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
 
       // Add the topic to the list of advertised services.
@@ -260,7 +274,7 @@ namespace gz
       // it will recover the replier handler associated to the topic and
       // will invoke the service call.
       this->Shared()->repliers.AddHandler(
-        fullyQualifiedTopic, this->NodeUuid(), repHandlerPtr);
+        fullyQualifiedTopic, this->NodeKey(), repHandlerPtr);
 
       // Notify the discovery service to register and advertise my responser.
       ServicePublisher publisher(fullyQualifiedTopic,
@@ -414,67 +428,70 @@ namespace gz
         return false;
       }
 
-      bool localResponserFound;
-      IRepHandlerPtr repHandler;
+      // The type of a generic reply is only known at run time.
+      if constexpr (std::is_same_v<ReplyT, google::protobuf::Message>)
       {
-        std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
-        localResponserFound = this->Shared()->repliers.FirstHandler(
-              fullyQualifiedTopic,
-              RequestT().GetTypeName(),
-              ReplyT().GetTypeName(),
-              repHandler);
+        return this->RequestGenericReply(fullyQualifiedTopic,
+          TypeId(&_request), _request, _cb);
       }
-
-      // If the responser is within my process.
-      if (localResponserFound)
+      else
       {
-        // There is a responser in my process, let's use it.
-        ReplyT rep;
-        bool result = repHandler->RunLocalCallback(_request, rep);
-
-        _cb(rep, result);
-        return true;
-      }
+        // If the responser is within my process. The lookup doesn't lock the
+        // shared state.
+        IRepHandlerPtr repHandler;
+        if (this->Shared()->repliers.FirstHandler(fullyQualifiedTopic,
+              TypeId(&_request), TypeId<ReplyT>(), repHandler))
+        {
+          // There is a responser in my process, let's use it.
+          ReplyT rep;
+          bool result = repHandler->RunLocalCallback(_request, rep);
 
-      // Create a new request handler.
-      std::shared_ptr<ReqHandler<RequestT, ReplyT>> reqHandlerPtr(
-        new ReqHandler<RequestT, ReplyT>(this->NodeUuid()));
+          _cb(rep, result);
+          return true;
+        }
 
-      // Insert the request's parameters.
-      reqHandlerPtr->SetMessage(&_request);
+        // Create a new request handler.
+        std::shared_ptr<ReqHandler<RequestT, ReplyT>> reqHandlerPtr(
+          new ReqHandler<RequestT, ReplyT>(this->NodeUuid()));
 
-      // Insert the callback into the handler.
-      reqHandlerPtr->SetCallback(_cb);
+        // Insert the request's parameters.
+        reqHandlerPtr->SetMessage(&_request);
 
-      {
-        std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
+        // Insert the callback into the handler.
+        reqHandlerPtr->SetCallback(_cb);
 
-        // Store the request handler.
-        this->Shared()->requests.AddHandler(
-          fullyQualifiedTopic, this->NodeUuid(), reqHandlerPtr);
+        this->Shared()->InitializeSrvTransport();
 
-        // If the responser's address is known, make the request.
-        SrvAddresses_M addresses;
-        if (this->Shared()->TopicPublishers(fullyQualifiedTopic, addresses))
-        {
-          this->Shared()->SendPendingRemoteReqs(fullyQualifiedTopic,
-            RequestT().GetTypeName(), ReplyT().GetTypeName());
-        }
-        else
         {
-          // Discover the service responser.
-          if (!this->Shared()->DiscoverService(fullyQualifiedTopic))
+          std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
+
+          // Store the request handler.
+          this->Shared()->requests.AddHandler(
+            fullyQualifiedTopic, this->NodeKey(), reqHandlerPtr);
+
+          // If the responser's address is known, make the request.
+          SrvAddresses_M addresses;
+          if (this->Shared()->TopicPublishers(fullyQualifiedTopic, addresses))
+          {
+            this->Shared()->SendPendingRemoteReqs(fullyQualifiedTopic,
+              RequestT().GetTypeName(), ReplyT().GetTypeName());
+          }
+          else
           {
-            std::cerr << "Node::Request(): Error discovering service ["
-                      << topic
-                      << "]. Did you forget to start the discovery service?"
-                      << std::endl;
-            return false;
+            // Discover the service responser.
+            if (!this->Shared()->DiscoverService(fullyQualifiedTopic))
+            {
+              std::cerr << "Node::Request(): Error discovering service ["
+                        << topic
+                        << "]. Did you forget to start the discovery service?"
+                        << std::endl;
+              return false;
+            }
           }
         }
-      }
 
-      return true;
+        return true;
+      }
     }
 
     //////////////////////////////////////////////////
@@ -538,6 +555,17 @@ namespace gz
         return false;
       }
 
+      // If the responser is within my process. The lookup doesn't lock the
+      // shared state.
+      IRepHandlerPtr repHandler;
+      if (this->Shared()->repliers.FirstHandler(fullyQualifiedTopic,
+            TypeId(&_request), TypeId(&_reply), repHandler))
+      {
+        // There is a responser in my process, let's use it.
+        _result = repHandler->RunLocalCallback(_request, _reply);
+        return true;
+      }
+
       // Create a new request handler.
       std::shared_ptr<ReqHandler<RequestT, ReplyT>> reqHandlerPtr(
         new ReqHandler<RequestT, ReplyT>(this->NodeUuid()));
@@ -546,21 +574,13 @@ namespace gz
       reqHandlerPtr->SetMessage(&_request);
       reqHandlerPtr->SetResponse(&_reply);
 
-      std::unique_lock<std::recursive_mutex> lk(this->Shared()->mutex);
+      this->Shared()->InitializeSrvTransport();
 
-      // If the responser is within my process.
-      IRepHandlerPtr repHandler;
-      if (this->Shared()->repliers.FirstHandler(fullyQualifiedTopic,
-        _request.GetTypeName(), _reply.GetTypeName(), repHandler))
-      {
-        // There is a responser in my process, let's use it.
-        _result = repHandler->RunLocalCallback(_request, _reply);
-        return true;
-      }
+      std::unique_lock<std::recursive_mutex> lk(this->Shared()->mutex);
 
       // Store the request handler.
       this->Shared()->requests.AddHandler(
-        fullyQualifiedTopic, this->NodeUuid(), reqHandlerPtr);
+        fullyQualifiedTopic, this->NodeKey(), reqHandlerPtr);
 
       // If the responser's address is known, make the request.
       SrvAddresses_M addresses;
@@ -585,9 +605,14 @@ namespace gz
       // Wait until the REP is available.
       bool executed = reqHandlerPtr->WaitUntil(lk, _timeout);
 
-      // The request was not executed.
+      // The request was not executed. Forget it, so it doesn't keep a slot
+      // of the window of the responder in pipelining mode.
       if (!executed)
+      {
+        this->Shared()->AbandonRequest(fullyQualifiedTopic, this->NodeKey(),
+          reqHandlerPtr->HandlerKey());
         return false;
+      }
 
       // The request was executed but did not succeed.
       if (!reqHandlerPtr->Result())
@@ -637,6 +662,137 @@ namespace gz
       return this->Request<RequestT, gz::msgs::Empty>(
             _topic, _request, f);
     }
+
+    //////////////////////////////////////////////////
+    template<typename RequestT, typename ReplyT>
+    Node::ServiceClient Node::CreateServiceClient(const std::string &_topic)
+    {
+      return this->CreateServiceClient(_topic, RequestT().GetTypeName(),
+        ReplyT().GetTypeName());
+    }
+
+    //////////////////////////////////////////////////
+    template<typename MessageT>
+    MsgTypeId Node::TypeId(const MessageT *_msg)
+    {
+      if constexpr (std::is_same_v<MessageT, google::protobuf::Message>)
+      {
+        return _msg ? msgTypeId(_msg->GetTypeName()) : kInvalidMsgTypeId;
+      }
+      else
+      {
+        (void)_msg;
+        static const MsgTypeId kTypeId = msgTypeId(MessageT().GetTypeName());
+        return kTypeId;
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template<typename RequestT, typename ReplyT>
+    bool Node::ServiceClient::Request(
+      const RequestT &_request,
+      const unsigned int _timeout,
+      ReplyT &_reply,
+      bool &_result)
+    {
+      if (!this->CheckTypes(TypeId(&_request), TypeId(&_reply)))
+        return false;
+
+      // If the responser is within my process.
+      IRepHandlerPtr repHandler;
+      if (this->LocalResponder(repHandler))
+      {
+        // There is a responser in my process, let's use it.
+        _result = repHandler->RunLocalCallback(_request, _reply);
+        return true;
+      }
+
+      // Create a new request handler.
+      auto reqHandlerPtr =
+        std::make_shared<ReqHandler<RequestT, ReplyT>>(this->NodeUuid());
+
+      // Insert the request's parameters.
+      reqHandlerPtr->SetMessage(&_request);
+      reqHandlerPtr->SetResponse(&_reply);
+
+      // The request was not executed.
+      if (!this->SendRequestAndWait(reqHandlerPtr, _timeout))
+        return false;
+
+      // The request was executed but did not succeed.
+      if (!reqHandlerPtr->Result())
+      {
+        _result = false;
+        return true;
+      }
+
+      // Parse the response.
+      if (!_reply.ParseFromString(reqHandlerPtr->Response()))
+      {
+        std::cerr << "ServiceClient::Request(): Error Parsing the response"
+                  << std::endl;
+        _result = false;
+        return true;
+      }
+
+      _result = true;
+      return true;
+    }
+
+    //////////////////////////////////////////////////
+    template<typename RequestT, typename ReplyT>
+    bool Node::ServiceClient::Request(
+      const RequestT &_request,
+      const std::function<void(const ReplyT &_reply,
+                               const bool _result)> &_callback)
+    {
+      // The type of a generic reply is only known at run time.
+      if constexpr (std::is_same_v<ReplyT, google::protobuf::Message>)
+      {
+        return this->RequestGenericReply(TypeId(&_request), _request,
+          _callback);
+      }
+      else
+      {
+        if (!this->CheckTypes(TypeId(&_request), TypeId<ReplyT>()))
+          return false;
+
+        // If the responser is within my process.
+        IRepHandlerPtr repHandler;
+        if (this->LocalResponder(repHandler))
+        {
+          // There is a responser in my process, let's use it.
+          ReplyT rep;
+          bool result = repHandler->RunLocalCallback(_request, rep);
+
+          _callback(rep, result);
+          return true;
+        }
+
+        // Create a new request handler.
+        auto reqHandlerPtr =
+          std::make_shared<ReqHandler<RequestT, ReplyT>>(this->NodeUuid());
+
+        // Insert the request's parameters and the callback.
+        reqHandlerPtr->SetMessage(&_request);
+        reqHandlerPtr->SetCallback(_callback);
+
+        return this->SendRequest(reqHandlerPtr);
+      }
+    }
+
+    //////////////////////////////////////////////////
+    template<typename RequestT>
+    bool Node::ServiceClient::Request(const RequestT &_request)
+    {
+      // The response is ignored.
+      std::function<void(const gz::msgs::Empty &, const bool)> f =
+        [](const gz::msgs::Empty &, const bool)
+      {
+      };
+
+      return this->Request<RequestT, gz::msgs::Empty>(_request, f);
+    }
   }
 }
 
@@ -21,13 +21,17 @@
 #include <chrono>
 #include <ios>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <gz/transport/config.hh>
 #include <gz/transport/log/Batch.hh>
 #include <gz/transport/log/QueryOptions.hh>
 #include <gz/transport/log/Descriptor.hh>
 #include <gz/transport/log/Export.hh>
+#include <gz/transport/log/SummaryBucket.hh>
+#include <gz/transport/log/WriteProfile.hh>
 
 namespace gz
 {
@@ -76,6 +80,18 @@ namespace gz
         public: bool Open(const std::string &_file,
             std::ios_base::openmode _mode = std::ios_base::in);
 
+        /// \brief Set the settings used when writing the log. The page size
+        /// is only applied when a new log is created; the rest of the settings
+        /// are applied every time the log is opened for writing.
+        /// \param[in] _profile The write settings.
+        /// \return False if a log is already open, true otherwise.
+        /// \sa WriteProfile
+        public: bool SetWriteProfile(const log::WriteProfile &_profile);
+
+        /// \brief Get the settings used when writing the log.
+        /// \return The write settings.
+        public: const log::WriteProfile &WriteProfile() const;
+
         /// \brief Get the name of the log file.
         /// \return The name of the log file, or an empty string if Open has
         /// not been successfully called.
@@ -120,6 +136,48 @@ namespace gz
         /// valid or if data retrieval failed.
         public: std::chrono::nanoseconds EndTime() const;
 
+        /// \brief Build per-topic summaries of the messages in the log. The
+        /// time line is split into buckets of the given size and, for every
+        /// topic, the number of messages, their total size and the time of
+        /// the first message are stored for each bucket. The summaries are
+        /// stored in the log file, next to the messages, so they only need to
+        /// be built once. Any previous summary is replaced. Messages inserted
+        /// after the summary was built are not part of it.
+        /// \param[in] _bucketSize Duration of each bucket.
+        /// \return True if the summary was built, false if the log is not
+        /// writable or the bucket size is not positive.
+        public: bool BuildSummary(const std::chrono::nanoseconds &_bucketSize);
+
+        /// \brief Get the duration of the buckets of the summary.
+        /// \return The bucket duration, or zero if the log has no summary.
+        public: std::chrono::nanoseconds SummaryBucketSize() const;
+
+        /// \brief Get the summary of every topic, ordered by time.
+        /// \return The non-empty buckets of the summary, or an empty vector if
+        /// the log has no summary.
+        /// \sa BuildSummary
+        public: std::vector<SummaryBucket> Summary() const;
+
+        /// \brief Get the summary of a topic, ordered by time.
+        /// \param[in] _topic Name of the topic.
+        /// \return The non-empty buckets of the topic, or an empty vector if
+        /// the log has no summary or the topic is not in the log.
+        /// \sa BuildSummary
+        public: std::vector<SummaryBucket> Summary(
+            const std::string &_topic) const;
+
+        /// \brief Get the time of the first message received on a topic after
+        /// a given time. This is fast when the log has a summary, because only
+        /// one bucket of messages needs to be read.
+        /// \param[in] _topic Name of the topic.
+        /// \param[in] _after Only messages received strictly after this time
+        /// are considered.
+        /// \return Time of the message, or std::nullopt if there are no more
+        /// messages on the topic.
+        public: std::optional<std::chrono::nanoseconds> NextMessageTime(
+            const std::string &_topic,
+            const std::chrono::nanoseconds &_after) const;
+
         /// \internal Implementation for this class
         private: class Implementation;
 
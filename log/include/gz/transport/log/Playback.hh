@@ -18,6 +18,7 @@
 #define GZ_TRANSPORT_LOG_PLAYBACK_HH_
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <regex>
 #include <string>
@@ -25,6 +26,7 @@
 #include <gz/transport/config.hh>
 #include <gz/transport/log/Export.hh>
 #include <gz/transport/NodeOptions.hh>
+#include <gz/transport/TopicStatistics.hh>
 
 namespace gz
 {
@@ -60,9 +62,10 @@ namespace gz
         public: ~Playback();
 
         /// \brief Begin playing messages
-        /// \param[in] _waitAfterAdvertising How long to wait before the
+        /// \param[in] _waitAfterAdvertising Maximum time to wait before the
         /// publications begin after advertising the topics that will be played
-        /// back.
+        /// back. The publications begin earlier if every topic has a
+        /// subscriber.
         /// \param[in] _msgWaiting True to wait between publication of
         /// messages based on the message timestamps. False to playback
         /// messages as fast as possible. Default value is true.
@@ -136,6 +139,67 @@ namespace gz
         /// due to this function call.
         public: int64_t RemoveTopic(const std::regex &_topic);
 
+        /// \brief Set the number of worker threads used to publish the
+        /// messages of future playbacks.
+        ///
+        /// By default (0 threads) a single thread keeps the timing and
+        /// publishes every message. With one or more worker threads the
+        /// playback thread only keeps the timing and hands each message to
+        /// the worker that owns its topic. Every topic is assigned to exactly
+        /// one worker, so the messages of a topic are still published in
+        /// order, while large messages of different topics sharing the same
+        /// timestamp are published concurrently.
+        ///
+        /// \note This only affects the handles returned by subsequent calls
+        /// to Start().
+        /// \param[in] _threads Number of publishing worker threads.
+        public: void SetPublishThreads(std::size_t _threads);
+
+        /// \brief Get the number of worker threads used to publish messages.
+        /// \return The number of publishing worker threads. 0 means that the
+        /// playback thread publishes the messages itself.
+        /// \sa SetPublishThreads
+        public: std::size_t PublishThreads() const;
+
+        /// \brief Enable or disable the precise timing mode of future
+        /// playbacks.
+        ///
+        /// By default the playback thread sleeps until the time of the next
+        /// message, so the publication times jitter by the granularity of the
+        /// OS scheduler. In precise mode the playback thread sleeps until it is
+        /// _spinThreshold away from the time of the next message, and then
+        /// busy-waits for the remaining time. This reduces the jitter to a few
+        /// microseconds at the cost of keeping one CPU core busy while
+        /// spinning.
+        ///
+        /// \note This only affects the handles returned by subsequent calls
+        /// to Start().
+        /// \param[in] _precise True to enable the precise timing mode.
+        /// \param[in] _spinThreshold Time before the publication of each
+        /// message at which the playback thread stops sleeping and starts
+        /// spinning.
+        /// \sa PlaybackHandle::TimingError
+        public: void SetPreciseTiming(bool _precise,
+            const std::chrono::nanoseconds &_spinThreshold);
+
+        /// \brief Enable or disable the precise timing mode of future
+        /// playbacks, keeping the current spin threshold (500 microseconds
+        /// unless it was changed).
+        /// \param[in] _precise True to enable the precise timing mode.
+        /// \sa SetPreciseTiming(bool, const std::chrono::nanoseconds &)
+        public: void SetPreciseTiming(bool _precise);
+
+        /// \brief Check whether the precise timing mode is enabled.
+        /// \return True if the precise timing mode is enabled.
+        /// \sa SetPreciseTiming
+        public: bool PreciseTiming() const;
+
+        /// \brief Get the spin threshold used by the precise timing mode.
+        /// \return Time before each publication at which the playback thread
+        /// starts spinning.
+        /// \sa SetPreciseTiming
+        public: std::chrono::nanoseconds SpinThreshold() const;
+
         /// \internal Implementation of this class
         private: class Implementation;
 
@@ -202,6 +266,16 @@ namespace gz
         /// \return end time of the log, in nanoseconds
         public: std::chrono::nanoseconds EndTime() const;
 
+        /// \brief Get statistics about the timing error of the published
+        /// messages. The timing error is the delay between the time at which
+        /// a message was scheduled to be published and the time at which it
+        /// was actually published, in microseconds.
+        /// \note Only messages played back with message waiting enabled are
+        /// measured.
+        /// \return Timing error statistics, in microseconds.
+        /// \sa Playback::SetPreciseTiming
+        public: Statistics TimingError() const;
+
         /// \brief Destructor
         public: ~PlaybackHandle();
 
@@ -17,6 +17,7 @@
 #ifndef GZ_TRANSPORT_LOG_RECORDER_HH_
 #define GZ_TRANSPORT_LOG_RECORDER_HH_
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <regex>
@@ -26,6 +27,7 @@
 #include <gz/transport/Clock.hh>
 #include <gz/transport/config.hh>
 #include <gz/transport/log/Export.hh>
+#include <gz/transport/log/WriteProfile.hh>
 
 namespace gz
 {
@@ -120,6 +122,33 @@ namespace gz
         /// \param[in] _size Buffer size in MB
         public: void SetBufferSize(std::size_t _size);
 
+        /// \brief Set the settings used when writing the log file. The
+        /// settings are applied the next time Start is called.
+        /// \param[in] _profile The write settings.
+        /// \return RecorderError::SUCCESS if the settings were stored, or
+        /// RecorderError::ALREADY_RECORDING if a recording is in progress.
+        /// \sa WriteProfile::Fast()
+        public: RecorderError SetWriteProfile(
+                    const log::WriteProfile &_profile);
+
+        /// \brief Get the settings used when writing the log file.
+        /// \return The write settings.
+        public: const log::WriteProfile &WriteProfile() const;
+
+        /// \brief Set the bucket size of the summary that is built when the
+        /// recording stops. The summary allows tools to draw a timeline of
+        /// the log without reading every message.
+        /// \param[in] _bucketSize Duration of each bucket, or zero to not
+        /// build a summary. By default, no summary is built.
+        /// \sa Log::BuildSummary
+        public: void SetSummaryBucketSize(
+                    const std::chrono::nanoseconds &_bucketSize);
+
+        /// \brief Get the bucket size of the summary that is built when the
+        /// recording stops.
+        /// \return Duration of each bucket, or zero if no summary is built.
+        public: std::chrono::nanoseconds SummaryBucketSize() const;
+
         /// \internal Implementation of this class
         private: class Implementation;
 
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_LOG_SUMMARYBUCKET_HH_
+#define GZ_TRANSPORT_LOG_SUMMARYBUCKET_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <gz/transport/config.hh>
+
+namespace gz
+{
+  namespace transport
+  {
+    namespace log
+    {
+      // Inline bracket to help doxygen filtering.
+      inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+      //
+      /// \brief Summary of the messages received on one topic during a
+      /// fixed time interval of a log.
+      /// \sa Log::BuildSummary
+      struct SummaryBucket
+      {
+        /// \brief Name of the topic.
+        std::string topic;
+
+        /// \brief Name of the message type.
+        std::string type;
+
+        /// \brief Start time of the bucket. The bucket covers the time range
+        /// [start, start + Log::SummaryBucketSize()).
+        std::chrono::nanoseconds start{0};
+
+        /// \brief Time the first message in the bucket was received.
+        std::chrono::nanoseconds firstTime{0};
+
+        /// \brief Number of messages in the bucket.
+        uint64_t count{0};
+
+        /// \brief Total size of the serialized messages in bytes.
+        uint64_t bytes{0};
+      };
+      }
+    }
+  }
+}
+#endif
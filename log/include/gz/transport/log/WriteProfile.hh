@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_LOG_WRITEPROFILE_HH_
+#define GZ_TRANSPORT_LOG_WRITEPROFILE_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <gz/transport/config.hh>
+#include <gz/transport/log/Export.hh>
+
+namespace gz
+{
+  namespace transport
+  {
+    namespace log
+    {
+      // Inline bracket to help doxygen filtering.
+      inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+      //
+      /// \brief SQLite journal mode used when writing a log.
+      /// See https://www.sqlite.org/pragma.html#pragma_journal_mode
+      enum class JournalMode : int64_t
+      {
+        /// \brief Keep the SQLite default (a rollback journal that is deleted
+        /// at the end of each transaction).
+        DEFAULT = 0,
+
+        /// \brief Rollback journal truncated at the end of each transaction.
+        TRUNCATE,
+
+        /// \brief Rollback journal kept on disk and overwritten.
+        PERSIST,
+
+        /// \brief Rollback journal kept in memory. A crash in the middle of a
+        /// transaction may corrupt the log.
+        MEMORY,
+
+        /// \brief Write-ahead log. Readers do not block the writer and commits
+        /// are much cheaper.
+        WAL,
+
+        /// \brief No journal at all. A crash in the middle of a transaction may
+        /// corrupt the log.
+        OFF
+      };
+
+      /// \brief How often SQLite flushes the data to the disk when writing a
+      /// log. See https://www.sqlite.org/pragma.html#pragma_synchronous
+      enum class SynchronousMode : int64_t
+      {
+        /// \brief Keep the SQLite default (FULL).
+        DEFAULT = 0,
+
+        /// \brief Hand the data to the OS without waiting for it to reach the
+        /// disk. An OS crash or power loss may corrupt the log.
+        OFF,
+
+        /// \brief Sync at the most critical moments. Safe in WAL mode, an OS
+        /// crash or power loss may roll back the last transactions.
+        NORMAL,
+
+        /// \brief Sync on every commit.
+        FULL,
+
+        /// \brief Like FULL, also syncing the directory of the journal.
+        EXTRA
+      };
+
+      /// \brief Forward declaration
+      class WriteProfilePrivate;
+
+      /// \brief Settings that trade durability for write throughput when
+      /// writing a log. The default profile keeps the SQLite defaults, which
+      /// are optimized for safety. Use Fast() for sustained high write rates.
+      class GZ_TRANSPORT_LOG_VISIBLE WriteProfile
+      {
+        /// \brief Default constructor. Keeps the SQLite defaults and commits
+        /// every 500 ms.
+        public: WriteProfile();
+
+        /// \brief Copy constructor.
+        /// \param[in] _other WriteProfile to copy.
+        public: WriteProfile(const WriteProfile &_other);
+
+        /// \brief Destructor.
+        public: ~WriteProfile();
+
+        /// \brief Assignment operator.
+        /// \param[in] _other The new WriteProfile.
+        /// \return A reference to this instance.
+        public: WriteProfile &operator=(const WriteProfile &_other);
+
+        /// \brief A profile optimized for safety. This is the default profile.
+        /// \return The safe profile.
+        public: static WriteProfile Safe();
+
+        /// \brief A profile for sustained high write rates: write-ahead log,
+        /// NORMAL synchronization, a 64 MB page cache, a 256 MB memory map and
+        /// one commit per second. A crash may lose the last transactions, but
+        /// does not corrupt the log.
+        /// \return The fast profile.
+        public: static WriteProfile Fast();
+
+        /// \brief A profile that maximizes the write rate at the expense of
+        /// durability: in-memory journal, no synchronization, a 64 MB page
+        /// cache and one commit every 5 seconds. A crash may corrupt the log.
+        /// \return The fastest profile.
+        public: static WriteProfile Fastest();
+
+        /// \brief Get the journal mode.
+        /// \return The journal mode.
+        public: log::JournalMode JournalMode() const;
+
+        /// \brief Set the journal mode.
+        /// \param[in] _mode The journal mode.
+        public: void SetJournalMode(log::JournalMode _mode);
+
+        /// \brief Get the synchronous mode.
+        /// \return The synchronous mode.
+        public: log::SynchronousMode SynchronousMode() const;
+
+        /// \brief Set the synchronous mode.
+        /// \param[in] _mode The synchronous mode.
+        public: void SetSynchronousMode(log::SynchronousMode _mode);
+
+        /// \brief Get the database page size.
+        /// \return Page size in bytes, or 0 to keep the SQLite default.
+        public: std::size_t PageSize() const;
+
+        /// \brief Set the database page size. The page size only takes effect
+        /// when the log is created.
+        /// \param[in] _size Page size in bytes. It must be a power of two
+        /// between 512 and 65536, or 0 to keep the SQLite default.
+        /// \return True if the size is valid.
+        public: bool SetPageSize(std::size_t _size);
+
+        /// \brief Get the size of the page cache.
+        /// \return Cache size in KiB, or 0 to keep the SQLite default.
+        public: std::size_t CacheSize() const;
+
+        /// \brief Set the size of the page cache.
+        /// \param[in] _size Cache size in KiB, or 0 to keep the SQLite default.
+        public: void SetCacheSize(std::size_t _size);
+
+        /// \brief Get the maximum size of the memory map used to access the
+        /// log.
+        /// \return Memory map size in bytes, or 0 to disable memory mapping.
+        public: std::size_t MmapSize() const;
+
+        /// \brief Set the maximum size of the memory map used to access the
+        /// log.
+        /// \param[in] _size Memory map size in bytes, or 0 to disable memory
+        /// mapping.
+        public: void SetMmapSize(std::size_t _size);
+
+        /// \brief Get the time between commits.
+        /// \return The time between commits.
+        public: std::chrono::milliseconds TransactionPeriod() const;
+
+        /// \brief Set the time between commits. Messages are inserted in a
+        /// transaction that is committed when this period elapses, so longer
+        /// periods mean fewer, larger commits.
+        /// \param[in] _period The time between commits.
+        public: void SetTransactionPeriod(
+            const std::chrono::milliseconds &_period);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+        /// \internal
+        /// \brief Smart pointer to private data.
+        private: std::unique_ptr<WriteProfilePrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+      };
+      }
+    }
+  }
+}
+#endif
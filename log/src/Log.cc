@@ -23,8 +23,10 @@
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "gz/transport/log/Descriptor.hh"
 #include "gz/transport/log/Log.hh"
@@ -76,6 +78,13 @@ class gz::transport::log::Log::Implementation
   /// \brief SQLite3 database pointer wrapper
   public: std::shared_ptr<raii_sqlite3::Database> db;
 
+  /// \brief Compiled statement used to insert messages. It is compiled once
+  /// and reused for every message, which matters when inserting messages in
+  /// bulk.
+  /// \note This member needs to come after the db member so that it gets
+  /// finalized before the database is closed.
+  public: std::unique_ptr<raii_sqlite3::Statement> insertStatement;
+
   /// \brief True if a transaction is in progress
   public: bool inTransaction = false;
 
@@ -88,6 +97,41 @@ class gz::transport::log::Log::Implementation
   /// \brief duration between transactions
   public: std::chrono::milliseconds transactionPeriod;
 
+  /// \brief Settings used when writing the log
+  public: log::WriteProfile writeProfile;
+
+  /// \brief Apply the settings of writeProfile to a database
+  /// \param[in] _db The database
+  /// \param[in] _create True if the database is being created
+  /// \return True on success
+  public: bool ApplyWriteProfile(raii_sqlite3::Database &_db,
+                                 bool _create) const;
+
+  /// \brief Read the settings of the summary, if the log has one
+  /// \param[out] _bucketSize Duration of each bucket
+  /// \param[out] _lastMessageId Id of the last message in the summary
+  /// \return True if the log has a summary
+  public: bool SummaryInfo(std::chrono::nanoseconds &_bucketSize,
+                           int64_t &_lastMessageId) const;
+
+  /// \brief Read the buckets of the summary
+  /// \param[in] _topic Name of the topic, or nullptr for all the topics
+  /// \return The buckets ordered by time
+  public: std::vector<SummaryBucket> QuerySummary(
+      const std::string *_topic) const;
+
+  /// \brief Get the time of the first message on a topic in a time range
+  /// \param[in] _sql Query with the topic name and time bound as parameters
+  /// 1 and 2, and an optional extra integer bound as parameter 3
+  /// \param[in] _topic Name of the topic
+  /// \param[in] _after Lower bound (exclusive) of the time range
+  /// \param[in] _extra Value bound to parameter 3, if any
+  /// \return Time of the message, or std::nullopt if there is none
+  public: std::optional<std::chrono::nanoseconds> FirstTime(
+      const std::string &_sql, const std::string &_topic,
+      const std::chrono::nanoseconds &_after,
+      const std::optional<int64_t> &_extra) const;
+
   /// \brief Flag to track whether we need to generate a new Descriptor
   private: mutable bool needNewDescriptor = true;
 
@@ -171,6 +215,187 @@ const log::Descriptor *Log::Implementation::Descriptor() const
   return &this->descriptor;
 }
 
+//////////////////////////////////////////////////
+bool Log::Implementation::ApplyWriteProfile(raii_sqlite3::Database &_db,
+    bool _create) const
+{
+  std::string pragmas;
+
+  // The page size must be set before the first table is created
+  if (_create && this->writeProfile.PageSize() > 0)
+  {
+    pragmas += "PRAGMA page_size = " +
+      std::to_string(this->writeProfile.PageSize()) + ";";
+  }
+
+  switch (this->writeProfile.JournalMode())
+  {
+    case log::JournalMode::TRUNCATE:
+      pragmas += "PRAGMA journal_mode = TRUNCATE;";
+      break;
+    case log::JournalMode::PERSIST:
+      pragmas += "PRAGMA journal_mode = PERSIST;";
+      break;
+    case log::JournalMode::MEMORY:
+      pragmas += "PRAGMA journal_mode = MEMORY;";
+      break;
+    case log::JournalMode::WAL:
+      pragmas += "PRAGMA journal_mode = WAL;";
+      break;
+    case log::JournalMode::OFF:
+      pragmas += "PRAGMA journal_mode = OFF;";
+      break;
+    case log::JournalMode::DEFAULT:
+    default:
+      break;
+  }
+
+  switch (this->writeProfile.SynchronousMode())
+  {
+    case log::SynchronousMode::OFF:
+      pragmas += "PRAGMA synchronous = OFF;";
+      break;
+    case log::SynchronousMode::NORMAL:
+      pragmas += "PRAGMA synchronous = NORMAL;";
+      break;
+    case log::SynchronousMode::FULL:
+      pragmas += "PRAGMA synchronous = FULL;";
+      break;
+    case log::SynchronousMode::EXTRA:
+      pragmas += "PRAGMA synchronous = EXTRA;";
+      break;
+    case log::SynchronousMode::DEFAULT:
+    default:
+      break;
+  }
+
+  // A negative value is interpreted by SQLite as a size in KiB
+  if (this->writeProfile.CacheSize() > 0)
+  {
+    pragmas += "PRAGMA cache_size = -" +
+      std::to_string(this->writeProfile.CacheSize()) + ";";
+  }
+
+  if (this->writeProfile.MmapSize() > 0)
+  {
+    pragmas += "PRAGMA mmap_size = " +
+      std::to_string(this->writeProfile.MmapSize()) + ";";
+  }
+
+  if (pragmas.empty())
+    return true;
+
+  LDBG("Write profile: " << pragmas << "\n");
+  int returnCode = sqlite3_exec(_db.Handle(), pragmas.c_str(), NULL, 0, NULL);
+  if (returnCode != SQLITE_OK)
+  {
+    LERR("Failed to apply write profile: " << sqlite3_errmsg(_db.Handle())
+         << "\n");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Log::Implementation::SummaryInfo(std::chrono::nanoseconds &_bucketSize,
+    int64_t &_lastMessageId) const
+{
+  // The statement fails to compile if the summary tables do not exist
+  raii_sqlite3::Statement statement(*(this->db),
+      "SELECT bucket_size, last_message_id FROM summary_info;");
+  if (!statement || sqlite3_step(statement.Handle()) != SQLITE_ROW)
+    return false;
+
+  _bucketSize = std::chrono::nanoseconds(
+      sqlite3_column_int64(statement.Handle(), 0));
+  _lastMessageId = sqlite3_column_int64(statement.Handle(), 1);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<SummaryBucket> Log::Implementation::QuerySummary(
+    const std::string *_topic) const
+{
+  std::vector<SummaryBucket> buckets;
+
+  std::string sql =
+    "SELECT topics.name, message_types.name, summary_buckets.bucket_start,"
+    " summary_buckets.first_time_recv, summary_buckets.message_count,"
+    " summary_buckets.total_bytes"
+    " FROM summary_buckets"
+    " JOIN topics ON summary_buckets.topic_id = topics.id"
+    " JOIN message_types ON topics.message_type_id = message_types.id";
+  if (_topic)
+    sql += " WHERE topics.name = ?001";
+  sql += " ORDER BY summary_buckets.bucket_start, topics.name;";
+
+  raii_sqlite3::Statement statement(*(this->db), sql);
+  if (!statement)
+    return buckets;
+
+  if (_topic && sqlite3_bind_text(statement.Handle(), 1, _topic->c_str(),
+        static_cast<int>(_topic->size()), nullptr) != SQLITE_OK)
+  {
+    LERR("Failed to bind topic name\n");
+    return buckets;
+  }
+
+  while (sqlite3_step(statement.Handle()) == SQLITE_ROW)
+  {
+    SummaryBucket bucket;
+    bucket.topic = reinterpret_cast<const char *>(
+        sqlite3_column_text(statement.Handle(), 0));
+    bucket.type = reinterpret_cast<const char *>(
+        sqlite3_column_text(statement.Handle(), 1));
+    bucket.start = std::chrono::nanoseconds(
+        sqlite3_column_int64(statement.Handle(), 2));
+    bucket.firstTime = std::chrono::nanoseconds(
+        sqlite3_column_int64(statement.Handle(), 3));
+    bucket.count = static_cast<uint64_t>(
+        sqlite3_column_int64(statement.Handle(), 4));
+    bucket.bytes = static_cast<uint64_t>(
+        sqlite3_column_int64(statement.Handle(), 5));
+    buckets.push_back(std::move(bucket));
+  }
+
+  return buckets;
+}
+
+//////////////////////////////////////////////////
+std::optional<std::chrono::nanoseconds> Log::Implementation::FirstTime(
+    const std::string &_sql, const std::string &_topic,
+    const std::chrono::nanoseconds &_after,
+    const std::optional<int64_t> &_extra) const
+{
+  raii_sqlite3::Statement statement(*(this->db), _sql);
+  if (!statement)
+  {
+    LERR("Failed to compile next message query\n");
+    return std::nullopt;
+  }
+
+  int returnCode = sqlite3_bind_text(statement.Handle(), 1, _topic.c_str(),
+      static_cast<int>(_topic.size()), nullptr);
+  if (returnCode == SQLITE_OK)
+    returnCode = sqlite3_bind_int64(statement.Handle(), 2, _after.count());
+  if (returnCode == SQLITE_OK && _extra)
+    returnCode = sqlite3_bind_int64(statement.Handle(), 3, *_extra);
+  if (returnCode != SQLITE_OK)
+  {
+    LERR("Failed to bind next message query parameters\n");
+    return std::nullopt;
+  }
+
+  // MIN() always returns a row, which is NULL if nothing matched
+  if (sqlite3_step(statement.Handle()) != SQLITE_ROW ||
+      sqlite3_column_type(statement.Handle(), 0) == SQLITE_NULL)
+  {
+    return std::nullopt;
+  }
+
+  return std::chrono::nanoseconds(sqlite3_column_int64(statement.Handle(), 0));
+}
+
 //////////////////////////////////////////////////
 int Log::Implementation::EndTransactionIfEnoughTimeHasPassed()
 {
@@ -333,17 +558,28 @@ bool Log::Implementation::InsertMessage(
     return false;
 
   int returnCode;
-  const std::string sql =
-    "INSERT INTO messages (time_recv, message, topic_id)"
-    "VALUES (?001, ?002, ?003);";
 
-  // Compile the statement
-  raii_sqlite3::Statement statement(*(this->db), sql);
-  if (!statement)
+  // Compile the statement the first time, and reuse it afterwards
+  if (!this->insertStatement)
   {
-    LERR("Failed to compile insert message statement\n");
-    return false;
+    const std::string sql =
+      "INSERT INTO messages (time_recv, message, topic_id)"
+      "VALUES (?001, ?002, ?003);";
+
+    auto newStatement = std::make_unique<raii_sqlite3::Statement>(
+        *(this->db), sql);
+    if (!*newStatement)
+    {
+      LERR("Failed to compile insert message statement\n");
+      return false;
+    }
+    this->insertStatement = std::move(newStatement);
   }
+  raii_sqlite3::Statement &statement = *this->insertStatement;
+
+  // Clear the state left by the previous message
+  sqlite3_reset(statement.Handle());
+  sqlite3_clear_bindings(statement.Handle());
 
   // Bind parameters
   returnCode = sqlite3_bind_int64(statement.Handle(), 1, _time.count());
@@ -372,6 +608,11 @@ bool Log::Implementation::InsertMessage(
 
   // Execute the statement
   returnCode = sqlite3_step(statement.Handle());
+
+  // Release the reference to the message data
+  sqlite3_reset(statement.Handle());
+  sqlite3_clear_bindings(statement.Handle());
+
   if (returnCode != SQLITE_DONE)
   {
     LERR("Failed to insert message. sqlite3 return code[" << returnCode
@@ -386,7 +627,8 @@ Log::Log()
   : dataPtr(new Implementation)
 {
   // Default to 2 transactions per second
-  this->dataPtr->transactionPeriod = std::chrono::milliseconds(500);
+  this->dataPtr->transactionPeriod =
+    this->dataPtr->writeProfile.TransactionPeriod();
 }
 
 //////////////////////////////////////////////////
@@ -441,6 +683,18 @@ bool Log::Open(const std::string &_file, const std::ios_base::openmode _mode)
   // Don't need to create a schema if this is read only
   if (std::ios_base::out & _mode)
   {
+    // A log without tables is being created
+    bool create = true;
+    {
+      raii_sqlite3::Statement countTables(*db,
+          "SELECT COUNT(*) FROM sqlite_master;");
+      if (countTables && sqlite3_step(countTables.Handle()) == SQLITE_ROW)
+        create = sqlite3_column_int64(countTables.Handle(), 0) == 0;
+    }
+
+    if (!this->dataPtr->ApplyWriteProfile(*db, create))
+      return false;
+
     // Test hook so tests can be run before `make install`
     std::string schemaFile;
     const char *envPath = std::getenv(SchemaLocationEnvVar.c_str());
@@ -518,6 +772,26 @@ bool Log::Open(const std::string &_file, const std::ios_base::openmode _mode)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Log::SetWriteProfile(const log::WriteProfile &_profile)
+{
+  if (this->dataPtr->db)
+  {
+    LERR("The write profile must be set before opening the log\n");
+    return false;
+  }
+
+  this->dataPtr->writeProfile = _profile;
+  this->dataPtr->transactionPeriod = _profile.TransactionPeriod();
+  return true;
+}
+
+//////////////////////////////////////////////////
+const log::WriteProfile &Log::WriteProfile() const
+{
+  return this->dataPtr->writeProfile;
+}
+
 //////////////////////////////////////////////////
 const log::Descriptor *Log::Descriptor() const
 {
@@ -731,3 +1005,147 @@ std::string Log::Filename() const
 {
   return this->dataPtr->filename;
 }
+
+//////////////////////////////////////////////////
+bool Log::BuildSummary(const std::chrono::nanoseconds &_bucketSize)
+{
+  if (!this->Valid())
+  {
+    LERR("Cannot build the summary of an invalid log.\n");
+    return false;
+  }
+
+  if (_bucketSize <= std::chrono::nanoseconds::zero())
+  {
+    LERR("The bucket size of the summary must be positive\n");
+    return false;
+  }
+
+  // Buckets are aligned to multiples of the bucket size. The modulo
+  // expression rounds down negative times too.
+  const std::string size = std::to_string(_bucketSize.count());
+  const std::string bucketStart =
+    "time_recv - ((time_recv % " + size + ") + " + size + ") % " + size;
+
+  const std::string sql =
+    "CREATE TABLE IF NOT EXISTS summary_info ("
+    "  bucket_size INTEGER NOT NULL,"
+    "  last_message_id INTEGER NOT NULL);"
+    "CREATE TABLE IF NOT EXISTS summary_buckets ("
+    "  topic_id INTEGER NOT NULL REFERENCES topics (id) ON DELETE CASCADE,"
+    "  bucket_start INTEGER NOT NULL,"
+    "  message_count INTEGER NOT NULL,"
+    "  total_bytes INTEGER NOT NULL,"
+    "  first_message_id INTEGER NOT NULL,"
+    "  first_time_recv INTEGER NOT NULL,"
+    "  PRIMARY KEY (topic_id, bucket_start));"
+    "DELETE FROM summary_info;"
+    "DELETE FROM summary_buckets;"
+    "INSERT INTO summary_info (bucket_size, last_message_id)"
+    "  SELECT " + size + ", IFNULL(MAX(id), 0) FROM messages;"
+    // SQLite takes the bare id column from the row that matches MIN()
+    "INSERT INTO summary_buckets"
+    "  SELECT topic_id, " + bucketStart + " AS bucket, COUNT(*),"
+    "  SUM(LENGTH(message)), id, MIN(time_recv)"
+    "  FROM messages GROUP BY topic_id, bucket;";
+
+  // Build the summary in a single transaction, together with any pending
+  // messages
+  if (SQLITE_OK != this->dataPtr->BeginTransactionIfNotInOne())
+    return false;
+
+  int returnCode = sqlite3_exec(
+      this->dataPtr->db->Handle(), sql.c_str(), NULL, 0, nullptr);
+  if (returnCode != SQLITE_OK)
+  {
+    LERR("Failed to build summary: "
+         << sqlite3_errmsg(this->dataPtr->db->Handle()) << "\n");
+    sqlite3_exec(this->dataPtr->db->Handle(), "ROLLBACK;", NULL, 0, nullptr);
+    this->dataPtr->inTransaction = false;
+    return false;
+  }
+
+  return SQLITE_OK == this->dataPtr->EndTransaction();
+}
+
+//////////////////////////////////////////////////
+std::chrono::nanoseconds Log::SummaryBucketSize() const
+{
+  std::chrono::nanoseconds bucketSize{0};
+  int64_t lastMessageId;
+  if (!this->Valid() ||
+      !this->dataPtr->SummaryInfo(bucketSize, lastMessageId))
+  {
+    return std::chrono::nanoseconds::zero();
+  }
+  return bucketSize;
+}
+
+//////////////////////////////////////////////////
+std::vector<SummaryBucket> Log::Summary() const
+{
+  if (!this->Valid())
+    return {};
+  return this->dataPtr->QuerySummary(nullptr);
+}
+
+//////////////////////////////////////////////////
+std::vector<SummaryBucket> Log::Summary(const std::string &_topic) const
+{
+  if (!this->Valid())
+    return {};
+  return this->dataPtr->QuerySummary(&_topic);
+}
+
+//////////////////////////////////////////////////
+std::optional<std::chrono::nanoseconds> Log::NextMessageTime(
+    const std::string &_topic, const std::chrono::nanoseconds &_after) const
+{
+  if (!this->Valid())
+    return std::nullopt;
+
+  const std::string messagesOnTopic =
+    "SELECT MIN(messages.time_recv) FROM messages"
+    " JOIN topics ON messages.topic_id = topics.id"
+    " WHERE topics.name = ?001 AND messages.time_recv > ?002";
+
+  std::chrono::nanoseconds bucketSize;
+  int64_t lastMessageId;
+  if (!this->dataPtr->SummaryInfo(bucketSize, lastMessageId) ||
+      bucketSize <= std::chrono::nanoseconds::zero())
+  {
+    return this->dataPtr->FirstTime(
+        messagesOnTopic + ";", _topic, _after, std::nullopt);
+  }
+
+  // Start of the bucket that contains _after
+  const int64_t size = bucketSize.count();
+  const int64_t after = _after.count();
+  const int64_t start = after - ((after % size) + size) % size;
+
+  // Look for the message in the remainder of the current bucket
+  std::optional<std::chrono::nanoseconds> next = this->dataPtr->FirstTime(
+      messagesOnTopic + " AND messages.time_recv < ?003;",
+      _topic, _after, start + size);
+
+  // Otherwise, use the summary to jump to the next bucket with messages
+  if (!next)
+  {
+    next = this->dataPtr->FirstTime(
+        "SELECT MIN(summary_buckets.first_time_recv) FROM summary_buckets"
+        " JOIN topics ON summary_buckets.topic_id = topics.id"
+        " WHERE topics.name = ?001 AND summary_buckets.bucket_start > ?002;",
+        _topic, std::chrono::nanoseconds(start), std::nullopt);
+  }
+
+  // Messages inserted after the summary was built are not in it
+  std::optional<std::chrono::nanoseconds> unsummarized =
+    this->dataPtr->FirstTime(
+      messagesOnTopic + " AND messages.id > ?003;",
+      _topic, _after, lastMessageId);
+
+  if (unsummarized && (!next || *unsummarized < *next))
+    next = unsummarized;
+
+  return next;
+}
@@ -15,9 +15,62 @@
  *
 */
 
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "gz/transport/log/Log.hh"
 #include "cmd/LogCommandAPI.hh"
+#include "test_config.hh"
 #include "gtest/gtest.h"
 
+using namespace gz;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////
+/// \brief Create a log with one message per second during 10 seconds on
+/// /foo and on /bar.
+/// \param[in] _file Path to the log file.
+/// \return True on success.
+bool CreateTestLog(const std::string &_file)
+{
+  transport::log::Log logFile;
+  if (!logFile.Open(_file, std::ios_base::out))
+    return false;
+
+  for (int i = 0; i < 10; ++i)
+  {
+    const std::string data = "data" + std::to_string(i);
+    for (const std::string topic : {"/foo", "/bar"})
+    {
+      if (!logFile.InsertMessage(std::chrono::seconds(1 + i), topic,
+            "some.message.type", data.data(), data.size()))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the messages of a log.
+/// \param[in] _file Path to the log file.
+/// \return The time and topic of every message, in order.
+std::vector<std::pair<std::chrono::nanoseconds, std::string>> ReadTestLog(
+    const std::string &_file)
+{
+  std::vector<std::pair<std::chrono::nanoseconds, std::string>> result;
+  transport::log::Log logFile;
+  if (!logFile.Open(_file, std::ios_base::in))
+    return result;
+
+  for (const transport::log::Message &msg : logFile.QueryMessages())
+    result.push_back({msg.TimeReceived(), msg.Topic()});
+  return result;
+}
+
 //////////////////////////////////////////////////
 TEST(LogCommandAPI, Version)
 {
@@ -64,3 +117,78 @@ TEST(LogCommandAPI, PlaybackFailedToOpen)
   EXPECT_EQ(FAILED_TO_OPEN,
     playbackTopics("!@#$%^&*(:;[{]})?/.'|", ".*", 0, "", false));
 }
+
+//////////////////////////////////////////////////
+TEST(LogCommandAPI, FilterSplitMergeBadRegex)
+{
+  EXPECT_EQ(BAD_REGEX, filterLog(":memory:", ":memory:", "*", -1, -1));
+  EXPECT_EQ(BAD_REGEX, splitLog(":memory:", "split", "*", 1));
+  EXPECT_EQ(BAD_REGEX, mergeLogs(":memory:", ":memory:", "*"));
+  EXPECT_EQ(BAD_REGEX, catLog(":memory:", "*", -1, -1));
+}
+
+//////////////////////////////////////////////////
+TEST(LogCommandAPI, FilterSplitMergeFailedToOpen)
+{
+  const char *file = "!@#$%^&*(:;[{]})?/.'|";
+  EXPECT_EQ(FAILED_TO_OPEN, filterLog(file, ":memory:", ".*", -1, -1));
+  EXPECT_EQ(FAILED_TO_OPEN, splitLog(file, "split", ".*", 1));
+  EXPECT_EQ(FAILED_TO_OPEN, mergeLogs(file, ":memory:", ".*"));
+  EXPECT_EQ(FAILED_TO_OPEN, mergeLogs("", ":memory:", ".*"));
+  EXPECT_EQ(FAILED_TO_OPEN, catLog(file, ".*", -1, -1));
+}
+
+//////////////////////////////////////////////////
+TEST(LogCommandAPI, FilterSplitMerge)
+{
+  const std::filesystem::path dir =
+    std::filesystem::temp_directory_path() /
+    ("gz_log_cmd_" + testing::getRandomNumber());
+  ASSERT_TRUE(std::filesystem::create_directories(dir));
+
+  const std::string input = (dir / "input.tlog").string();
+  ASSERT_TRUE(CreateTestLog(input));
+  ASSERT_EQ(20u, ReadTestLog(input).size());
+
+  // Keep /foo between the 2nd and 5th second after the start of the log
+  const std::string filtered = (dir / "filtered.tlog").string();
+  EXPECT_EQ(SUCCESS, filterLog(input.c_str(), filtered.c_str(), "/foo",
+        2, 5));
+  auto messages = ReadTestLog(filtered);
+  ASSERT_EQ(4u, messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    EXPECT_EQ(std::chrono::seconds(3 + i), messages[i].first);
+    EXPECT_EQ("/foo", messages[i].second);
+  }
+
+  // The output must not exist yet
+  EXPECT_EQ(FAILED_TO_OPEN, filterLog(input.c_str(), filtered.c_str(), ".*",
+        -1, -1));
+
+  // Split in chunks of 4 seconds
+  const std::string prefix = (dir / "split").string();
+  EXPECT_EQ(SUCCESS, splitLog(input.c_str(), prefix.c_str(), ".*", 4));
+  EXPECT_EQ(8u, ReadTestLog(prefix + "_0.tlog").size());
+  EXPECT_EQ(8u, ReadTestLog(prefix + "_1.tlog").size());
+  EXPECT_EQ(4u, ReadTestLog(prefix + "_2.tlog").size());
+  EXPECT_FALSE(std::filesystem::exists(prefix + "_3.tlog"));
+
+  // Merge the chunks back, in any order
+  const std::string merged = (dir / "merged.tlog").string();
+  const std::string inputs =
+    prefix + "_2.tlog\n" + prefix + "_0.tlog\n" + prefix + "_1.tlog";
+  EXPECT_EQ(SUCCESS, mergeLogs(inputs.c_str(), merged.c_str(), "/bar"));
+  messages = ReadTestLog(merged);
+  ASSERT_EQ(10u, messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i)
+  {
+    EXPECT_EQ(std::chrono::seconds(1 + i), messages[i].first);
+    EXPECT_EQ("/bar", messages[i].second);
+  }
+
+  EXPECT_EQ(SUCCESS, catLog(merged.c_str(), ".*", -1, -1));
+
+  std::filesystem::remove_all(dir);
+}
+
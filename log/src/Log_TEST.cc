@@ -16,9 +16,12 @@
 */
 
 #include <chrono>
+#include <filesystem>
 #include <ios>
+#include <optional>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "gz/transport/log/Log.hh"
 #include "test_config.hh"
@@ -258,3 +261,161 @@ TEST(Log, OpenCorruptDatabase)
   EXPECT_GT(logFile.EndTime(), 0ns) << "logFile.EndTime() == "
     << logFile.EndTime().count() << "ns";;
 }
+
+//////////////////////////////////////////////////
+TEST(Log, SetWriteProfile)
+{
+  log::Log logFile;
+  EXPECT_EQ(log::JournalMode::DEFAULT, logFile.WriteProfile().JournalMode());
+
+  log::WriteProfile profile = log::WriteProfile::Fast();
+  profile.SetTransactionPeriod(100ms);
+  EXPECT_TRUE(logFile.SetWriteProfile(profile));
+  EXPECT_EQ(log::JournalMode::WAL, logFile.WriteProfile().JournalMode());
+  EXPECT_EQ(100ms, logFile.WriteProfile().TransactionPeriod());
+
+  ASSERT_TRUE(logFile.Open(":memory:", std::ios_base::out));
+  EXPECT_FALSE(logFile.SetWriteProfile(log::WriteProfile::Safe()));
+  EXPECT_EQ(log::JournalMode::WAL, logFile.WriteProfile().JournalMode());
+}
+
+//////////////////////////////////////////////////
+TEST(Log, WriteProfileRoundTrip)
+{
+  const std::filesystem::path dir =
+    std::filesystem::temp_directory_path() /
+    ("gz_log_profile_" + testing::getRandomNumber());
+  ASSERT_TRUE(std::filesystem::create_directories(dir));
+
+  log::WriteProfile custom;
+  custom.SetJournalMode(log::JournalMode::TRUNCATE);
+  custom.SetSynchronousMode(log::SynchronousMode::OFF);
+  EXPECT_TRUE(custom.SetPageSize(16384));
+
+  for (const auto &profile : {log::WriteProfile::Safe(),
+       log::WriteProfile::Fast(), log::WriteProfile::Fastest(), custom})
+  {
+    const std::string path =
+      (dir / ("profile_" + testing::getRandomNumber() + ".tlog")).string();
+    std::string data("Hello World");
+
+    {
+      log::Log logFile;
+      ASSERT_TRUE(logFile.SetWriteProfile(profile));
+      ASSERT_TRUE(logFile.Open(path, std::ios_base::out));
+      for (int i = 0; i < 100; ++i)
+      {
+        EXPECT_TRUE(logFile.InsertMessage(
+            std::chrono::seconds(i),
+            "/some/topic/name",
+            "some.message.type",
+            reinterpret_cast<const void *>(data.c_str()),
+            data.size()));
+      }
+    }
+
+    log::Log logFile;
+    ASSERT_TRUE(logFile.Open(path, std::ios_base::in));
+    int count = 0;
+    for (const log::Message &msg : logFile.QueryMessages())
+    {
+      EXPECT_EQ(data, msg.Data());
+      ++count;
+    }
+    EXPECT_EQ(100, count);
+    EXPECT_EQ(99s, logFile.EndTime());
+  }
+
+  std::filesystem::remove_all(dir);
+}
+
+//////////////////////////////////////////////////
+TEST(Log, Summary)
+{
+  log::Log logFile;
+  EXPECT_FALSE(logFile.BuildSummary(1s));
+  EXPECT_EQ(0ns, logFile.SummaryBucketSize());
+  EXPECT_TRUE(logFile.Summary().empty());
+  EXPECT_FALSE(logFile.NextMessageTime("/foo", 0ns));
+
+  ASSERT_TRUE(logFile.Open(":memory:", std::ios_base::out));
+  EXPECT_EQ(0ns, logFile.SummaryBucketSize());
+  EXPECT_TRUE(logFile.Summary().empty());
+
+  std::string data("0123456789");
+  auto insert = [&](const std::chrono::nanoseconds &_time,
+                    const std::string &_topic)
+  {
+    EXPECT_TRUE(logFile.InsertMessage(_time, _topic, "some.message.type",
+          reinterpret_cast<const void *>(data.c_str()), data.size()));
+  };
+
+  // /foo publishes every 100 ms during the first 2 seconds, /bar publishes
+  // once at 1.5 s and once at 10.2 s.
+  for (int i = 0; i < 20; ++i)
+    insert(std::chrono::milliseconds(100 * i), "/foo");
+  insert(1500ms, "/bar");
+  insert(10200ms, "/bar");
+
+  // Without a summary, the next message is found by scanning the messages
+  EXPECT_EQ(std::make_optional<std::chrono::nanoseconds>(1500ms),
+      logFile.NextMessageTime("/bar", 0ns));
+
+  EXPECT_FALSE(logFile.BuildSummary(0ns));
+  ASSERT_TRUE(logFile.BuildSummary(1s));
+  EXPECT_EQ(1s, logFile.SummaryBucketSize());
+
+  std::vector<log::SummaryBucket> summary = logFile.Summary();
+  ASSERT_EQ(4u, summary.size());
+
+  EXPECT_EQ("/foo", summary[0].topic);
+  EXPECT_EQ("some.message.type", summary[0].type);
+  EXPECT_EQ(0s, summary[0].start);
+  EXPECT_EQ(0s, summary[0].firstTime);
+  EXPECT_EQ(10u, summary[0].count);
+  EXPECT_EQ(10u * data.size(), summary[0].bytes);
+
+  EXPECT_EQ("/bar", summary[1].topic);
+  EXPECT_EQ(1s, summary[1].start);
+  EXPECT_EQ(1500ms, summary[1].firstTime);
+  EXPECT_EQ(1u, summary[1].count);
+
+  EXPECT_EQ("/foo", summary[2].topic);
+  EXPECT_EQ(1s, summary[2].start);
+  EXPECT_EQ(1s, summary[2].firstTime);
+  EXPECT_EQ(10u, summary[2].count);
+
+  EXPECT_EQ("/bar", summary[3].topic);
+  EXPECT_EQ(10s, summary[3].start);
+  EXPECT_EQ(10200ms, summary[3].firstTime);
+
+  summary = logFile.Summary("/bar");
+  ASSERT_EQ(2u, summary.size());
+  EXPECT_EQ(1s, summary[0].start);
+  EXPECT_EQ(10s, summary[1].start);
+  EXPECT_TRUE(logFile.Summary("/baz").empty());
+
+  // Jump within a bucket and across buckets
+  EXPECT_EQ(std::make_optional<std::chrono::nanoseconds>(1500ms),
+      logFile.NextMessageTime("/bar", 0ns));
+  EXPECT_EQ(std::make_optional<std::chrono::nanoseconds>(10200ms),
+      logFile.NextMessageTime("/bar", 1500ms));
+  EXPECT_EQ(std::make_optional<std::chrono::nanoseconds>(1900ms),
+      logFile.NextMessageTime("/foo", 1850ms));
+  EXPECT_FALSE(logFile.NextMessageTime("/foo", 1900ms));
+  EXPECT_FALSE(logFile.NextMessageTime("/bar", 10200ms));
+  EXPECT_FALSE(logFile.NextMessageTime("/baz", 0ns));
+
+  // Messages inserted after the summary are still found
+  insert(5s, "/foo");
+  EXPECT_EQ(std::make_optional<std::chrono::nanoseconds>(5s),
+      logFile.NextMessageTime("/foo", 1900ms));
+  EXPECT_EQ(4u, logFile.Summary().size());
+
+  // Rebuilding replaces the summary
+  ASSERT_TRUE(logFile.BuildSummary(1min));
+  EXPECT_EQ(1min, logFile.SummaryBucketSize());
+  summary = logFile.Summary("/foo");
+  ASSERT_EQ(1u, summary.size());
+  EXPECT_EQ(21u, summary[0].count);
+}
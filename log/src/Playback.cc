@@ -17,15 +17,19 @@
 
 #include <sqlite3.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <gz/transport/Node.hh>
 #include <gz/transport/log/Log.hh>
@@ -43,6 +47,131 @@ using namespace gz::transport::log;
 // See: https://www.sqlite.org/threadsafe.html
 static const bool kSqlite3Threadsafe = (sqlite3_threadsafe() != 0);
 
+//////////////////////////////////////////////////
+/// \brief A worker thread that publishes the messages of a group of topics
+/// in the same order in which they were scheduled.
+class PublishWorker
+{
+  /// \brief A message waiting to be published.
+  private: struct Pending
+  {
+    /// \brief Publisher used to send the message.
+    Node::Publisher *publisher;
+
+    /// \brief Serialized message.
+    std::string data;
+
+    /// \brief Message type name.
+    std::string type;
+  };
+
+  /// \brief Constructor. Starts the worker thread.
+  public: PublishWorker()
+  {
+    this->thread = std::thread(&PublishWorker::Run, this);
+  }
+
+  /// \brief Destructor. Discards pending messages and joins the thread.
+  public: ~PublishWorker()
+  {
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      this->stop = true;
+      this->queue.clear();
+    }
+    this->queueCondition.notify_all();
+
+    if (this->thread.joinable())
+      this->thread.join();
+  }
+
+  /// \brief Queue a message for publication.
+  /// \param[in] _publisher Publisher used to send the message. It must
+  /// outlive this worker.
+  /// \param[in] _data Serialized message.
+  /// \param[in] _type Message type name.
+  public: void Push(Node::Publisher *_publisher,
+                    std::string &&_data,
+                    std::string &&_type)
+  {
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      this->queue.push_back({_publisher, std::move(_data), std::move(_type)});
+    }
+    this->queueCondition.notify_one();
+  }
+
+  /// \brief Discard all the messages that are still waiting to be published.
+  public: void Clear()
+  {
+    std::lock_guard<std::mutex> lk(this->mutex);
+    this->queue.clear();
+    this->idleCondition.notify_all();
+  }
+
+  /// \brief Block until every queued message has been published.
+  public: void WaitUntilIdle()
+  {
+    std::unique_lock<std::mutex> lk(this->mutex);
+    this->idleCondition.wait(lk, [this]
+    {
+      return this->stop || (this->queue.empty() && !this->busy);
+    });
+  }
+
+  /// \brief Thread body. Publishes queued messages in FIFO order.
+  private: void Run()
+  {
+    std::unique_lock<std::mutex> lk(this->mutex);
+    while (true)
+    {
+      this->queueCondition.wait(lk, [this]
+      {
+        return this->stop || !this->queue.empty();
+      });
+
+      if (this->stop)
+        break;
+
+      Pending pending = std::move(this->queue.front());
+      this->queue.pop_front();
+      this->busy = true;
+
+      // Publish without holding the lock, so the scheduler is never blocked
+      // by a slow publication.
+      lk.unlock();
+      pending.publisher->PublishRaw(pending.data, pending.type);
+      lk.lock();
+
+      this->busy = false;
+      if (this->queue.empty())
+        this->idleCondition.notify_all();
+    }
+    this->idleCondition.notify_all();
+  }
+
+  /// \brief Protects the queue and the flags.
+  private: std::mutex mutex;
+
+  /// \brief Wakes up the worker when a message is queued or on stop.
+  private: std::condition_variable queueCondition;
+
+  /// \brief Wakes up threads waiting for the queue to be drained.
+  private: std::condition_variable idleCondition;
+
+  /// \brief Messages waiting to be published.
+  private: std::deque<Pending> queue;
+
+  /// \brief True while a message is being published.
+  private: bool busy = false;
+
+  /// \brief True when the worker should exit.
+  private: bool stop = false;
+
+  /// \brief The worker thread.
+  private: std::thread thread;
+};
+
 //////////////////////////////////////////////////
 /// \brief Private implementation of Playback
 class gz::transport::log::Playback::Implementation
@@ -97,6 +226,17 @@ class gz::transport::log::Playback::Implementation
 
   /// \brief The node options.
   public: NodeOptions nodeOptions;
+
+  /// \brief Number of worker threads used to publish messages.
+  public: std::size_t publishThreads = 0;
+
+  /// \brief True to sleep and then spin until the time of each message.
+  public: bool preciseTiming = false;
+
+  /// \brief Time before each publication at which the playback thread starts
+  /// spinning when preciseTiming is enabled.
+  public: std::chrono::nanoseconds spinThreshold =
+    std::chrono::microseconds(500);
 };
 
 //////////////////////////////////////////////////
@@ -111,12 +251,21 @@ class PlaybackHandle::Implementation
   /// \param[in] _msgWaiting True to wait between publication of
   /// messages based on the message timestamps. False to playback
   /// messages as fast as possible. Default value is true.
+  /// \param[in] _publishThreads Number of worker threads used to publish
+  /// messages. 0 to publish from the playback thread.
+  /// \param[in] _preciseTiming True to sleep and then spin until the time of
+  /// each message.
+  /// \param[in] _spinThreshold Time before each publication at which the
+  /// playback thread starts spinning in precise timing mode.
   public: Implementation(
       const std::shared_ptr<Log> &_logFile,
       const std::unordered_set<std::string> &_topics,
       const std::chrono::nanoseconds &_waitAfterAdvertising,
       const NodeOptions &_nodeOptions,
-      bool _msgWaiting);
+      bool _msgWaiting,
+      std::size_t _publishThreads,
+      bool _preciseTiming,
+      const std::chrono::nanoseconds &_spinThreshold);
 
   /// \brief Look through the types of data that _topic can publish and create
   /// a publisher for each type.
@@ -133,6 +282,14 @@ class PlaybackHandle::Implementation
   /// \brief Begin playing messages in another thread
   public: void StartPlayback();
 
+  /// \brief Publish the message currently pointed by messageIter, either
+  /// directly or through the worker that owns its topic.
+  /// \pre batchMutex is locked.
+  public: void PublishCurrentMessage();
+
+  /// \brief Block until the workers have published every queued message.
+  public: void WaitForWorkers();
+
   /// \brief Stop the playback
   public: void Stop();
 
@@ -152,6 +309,19 @@ class PlaybackHandle::Implementation
   /// stop event interrupt it
   public: bool WaitUntil(const std::chrono::nanoseconds &_targetTime);
 
+  /// \brief Puts the calling thread to sleep until a given time is achieved,
+  /// relying on the OS scheduler to wake it up.
+  /// \param[in] _targetTime Time at which the wait must finish. Measured in
+  /// POSIX time (time since epoch) in nanoseconds
+  /// \return True if the wait ends successfully or false if a pause or
+  /// stop event interrupt it
+  public: bool SleepUntil(const std::chrono::nanoseconds &_targetTime);
+
+  /// \brief Record the delay between the scheduled and the actual
+  /// publication time of a message.
+  /// \param[in] _targetTime Time at which the message was scheduled.
+  public: void UpdateTimingError(const std::chrono::nanoseconds &_targetTime);
+
   /// \brief Pauses the playback
   public: void Pause();
 
@@ -249,6 +419,28 @@ class PlaybackHandle::Implementation
   /// messages based on the message timestamps. False to playback
   /// messages as fast as possible.
   public: bool msgWaiting = true;
+
+  /// \brief Index of the worker in charge of each topic.
+  public: std::unordered_map<std::string, std::size_t> topicWorkers;
+
+  /// \brief True to sleep and then spin until the time of each message.
+  public: bool preciseTiming = false;
+
+  /// \brief Time before each publication at which the playback thread starts
+  /// spinning when preciseTiming is enabled.
+  public: std::chrono::nanoseconds spinThreshold;
+
+  /// \brief Statistics of the publication timing error, in microseconds.
+  public: Statistics timingError;
+
+  /// \brief Protects timingError.
+  public: mutable std::mutex timingErrorMutex;
+
+  /// \brief Worker threads publishing messages. Empty when the playback
+  /// thread publishes the messages itself.
+  /// \note This member needs to come after the publishers member so that the
+  /// workers are destructed before the publishers they use.
+  public: std::vector<std::unique_ptr<PublishWorker>> workers;
 };
 
 //////////////////////////////////////////////////
@@ -313,7 +505,9 @@ PlaybackHandlePtr Playback::Start(
         new PlaybackHandle(
           std::make_unique<PlaybackHandle::Implementation>(
             this->dataPtr->logFile, topics, _waitAfterAdvertising,
-            this->dataPtr->nodeOptions, _msgWaiting)));
+            this->dataPtr->nodeOptions, _msgWaiting,
+            this->dataPtr->publishThreads, this->dataPtr->preciseTiming,
+            this->dataPtr->spinThreshold)));
 
   // We only need to store this if sqlite3 was not compiled in threadsafe mode.
   if (!kSqlite3Threadsafe)
@@ -328,6 +522,44 @@ bool Playback::Valid() const
   return this->dataPtr->logFile->Valid();
 }
 
+//////////////////////////////////////////////////
+void Playback::SetPublishThreads(std::size_t _threads)
+{
+  this->dataPtr->publishThreads = _threads;
+}
+
+//////////////////////////////////////////////////
+std::size_t Playback::PublishThreads() const
+{
+  return this->dataPtr->publishThreads;
+}
+
+//////////////////////////////////////////////////
+void Playback::SetPreciseTiming(bool _precise,
+    const std::chrono::nanoseconds &_spinThreshold)
+{
+  this->dataPtr->preciseTiming = _precise;
+  this->dataPtr->spinThreshold = _spinThreshold;
+}
+
+//////////////////////////////////////////////////
+void Playback::SetPreciseTiming(bool _precise)
+{
+  this->dataPtr->preciseTiming = _precise;
+}
+
+//////////////////////////////////////////////////
+bool Playback::PreciseTiming() const
+{
+  return this->dataPtr->preciseTiming;
+}
+
+//////////////////////////////////////////////////
+std::chrono::nanoseconds Playback::SpinThreshold() const
+{
+  return this->dataPtr->spinThreshold;
+}
+
 //////////////////////////////////////////////////
 bool Playback::AddTopic(const std::string &_topic)
 {
@@ -426,7 +658,10 @@ PlaybackHandle::Implementation::Implementation(
     const std::unordered_set<std::string> &_topics,
     const std::chrono::nanoseconds &_waitAfterAdvertising,
     const NodeOptions &_nodeOptions,
-    bool _msgWaiting)
+    bool _msgWaiting,
+    std::size_t _publishThreads,
+    bool _preciseTiming,
+    const std::chrono::nanoseconds &_spinThreshold)
   : stop(true),
     finished(false),
     paused(false),
@@ -435,7 +670,9 @@ PlaybackHandle::Implementation::Implementation(
     batch(logFile->QueryMessages(TopicList::Create(_topics))),
     messageIter(batch.begin()),
     firstMessageTime(messageIter->TimeReceived()),
-    msgWaiting(_msgWaiting)
+    msgWaiting(_msgWaiting),
+    preciseTiming(_preciseTiming),
+    spinThreshold(_spinThreshold)
 {
   this->node.reset(new transport::Node(_nodeOptions));
 
@@ -444,7 +681,37 @@ PlaybackHandle::Implementation::Implementation(
     this->AddTopic(topic);
   }
 
-  std::this_thread::sleep_for(_waitAfterAdvertising);
+  // Never spawn more workers than topics, they would stay idle.
+  const std::size_t numWorkers = std::min(_publishThreads, _topics.size());
+  for (std::size_t i = 0; i < numWorkers; ++i)
+    this->workers.push_back(std::make_unique<PublishWorker>());
+
+  // Distribute the topics among the workers in a round-robin fashion.
+  if (!this->workers.empty())
+  {
+    std::size_t next = 0;
+    for (const std::string &topic : _topics)
+    {
+      this->topicWorkers[topic] = next;
+      next = (next + 1) % this->workers.size();
+    }
+  }
+
+  // Give the subscribers time to connect, but stop waiting as soon as every
+  // topic has one.
+  const auto deadline =
+    std::chrono::steady_clock::now() + _waitAfterAdvertising;
+  for (const auto &topicPubs : this->publishers)
+  {
+    for (const auto &typePub : topicPubs.second)
+    {
+      const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0)
+        break;
+      typePub.second.WaitForSubscribers(1u, remaining);
+    }
+  }
 
   if (this->batch.begin() == this->batch.end())
   {
@@ -551,18 +818,17 @@ void PlaybackHandle::Implementation::StartPlayback()
               this->lastEventTime + timeDelta);
           // Wait until target time is reached or playback is stopped/paused
           // In the latter case, break the iteration step
-          if (this->msgWaiting && !this->WaitUntil(timeToWaitUntil))
+          if (this->msgWaiting)
           {
-            continue;
+            if (!this->WaitUntil(timeToWaitUntil))
+              continue;
+            this->UpdateTimingError(timeToWaitUntil);
           }
           // Publish the message
           {
           std::unique_lock<std::mutex> lk(this->batchMutex);
           LDBG("publishing\n");
-          this->publishers[
-            this->messageIter->Topic()][
-              this->messageIter->Type()].PublishRaw(
-                this->messageIter->Data(), this->messageIter->Type());
+          this->PublishCurrentMessage();
           // Advance iterator to next message
           ++this->messageIter;
           this->playbackTime = this->nextMessageTime;
@@ -591,14 +857,76 @@ void PlaybackHandle::Implementation::StartPlayback()
           this->Pause();
         }
       }
+      this->WaitForWorkers();
       this->finished = true;
       this->waitConditionVariable.notify_all();
   });
 }
 
+//////////////////////////////////////////////////
+void PlaybackHandle::Implementation::PublishCurrentMessage()
+{
+  std::string topic = this->messageIter->Topic();
+  std::string type = this->messageIter->Type();
+  Node::Publisher &publisher = this->publishers[topic][type];
+
+  if (this->workers.empty())
+  {
+    publisher.PublishRaw(this->messageIter->Data(), type);
+    return;
+  }
+
+  this->workers[this->topicWorkers[topic]]->Push(
+      &publisher, this->messageIter->Data(), std::move(type));
+}
+
+//////////////////////////////////////////////////
+void PlaybackHandle::Implementation::WaitForWorkers()
+{
+  for (auto &worker : this->workers)
+  {
+    if (this->stop)
+      return;
+    worker->WaitUntilIdle();
+  }
+}
+
 //////////////////////////////////////////////////
 bool PlaybackHandle::Implementation::WaitUntil(
     const std::chrono::nanoseconds &_targetTime)
+{
+  if (!this->preciseTiming)
+    return this->SleepUntil(_targetTime);
+
+  // Sleep until we are close to the target time. The OS scheduler might wake
+  // us up late, so we leave a safety margin of spinThreshold.
+  if (!this->SleepUntil(_targetTime - this->spinThreshold))
+    return false;
+
+  // Busy-wait for the remaining time.
+  while (std::chrono::steady_clock::now().time_since_epoch() < _targetTime)
+  {
+    if (this->stop || this->paused)
+      return false;
+  }
+
+  return !this->stop && !this->paused;
+}
+
+//////////////////////////////////////////////////
+void PlaybackHandle::Implementation::UpdateTimingError(
+    const std::chrono::nanoseconds &_targetTime)
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  const std::chrono::duration<double, std::micro> error = now - _targetTime;
+
+  std::lock_guard<std::mutex> lk(this->timingErrorMutex);
+  this->timingError.Update(error.count());
+}
+
+//////////////////////////////////////////////////
+bool PlaybackHandle::Implementation::SleepUntil(
+    const std::chrono::nanoseconds &_targetTime)
 {
   const auto waitStartTime =
     std::chrono::steady_clock::now().time_since_epoch();
@@ -664,6 +992,10 @@ void PlaybackHandle::Implementation::Seek(
     this->batch = this->logFile->QueryMessages(
         TopicList::Create(this->trackedTopics, timeRange));
     this->messageIter = this->batch.begin();
+
+    // Messages scheduled before the seek are no longer relevant.
+    for (auto &worker : this->workers)
+      worker->Clear();
   }
   this->playbackTime = this->messageIter->TimeReceived();
   this->nextMessageTime = this->messageIter->TimeReceived();
@@ -689,6 +1021,11 @@ void PlaybackHandle::Implementation::Stop()
     this->paused = false;
   }
 
+  // Drop the pending publications, so the playback thread does not wait for
+  // them to be published before exiting.
+  for (auto &worker : this->workers)
+    worker->Clear();
+
   if (this->playbackThread.joinable())
     this->playbackThread.join();
 }
@@ -803,6 +1140,13 @@ std::chrono::nanoseconds PlaybackHandle::EndTime() const
   return this->dataPtr->playbackEndTime;
 }
 
+//////////////////////////////////////////////////
+Statistics PlaybackHandle::TimingError() const
+{
+  std::lock_guard<std::mutex> lk(this->dataPtr->timingErrorMutex);
+  return this->dataPtr->timingError;
+}
+
 //////////////////////////////////////////////////
 PlaybackHandle::PlaybackHandle(
   std::unique_ptr<Implementation> &&_internal) // NOLINT
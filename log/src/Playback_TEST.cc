@@ -30,3 +30,35 @@ TEST(Playback, PlaybackEmptyDatabase)
   EXPECT_EQ(-1, playback.AddTopic(std::regex(".*")));
   EXPECT_EQ(nullptr, playback.Start());
 }
+
+//////////////////////////////////////////////////
+TEST(Playback, PublishThreads)
+{
+  log::Playback playback(":memory:");
+  EXPECT_EQ(0u, playback.PublishThreads());
+
+  playback.SetPublishThreads(4);
+  EXPECT_EQ(4u, playback.PublishThreads());
+
+  playback.SetPublishThreads(0);
+  EXPECT_EQ(0u, playback.PublishThreads());
+}
+
+//////////////////////////////////////////////////
+TEST(Playback, PreciseTiming)
+{
+  log::Playback playback(":memory:");
+  EXPECT_FALSE(playback.PreciseTiming());
+
+  playback.SetPreciseTiming(true, std::chrono::microseconds(200));
+  EXPECT_TRUE(playback.PreciseTiming());
+  EXPECT_EQ(std::chrono::microseconds(200), playback.SpinThreshold());
+
+  // Disabling and enabling the mode keeps the threshold.
+  playback.SetPreciseTiming(false);
+  EXPECT_FALSE(playback.PreciseTiming());
+  EXPECT_EQ(std::chrono::microseconds(200), playback.SpinThreshold());
+  playback.SetPreciseTiming(true);
+  EXPECT_TRUE(playback.PreciseTiming());
+  EXPECT_EQ(std::chrono::microseconds(200), playback.SpinThreshold());
+}
@@ -112,6 +112,13 @@ class gz::transport::log::Recorder::Implementation
   /// \brief log file or nullptr if not recording
   public: std::unique_ptr<Log> logFile;
 
+  /// \brief Settings used when writing the log file
+  public: log::WriteProfile writeProfile;
+
+  /// \brief Bucket size of the summary built when the recording stops.
+  /// Zero to not build a summary.
+  public: std::chrono::nanoseconds summaryBucketSize{0};
+
   /// \brief A set of topic patterns that we want to subscribe to
   public: std::vector<std::regex> patterns;
 
@@ -477,6 +484,7 @@ RecorderError Recorder::Start(const std::string &_file)
   }
 
   this->dataPtr->logFile.reset(new Log());
+  this->dataPtr->logFile->SetWriteProfile(this->dataPtr->writeProfile);
   if (!this->dataPtr->logFile->Open(_file, std::ios_base::out))
   {
     LERR("Failed to open or create file [" << _file << "]\n");
@@ -504,9 +512,12 @@ void Recorder::Stop()
   // If there is any data left in the dataQueue, write it all to disk
   LMSG("Log Recorder finalizing log file. This might take some time...");
   this->dataPtr->FlushDataQueue();
-  LMSG("Done\n");
 
   std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  if (this->dataPtr->summaryBucketSize > std::chrono::nanoseconds::zero())
+    this->dataPtr->logFile->BuildSummary(this->dataPtr->summaryBucketSize);
+  LMSG("Done\n");
+
   this->dataPtr->logFile.reset(nullptr);
 }
 
@@ -548,3 +559,37 @@ void Recorder::SetBufferSize(std::size_t _size)
   // Shift by 20 to convert to bytes
   this->dataPtr->maxBufferSize = _size << 20;
 }
+
+//////////////////////////////////////////////////
+RecorderError Recorder::SetWriteProfile(const log::WriteProfile &_profile)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  if (this->dataPtr->logFile)
+  {
+    LERR("Recording is already in progress\n");
+    return RecorderError::ALREADY_RECORDING;
+  }
+  this->dataPtr->writeProfile = _profile;
+  return RecorderError::SUCCESS;
+}
+
+//////////////////////////////////////////////////
+const log::WriteProfile &Recorder::WriteProfile() const
+{
+  return this->dataPtr->writeProfile;
+}
+
+//////////////////////////////////////////////////
+void Recorder::SetSummaryBucketSize(
+    const std::chrono::nanoseconds &_bucketSize)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  this->dataPtr->summaryBucketSize = _bucketSize;
+}
+
+//////////////////////////////////////////////////
+std::chrono::nanoseconds Recorder::SummaryBucketSize() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->logFileMutex);
+  return this->dataPtr->summaryBucketSize;
+}
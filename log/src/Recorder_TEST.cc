@@ -15,6 +15,7 @@
  *
 */
 
+#include <chrono>
 #include <regex>
 #include <string>
 
@@ -102,3 +103,41 @@ TEST(Record, SetBufferSize)
   recorder.SetBufferSize(40);
   EXPECT_EQ(40u, recorder.BufferSize());
 }
+
+//////////////////////////////////////////////////
+TEST(Record, SetWriteProfile)
+{
+  transport::log::Recorder recorder;
+  EXPECT_EQ(transport::log::RecorderError::SUCCESS,
+      recorder.SetWriteProfile(transport::log::WriteProfile::Fastest()));
+  EXPECT_EQ(transport::log::SynchronousMode::OFF,
+      recorder.WriteProfile().SynchronousMode());
+
+  EXPECT_EQ(
+      transport::log::RecorderError::SUCCESS, recorder.Start(":memory:"));
+  EXPECT_EQ(transport::log::RecorderError::ALREADY_RECORDING,
+      recorder.SetWriteProfile(transport::log::WriteProfile::Safe()));
+  recorder.Stop();
+
+  EXPECT_EQ(transport::log::RecorderError::SUCCESS,
+      recorder.SetWriteProfile(transport::log::WriteProfile::Safe()));
+  EXPECT_EQ(transport::log::SynchronousMode::DEFAULT,
+      recorder.WriteProfile().SynchronousMode());
+}
+
+//////////////////////////////////////////////////
+TEST(Record, SummaryBucketSize)
+{
+  using namespace std::chrono_literals;
+
+  transport::log::Recorder recorder;
+  EXPECT_EQ(0ns, recorder.SummaryBucketSize());
+
+  recorder.SetSummaryBucketSize(1s);
+  EXPECT_EQ(1s, recorder.SummaryBucketSize());
+
+  EXPECT_EQ(
+      transport::log::RecorderError::SUCCESS, recorder.Start(":memory:"));
+  recorder.Stop();
+  EXPECT_EQ(1s, recorder.SummaryBucketSize());
+}
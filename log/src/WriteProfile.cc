@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+
+#include "gz/transport/log/WriteProfile.hh"
+
+using namespace gz::transport;
+using namespace gz::transport::log;
+
+/// \brief Private implementation
+class gz::transport::log::WriteProfilePrivate
+{
+  /// \brief Journal mode.
+  public: log::JournalMode journalMode = log::JournalMode::DEFAULT;
+
+  /// \brief Synchronous mode.
+  public: log::SynchronousMode synchronousMode =
+    log::SynchronousMode::DEFAULT;
+
+  /// \brief Page size in bytes. 0 for the SQLite default.
+  public: std::size_t pageSize = 0;
+
+  /// \brief Page cache size in KiB. 0 for the SQLite default.
+  public: std::size_t cacheSize = 0;
+
+  /// \brief Memory map size in bytes. 0 to disable memory mapping.
+  public: std::size_t mmapSize = 0;
+
+  /// \brief Time between commits. Default to 2 transactions per second.
+  public: std::chrono::milliseconds transactionPeriod{500};
+};
+
+//////////////////////////////////////////////////
+WriteProfile::WriteProfile()
+  : dataPtr(new WriteProfilePrivate)
+{
+}
+
+//////////////////////////////////////////////////
+WriteProfile::WriteProfile(const WriteProfile &_other)
+  : dataPtr(new WriteProfilePrivate)
+{
+  (*this) = _other;
+}
+
+//////////////////////////////////////////////////
+WriteProfile::~WriteProfile()
+{
+}
+
+//////////////////////////////////////////////////
+WriteProfile &WriteProfile::operator=(const WriteProfile &_other)
+{
+  *(this->dataPtr) = *(_other.dataPtr);
+  return *this;
+}
+
+//////////////////////////////////////////////////
+WriteProfile WriteProfile::Safe()
+{
+  return WriteProfile();
+}
+
+//////////////////////////////////////////////////
+WriteProfile WriteProfile::Fast()
+{
+  WriteProfile profile;
+  profile.SetJournalMode(log::JournalMode::WAL);
+  profile.SetSynchronousMode(log::SynchronousMode::NORMAL);
+  profile.SetCacheSize(64 * 1024);
+  profile.SetMmapSize(256u << 20);
+  profile.SetTransactionPeriod(std::chrono::seconds(1));
+  return profile;
+}
+
+//////////////////////////////////////////////////
+WriteProfile WriteProfile::Fastest()
+{
+  WriteProfile profile;
+  profile.SetJournalMode(log::JournalMode::MEMORY);
+  profile.SetSynchronousMode(log::SynchronousMode::OFF);
+  profile.SetCacheSize(64 * 1024);
+  profile.SetTransactionPeriod(std::chrono::seconds(5));
+  return profile;
+}
+
+//////////////////////////////////////////////////
+log::JournalMode WriteProfile::JournalMode() const
+{
+  return this->dataPtr->journalMode;
+}
+
+//////////////////////////////////////////////////
+void WriteProfile::SetJournalMode(log::JournalMode _mode)
+{
+  this->dataPtr->journalMode = _mode;
+}
+
+//////////////////////////////////////////////////
+log::SynchronousMode WriteProfile::SynchronousMode() const
+{
+  return this->dataPtr->synchronousMode;
+}
+
+//////////////////////////////////////////////////
+void WriteProfile::SetSynchronousMode(log::SynchronousMode _mode)
+{
+  this->dataPtr->synchronousMode = _mode;
+}
+
+//////////////////////////////////////////////////
+std::size_t WriteProfile::PageSize() const
+{
+  return this->dataPtr->pageSize;
+}
+
+//////////////////////////////////////////////////
+bool WriteProfile::SetPageSize(std::size_t _size)
+{
+  // Must be 0 or a power of two between 512 and 65536
+  const bool isPowerOfTwo = (_size & (_size - 1)) == 0;
+  if (_size != 0 && (!isPowerOfTwo || _size < 512 || _size > 65536))
+    return false;
+
+  this->dataPtr->pageSize = _size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t WriteProfile::CacheSize() const
+{
+  return this->dataPtr->cacheSize;
+}
+
+//////////////////////////////////////////////////
+void WriteProfile::SetCacheSize(std::size_t _size)
+{
+  this->dataPtr->cacheSize = _size;
+}
+
+//////////////////////////////////////////////////
+std::size_t WriteProfile::MmapSize() const
+{
+  return this->dataPtr->mmapSize;
+}
+
+//////////////////////////////////////////////////
+void WriteProfile::SetMmapSize(std::size_t _size)
+{
+  this->dataPtr->mmapSize = _size;
+}
+
+//////////////////////////////////////////////////
+std::chrono::milliseconds WriteProfile::TransactionPeriod() const
+{
+  return this->dataPtr->transactionPeriod;
+}
+
+//////////////////////////////////////////////////
+void WriteProfile::SetTransactionPeriod(
+    const std::chrono::milliseconds &_period)
+{
+  this->dataPtr->transactionPeriod = _period;
+}
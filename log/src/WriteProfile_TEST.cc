@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+
+#include "gz/transport/log/WriteProfile.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace gz::transport;
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////
+TEST(WriteProfile, Defaults)
+{
+  log::WriteProfile profile;
+  EXPECT_EQ(log::JournalMode::DEFAULT, profile.JournalMode());
+  EXPECT_EQ(log::SynchronousMode::DEFAULT, profile.SynchronousMode());
+  EXPECT_EQ(0u, profile.PageSize());
+  EXPECT_EQ(0u, profile.CacheSize());
+  EXPECT_EQ(0u, profile.MmapSize());
+  EXPECT_EQ(500ms, profile.TransactionPeriod());
+
+  log::WriteProfile safe = log::WriteProfile::Safe();
+  EXPECT_EQ(profile.JournalMode(), safe.JournalMode());
+  EXPECT_EQ(profile.SynchronousMode(), safe.SynchronousMode());
+  EXPECT_EQ(profile.TransactionPeriod(), safe.TransactionPeriod());
+}
+
+//////////////////////////////////////////////////
+TEST(WriteProfile, Presets)
+{
+  log::WriteProfile fast = log::WriteProfile::Fast();
+  EXPECT_EQ(log::JournalMode::WAL, fast.JournalMode());
+  EXPECT_EQ(log::SynchronousMode::NORMAL, fast.SynchronousMode());
+  EXPECT_GT(fast.CacheSize(), 0u);
+  EXPECT_GT(fast.MmapSize(), 0u);
+  EXPECT_GT(fast.TransactionPeriod(), 500ms);
+
+  log::WriteProfile fastest = log::WriteProfile::Fastest();
+  EXPECT_EQ(log::JournalMode::MEMORY, fastest.JournalMode());
+  EXPECT_EQ(log::SynchronousMode::OFF, fastest.SynchronousMode());
+  EXPECT_GT(fastest.TransactionPeriod(), fast.TransactionPeriod());
+}
+
+//////////////////////////////////////////////////
+TEST(WriteProfile, CopyAndAssign)
+{
+  log::WriteProfile profile;
+  profile.SetJournalMode(log::JournalMode::PERSIST);
+  profile.SetSynchronousMode(log::SynchronousMode::EXTRA);
+  profile.SetCacheSize(1024);
+  profile.SetMmapSize(4096);
+  profile.SetTransactionPeriod(2s);
+
+  log::WriteProfile copy(profile);
+  EXPECT_EQ(log::JournalMode::PERSIST, copy.JournalMode());
+  EXPECT_EQ(log::SynchronousMode::EXTRA, copy.SynchronousMode());
+  EXPECT_EQ(1024u, copy.CacheSize());
+  EXPECT_EQ(4096u, copy.MmapSize());
+  EXPECT_EQ(2s, copy.TransactionPeriod());
+
+  // The copy must not share state with the original
+  copy.SetJournalMode(log::JournalMode::OFF);
+  EXPECT_EQ(log::JournalMode::PERSIST, profile.JournalMode());
+
+  log::WriteProfile assigned;
+  assigned = copy;
+  EXPECT_EQ(log::JournalMode::OFF, assigned.JournalMode());
+  EXPECT_EQ(2s, assigned.TransactionPeriod());
+}
+
+//////////////////////////////////////////////////
+TEST(WriteProfile, PageSize)
+{
+  log::WriteProfile profile;
+  EXPECT_TRUE(profile.SetPageSize(512));
+  EXPECT_EQ(512u, profile.PageSize());
+  EXPECT_TRUE(profile.SetPageSize(65536));
+  EXPECT_EQ(65536u, profile.PageSize());
+
+  EXPECT_FALSE(profile.SetPageSize(256));
+  EXPECT_FALSE(profile.SetPageSize(131072));
+  EXPECT_FALSE(profile.SetPageSize(5000));
+  EXPECT_EQ(65536u, profile.PageSize());
+
+  EXPECT_TRUE(profile.SetPageSize(0));
+  EXPECT_EQ(0u, profile.PageSize());
+}
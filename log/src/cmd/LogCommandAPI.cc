@@ -17,13 +17,26 @@
 
 #include "LogCommandAPI.hh"
 
+#include <chrono>
+#include <condition_variable>
 #include <csignal>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gz/msgs/Factory.hh>
 
 #include <gz/transport/log/Export.hh>
+#include <gz/transport/log/Log.hh>
 #include <gz/transport/log/Playback.hh>
+#include <gz/transport/log/QueryOptions.hh>
 #include <gz/transport/log/Recorder.hh>
 #include <gz/transport/Node.hh>
 #include <gz/transport/NodeOptions.hh>
@@ -137,3 +150,423 @@ int playbackTopics(const char *_file, const char *_pattern, const int _wait_ms,
   LDBG("Shutting down\n");
   return SUCCESS;
 }
+
+//////////////////////////////////////////////////
+/// \brief A message read from a log. Unlike log::Message, it owns its data,
+/// so it can be handed over to another thread.
+struct LoggedMessage
+{
+  /// \brief Time the message was received.
+  std::chrono::nanoseconds time;
+
+  /// \brief Topic name.
+  std::string topic;
+
+  /// \brief Message type name.
+  std::string type;
+
+  /// \brief Serialized message.
+  std::string data;
+};
+
+//////////////////////////////////////////////////
+/// \brief Streams the messages of a log from a background thread, so reading
+/// the input overlaps with processing or writing the output. Messages are
+/// handed over in chunks through a bounded queue, which keeps the memory
+/// usage constant regardless of the size of the log.
+class LogReader
+{
+  /// \brief Number of messages per chunk.
+  private: static constexpr std::size_t kChunkSize = 256;
+
+  /// \brief Maximum number of chunks waiting to be consumed.
+  private: static constexpr std::size_t kMaxChunks = 16;
+
+  /// \brief Constructor.
+  /// \param[in] _file Path to the log file to read.
+  public: explicit LogReader(const std::string &_file)
+  {
+    this->valid = this->log.Open(_file, std::ios_base::in);
+  }
+
+  /// \brief Destructor. Stops the reading thread.
+  public: ~LogReader()
+  {
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      this->stop = true;
+    }
+    this->condition.notify_all();
+
+    if (this->thread.joinable())
+      this->thread.join();
+  }
+
+  /// \brief Whether the log was successfully opened.
+  /// \return True if the log is valid.
+  public: bool Valid() const
+  {
+    return this->valid;
+  }
+
+  /// \brief Get the log being read.
+  /// \return The log.
+  public: transport::log::Log &LogFile()
+  {
+    return this->log;
+  }
+
+  /// \brief Start reading the messages matching the query in the background.
+  /// \param[in] _options Messages to read.
+  public: void Start(const transport::log::QueryOptions &_options)
+  {
+    this->batch = this->log.QueryMessages(_options);
+    this->thread = std::thread(&LogReader::Run, this);
+  }
+
+  /// \brief Peek at the next message, blocking until it is available.
+  /// \return The next message, or nullptr if there are no more messages.
+  public: const LoggedMessage *Peek()
+  {
+    if (this->index >= this->current.size())
+    {
+      this->current.clear();
+      this->index = 0;
+
+      std::unique_lock<std::mutex> lk(this->mutex);
+      this->condition.wait(lk, [this]
+      {
+        return this->done || !this->chunks.empty();
+      });
+
+      if (this->chunks.empty())
+        return nullptr;
+
+      this->current = std::move(this->chunks.front());
+      this->chunks.pop_front();
+      lk.unlock();
+      this->condition.notify_all();
+    }
+
+    return &this->current[this->index];
+  }
+
+  /// \brief Move to the next message.
+  /// \pre Peek() returned a valid message.
+  public: void Pop()
+  {
+    ++this->index;
+  }
+
+  /// \brief Thread body. Reads the messages and queues them in chunks.
+  private: void Run()
+  {
+    std::vector<LoggedMessage> chunk;
+    chunk.reserve(kChunkSize);
+
+    for (const transport::log::Message &msg : this->batch)
+    {
+      chunk.push_back(
+        {msg.TimeReceived(), msg.Topic(), msg.Type(), msg.Data()});
+
+      if (chunk.size() < kChunkSize)
+        continue;
+
+      std::unique_lock<std::mutex> lk(this->mutex);
+      this->condition.wait(lk, [this]
+      {
+        return this->stop || this->chunks.size() < kMaxChunks;
+      });
+      if (this->stop)
+        return;
+
+      this->chunks.push_back(std::move(chunk));
+      lk.unlock();
+      this->condition.notify_all();
+
+      chunk = std::vector<LoggedMessage>();
+      chunk.reserve(kChunkSize);
+    }
+
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      if (!chunk.empty())
+        this->chunks.push_back(std::move(chunk));
+      this->done = true;
+    }
+    this->condition.notify_all();
+  }
+
+  /// \brief The log being read.
+  private: transport::log::Log log;
+
+  /// \brief True if the log was successfully opened.
+  private: bool valid = false;
+
+  /// \brief Messages being read.
+  private: transport::log::Batch batch;
+
+  /// \brief Protects chunks, done and stop.
+  private: std::mutex mutex;
+
+  /// \brief Signals changes in the queue of chunks.
+  private: std::condition_variable condition;
+
+  /// \brief Chunks read and waiting to be consumed.
+  private: std::deque<std::vector<LoggedMessage>> chunks;
+
+  /// \brief Chunk being consumed.
+  private: std::vector<LoggedMessage> current;
+
+  /// \brief Index of the next message in the current chunk.
+  private: std::size_t index = 0;
+
+  /// \brief True when the reading thread has read every message.
+  private: bool done = false;
+
+  /// \brief True when the reading thread should exit.
+  private: bool stop = false;
+
+  /// \brief The reading thread.
+  private: std::thread thread;
+};
+
+//////////////////////////////////////////////////
+/// \brief Build a query for the topics matching a pattern within a time
+/// window relative to the start of a log.
+/// \param[in] _log The log to query.
+/// \param[in] _pattern Pattern of the topics.
+/// \param[in] _start Beginning of the window, in seconds since the start of
+/// the log. Negative for no beginning.
+/// \param[in] _end End of the window, in seconds since the start of the log.
+/// Negative for no end.
+/// \return The query.
+static transport::log::TopicPattern TimeWindowQuery(
+    const transport::log::Log &_log, const std::regex &_pattern,
+    double _start, double _end)
+{
+  const std::chrono::nanoseconds logStart = _log.StartTime();
+  auto toLogTime = [&logStart](double _seconds)
+  {
+    return logStart + std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(_seconds));
+  };
+
+  transport::log::QualifiedTime begin;
+  if (_start >= 0)
+    begin = transport::log::QualifiedTime(toLogTime(_start));
+
+  transport::log::QualifiedTime end;
+  if (_end >= 0)
+    end = transport::log::QualifiedTime(toLogTime(_end));
+
+  return transport::log::TopicPattern(
+      _pattern, transport::log::QualifiedTimeRange(begin, end));
+}
+
+//////////////////////////////////////////////////
+/// \brief Compile a regular expression.
+/// \param[in] _pattern The ECMAScript regular expression.
+/// \param[out] _regex The compiled expression.
+/// \return True on success.
+static bool CompilePattern(const char *_pattern, std::regex &_regex)
+{
+  try
+  {
+    _regex = _pattern;
+  }
+  catch (const std::regex_error &e)
+  {
+    LERR("Regex pattern is invalid\n");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Insert a message into a log.
+/// \param[in] _log The log to write.
+/// \param[in] _msg The message.
+/// \return True on success.
+static bool WriteMessage(transport::log::Log &_log, const LoggedMessage &_msg)
+{
+  if (!_log.InsertMessage(_msg.time, _msg.topic, _msg.type,
+        _msg.data.data(), _msg.data.size()))
+  {
+    LERR("Failed to write message on [" << _msg.topic << "]\n");
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+int filterLog(const char *_input, const char *_output, const char *_pattern,
+  double _start, double _end)
+{
+  std::regex regexPattern;
+  if (!CompilePattern(_pattern, regexPattern))
+    return BAD_REGEX;
+
+  LogReader reader(_input);
+  if (!reader.Valid())
+    return FAILED_TO_OPEN;
+
+  transport::log::Log output;
+  if (!output.Open(_output, std::ios_base::out))
+    return FAILED_TO_OPEN;
+
+  reader.Start(
+      TimeWindowQuery(reader.LogFile(), regexPattern, _start, _end));
+
+  for (const LoggedMessage *msg = reader.Peek(); msg; msg = reader.Peek())
+  {
+    if (!WriteMessage(output, *msg))
+      return FAILED_TO_WRITE;
+    reader.Pop();
+  }
+
+  return SUCCESS;
+}
+
+//////////////////////////////////////////////////
+int splitLog(const char *_input, const char *_prefix, const char *_pattern,
+  double _duration)
+{
+  std::regex regexPattern;
+  if (!CompilePattern(_pattern, regexPattern))
+    return BAD_REGEX;
+
+  if (_duration <= 0)
+  {
+    LERR("The duration of each log must be positive\n");
+    return FAILED_TO_WRITE;
+  }
+
+  LogReader reader(_input);
+  if (!reader.Valid())
+    return FAILED_TO_OPEN;
+
+  const std::chrono::nanoseconds logStart = reader.LogFile().StartTime();
+  const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(_duration));
+
+  reader.Start(transport::log::TopicPattern(regexPattern));
+
+  std::unique_ptr<transport::log::Log> output;
+  int64_t outputIndex = -1;
+  for (const LoggedMessage *msg = reader.Peek(); msg; msg = reader.Peek())
+  {
+    const int64_t index = (msg->time - logStart) / duration;
+    if (index != outputIndex)
+    {
+      // Close the previous file before opening the next one
+      output.reset();
+      outputIndex = index;
+
+      const std::string file =
+        std::string(_prefix) + "_" + std::to_string(index) + ".tlog";
+      output = std::make_unique<transport::log::Log>();
+      if (!output->Open(file, std::ios_base::out))
+        return FAILED_TO_OPEN;
+      LDBG("Writing [" << file << "]\n");
+    }
+
+    if (!WriteMessage(*output, *msg))
+      return FAILED_TO_WRITE;
+    reader.Pop();
+  }
+
+  return SUCCESS;
+}
+
+//////////////////////////////////////////////////
+int mergeLogs(const char *_inputs, const char *_output, const char *_pattern)
+{
+  std::regex regexPattern;
+  if (!CompilePattern(_pattern, regexPattern))
+    return BAD_REGEX;
+
+  // Every input is read by its own thread
+  std::vector<std::unique_ptr<LogReader>> readers;
+  std::istringstream inputs(_inputs);
+  std::string file;
+  while (std::getline(inputs, file))
+  {
+    if (file.empty())
+      continue;
+
+    auto reader = std::make_unique<LogReader>(file);
+    if (!reader->Valid())
+      return FAILED_TO_OPEN;
+    readers.push_back(std::move(reader));
+  }
+
+  if (readers.empty())
+    return FAILED_TO_OPEN;
+
+  transport::log::Log output;
+  if (!output.Open(_output, std::ios_base::out))
+    return FAILED_TO_OPEN;
+
+  for (auto &reader : readers)
+    reader->Start(transport::log::TopicPattern(regexPattern));
+
+  // Interleave the inputs, always writing the oldest pending message
+  while (true)
+  {
+    LogReader *oldest = nullptr;
+    const LoggedMessage *oldestMsg = nullptr;
+    for (auto &reader : readers)
+    {
+      const LoggedMessage *msg = reader->Peek();
+      if (msg && (!oldestMsg || msg->time < oldestMsg->time))
+      {
+        oldest = reader.get();
+        oldestMsg = msg;
+      }
+    }
+
+    if (!oldest)
+      break;
+
+    if (!WriteMessage(output, *oldestMsg))
+      return FAILED_TO_WRITE;
+    oldest->Pop();
+  }
+
+  return SUCCESS;
+}
+
+//////////////////////////////////////////////////
+int catLog(const char *_input, const char *_pattern, double _start,
+  double _end)
+{
+  std::regex regexPattern;
+  if (!CompilePattern(_pattern, regexPattern))
+    return BAD_REGEX;
+
+  LogReader reader(_input);
+  if (!reader.Valid())
+    return FAILED_TO_OPEN;
+
+  reader.Start(
+      TimeWindowQuery(reader.LogFile(), regexPattern, _start, _end));
+
+  for (const LoggedMessage *msg = reader.Peek(); msg; msg = reader.Peek())
+  {
+    std::cout << "time: " << msg->time.count() << "\n"
+              << "topic: " << msg->topic << "\n"
+              << "type: " << msg->type << "\n"
+              << "size: " << msg->data.size() << "\n";
+
+    auto protoMsg = msgs::Factory::New(msg->type);
+    if (protoMsg && protoMsg->ParseFromString(msg->data))
+      std::cout << protoMsg->DebugString();
+    std::cout << "---" << std::endl;
+
+    reader.Pop();
+  }
+
+  return SUCCESS;
+}
+
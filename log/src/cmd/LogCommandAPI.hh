@@ -27,6 +27,7 @@ extern "C"
     FAILED_TO_SUBSCRIBE = 4,
     INVALID_VERSION     = 5,
     INVALID_REMAP       = 6,
+    FAILED_TO_WRITE     = 7,
   };
 
   /// \brief Sets verbosity of library
@@ -52,4 +53,56 @@ extern "C"
     const int _wait_ms,
     const char *_remap,
     int _fast);
+
+  /// \brief Copy the messages of the topics whose name matches the given
+  /// pattern, within a time window, into a new log file.
+  /// \param[in] _input Path to the log file to read
+  /// \param[in] _output Path to the log file to create
+  /// \param[in] _pattern ECMAScript regular expression to match against topics
+  /// \param[in] _start Beginning of the time window, in seconds since the
+  /// first message of the input log. Negative to start at the beginning.
+  /// \param[in] _end End of the time window, in seconds since the first
+  /// message of the input log. Negative to stop at the end.
+  int GZ_TRANSPORT_LOG_VISIBLE filterLog(
+    const char *_input,
+    const char *_output,
+    const char *_pattern,
+    double _start,
+    double _end);
+
+  /// \brief Split a log file into consecutive log files of a given duration.
+  /// The output files are named <_prefix>_0.tlog, <_prefix>_1.tlog, ...
+  /// \param[in] _input Path to the log file to read
+  /// \param[in] _prefix Path prefix of the log files to create
+  /// \param[in] _pattern ECMAScript regular expression to match against topics
+  /// \param[in] _duration Duration of each output log file, in seconds
+  int GZ_TRANSPORT_LOG_VISIBLE splitLog(
+    const char *_input,
+    const char *_prefix,
+    const char *_pattern,
+    double _duration);
+
+  /// \brief Merge several log files into a new one, interleaving their
+  /// messages in time order.
+  /// \param[in] _inputs Newline-separated paths of the log files to read
+  /// \param[in] _output Path to the log file to create
+  /// \param[in] _pattern ECMAScript regular expression to match against topics
+  int GZ_TRANSPORT_LOG_VISIBLE mergeLogs(
+    const char *_inputs,
+    const char *_output,
+    const char *_pattern);
+
+  /// \brief Print the messages of the topics whose name matches the given
+  /// pattern, within a time window, to the standard output.
+  /// \param[in] _input Path to the log file to read
+  /// \param[in] _pattern ECMAScript regular expression to match against topics
+  /// \param[in] _start Beginning of the time window, in seconds since the
+  /// first message of the log. Negative to start at the beginning.
+  /// \param[in] _end End of the time window, in seconds since the first
+  /// message of the log. Negative to stop at the end.
+  int GZ_TRANSPORT_LOG_VISIBLE catLog(
+    const char *_input,
+    const char *_pattern,
+    double _start,
+    double _end);
 }
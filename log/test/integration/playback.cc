@@ -92,6 +92,91 @@ bool ExpectSameMessages(
 }
 
 
+//////////////////////////////////////////////////
+/// \brief Records the chirps of some topics in a log and opens the playback
+/// of the log. The messages received by the subscriptions of the node are
+/// tracked, so the playback can be compared with the original messages.
+class RecordedChirps
+{
+  /// \brief Constructor. Records the chirps.
+  /// \param[in] _logName Name of the log, an in-memory database.
+  /// \param[in] _topics Topics to record.
+  /// \param[in] _numChirps Number of chirps published on each topic.
+  public: RecordedChirps(const std::string &_logName,
+                         const std::vector<std::string> &_topics,
+                         const int _numChirps = 100)
+  {
+    auto callback = [this](
+        const char *_data,
+        std::size_t _len,
+        const gz::transport::MessageInfo &_msgInfo)
+    {
+      TrackMessages(this->incomingData, _data, _len, _msgInfo);
+    };
+
+    gz::transport::log::Recorder recorder;
+    for (const std::string &topic : _topics)
+    {
+      this->node.SubscribeRaw(topic, callback);
+      recorder.AddTopic(topic);
+    }
+
+    EXPECT_EQ(gz::transport::log::RecorderError::SUCCESS,
+      recorder.Start(_logName));
+
+    testing::forkHandlerType chirper =
+      gz::transport::log::test::BeginChirps(_topics, _numChirps, partition);
+
+    // Wait for the chirping to finish
+    testing::waitAndCleanupFork(chirper);
+
+    // Wait to make sure our callbacks are done processing the incoming
+    // messages
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    // Create playback before stopping so sqlite memory database is shared
+    this->playback =
+      std::make_unique<gz::transport::log::Playback>(_logName);
+    recorder.Stop();
+
+    // Keep the original data and clear it, so the playback recreates it
+    std::unique_lock<std::mutex> lock(dataMutex);
+    this->originalData = this->incomingData;
+    this->incomingData.clear();
+  }
+
+  /// \brief Play the log back and wait until it finishes.
+  /// \return The handle of the finished playback.
+  public: gz::transport::log::PlaybackHandlePtr Play()
+  {
+    const auto handle = this->playback->Start();
+    std::cout << "Waiting to for playback to finish..." << std::endl;
+    handle->WaitUntilFinished();
+    std::cout << " Done waiting..." << std::endl;
+    handle->Stop();
+    std::cout << "Playback finished!" << std::endl;
+
+    // Wait to make sure our callbacks are done processing the incoming
+    // messages (Strangely, Windows throws an exception when this is ~1s or
+    // more)
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    return handle;
+  }
+
+  /// \brief Messages received while recording.
+  public: std::vector<MessageInformation> originalData;
+
+  /// \brief Messages received during the playback.
+  public: std::vector<MessageInformation> incomingData;
+
+  /// \brief Playback of the log.
+  public: std::unique_ptr<gz::transport::log::Playback> playback;
+
+  /// \brief Node subscribed to the topics. It's destroyed first, so the
+  /// callbacks don't outlive incomingData.
+  public: gz::transport::Node node;
+};
+
 //////////////////////////////////////////////////
 /// \brief Record a log and then play it back. Verify that the playback matches
 /// the original.
@@ -438,6 +523,66 @@ TEST(playback, GZ_UTILS_TEST_DISABLED_ON_MAC(ReplayLogMoveInstances))
   EXPECT_TRUE(ExpectSameMessages(originalData, incomingData));
 }
 
+//////////////////////////////////////////////////
+/// \brief Record a log and then play it back using publishing worker threads.
+/// Messages of different topics may be interleaved differently, but the order
+/// within each topic must match the original.
+TEST(playback, GZ_UTILS_TEST_DISABLED_ON_MAC(ReplayLogPublishThreads))
+{
+  std::vector<std::string> topics = {"/foo", "/bar", "/baz"};
+  RecordedChirps log(
+    "file:playbackReplayLogPublishThreads?mode=memory&cache=shared", topics);
+
+  EXPECT_EQ(0u, log.playback->PublishThreads());
+  log.playback->SetPublishThreads(2);
+  EXPECT_EQ(2u, log.playback->PublishThreads());
+
+  const auto handle = log.Play();
+  EXPECT_TRUE(handle->Finished());
+
+  ASSERT_EQ(log.originalData.size(), log.incomingData.size());
+  for (const std::string &topic : topics)
+  {
+    std::vector<MessageInformation> original;
+    std::vector<MessageInformation> played;
+    for (const MessageInformation &info : log.originalData)
+    {
+      if (info.topic == topic)
+        original.push_back(info);
+    }
+    for (const MessageInformation &info : log.incomingData)
+    {
+      if (info.topic == topic)
+        played.push_back(info);
+    }
+    EXPECT_TRUE(ExpectSameMessages(original, played)) << topic;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Record a log and then play it back in precise timing mode. Verify
+/// that the playback matches the original and that the timing error is
+/// measured.
+TEST(playback, GZ_UTILS_TEST_DISABLED_ON_MAC(ReplayLogPreciseTiming))
+{
+  RecordedChirps log(
+    "file:playbackReplayLogPreciseTiming?mode=memory&cache=shared",
+    {"/foo", "/bar", "/baz"});
+
+  log.playback->SetPreciseTiming(true, std::chrono::milliseconds(1));
+  EXPECT_TRUE(log.playback->PreciseTiming());
+  EXPECT_EQ(std::chrono::milliseconds(1), log.playback->SpinThreshold());
+
+  const auto handle = log.Play();
+
+  // Every message has been scheduled, so every message has been measured.
+  const gz::transport::Statistics timingError = handle->TimingError();
+  EXPECT_EQ(log.originalData.size(), timingError.Count());
+  EXPECT_GE(timingError.Min(), 0.0);
+
+  EXPECT_TRUE(ExpectSameMessages(log.originalData, log.incomingData));
+}
+
 //////////////////////////////////////////////////
 /// \brief Record a log and then play it back calling the Pause and Resume
 /// methods to control the playback flow.
@@ -18,6 +18,7 @@
 
 #include <gtest/gtest.h>
 
+#include <filesystem>
 #include <optional>
 #include <numeric>
 
@@ -531,6 +532,71 @@ TEST(recorder, DataWriterQueueLargeMessages)
   TestBufferSizeSettings(1, 1);
 }
 
+//////////////////////////////////////////////////
+/// \brief Record with a summary and check that the summary accounts for every
+/// recorded message.
+TEST(recorder, GZ_UTILS_TEST_DISABLED_ON_MAC(RecordSummary))
+{
+  std::vector<std::string> topics = {"/foo", "/bar"};
+
+  const std::filesystem::path logPath =
+    std::filesystem::temp_directory_path() /
+    ("recorderSummary_" + testing::getRandomNumber() + ".tlog");
+
+  gz::transport::log::Recorder recorder;
+  recorder.SetSummaryBucketSize(std::chrono::milliseconds(100));
+  for (const std::string &topic : topics)
+    recorder.AddTopic(topic);
+
+  EXPECT_EQ(recorder.Start(logPath.string()),
+            gz::transport::log::RecorderError::SUCCESS);
+
+  const int numChirps = 20;
+  testing::forkHandlerType chirper =
+      gz::transport::log::test::BeginChirps(topics, numChirps, partition);
+
+  // Wait for the chirping to finish
+  testing::waitAndCleanupFork(chirper);
+
+  // Wait to make sure our callbacks are done processing the incoming messages
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+  recorder.Stop();
+
+  gz::transport::log::Log log;
+  ASSERT_TRUE(log.Open(logPath.string()));
+  EXPECT_EQ(std::chrono::milliseconds(100), log.SummaryBucketSize());
+
+  uint64_t numMessages = 0;
+  for (const gz::transport::log::Message &msg : log.QueryMessages())
+  {
+    (void)msg;
+    ++numMessages;
+  }
+  EXPECT_EQ(static_cast<uint64_t>(numChirps * topics.size()), numMessages);
+
+  uint64_t numSummarized = 0;
+  for (const gz::transport::log::SummaryBucket &bucket : log.Summary())
+  {
+    EXPECT_GE(bucket.firstTime, bucket.start);
+    EXPECT_LT(bucket.firstTime,
+              bucket.start + std::chrono::milliseconds(100));
+    numSummarized += bucket.count;
+  }
+  EXPECT_EQ(numMessages, numSummarized);
+
+  // Walk the /foo messages by jumping from one to the next
+  std::size_t numJumps = 0;
+  auto next = log.NextMessageTime("/foo", std::chrono::nanoseconds(-1));
+  while (next)
+  {
+    ++numJumps;
+    next = log.NextMessageTime("/foo", *next);
+  }
+  EXPECT_EQ(static_cast<std::size_t>(numChirps), numJumps);
+
+  std::filesystem::remove(logPath);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -57,6 +57,12 @@ namespace gz
 
       /// \brief Default message publication rate.
       public: uint64_t msgsPerSec = kUnthrottled;
+
+      /// \brief Whether the messages are sent with multicast.
+      public: bool multicast = false;
+
+      /// \brief Keyframe interval of the delta encoding, 0 if disabled.
+      public: uint32_t deltaKeyframeInterval = 0;
     };
 
     /// \internal
@@ -68,6 +74,15 @@ namespace gz
 
       /// \brief Destructor.
       public: virtual ~AdvertiseServiceOptionsPrivate() = default;
+
+      /// \brief Whether the responses can be cached by the requesters.
+      public: bool cacheable = false;
+
+      /// \brief Time that a cached response remains valid in milliseconds.
+      public: uint64_t cacheTtl = 0;
+
+      /// \brief Version of the responses.
+      public: uint64_t cacheVersion = 0;
     };
     }
   }
@@ -148,6 +163,8 @@ AdvertiseMessageOptions &AdvertiseMessageOptions::operator=(
 {
   AdvertiseOptions::operator=(_other);
   this->SetMsgsPerSec(_other.MsgsPerSec());
+  this->SetMulticast(_other.Multicast());
+  this->SetDeltaKeyframeInterval(_other.DeltaKeyframeInterval());
   return *this;
 }
 
@@ -156,7 +173,9 @@ bool AdvertiseMessageOptions::operator==(
   const AdvertiseMessageOptions &_other) const
 {
   return AdvertiseOptions::operator==(_other) &&
-         this->MsgsPerSec() == _other.MsgsPerSec();
+         this->MsgsPerSec() == _other.MsgsPerSec() &&
+         this->Multicast() == _other.Multicast() &&
+         this->DeltaKeyframeInterval() == _other.DeltaKeyframeInterval();
 }
 
 //////////////////////////////////////////////////
@@ -184,6 +203,31 @@ void AdvertiseMessageOptions::SetMsgsPerSec(const uint64_t _newMsgsPerSec)
   this->dataPtr->msgsPerSec = _newMsgsPerSec;
 }
 
+//////////////////////////////////////////////////
+bool AdvertiseMessageOptions::Multicast() const
+{
+  return this->dataPtr->multicast;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseMessageOptions::SetMulticast(const bool _multicast)
+{
+  this->dataPtr->multicast = _multicast;
+}
+
+//////////////////////////////////////////////////
+uint32_t AdvertiseMessageOptions::DeltaKeyframeInterval() const
+{
+  return this->dataPtr->deltaKeyframeInterval;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseMessageOptions::SetDeltaKeyframeInterval(
+  const uint32_t _interval)
+{
+  this->dataPtr->deltaKeyframeInterval = _interval;
+}
+
 //////////////////////////////////////////////////
 AdvertiseServiceOptions::AdvertiseServiceOptions()
   : AdvertiseOptions(),
@@ -209,6 +253,9 @@ AdvertiseServiceOptions &AdvertiseServiceOptions::operator=(
   const AdvertiseServiceOptions &_other)
 {
   AdvertiseOptions::operator=(_other);
+  this->SetCacheable(_other.Cacheable());
+  this->SetCacheTtl(_other.CacheTtl());
+  this->SetCacheVersion(_other.CacheVersion());
   return *this;
 }
 
@@ -216,7 +263,10 @@ AdvertiseServiceOptions &AdvertiseServiceOptions::operator=(
 bool AdvertiseServiceOptions::operator==(
   const AdvertiseServiceOptions &_other) const
 {
-  return AdvertiseOptions::operator==(_other);
+  return AdvertiseOptions::operator==(_other) &&
+         this->Cacheable() == _other.Cacheable() &&
+         this->CacheTtl() == _other.CacheTtl() &&
+         this->CacheVersion() == _other.CacheVersion();
 }
 
 //////////////////////////////////////////////////
@@ -225,3 +275,39 @@ bool AdvertiseServiceOptions::operator!=(
 {
   return !(*this == _other);
 }
+
+//////////////////////////////////////////////////
+bool AdvertiseServiceOptions::Cacheable() const
+{
+  return this->dataPtr->cacheable;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseServiceOptions::SetCacheable(const bool _cacheable)
+{
+  this->dataPtr->cacheable = _cacheable;
+}
+
+//////////////////////////////////////////////////
+uint64_t AdvertiseServiceOptions::CacheTtl() const
+{
+  return this->dataPtr->cacheTtl;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseServiceOptions::SetCacheTtl(const uint64_t _ttl)
+{
+  this->dataPtr->cacheTtl = _ttl;
+}
+
+//////////////////////////////////////////////////
+uint64_t AdvertiseServiceOptions::CacheVersion() const
+{
+  return this->dataPtr->cacheVersion;
+}
+
+//////////////////////////////////////////////////
+void AdvertiseServiceOptions::SetCacheVersion(const uint64_t _version)
+{
+  this->dataPtr->cacheVersion = _version;
+}
@@ -184,6 +184,28 @@ TEST(AdvertiseOptionsTest, msgAccessors)
   opts.SetMsgsPerSec(10u);
   EXPECT_EQ(opts.MsgsPerSec(), 10u);
   EXPECT_TRUE(opts.Throttled());
+
+  // Multicast.
+  EXPECT_FALSE(opts.Multicast());
+  opts.SetMulticast(true);
+  EXPECT_TRUE(opts.Multicast());
+
+  AdvertiseMessageOptions other(opts);
+  EXPECT_TRUE(other.Multicast());
+  EXPECT_EQ(opts, other);
+  other.SetMulticast(false);
+  EXPECT_NE(opts, other);
+
+  // Delta encoding.
+  EXPECT_EQ(0u, opts.DeltaKeyframeInterval());
+  opts.SetDeltaKeyframeInterval(30u);
+  EXPECT_EQ(30u, opts.DeltaKeyframeInterval());
+
+  other = opts;
+  EXPECT_EQ(30u, other.DeltaKeyframeInterval());
+  EXPECT_EQ(opts, other);
+  other.SetDeltaKeyframeInterval(0u);
+  EXPECT_NE(opts, other);
 }
 
 //////////////////////////////////////////////////
@@ -252,3 +274,35 @@ TEST(AdvertiseOptionsTest, srvAccessors)
   opts.SetScope(Scope_t::HOST);
   EXPECT_EQ(opts.Scope(), Scope_t::HOST);
 }
+
+//////////////////////////////////////////////////
+/// \brief Check the cache options.
+TEST(AdvertiseOptionsTest, srvCache)
+{
+  AdvertiseServiceOptions opts1;
+  EXPECT_FALSE(opts1.Cacheable());
+  EXPECT_EQ(0u, opts1.CacheTtl());
+  EXPECT_EQ(0u, opts1.CacheVersion());
+
+  opts1.SetCacheable(true);
+  opts1.SetCacheTtl(500u);
+  opts1.SetCacheVersion(3u);
+  EXPECT_TRUE(opts1.Cacheable());
+  EXPECT_EQ(500u, opts1.CacheTtl());
+  EXPECT_EQ(3u, opts1.CacheVersion());
+
+  AdvertiseServiceOptions opts2(opts1);
+  EXPECT_EQ(opts1, opts2);
+  opts2.SetCacheVersion(4u);
+  EXPECT_NE(opts1, opts2);
+
+  std::ostringstream output;
+  output << opts1;
+  std::string expectedOutput =
+    "Advertise options:\n"
+    "\tScope: All\n"
+    "\tCacheable? Yes\n"
+    "\tCache TTL: 500 ms\n"
+    "\tCache version: 3\n";
+  EXPECT_EQ(output.str(), expectedOutput);
+}
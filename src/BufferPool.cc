@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "gz/transport/BufferPool.hh"
+#include "gz/transport/Helpers.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  /// \brief Number of size classes.
+  constexpr std::size_t kNumClasses = 21u;
+  static_assert((BufferPool::kMinSize << (kNumClasses - 1)) ==
+                BufferPool::kMaxSize, "Wrong number of size classes");
+
+  /// \brief Class of the buffers that are not pooled.
+  constexpr uint32_t kUnpooled = UINT32_MAX;
+
+  /// \brief Maximum bytes kept in the shared list of a class. At least one
+  /// buffer is kept while the pool is under BufferPool::kMaxIdleBytes.
+  constexpr std::size_t kMaxIdleBytesPerClass = 32u * 1024u * 1024u;
+
+  /// \brief Maximum size of the classes kept in the per thread caches.
+  constexpr std::size_t kMaxThreadCachedSize = 1024u * 1024u;
+
+  /// \brief Maximum number of buffers of a class in a per thread cache.
+  constexpr std::size_t kMaxThreadCachedBuffers = 4u;
+
+  /// \brief Information stored before each buffer. Its size keeps the
+  /// buffers aligned as the memory returned by new.
+  struct alignas(alignof(std::max_align_t)) Header
+  {
+    /// \brief Size class, or kUnpooled.
+    uint32_t sizeClass;
+
+    /// \brief Whether the block was mapped with mmap().
+    uint32_t mapped;
+
+    /// \brief Size of the block, including this header.
+    std::size_t blockSize;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the size of the buffers of a class.
+  /// \param[in] _class The class.
+  /// \return The size.
+  std::size_t classSize(const std::size_t _class)
+  {
+    return BufferPool::kMinSize << _class;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Get the smallest class that fits a size.
+  /// \param[in] _size The size, at most BufferPool::kMaxSize.
+  /// \return The class.
+  std::size_t classFor(const std::size_t _size)
+  {
+    std::size_t c = 0;
+    while (classSize(c) < _size)
+      ++c;
+    return c;
+  }
+
+  /// \brief Shared state of the pool.
+  class Pool
+  {
+    /// \brief Constructor. Reads the configuration from the environment.
+    public: Pool()
+    {
+      std::string value;
+      if (env("GZ_TRANSPORT_BUFFER_POOL", value) && value == "0")
+        this->enabled = false;
+      if (env("GZ_TRANSPORT_HUGE_PAGES", value) && value == "1")
+        this->hugePages = true;
+    }
+
+    /// \brief Allocate a new block.
+    /// \param[in] _size Usable size of the block.
+    /// \param[in] _class Size class of the block.
+    /// \return The header of the block.
+    public: Header *NewBlock(const std::size_t _size, const uint32_t _class)
+    {
+      const std::size_t blockSize = _size + sizeof(Header);
+      void *memory = nullptr;
+      uint32_t mapped = 0;
+
+#ifdef __linux__
+      if (this->hugePages && _size >= BufferPool::kHugePageSize)
+      {
+        memory = mmap(nullptr, blockSize, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+          memory = nullptr;
+        }
+        else
+        {
+          madvise(memory, blockSize, MADV_HUGEPAGE);
+          mapped = 1;
+        }
+      }
+#endif
+
+      if (!memory)
+        memory = new char[blockSize];
+
+      Header *header = static_cast<Header *>(memory);
+      header->sizeClass = _class;
+      header->mapped = mapped;
+      header->blockSize = blockSize;
+      return header;
+    }
+
+    /// \brief Release a block to the system.
+    /// \param[in] _header Header of the block.
+    public: static void DeleteBlock(Header *_header)
+    {
+#ifdef __linux__
+      if (_header->mapped)
+      {
+        munmap(_header, _header->blockSize);
+        return;
+      }
+#endif
+      delete[] reinterpret_cast<char *>(_header);
+    }
+
+    /// \brief Get a block from the shared list of a class.
+    /// \param[in] _class The class.
+    /// \return The block, or null if the list is empty.
+    public: Header *Pop(const std::size_t _class)
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      auto &list = this->lists[_class];
+      if (list.empty())
+        return nullptr;
+      Header *header = list.back();
+      list.pop_back();
+      this->idleBytes -= classSize(_class);
+      return header;
+    }
+
+    /// \brief Keep a block in the shared list of its class, or release it
+    /// if the list or the pool is full.
+    /// \param[in] _header The block.
+    public: void Push(Header *_header)
+    {
+      const std::size_t c = _header->sizeClass;
+      {
+        std::lock_guard<std::mutex> lk(this->mutex);
+        auto &list = this->lists[c];
+        if (this->idleBytes + classSize(c) <= BufferPool::kMaxIdleBytes &&
+            (list.empty() ||
+             (list.size() + 1) * classSize(c) <= kMaxIdleBytesPerClass))
+        {
+          list.push_back(_header);
+          this->idleBytes += classSize(c);
+          return;
+        }
+      }
+      DeleteBlock(_header);
+    }
+
+    /// \brief Release all the blocks of the shared lists.
+    public: void Trim()
+    {
+      std::array<std::vector<Header *>, kNumClasses> released;
+      {
+        std::lock_guard<std::mutex> lk(this->mutex);
+        released.swap(this->lists);
+        this->idleBytes = 0;
+      }
+
+      for (auto &list : released)
+      {
+        for (Header *header : list)
+          DeleteBlock(header);
+      }
+    }
+
+    /// \brief Whether buffers are pooled.
+    public: bool enabled = true;
+
+    /// \brief Whether large buffers are backed by huge pages.
+    public: bool hugePages = false;
+
+    /// \brief Allocations served with a pooled buffer.
+    public: std::atomic<uint64_t> hits{0};
+
+    /// \brief Allocations that needed a new buffer.
+    public: std::atomic<uint64_t> misses{0};
+
+    /// \brief Allocations not pooled.
+    public: std::atomic<uint64_t> unpooled{0};
+
+    /// \brief Mutex to protect the lists.
+    public: std::mutex mutex;
+
+    /// \brief Free blocks of each class.
+    public: std::array<std::vector<Header *>, kNumClasses> lists;
+
+    /// \brief Bytes kept in the lists.
+    public: uint64_t idleBytes = 0;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the shared pool. It's never destroyed, so buffers can be
+  /// released while the process exits.
+  /// \return The pool.
+  Pool &pool()
+  {
+    static Pool *instance = new Pool();
+    return *instance;
+  }
+
+  /// \brief Set when the cache of the current thread has been destroyed,
+  /// e.g. while other thread local objects release their buffers.
+  thread_local bool threadCacheDestroyed = false;
+
+  /// \brief Free blocks kept by a thread. They go back to the shared lists
+  /// when the thread exits.
+  class ThreadCache
+  {
+    /// \brief Destructor.
+    public: ~ThreadCache()
+    {
+      threadCacheDestroyed = true;
+      for (auto &list : this->lists)
+      {
+        for (Header *header : list)
+          pool().Push(header);
+      }
+    }
+
+    /// \brief Free blocks of each class.
+    public: std::array<std::vector<Header *>, kNumClasses> lists;
+  };
+
+  //////////////////////////////////////////////////
+  /// \brief Get the cache of the current thread.
+  /// \return The cache, or null if the thread is exiting.
+  ThreadCache *threadCache()
+  {
+    if (threadCacheDestroyed)
+      return nullptr;
+    thread_local ThreadCache cache;
+    return &cache;
+  }
+}
+
+//////////////////////////////////////////////////
+char *BufferPool::Allocate(const std::size_t _size)
+{
+  Pool &p = pool();
+  Header *header = nullptr;
+
+  if (!p.enabled || _size > kMaxSize)
+  {
+    ++p.unpooled;
+    header = p.NewBlock(_size, kUnpooled);
+    return reinterpret_cast<char *>(header + 1);
+  }
+
+  const std::size_t c = classFor(_size);
+  ThreadCache *cache = threadCache();
+  if (cache && classSize(c) <= kMaxThreadCachedSize)
+  {
+    auto &list = cache->lists[c];
+    if (!list.empty())
+    {
+      header = list.back();
+      list.pop_back();
+    }
+  }
+
+  if (!header)
+    header = p.Pop(c);
+
+  if (header)
+  {
+    ++p.hits;
+  }
+  else
+  {
+    ++p.misses;
+    header = p.NewBlock(classSize(c), static_cast<uint32_t>(c));
+  }
+
+  return reinterpret_cast<char *>(header + 1);
+}
+
+//////////////////////////////////////////////////
+void BufferPool::Free(void *_buffer)
+{
+  if (!_buffer)
+    return;
+
+  Header *header = static_cast<Header *>(_buffer) - 1;
+  if (header->sizeClass == kUnpooled)
+  {
+    Pool::DeleteBlock(header);
+    return;
+  }
+
+  ThreadCache *cache = threadCache();
+  if (cache && classSize(header->sizeClass) <= kMaxThreadCachedSize)
+  {
+    auto &list = cache->lists[header->sizeClass];
+    if (list.size() < kMaxThreadCachedBuffers)
+    {
+      list.push_back(header);
+      return;
+    }
+  }
+
+  pool().Push(header);
+}
+
+//////////////////////////////////////////////////
+void BufferPool::ZmqFree(void *_buffer, void * /*_hint*/)
+{
+  if (!_buffer)
+    return;
+
+  // ZeroMQ releases the buffers on its I/O thread, which never allocates
+  // them. They go straight to the shared lists, where the publishers find
+  // them, instead of staying in the cache of that thread.
+  Header *header = static_cast<Header *>(_buffer) - 1;
+  if (header->sizeClass == kUnpooled)
+    Pool::DeleteBlock(header);
+  else
+    pool().Push(header);
+}
+
+//////////////////////////////////////////////////
+BufferPool::Stats BufferPool::Statistics()
+{
+  Pool &p = pool();
+  Stats stats;
+  stats.hits = p.hits;
+  stats.misses = p.misses;
+  stats.unpooled = p.unpooled;
+  {
+    std::lock_guard<std::mutex> lk(p.mutex);
+    stats.idleBytes = p.idleBytes;
+  }
+  return stats;
+}
+
+//////////////////////////////////////////////////
+void BufferPool::Trim()
+{
+  pool().Trim();
+}
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "gz/transport/BufferPool.hh"
+#include "test_config.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+//////////////////////////////////////////////////
+/// \brief A released buffer is reused by the next allocation of its class.
+TEST(BufferPoolTest, Reuse)
+{
+  char *buffer = BufferPool::Allocate(100);
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(buffer) %
+    alignof(std::max_align_t));
+  std::memset(buffer, 1, 100);
+  BufferPool::Free(buffer);
+
+  const BufferPool::Stats before = BufferPool::Statistics();
+
+  // 128 bytes is the same size class as 100 bytes.
+  char *other = BufferPool::Allocate(128);
+  EXPECT_EQ(buffer, other);
+  std::memset(other, 2, 128);
+  BufferPool::Free(other);
+
+  const BufferPool::Stats after = BufferPool::Statistics();
+  EXPECT_EQ(before.hits + 1, after.hits);
+  EXPECT_EQ(before.misses, after.misses);
+  EXPECT_GT(after.HitRate(), 0.0);
+
+  // Freeing null is allowed.
+  BufferPool::Free(nullptr);
+}
+
+//////////////////////////////////////////////////
+/// \brief Buffers larger than the largest class are not pooled.
+TEST(BufferPoolTest, Unpooled)
+{
+  const BufferPool::Stats before = BufferPool::Statistics();
+  char *buffer = BufferPool::Allocate(BufferPool::kMaxSize + 1);
+  ASSERT_NE(nullptr, buffer);
+  buffer[BufferPool::kMaxSize] = 1;
+  BufferPool::ZmqFree(buffer, nullptr);
+
+  const BufferPool::Stats after = BufferPool::Statistics();
+  EXPECT_EQ(before.unpooled + 1, after.unpooled);
+  EXPECT_EQ(before.idleBytes, after.idleBytes);
+}
+
+//////////////////////////////////////////////////
+/// \brief Buffers can be released by another thread, and the buffers
+/// cached by a thread go back to the shared lists when it exits.
+TEST(BufferPoolTest, CrossThread)
+{
+  BufferPool::Trim();
+
+  // Too large for the per thread caches.
+  const std::size_t size = 4u * 1024u * 1024u;
+  BufferPool::Ptr buffer(BufferPool::Allocate(size));
+  ASSERT_NE(nullptr, buffer);
+
+  std::thread thread([&buffer]()
+  {
+    buffer.reset();
+  });
+  thread.join();
+  EXPECT_EQ(size, BufferPool::Statistics().idleBytes);
+
+  char *other = BufferPool::Allocate(size);
+  EXPECT_EQ(0u, BufferPool::Statistics().idleBytes);
+  BufferPool::Free(other);
+
+  // Small buffers cached by a thread.
+  std::thread cacheThread([]()
+  {
+    BufferPool::Free(BufferPool::Allocate(1000));
+  });
+  cacheThread.join();
+  EXPECT_EQ(size + 1024u, BufferPool::Statistics().idleBytes);
+
+  // Buffers released by ZeroMQ skip the per thread caches, so they are
+  // available to the other threads right away.
+  BufferPool::Trim();
+  char *small = BufferPool::Allocate(1000);
+  std::thread zmqThread([small]()
+  {
+    BufferPool::ZmqFree(small, nullptr);
+  });
+  zmqThread.join();
+  EXPECT_EQ(1024u, BufferPool::Statistics().idleBytes);
+
+  BufferPool::Trim();
+  EXPECT_EQ(0u, BufferPool::Statistics().idleBytes);
+}
+
+//////////////////////////////////////////////////
+/// \brief The shared lists of all the classes together keep at most
+/// kMaxIdleBytes.
+TEST(BufferPoolTest, IdleLimit)
+{
+  BufferPool::Trim();
+
+  // One buffer of each class too large for the per thread caches, from the
+  // largest one.
+  std::vector<char *> buffers;
+  for (std::size_t size = BufferPool::kMaxSize; size > 1024u * 1024u;
+       size /= 2u)
+  {
+    buffers.push_back(BufferPool::Allocate(size));
+  }
+  for (char *buffer : buffers)
+    BufferPool::Free(buffer);
+
+  // The largest buffer fills the pool, the rest are released.
+  EXPECT_EQ(BufferPool::kMaxSize, BufferPool::Statistics().idleBytes);
+  BufferPool::Trim();
+
+  // The same classes released from the smallest one.
+  buffers.clear();
+  for (std::size_t size = 2u * 1024u * 1024u; size <= BufferPool::kMaxSize;
+       size *= 2u)
+  {
+    buffers.push_back(BufferPool::Allocate(size));
+  }
+  for (char *buffer : buffers)
+    BufferPool::Free(buffer);
+
+  // The smaller buffers are kept, the largest one doesn't fit anymore.
+  EXPECT_EQ(BufferPool::kMaxIdleBytes - 2u * 1024u * 1024u,
+    BufferPool::Statistics().idleBytes);
+
+  BufferPool::Trim();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the hit rate computation.
+TEST(BufferPoolTest, HitRate)
+{
+  BufferPool::Stats stats;
+  EXPECT_DOUBLE_EQ(0.0, stats.HitRate());
+  stats.hits = 3;
+  stats.misses = 1;
+  stats.unpooled = 10;
+  EXPECT_DOUBLE_EQ(0.75, stats.HitRate());
+}
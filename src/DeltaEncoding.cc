@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "DeltaEncoding.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  /// \brief Copy bytes of the previous message.
+  const uint8_t kCopy = 0u;
+
+  /// \brief Replace bytes of the previous message with literal bytes.
+  const uint8_t kReplace = 1u;
+
+  /// \brief Insert literal bytes.
+  const uint8_t kInsert = 2u;
+
+  /// \brief Skip bytes of the previous message.
+  const uint8_t kSkip = 3u;
+
+  /// \brief Minimum number of unchanged bytes copied between two changed
+  /// regions. Shorter runs are replaced, which is smaller.
+  const std::size_t kMinCopy = 8u;
+
+  //////////////////////////////////////////////////
+  /// \brief Append a varint.
+  /// \param[in] _value Value to append.
+  /// \param[out] _buffer Buffer.
+  void appendVarint(uint64_t _value, std::string &_buffer)
+  {
+    while (_value >= 0x80u)
+    {
+      _buffer.push_back(static_cast<char>((_value & 0x7Fu) | 0x80u));
+      _value >>= 7;
+    }
+    _buffer.push_back(static_cast<char>(_value));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read a varint written by appendVarint().
+  /// \param[in] _data Encoded data.
+  /// \param[in] _size Size of the encoded data.
+  /// \param[in, out] _pos Position of the varint, updated to the position
+  /// after it.
+  /// \param[out] _value Value read.
+  /// \return False if the varint is malformed.
+  bool readVarint(const char *_data, const std::size_t _size,
+                  std::size_t &_pos, uint64_t &_value)
+  {
+    _value = 0;
+    for (int shift = 0; shift < 64 && _pos < _size; shift += 7)
+    {
+      const auto byte = static_cast<unsigned char>(_data[_pos++]);
+      _value |= static_cast<uint64_t>(byte & 0x7Fu) << shift;
+      if ((byte & 0x80u) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Append an operation.
+  /// \param[in] _op Operation code.
+  /// \param[in] _data Literal bytes, or nullptr.
+  /// \param[in] _len Length of the operation.
+  /// \param[out] _buffer Buffer.
+  void appendOp(const uint8_t _op, const char *_data, const std::size_t _len,
+                std::string &_buffer)
+  {
+    if (_len == 0)
+      return;
+
+    _buffer.push_back(static_cast<char>(_op));
+    appendVarint(_len, _buffer);
+    if (_data)
+      _buffer.append(_data, _len);
+  }
+}
+
+//////////////////////////////////////////////////
+DeltaEncoder::DeltaEncoder(const uint32_t _keyframeInterval)
+  : keyframeInterval(std::max(_keyframeInterval, 1u))
+{
+}
+
+//////////////////////////////////////////////////
+void DeltaEncoder::Encode(const char *_data, const std::size_t _size,
+  std::string &_frame)
+{
+  bool keyframe = this->untilKeyframe == 0;
+  if (!keyframe)
+  {
+    this->diff.clear();
+    Diff(this->base, _data, _size, this->diff);
+
+    // Send the full message if the difference isn't smaller.
+    keyframe = this->diff.size() >= _size;
+  }
+
+  if (keyframe)
+    this->untilKeyframe = this->keyframeInterval;
+  --this->untilKeyframe;
+  ++this->seq;
+
+  _frame.clear();
+  _frame.reserve(kHeaderSize + (keyframe ? _size : this->diff.size()));
+  _frame.push_back(static_cast<char>(keyframe ? kKeyframe : kDiff));
+  for (int i = 3; i >= 0; --i)
+    _frame.push_back(static_cast<char>((this->seq >> (8 * i)) & 0xFF));
+  if (keyframe)
+    _frame.append(_data, _size);
+  else
+    _frame.append(this->diff);
+
+  this->base.assign(_data, _size);
+}
+
+//////////////////////////////////////////////////
+void DeltaEncoder::ForceKeyframe()
+{
+  this->untilKeyframe = 0;
+}
+
+//////////////////////////////////////////////////
+void DeltaEncoder::Diff(const std::string &_base, const char *_data,
+  const std::size_t _size, std::string &_diff)
+{
+  const char *base = _base.data();
+  const std::size_t baseSize = _base.size();
+  const std::size_t minSize = std::min(baseSize, _size);
+
+  // Common prefix and suffix, so insertions and removals in the middle are
+  // cheap.
+  const std::size_t prefix = static_cast<std::size_t>(
+    std::mismatch(base, base + minSize, _data).first - base);
+  std::size_t suffix = 0;
+  while (suffix < minSize - prefix &&
+         base[baseSize - 1 - suffix] == _data[_size - 1 - suffix])
+  {
+    ++suffix;
+  }
+
+  appendVarint(_size, _diff);
+  appendOp(kCopy, nullptr, prefix, _diff);
+
+  // Compare the rest byte by byte.
+  const char *baseMid = base + prefix;
+  const char *dataMid = _data + prefix;
+  const std::size_t baseMidSize = baseSize - prefix - suffix;
+  const std::size_t dataMidSize = _size - prefix - suffix;
+  const std::size_t overlap = std::min(baseMidSize, dataMidSize);
+
+  std::size_t i = 0;
+  while (i < overlap)
+  {
+    // Unchanged bytes.
+    std::size_t j = static_cast<std::size_t>(std::mismatch(
+      baseMid + i, baseMid + overlap, dataMid + i).first - baseMid);
+    appendOp(kCopy, nullptr, j - i, _diff);
+    i = j;
+
+    // Changed bytes, until enough unchanged bytes are found.
+    std::size_t equal = 0;
+    while (j < overlap && equal < kMinCopy)
+    {
+      equal = baseMid[j] == dataMid[j] ? equal + 1 : 0;
+      ++j;
+    }
+    if (equal == kMinCopy)
+      j -= kMinCopy;
+    appendOp(kReplace, dataMid + i, j - i, _diff);
+    i = j;
+  }
+
+  if (dataMidSize > overlap)
+    appendOp(kInsert, dataMid + overlap, dataMidSize - overlap, _diff);
+  else
+    appendOp(kSkip, nullptr, baseMidSize - overlap, _diff);
+
+  appendOp(kCopy, nullptr, suffix, _diff);
+}
+
+//////////////////////////////////////////////////
+bool DeltaDecoder::Decode(const char *_frame, const std::size_t _size,
+  std::string &_data)
+{
+  if (_size < DeltaEncoder::kHeaderSize)
+  {
+    ++this->dropped;
+    return false;
+  }
+
+  const auto kind = static_cast<uint8_t>(_frame[0]);
+  uint32_t frameSeq = 0;
+  for (int i = 1; i <= 4; ++i)
+  {
+    frameSeq = (frameSeq << 8) |
+      static_cast<uint32_t>(static_cast<unsigned char>(_frame[i]));
+  }
+  const char *payload = _frame + DeltaEncoder::kHeaderSize;
+  const std::size_t payloadSize = _size - DeltaEncoder::kHeaderSize;
+
+  if (kind == DeltaEncoder::kKeyframe)
+  {
+    this->base.assign(payload, payloadSize);
+  }
+  else if (kind == DeltaEncoder::kDiff && this->valid &&
+           frameSeq == this->seq + 1 &&
+           Patch(this->base, payload, payloadSize, this->next))
+  {
+    this->base.swap(this->next);
+  }
+  else
+  {
+    // Wait for the next keyframe.
+    this->valid = false;
+    ++this->dropped;
+    return false;
+  }
+
+  this->valid = true;
+  this->seq = frameSeq;
+  _data = this->base;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool DeltaDecoder::Patch(const std::string &_base, const char *_diff,
+  const std::size_t _size, std::string &_data)
+{
+  std::size_t pos = 0;
+  uint64_t dataSize = 0;
+  if (!readVarint(_diff, _size, pos, dataSize) ||
+      dataSize > _base.size() + _size)
+  {
+    return false;
+  }
+
+  _data.clear();
+  _data.reserve(static_cast<std::size_t>(dataSize));
+
+  // Position in the previous message.
+  std::size_t basePos = 0;
+  while (pos < _size)
+  {
+    const auto op = static_cast<uint8_t>(_diff[pos++]);
+    uint64_t len = 0;
+    if (!readVarint(_diff, _size, pos, len))
+      return false;
+
+    const bool literal = op == kReplace || op == kInsert;
+    const bool consumesBase = op == kCopy || op == kReplace || op == kSkip;
+    if (op > kSkip || (literal && len > _size - pos) ||
+        (consumesBase && len > _base.size() - basePos))
+    {
+      return false;
+    }
+
+    if (op == kCopy)
+      _data.append(_base, basePos, static_cast<std::size_t>(len));
+    else if (literal)
+      _data.append(_diff + pos, static_cast<std::size_t>(len));
+
+    if (literal)
+      pos += static_cast<std::size_t>(len);
+    if (consumesBase)
+      basePos += static_cast<std::size_t>(len);
+  }
+
+  return basePos == _base.size() && _data.size() == dataSize;
+}
+
+//////////////////////////////////////////////////
+uint64_t DeltaDecoder::DroppedMessages() const
+{
+  return this->dropped;
+}
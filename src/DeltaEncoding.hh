@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_DELTAENCODING_HH_
+#define GZ_TRANSPORT_DELTAENCODING_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class DeltaEncoder DeltaEncoding.hh
+    /// \brief Encoder of the topics advertised with
+    /// AdvertiseMessageOptions::SetDeltaKeyframeInterval(). Each message is
+    /// encoded in a frame that is either a keyframe, with the full message,
+    /// or the binary difference against the previous message.
+    ///
+    /// A frame starts with its kind (1 byte) and the sequence number of the
+    /// message (4 bytes, network byte order). A difference is made of the
+    /// size of the message followed by operations applied to the previous
+    /// message, each one an operation code (1 byte) and a length, both
+    /// encoded as varints, and the literal bytes of the operation, if any.
+    ///
+    /// The frames are sent on the topic name preceded by kTopicPrefix, so
+    /// subscribers that don't know about them never receive them.
+    class GZ_TRANSPORT_VISIBLE DeltaEncoder
+    {
+      /// \brief Prefix of the topic frame of the encoded messages.
+      public: static constexpr const char *kTopicPrefix = "gz_delta:";
+
+      /// \brief Size of the header of a frame.
+      public: static constexpr std::size_t kHeaderSize = 5u;
+
+      /// \brief Kind of a frame with a full message.
+      public: static constexpr uint8_t kKeyframe = 0u;
+
+      /// \brief Kind of a frame with a difference.
+      public: static constexpr uint8_t kDiff = 1u;
+
+      /// \brief Constructor.
+      /// \param[in] _keyframeInterval Number of messages between keyframes.
+      public: explicit DeltaEncoder(const uint32_t _keyframeInterval);
+
+      /// \brief Encode a message.
+      /// \param[in] _data Serialized message.
+      /// \param[in] _size Size of the message.
+      /// \param[out] _frame The frame to send.
+      public: void Encode(const char *_data, const std::size_t _size,
+                          std::string &_frame);
+
+      /// \brief Encode the next message as a keyframe, e.g. when a
+      /// subscriber joins.
+      public: void ForceKeyframe();
+
+      /// \brief Compute the difference between two messages.
+      /// \param[in] _base Previous message.
+      /// \param[in] _data New message.
+      /// \param[in] _size Size of the new message.
+      /// \param[out] _diff The difference is appended here.
+      public: static void Diff(const std::string &_base, const char *_data,
+                               const std::size_t _size, std::string &_diff);
+
+      /// \brief Number of messages between keyframes.
+      private: uint32_t keyframeInterval;
+
+      /// \brief Number of messages until the next keyframe.
+      private: uint32_t untilKeyframe = 0;
+
+      /// \brief Sequence number of the last message.
+      private: uint32_t seq = 0;
+
+      /// \brief Last message encoded.
+      private: std::string base;
+
+      /// \brief Buffer used to compute the differences.
+      private: std::string diff;
+    };
+
+    /// \class DeltaDecoder DeltaEncoding.hh
+    /// \brief Decoder of the frames created by a DeltaEncoder. A decoder is
+    /// needed per publisher and topic. Differences are dropped until a
+    /// keyframe is received, and after a message is lost.
+    class GZ_TRANSPORT_VISIBLE DeltaDecoder
+    {
+      /// \brief Decode a frame.
+      /// \param[in] _frame The frame.
+      /// \param[in] _size Size of the frame.
+      /// \param[out] _data The message.
+      /// \return False if the message can't be reconstructed.
+      public: bool Decode(const char *_frame, const std::size_t _size,
+                          std::string &_data);
+
+      /// \brief Apply a difference to a message.
+      /// \param[in] _base Previous message.
+      /// \param[in] _diff The difference.
+      /// \param[in] _size Size of the difference.
+      /// \param[out] _data The new message.
+      /// \return False if the difference is malformed.
+      public: static bool Patch(const std::string &_base, const char *_diff,
+                                const std::size_t _size, std::string &_data);
+
+      /// \brief Get the number of messages that couldn't be reconstructed.
+      /// \return The number of messages.
+      public: uint64_t DroppedMessages() const;
+
+      /// \brief Whether base holds the last message.
+      private: bool valid = false;
+
+      /// \brief Sequence number of the last message.
+      private: uint32_t seq = 0;
+
+      /// \brief Last message decoded.
+      private: std::string base;
+
+      /// \brief Buffer used to apply the differences.
+      private: std::string next;
+
+      /// \brief Number of messages dropped.
+      private: uint64_t dropped = 0;
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_DELTAENCODING_HH_
+#endif
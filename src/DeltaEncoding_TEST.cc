@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "DeltaEncoding.hh"
+#include "test_config.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Create a message of a given size with varied content.
+  /// \param[in] _size Size of the message.
+  /// \return The message.
+  std::string message(const std::size_t _size)
+  {
+    std::string data(_size, '\0');
+    for (std::size_t i = 0; i < _size; ++i)
+      data[i] = static_cast<char>((i * 7) % 253);
+    return data;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Compute a difference and apply it.
+  /// \param[in] _base Previous message.
+  /// \param[in] _data New message.
+  /// \return The size of the difference.
+  std::size_t roundTrip(const std::string &_base, const std::string &_data)
+  {
+    std::string diff;
+    DeltaEncoder::Diff(_base, _data.data(), _data.size(), diff);
+
+    std::string patched;
+    EXPECT_TRUE(DeltaDecoder::Patch(_base, diff.data(), diff.size(),
+      patched));
+    EXPECT_EQ(_data, patched);
+    return diff.size();
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the differences between messages.
+TEST(DeltaEncodingTest, DiffAndPatch)
+{
+  const std::string base = message(10000);
+
+  // Identical messages.
+  EXPECT_LT(roundTrip(base, base), 10u);
+
+  // A few changed bytes.
+  std::string data = base;
+  data[10] = 'a';
+  data[5000] = 'b';
+  data[5003] = 'c';
+  data[9999] = 'd';
+  EXPECT_LT(roundTrip(base, data), 40u);
+
+  // Insertion and removal in the middle.
+  data = base;
+  data.insert(4000, "inserted");
+  EXPECT_LT(roundTrip(base, data), 30u);
+  data = base;
+  data.erase(4000, 100);
+  EXPECT_LT(roundTrip(base, data), 20u);
+
+  // Growth, shrink and unrelated messages.
+  roundTrip(base, base + "tail");
+  roundTrip(base, base.substr(0, 500));
+  roundTrip(base, std::string(300, 'x'));
+  roundTrip("", base);
+  roundTrip(base, "");
+
+  // Malformed differences.
+  std::string diff;
+  std::string patched;
+  DeltaEncoder::Diff(base, data.data(), data.size(), diff);
+  EXPECT_FALSE(DeltaDecoder::Patch(base, diff.data(), diff.size() - 1,
+    patched));
+  EXPECT_FALSE(DeltaDecoder::Patch(base.substr(1), diff.data(), diff.size(),
+    patched));
+  diff[diff.size() - 2] = '\x09';
+  EXPECT_FALSE(DeltaDecoder::Patch(base, diff.data(), diff.size(), patched));
+}
+
+//////////////////////////////////////////////////
+/// \brief Encode and decode a stream of messages, with keyframes and a
+/// lost message.
+TEST(DeltaEncodingTest, Stream)
+{
+  DeltaEncoder encoder(4u);
+  DeltaDecoder decoder;
+  std::string data = message(5000);
+
+  std::vector<std::string> frames;
+  std::vector<std::string> msgs;
+  for (int i = 0; i < 10; ++i)
+  {
+    data[static_cast<std::size_t>(i) * 100] = 'z';
+    msgs.push_back(data);
+    frames.emplace_back();
+    encoder.Encode(data.data(), data.size(), frames.back());
+  }
+
+  // Keyframes every 4 messages, small differences in between.
+  for (std::size_t i = 0; i < frames.size(); ++i)
+  {
+    const bool keyframe = i % 4 == 0;
+    EXPECT_EQ(keyframe ? DeltaEncoder::kKeyframe : DeltaEncoder::kDiff,
+      static_cast<uint8_t>(frames[i][0]));
+    if (!keyframe)
+    {
+      EXPECT_LT(frames[i].size(), 50u);
+    }
+  }
+
+  // A late subscriber waits for a keyframe.
+  std::string decoded;
+  EXPECT_FALSE(decoder.Decode(frames[1].data(), frames[1].size(), decoded));
+  EXPECT_EQ(1u, decoder.DroppedMessages());
+
+  for (std::size_t i = 4; i < 6; ++i)
+  {
+    EXPECT_TRUE(decoder.Decode(frames[i].data(), frames[i].size(), decoded));
+    EXPECT_EQ(msgs[i], decoded);
+  }
+
+  // Message 6 is lost, so 7 can't be reconstructed.
+  EXPECT_FALSE(decoder.Decode(frames[7].data(), frames[7].size(), decoded));
+  EXPECT_EQ(2u, decoder.DroppedMessages());
+
+  EXPECT_TRUE(decoder.Decode(frames[8].data(), frames[8].size(), decoded));
+  EXPECT_EQ(msgs[8], decoded);
+  EXPECT_TRUE(decoder.Decode(frames[9].data(), frames[9].size(), decoded));
+  EXPECT_EQ(msgs[9], decoded);
+
+  // A forced keyframe.
+  encoder.ForceKeyframe();
+  std::string frame;
+  encoder.Encode(data.data(), data.size(), frame);
+  EXPECT_EQ(DeltaEncoder::kKeyframe, static_cast<uint8_t>(frame[0]));
+
+  // Malformed frames.
+  EXPECT_FALSE(decoder.Decode(frame.data(), 3u, decoded));
+  frame[0] = '\x07';
+  EXPECT_FALSE(decoder.Decode(frame.data(), frame.size(), decoded));
+}
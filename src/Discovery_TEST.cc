@@ -20,6 +20,7 @@
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "gz/transport/AdvertiseOptions.hh"
@@ -90,7 +91,7 @@ template<typename T> class DiscoveryDerived : public Discovery<T>
   public: void TestActivity(const std::string &_pUuid,
                             const bool _expectedActivity) const
   {
-    EXPECT_EQ(this->activity.find(_pUuid) !=
+    EXPECT_EQ(this->activity.find(transport::Uuid::FromIdentifier(_pUuid)) !=
               this->activity.end(), _expectedActivity);
   };
 };
@@ -193,6 +194,45 @@ TEST(DiscoveryTest, WithoutCallingStart)
   EXPECT_FALSE(discovery.Unadvertise(service, nUuid1));
 }
 
+//////////////////////////////////////////////////
+/// \brief A discovery limited to the process keeps the local publishers
+/// without using the network.
+TEST(DiscoveryTest, Local)
+{
+  reset();
+
+  MsgDiscovery discovery(pUuid1);
+  discovery.ConnectionsCb(onDiscoveryResponse);
+  discovery.Start();
+
+  // There's no initialization phase.
+  discovery.WaitForInit();
+  EXPECT_EQ("127.0.0.1", discovery.HostAddr());
+
+  MessagePublisher publisher(g_topic, addr1, ctrl1, pUuid1, nUuid1, "t",
+    AdvertiseMessageOptions());
+  EXPECT_TRUE(discovery.Advertise(publisher));
+
+  std::vector<std::string> topics;
+  discovery.TopicList(topics);
+  EXPECT_EQ(std::vector<std::string>({g_topic}), topics);
+
+  // The local publishers are discovered.
+  EXPECT_TRUE(discovery.Discover(g_topic));
+  EXPECT_TRUE(connectionExecuted);
+
+  // Another local discovery doesn't see them.
+  MsgDiscovery other(pUuid2);
+  other.Start();
+  std::vector<std::string> otherTopics;
+  other.TopicList(otherTopics);
+  EXPECT_TRUE(otherTopics.empty());
+
+  EXPECT_TRUE(discovery.Unadvertise(g_topic, nUuid1));
+  MsgAddresses_M addresses;
+  EXPECT_FALSE(discovery.Publishers(g_topic, addresses));
+}
+
 //////////////////////////////////////////////////
 /// \brief Advertise a topic without registering callbacks.
 TEST(DiscoveryTest, TestAdvertiseNoResponse)
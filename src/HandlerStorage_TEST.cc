@@ -18,21 +18,28 @@
 #include <gz/msgs/vector3d.pb.h>
 
 #include <map>
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "gz/transport/HandlerStorage.hh"
 #include "gz/transport/MessageInfo.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/RepHandler.hh"
 #include "gz/transport/SubscriptionHandler.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
 #include "gtest/gtest.h"
 
 using namespace gz;
 
 // Global variables used for multiple tests.
 std::string topic   = "foo"; // NOLINT(*)
-std::string nUuid1  = "node-UUID-1"; // NOLINT(*)
-std::string nUuid2  = "node-UUID-2"; // NOLINT(*)
+std::string nUuid1  = transport::Uuid().ToString(); // NOLINT(*)
+std::string nUuid2  = transport::Uuid().ToString(); // NOLINT(*)
 std::string hUuid   = "handler-UUID"; // NOLINT(*)
 int intResult       = 4;
 bool cbExecuted = false;
@@ -96,6 +103,12 @@ TEST(RepStorageTest, RepStorageAPI)
   EXPECT_FALSE(reps.HasHandlersForNode(topic, nUuid2));
   EXPECT_TRUE(reps.FirstHandler(topic, reqType, rep1Type, handler));
   ASSERT_TRUE(handler != NULL);
+
+  // A generic response type matches any response type.
+  EXPECT_TRUE(reps.FirstHandler(topic, transport::msgTypeId(reqType),
+    transport::kGenericMsgTypeId, handler));
+  EXPECT_FALSE(reps.FirstHandler(topic, transport::msgTypeId(rep1Type),
+    transport::kGenericMsgTypeId, handler));
   std::string handlerUuid = handler->HandlerUuid();
   EXPECT_EQ(handlerUuid, rep1HandlerPtr->HandlerUuid());
   EXPECT_TRUE(reps.Handler(topic, nUuid1, handlerUuid, handler));
@@ -239,3 +252,303 @@ TEST(RepStorageTest, SubStorageNoCallbacks)
   EXPECT_EQ(handler->NodeUuid(), sub1HandlerPtr->NodeUuid());
   EXPECT_EQ(handler->HandlerUuid(), sub1HandlerPtr->HandlerUuid());
 }
+
+//////////////////////////////////////////////////
+/// \brief Check that the handlers of a topic can be retrieved filtered by
+/// message type identifier.
+TEST(RepStorageTest, SubStorageHandlersByType)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  std::vector<transport::ISubscriptionHandlerPtr> handlers;
+  transport::MsgTypeId int32Id =
+    transport::msgTypeId(msgs::Int32().GetTypeName());
+  transport::MsgTypeId vector3dId =
+    transport::msgTypeId(msgs::Vector3d().GetTypeName());
+
+  EXPECT_FALSE(subs.Handlers(topic, int32Id, handlers));
+
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>>
+    intHandlerPtr(new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Vector3d>>
+    vecHandlerPtr(new transport::SubscriptionHandler<msgs::Vector3d>(nUuid2));
+  std::shared_ptr<transport::SubscriptionHandler<transport::ProtoMsg>>
+    genericHandlerPtr(
+      new transport::SubscriptionHandler<transport::ProtoMsg>(nUuid2));
+
+  EXPECT_EQ(int32Id, intHandlerPtr->TypeId());
+  EXPECT_EQ(vector3dId, vecHandlerPtr->TypeId());
+  EXPECT_EQ(transport::kGenericMsgTypeId, genericHandlerPtr->TypeId());
+  EXPECT_TRUE(intHandlerPtr->AcceptsType(int32Id));
+  EXPECT_FALSE(intHandlerPtr->AcceptsType(vector3dId));
+  EXPECT_TRUE(genericHandlerPtr->AcceptsType(int32Id));
+  EXPECT_TRUE(genericHandlerPtr->AcceptsType(vector3dId));
+
+  subs.AddHandler(topic, nUuid1, intHandlerPtr);
+  subs.AddHandler(topic, nUuid2, vecHandlerPtr);
+  subs.AddHandler(topic, nUuid2, genericHandlerPtr);
+
+  EXPECT_TRUE(subs.Handlers(topic, int32Id, handlers));
+  ASSERT_EQ(2u, handlers.size());
+  for (const auto &handler : handlers)
+    EXPECT_TRUE(handler->AcceptsType(int32Id));
+
+  handlers.clear();
+  EXPECT_TRUE(subs.Handlers(topic, vector3dId, handlers));
+  EXPECT_EQ(2u, handlers.size());
+
+  // Only the generic handler accepts an unknown type.
+  handlers.clear();
+  EXPECT_TRUE(subs.Handlers(topic,
+    transport::msgTypeId("gz.msgs.Unknown"), handlers));
+  ASSERT_EQ(1u, handlers.size());
+  EXPECT_EQ(genericHandlerPtr->HandlerUuid(), handlers[0]->HandlerUuid());
+
+  handlers.clear();
+  EXPECT_FALSE(subs.Handlers("unknown_topic", int32Id, handlers));
+  EXPECT_TRUE(handlers.empty());
+
+  // The type of a service handler is also available as an identifier.
+  transport::RepHandler<msgs::Vector3d, msgs::Int32> repHandler;
+  EXPECT_EQ(vector3dId, repHandler.ReqTypeId());
+  EXPECT_EQ(int32Id, repHandler.RepTypeId());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a handler list obtained with TopicHandlers() is not
+/// affected by later modifications of the storage.
+TEST(RepStorageTest, SubStorageSnapshot)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  EXPECT_EQ(nullptr, subs.TopicHandlers(topic));
+
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>>
+    sub1HandlerPtr(new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>>
+    sub2HandlerPtr(new transport::SubscriptionHandler<msgs::Int32>(nUuid2));
+
+  subs.AddHandler(topic, nUuid2, sub2HandlerPtr);
+  subs.AddHandler(topic, nUuid1, sub1HandlerPtr);
+
+  // Adding the same handler twice has no effect.
+  subs.AddHandler(topic, nUuid1, sub1HandlerPtr);
+
+  auto snapshot = subs.TopicHandlers(topic);
+  ASSERT_NE(nullptr, snapshot);
+  ASSERT_EQ(2u, snapshot->size());
+
+  // Handlers are sorted by node UUID.
+  const std::size_t first =
+    transport::Uuid::FromIdentifier(nUuid1) <
+    transport::Uuid::FromIdentifier(nUuid2) ? 0u : 1u;
+  auto sub1 = (*snapshot)[first];
+  auto sub2 = (*snapshot)[1u - first];
+  EXPECT_TRUE(transport::Uuid::FromIdentifier(nUuid1) == sub1.nUuid);
+  EXPECT_TRUE(sub1HandlerPtr->HandlerKey() == sub1.hUuid);
+  EXPECT_TRUE(transport::Uuid::FromIdentifier(nUuid2) == sub2.nUuid);
+  EXPECT_TRUE(sub2HandlerPtr->HandlerKey() == sub2.hUuid);
+
+  EXPECT_TRUE(subs.RemoveHandlersForNode(topic, nUuid1));
+  EXPECT_TRUE(subs.RemoveHandler(topic, nUuid2,
+    sub2HandlerPtr->HandlerUuid()));
+  EXPECT_FALSE(subs.HasHandlersForTopic(topic));
+  EXPECT_EQ(nullptr, subs.TopicHandlers(topic));
+
+  // The old snapshot still holds both handlers.
+  ASSERT_EQ(2u, snapshot->size());
+  EXPECT_EQ(sub1HandlerPtr, (*snapshot)[first].handler);
+  EXPECT_EQ(sub2HandlerPtr, (*snapshot)[1u - first].handler);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the version changes only when the storage changes.
+TEST(RepStorageTest, RepStorageVersion)
+{
+  transport::HandlerStorage<transport::IRepHandler> reps;
+  const uint64_t initial = reps.Version();
+
+  std::shared_ptr<transport::RepHandler<msgs::Int32, msgs::Int32>>
+    repHandlerPtr(new transport::RepHandler<msgs::Int32, msgs::Int32>());
+
+  reps.AddHandler(topic, nUuid1, repHandlerPtr);
+  const uint64_t added = reps.Version();
+  EXPECT_NE(initial, added);
+
+  // Neither lookups nor modifications without effect change the version.
+  transport::IRepHandlerPtr handler;
+  EXPECT_TRUE(reps.FirstHandler(topic, repHandlerPtr->ReqTypeId(),
+    repHandlerPtr->RepTypeId(), handler));
+  reps.AddHandler(topic, nUuid1, repHandlerPtr);
+  EXPECT_FALSE(reps.RemoveHandlersForNode(topic, nUuid2));
+  EXPECT_EQ(added, reps.Version());
+
+  EXPECT_TRUE(reps.RemoveHandlersForNode(topic, nUuid1));
+  EXPECT_NE(added, reps.Version());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the storage can be used with parsed UUIDs, and that
+/// the string and parsed UUIDs of the same identity are interchangeable.
+TEST(RepStorageTest, SubStorageUuidKeys)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>> handler(
+    new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+
+  const transport::Uuid &nodeKey = handler->NodeKey();
+  const transport::Uuid &handlerKey = handler->HandlerKey();
+  EXPECT_EQ(nUuid1, nodeKey.ToString());
+  EXPECT_EQ(handler->HandlerUuid(), handlerKey.ToString());
+
+  subs.AddHandler(topic, nodeKey, handler);
+  EXPECT_TRUE(subs.HasHandlersForNode(topic, nodeKey));
+  EXPECT_TRUE(subs.HasHandlersForNode(topic, nUuid1));
+  EXPECT_FALSE(subs.HasHandlersForNode(topic, transport::Uuid()));
+
+  std::shared_ptr<transport::ISubscriptionHandler> h;
+  EXPECT_TRUE(subs.Handler(topic, nodeKey, handlerKey, h));
+  EXPECT_EQ(handler, h);
+  EXPECT_TRUE(subs.Handler(topic, nUuid1, handler->HandlerUuid(), h));
+  EXPECT_FALSE(subs.Handler(topic, nodeKey, transport::Uuid(), h));
+
+  // The legacy map is indexed by the string form of the node UUID.
+  std::map<std::string, std::map<std::string,
+    std::shared_ptr<transport::ISubscriptionHandler>>> m;
+  ASSERT_TRUE(subs.Handlers(topic, m));
+  ASSERT_EQ(1u, m.size());
+  EXPECT_EQ(nUuid1, m.begin()->first);
+
+  EXPECT_FALSE(subs.RemoveHandler(topic, nodeKey, transport::Uuid()));
+  EXPECT_TRUE(subs.RemoveHandler(topic, nodeKey, handlerKey));
+  EXPECT_FALSE(subs.HasHandlersForNode(topic, nodeKey));
+
+  subs.AddHandler(topic, nUuid1, handler);
+  EXPECT_FALSE(subs.RemoveHandlersForNode(topic, transport::Uuid()));
+  EXPECT_TRUE(subs.RemoveHandlersForNode(topic, nodeKey));
+  EXPECT_FALSE(subs.HasHandlersForTopic(topic));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the snapshots kept by a thread are replaced when
+/// another thread changes the storage, and are never shared between
+/// storages.
+TEST(RepStorageTest, SubStorageThreadSnapshots)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>> handler(
+    new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+
+  // This thread reads the empty storage before another thread changes it.
+  EXPECT_FALSE(subs.HasHandlersForTopic(topic));
+  std::thread writer([&]()
+  {
+    subs.AddHandler(topic, nUuid1, handler);
+  });
+  writer.join();
+  EXPECT_TRUE(subs.HasHandlersForTopic(topic));
+
+  std::thread remover([&]()
+  {
+    EXPECT_TRUE(subs.RemoveHandlersForNode(topic, nUuid1));
+  });
+  remover.join();
+  EXPECT_FALSE(subs.HasHandlersForTopic(topic));
+
+  // Storages created at the address of destroyed ones, more than the
+  // snapshots kept by a thread.
+  for (int i = 0; i < 20; ++i)
+  {
+    auto storage = std::make_unique<
+      transport::HandlerStorage<transport::ISubscriptionHandler>>();
+    EXPECT_FALSE(storage->HasHandlersForTopic(topic));
+    storage->AddHandler(topic, nUuid1, handler);
+    EXPECT_TRUE(storage->HasHandlersForTopic(topic));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that topics are kept apart when there are many of them.
+TEST(RepStorageTest, SubStorageManyTopics)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  const int kTopics = 1000;
+
+  for (int i = 0; i < kTopics; ++i)
+  {
+    std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>> handler(
+      new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+    subs.AddHandler("/topic" + std::to_string(i), nUuid1, handler);
+  }
+
+  for (int i = 0; i < kTopics; ++i)
+  {
+    auto list = subs.TopicHandlers("/topic" + std::to_string(i));
+    ASSERT_NE(nullptr, list);
+    EXPECT_EQ(1u, list->size());
+  }
+
+  for (int i = 0; i < kTopics; i += 2)
+    EXPECT_TRUE(subs.RemoveHandlersForNode("/topic" + std::to_string(i),
+      nUuid1));
+
+  for (int i = 0; i < kTopics; ++i)
+  {
+    EXPECT_EQ(i % 2 == 1,
+      subs.HasHandlersForTopic("/topic" + std::to_string(i)));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the storage while other threads add and remove handlers.
+TEST(RepStorageTest, SubStorageConcurrentAccess)
+{
+  transport::HandlerStorage<transport::ISubscriptionHandler> subs;
+  transport::MsgTypeId int32Id =
+    transport::msgTypeId(msgs::Int32().GetTypeName());
+
+  // A handler that is never removed.
+  std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>> fixed(
+    new transport::SubscriptionHandler<msgs::Int32>(nUuid1));
+  subs.AddHandler(topic, nUuid1, fixed);
+
+  std::atomic<bool> done{false};
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 2; ++t)
+  {
+    writers.emplace_back([&subs, t]()
+    {
+      const std::string nUuid = "writer-" + std::to_string(t);
+      for (int i = 0; i < 500; ++i)
+      {
+        std::shared_ptr<transport::SubscriptionHandler<msgs::Int32>> handler(
+          new transport::SubscriptionHandler<msgs::Int32>(nUuid));
+        subs.AddHandler(topic, nUuid, handler);
+        subs.RemoveHandler(topic, nUuid, handler->HandlerUuid());
+      }
+    });
+  }
+
+  std::thread reader([&]()
+  {
+    while (!done)
+    {
+      auto list = subs.TopicHandlers(topic);
+      ASSERT_NE(nullptr, list);
+      bool found = false;
+      for (const auto &entry : *list)
+      {
+        EXPECT_TRUE(entry.handler->AcceptsType(int32Id));
+        found |= entry.handler == fixed;
+      }
+      EXPECT_TRUE(found);
+    }
+  });
+
+  for (auto &writer : writers)
+    writer.join();
+  done = true;
+  reader.join();
+
+  auto list = subs.TopicHandlers(topic);
+  ASSERT_NE(nullptr, list);
+  EXPECT_EQ(1u, list->size());
+}
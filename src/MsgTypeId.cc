@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gz/transport/MsgTypeId.hh"
+#include "gz/transport/TransportTypes.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE
+    {
+    /// \brief Process-wide table of interned message type names.
+    class MsgTypeRegistry
+    {
+      /// \brief Constructor. Registers the generic message type so it always
+      /// gets kGenericMsgTypeId.
+      public: MsgTypeRegistry()
+      {
+        auto it = this->ids.emplace(kGenericMessageType, kGenericMsgTypeId);
+        this->names.push_back(&it.first->first);
+      }
+
+      /// \brief Get the unique instance of the registry.
+      /// \return The registry.
+      public: static MsgTypeRegistry &Instance()
+      {
+        static MsgTypeRegistry instance;
+        return instance;
+      }
+
+      /// \sa msgTypeId
+      public: MsgTypeId Id(const std::string &_typeName)
+      {
+        if (_typeName.empty())
+          return kInvalidMsgTypeId;
+
+        // Most lookups are for names that are already registered.
+        {
+          std::shared_lock<std::shared_mutex> lk(this->mutex);
+          auto it = this->ids.find(_typeName);
+          if (it != this->ids.end())
+            return it->second;
+        }
+
+        std::unique_lock<std::shared_mutex> lk(this->mutex);
+        auto it = this->ids.find(_typeName);
+        if (it != this->ids.end())
+          return it->second;
+
+        const MsgTypeId id = static_cast<MsgTypeId>(this->ids.size()) + 1u;
+        auto inserted = this->ids.emplace(_typeName, id);
+        this->names.push_back(&inserted.first->first);
+        return id;
+      }
+
+      /// \sa msgTypeName
+      public: const std::string &Name(const MsgTypeId _id)
+      {
+        static const std::string kEmpty;
+
+        std::shared_lock<std::shared_mutex> lk(this->mutex);
+        if (_id == kInvalidMsgTypeId || _id > this->names.size())
+          return kEmpty;
+
+        // The keys of an unordered_map are never moved, so the reference
+        // remains valid after the lock is released.
+        return *this->names[_id - 1];
+      }
+
+      /// \brief Protects ids and names.
+      private: std::shared_mutex mutex;
+
+      /// \brief Identifier of each registered type name.
+      private: std::unordered_map<std::string, MsgTypeId> ids;
+
+      /// \brief Registered type names, indexed by identifier - 1. They point
+      /// to the keys of ids.
+      private: std::vector<const std::string *> names;
+    };
+
+    //////////////////////////////////////////////////
+    MsgTypeId msgTypeId(const std::string &_typeName)
+    {
+      // The identifiers never change, so each thread keeps the ones it has
+      // looked up and only locks the registry for new names.
+      thread_local std::unordered_map<std::string, MsgTypeId> known;
+      auto it = known.find(_typeName);
+      if (it != known.end())
+        return it->second;
+
+      const MsgTypeId id = MsgTypeRegistry::Instance().Id(_typeName);
+      if (id != kInvalidMsgTypeId)
+        known.emplace(_typeName, id);
+      return id;
+    }
+
+    //////////////////////////////////////////////////
+    const std::string &msgTypeName(const MsgTypeId _id)
+    {
+      return MsgTypeRegistry::Instance().Name(_id);
+    }
+    }
+  }
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/transport/MsgTypeId.hh"
+#include "gz/transport/TransportTypes.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+
+//////////////////////////////////////////////////
+/// \brief Check the reserved identifiers.
+TEST(MsgTypeIdTest, Reserved)
+{
+  EXPECT_EQ(transport::kInvalidMsgTypeId, transport::msgTypeId(""));
+  EXPECT_EQ(transport::kGenericMsgTypeId,
+    transport::msgTypeId(transport::kGenericMessageType));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that identifiers are stable and unique.
+TEST(MsgTypeIdTest, Interning)
+{
+  transport::MsgTypeId a = transport::msgTypeId("gz.msgs.MsgTypeIdA");
+  transport::MsgTypeId b = transport::msgTypeId("gz.msgs.MsgTypeIdB");
+
+  EXPECT_NE(transport::kInvalidMsgTypeId, a);
+  EXPECT_NE(transport::kGenericMsgTypeId, a);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a, transport::msgTypeId("gz.msgs.MsgTypeIdA"));
+  EXPECT_EQ(b, transport::msgTypeId("gz.msgs.MsgTypeIdB"));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the matching rules between handler and message types.
+TEST(MsgTypeIdTest, Matches)
+{
+  transport::MsgTypeId a = transport::msgTypeId("gz.msgs.MsgTypeIdA");
+  transport::MsgTypeId b = transport::msgTypeId("gz.msgs.MsgTypeIdB");
+
+  EXPECT_TRUE(transport::msgTypeMatches(a, a));
+  EXPECT_FALSE(transport::msgTypeMatches(a, b));
+  EXPECT_TRUE(transport::msgTypeMatches(transport::kGenericMsgTypeId, a));
+  EXPECT_FALSE(transport::msgTypeMatches(a, transport::kGenericMsgTypeId));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that identifiers map back to their names.
+TEST(MsgTypeIdTest, Name)
+{
+  transport::MsgTypeId a = transport::msgTypeId("gz.msgs.MsgTypeIdA");
+
+  EXPECT_EQ("gz.msgs.MsgTypeIdA", transport::msgTypeName(a));
+  EXPECT_EQ(&transport::msgTypeName(a), &transport::msgTypeName(a));
+  EXPECT_EQ(transport::kGenericMessageType,
+    transport::msgTypeName(transport::kGenericMsgTypeId));
+  EXPECT_TRUE(transport::msgTypeName(transport::kInvalidMsgTypeId).empty());
+  EXPECT_TRUE(transport::msgTypeName(1000000u).empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Register the same names from several threads and check that all of
+/// them observe the same identifiers.
+TEST(MsgTypeIdTest, Concurrent)
+{
+  const int kThreads = 8;
+  const int kNames = 100;
+  std::vector<std::vector<transport::MsgTypeId>> ids(kThreads);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&ids, t]()
+    {
+      for (int i = 0; i < kNames; ++i)
+      {
+        ids[t].push_back(
+          transport::msgTypeId("gz.msgs.Concurrent" + std::to_string(i)));
+      }
+    });
+  }
+
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int t = 1; t < kThreads; ++t)
+    EXPECT_EQ(ids[0], ids[t]);
+}
@@ -0,0 +1,579 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef _WIN32
+  #include <Winsock2.h>
+  #include <Ws2def.h>
+  #include <Ws2ipdef.h>
+  #include <Ws2tcpip.h>
+  using raw_type = char;
+#else
+  #include <arpa/inet.h>
+  #include <fcntl.h>
+  #include <netinet/in.h>
+  #include <sys/socket.h>
+  #include <sys/types.h>
+  #include <unistd.h>
+  using raw_type = void;
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "MulticastTransport.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  /// \brief Magic number at the beginning of each datagram ("GZMC").
+  constexpr uint32_t kMagic = 0x475A4D43u;
+
+  /// \brief Version of the datagram format.
+  constexpr uint8_t kVersion = 1u;
+
+  /// \brief Requested size of the socket buffers. Large messages are sent
+  /// as bursts of datagrams.
+  constexpr int kSocketBufferSize = 8 * 1024 * 1024;
+
+  //////////////////////////////////////////////////
+  /// \brief Write an unsigned integer in network byte order.
+  /// \param[in] _value The value.
+  /// \param[in] _bytes Number of bytes to write.
+  /// \param[out] _out Where to write.
+  void writeUint(const uint64_t _value, const std::size_t _bytes, char *_out)
+  {
+    for (std::size_t i = 0; i < _bytes; ++i)
+    {
+      _out[i] = static_cast<char>(
+        (_value >> (8u * (_bytes - 1u - i))) & 0xFFu);
+    }
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read an unsigned integer in network byte order.
+  /// \param[in] _in Where to read.
+  /// \param[in] _bytes Number of bytes to read.
+  /// \return The value.
+  uint64_t readUint(const char *_in, const std::size_t _bytes)
+  {
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < _bytes; ++i)
+      value = (value << 8u) | static_cast<unsigned char>(_in[i]);
+    return value;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Close a socket.
+  /// \param[in] _sock The socket.
+  void closeSocket(const int _sock)
+  {
+    if (_sock < 0)
+      return;
+#ifdef _WIN32
+    closesocket(_sock);
+#else
+    close(_sock);
+#endif
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read a string preceded by its size.
+  /// \param[in] _body The message.
+  /// \param[in, out] _pos Position of the size, moved past the string.
+  /// \param[out] _str The string.
+  /// \return False if the message is truncated.
+  bool readString(const std::string &_body, std::size_t &_pos,
+                  std::string &_str)
+  {
+    if (_pos + 2u > _body.size())
+      return false;
+    const std::size_t len =
+      static_cast<std::size_t>(readUint(&_body[_pos], 2u));
+    _pos += 2u;
+    if (_pos + len > _body.size())
+      return false;
+    _str.assign(_body, _pos, len);
+    _pos += len;
+    return true;
+  }
+}
+
+//////////////////////////////////////////////////
+MulticastTransport::MulticastTransport(const std::string &_hostAddr,
+  const std::vector<std::string> &_interfaces, const int _port)
+  : port(_port),
+    interfaces(_interfaces),
+    recvBuffer(kMaxDatagramSize)
+{
+  std::random_device rd;
+  this->stream = (static_cast<uint64_t>(rd()) << 32u) ^ rd();
+
+  this->sendSocket = static_cast<int>(socket(PF_INET, SOCK_DGRAM,
+    IPPROTO_UDP));
+  this->recvSocket = static_cast<int>(socket(PF_INET, SOCK_DGRAM,
+    IPPROTO_UDP));
+  if (this->sendSocket < 0 || this->recvSocket < 0)
+  {
+    std::cerr << "MulticastTransport: Socket creation failed." << std::endl;
+    closeSocket(this->sendSocket);
+    closeSocket(this->recvSocket);
+    this->sendSocket = -1;
+    this->recvSocket = -1;
+    return;
+  }
+
+  bool ok = true;
+
+  // Send through the interface advertised by this process, and deliver our
+  // own datagrams to the subscribers of this host.
+  struct in_addr ifAddr;
+  ifAddr.s_addr = inet_addr(_hostAddr.c_str());
+  unsigned char loop = 1;
+  ok = ok && setsockopt(this->sendSocket, IPPROTO_IP, IP_MULTICAST_IF,
+    reinterpret_cast<const char *>(&ifAddr), sizeof(ifAddr)) == 0;
+  ok = ok && setsockopt(this->sendSocket, IPPROTO_IP, IP_MULTICAST_LOOP,
+    reinterpret_cast<const char *>(&loop), sizeof(loop)) == 0;
+
+  int reuse = 1;
+  ok = ok && setsockopt(this->recvSocket, SOL_SOCKET, SO_REUSEADDR,
+    reinterpret_cast<const char *>(&reuse), sizeof(reuse)) == 0;
+#ifdef SO_REUSEPORT
+  ok = ok && setsockopt(this->recvSocket, SOL_SOCKET, SO_REUSEPORT,
+    reinterpret_cast<const char *>(&reuse), sizeof(reuse)) == 0;
+#endif
+
+#ifdef IP_MULTICAST_ALL
+  // Linux delivers to a socket bound to INADDR_ANY the datagrams of every
+  // group joined by any socket of the host on the same port, e.g. by other
+  // transport contexts. Only the groups joined with this socket are wanted.
+  int multicastAll = 0;
+  ok = ok && setsockopt(this->recvSocket, IPPROTO_IP, IP_MULTICAST_ALL,
+    reinterpret_cast<const char *>(&multicastAll),
+    sizeof(multicastAll)) == 0;
+#endif
+
+  if (!ok)
+  {
+    std::cerr << "MulticastTransport: Error setting socket options."
+              << std::endl;
+  }
+
+  // Larger buffers are best effort, the system might limit them.
+  int bufferSize = kSocketBufferSize;
+  setsockopt(this->sendSocket, SOL_SOCKET, SO_SNDBUF,
+    reinterpret_cast<const char *>(&bufferSize), sizeof(bufferSize));
+  setsockopt(this->recvSocket, SOL_SOCKET, SO_RCVBUF,
+    reinterpret_cast<const char *>(&bufferSize), sizeof(bufferSize));
+
+  sockaddr_in localAddr;
+  memset(&localAddr, 0, sizeof(localAddr));
+  localAddr.sin_family = AF_INET;
+  localAddr.sin_addr.s_addr = htonl(INADDR_ANY);
+  localAddr.sin_port = htons(static_cast<u_short>(this->port));
+  if (ok && bind(this->recvSocket,
+        reinterpret_cast<sockaddr *>(&localAddr), sizeof(localAddr)) < 0)
+  {
+    std::cerr << "MulticastTransport: Binding to port [" << this->port
+              << "] failed." << std::endl;
+    ok = false;
+  }
+
+  // Datagrams are read until there are no more.
+#ifdef _WIN32
+  u_long nonBlocking = 1;
+  ok = ok && ioctlsocket(this->recvSocket, FIONBIO, &nonBlocking) == 0;
+#else
+  const int flags = fcntl(this->recvSocket, F_GETFL, 0);
+  ok = ok && flags >= 0 &&
+    fcntl(this->recvSocket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+
+  if (!ok)
+  {
+    closeSocket(this->sendSocket);
+    closeSocket(this->recvSocket);
+    this->sendSocket = -1;
+    this->recvSocket = -1;
+  }
+}
+
+//////////////////////////////////////////////////
+MulticastTransport::~MulticastTransport()
+{
+  closeSocket(this->sendSocket);
+  closeSocket(this->recvSocket);
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::Valid() const
+{
+  return this->recvSocket >= 0;
+}
+
+//////////////////////////////////////////////////
+int MulticastTransport::Port() const
+{
+  return this->port;
+}
+
+//////////////////////////////////////////////////
+int MulticastTransport::Socket() const
+{
+  return this->recvSocket;
+}
+
+//////////////////////////////////////////////////
+std::string MulticastTransport::GroupFor(const std::string &_topic)
+{
+  // FNV-1a, the group must be the same for every process.
+  uint32_t hash = 2166136261u;
+  for (const char c : _topic)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619u;
+  }
+
+  // Zero is avoided, 239.255.0.x holds the default discovery group.
+  return "239.255." + std::to_string(1u + hash % 254u) + "." +
+    std::to_string(1u + (hash >> 8u) % 254u);
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::ParseEndpoint(const std::string &_endpoint,
+  std::string &_group, int &_port)
+{
+  const auto pos = _endpoint.rfind(':');
+  if (pos == std::string::npos || pos == 0)
+    return false;
+
+  _group = _endpoint.substr(0, pos);
+  in_addr addr;
+  if (inet_pton(AF_INET, _group.c_str(), &addr) != 1 ||
+      !IN_MULTICAST(ntohl(addr.s_addr)))
+  {
+    return false;
+  }
+
+  try
+  {
+    std::size_t end = 0;
+    const std::string portStr = _endpoint.substr(pos + 1);
+    _port = std::stoi(portStr, &end);
+    if (end != portStr.size())
+      return false;
+  }
+  catch (...)
+  {
+    return false;
+  }
+
+  return _port > 0 && _port <= 65535;
+}
+
+//////////////////////////////////////////////////
+std::string MulticastTransport::Endpoint(const std::string &_topic) const
+{
+  return GroupFor(_topic) + ":" + std::to_string(this->port);
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::Join(const std::string &_group)
+{
+  if (!this->Valid())
+    return false;
+
+  auto it = this->groups.find(_group);
+  if (it != this->groups.end())
+  {
+    ++it->second;
+    return true;
+  }
+
+  bool joined = false;
+  for (const auto &iface : this->interfaces)
+  {
+    struct ip_mreq group;
+    group.imr_multiaddr.s_addr = inet_addr(_group.c_str());
+    group.imr_interface.s_addr = inet_addr(iface.c_str());
+    if (setsockopt(this->recvSocket, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+          reinterpret_cast<const char *>(&group), sizeof(group)) == 0)
+    {
+      joined = true;
+    }
+  }
+
+  if (!joined)
+  {
+    std::cerr << "MulticastTransport: Unable to join group [" << _group
+              << "]" << std::endl;
+    return false;
+  }
+
+  this->groups[_group] = 1;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MulticastTransport::Leave(const std::string &_group)
+{
+  auto it = this->groups.find(_group);
+  if (it == this->groups.end() || --it->second > 0)
+    return;
+
+  this->groups.erase(it);
+  for (const auto &iface : this->interfaces)
+  {
+    struct ip_mreq group;
+    group.imr_multiaddr.s_addr = inet_addr(_group.c_str());
+    group.imr_interface.s_addr = inet_addr(iface.c_str());
+    setsockopt(this->recvSocket, IPPROTO_IP, IP_DROP_MEMBERSHIP,
+      reinterpret_cast<const char *>(&group), sizeof(group));
+  }
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::Send(const std::string &_group,
+  const std::string &_topic, const std::string &_sender,
+  const std::string &_msgType, const char *_data, const std::size_t _size)
+{
+  if (!this->Valid())
+    return false;
+
+  sockaddr_in dst;
+  memset(&dst, 0, sizeof(dst));
+  dst.sin_family = AF_INET;
+  dst.sin_addr.s_addr = inet_addr(_group.c_str());
+  dst.sin_port = htons(static_cast<u_short>(this->port));
+
+  const int sock = this->sendSocket;
+  return Fragment(this->stream, this->seq++, _topic, _sender, _msgType,
+    _data, _size,
+    [sock, &dst](const char *_datagram, const std::size_t _len)
+    {
+      // A full buffer drops the datagram, as the network would.
+      sendto(sock, reinterpret_cast<const raw_type *>(_datagram),
+        static_cast<int>(_len), 0, reinterpret_cast<sockaddr *>(&dst),
+        sizeof(dst));
+      return true;
+    });
+}
+
+//////////////////////////////////////////////////
+void MulticastTransport::Receive(std::vector<Message> &_msgs)
+{
+  if (!this->Valid())
+    return;
+
+  Message msg;
+  while (true)
+  {
+    const auto received = recvfrom(this->recvSocket,
+      reinterpret_cast<raw_type *>(this->recvBuffer.data()),
+      static_cast<int>(this->recvBuffer.size()), 0, nullptr, nullptr);
+    if (received <= 0)
+      return;
+
+    if (this->Process(this->recvBuffer.data(),
+          static_cast<std::size_t>(received), msg))
+    {
+      _msgs.push_back(std::move(msg));
+      msg = Message();
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::Fragment(const uint64_t _stream, const uint32_t _seq,
+  const std::string &_topic, const std::string &_sender,
+  const std::string &_msgType, const char *_data, const std::size_t _size,
+  const std::function<bool(const char *, std::size_t)> &_cb)
+{
+  if (_topic.size() > 0xFFFFu || _sender.size() > 0xFFFFu ||
+      _msgType.size() > 0xFFFFu)
+  {
+    return false;
+  }
+
+  // The strings that precede the data.
+  std::string prefix;
+  prefix.reserve(6u + _topic.size() + _sender.size() + _msgType.size());
+  for (const std::string *str : {&_topic, &_sender, &_msgType})
+  {
+    char len[2];
+    writeUint(str->size(), 2u, len);
+    prefix.append(len, 2u);
+    prefix.append(*str);
+  }
+
+  const std::size_t total = prefix.size() + _size;
+  if (total > kMaxMessageSize)
+  {
+    std::cerr << "MulticastTransport: Message of [" << total << "] bytes "
+              << "is too large" << std::endl;
+    return false;
+  }
+
+  const std::size_t fragSize = kMaxDatagramSize - kHeaderSize;
+  const std::size_t count = total == 0 ? 1u : (total + fragSize - 1u) /
+    fragSize;
+
+  char datagram[kMaxDatagramSize];
+  writeUint(kMagic, 4u, datagram);
+  writeUint(kVersion, 1u, datagram + 4);
+  writeUint(0u, 1u, datagram + 5);
+  writeUint(fragSize, 2u, datagram + 6);
+  writeUint(_stream, 8u, datagram + 8);
+  writeUint(_seq, 4u, datagram + 16);
+  writeUint(count, 4u, datagram + 24);
+  writeUint(total, 4u, datagram + 28);
+
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    writeUint(i, 4u, datagram + 20);
+
+    // Copy the part of the prefix and the part of the data in this fragment.
+    const std::size_t begin = i * fragSize;
+    const std::size_t end = std::min(begin + fragSize, total);
+    char *out = datagram + kHeaderSize;
+    for (std::size_t pos = begin; pos < end;)
+    {
+      if (pos < prefix.size())
+      {
+        const std::size_t n = std::min(end, prefix.size()) - pos;
+        memcpy(out, prefix.data() + pos, n);
+        out += n;
+        pos += n;
+      }
+      else
+      {
+        const std::size_t n = end - pos;
+        memcpy(out, _data + (pos - prefix.size()), n);
+        out += n;
+        pos += n;
+      }
+    }
+
+    if (!_cb(datagram, kHeaderSize + (end - begin)))
+      return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MulticastTransport::Process(const char *_datagram,
+  const std::size_t _size, Message &_msg)
+{
+  if (_size < kHeaderSize || readUint(_datagram, 4u) != kMagic ||
+      readUint(_datagram + 4, 1u) != kVersion)
+  {
+    return false;
+  }
+
+  const auto fragSize = static_cast<uint16_t>(readUint(_datagram + 6, 2u));
+  const uint64_t streamId = readUint(_datagram + 8, 8u);
+  const auto msgSeq = static_cast<uint32_t>(readUint(_datagram + 16, 4u));
+  const auto index = static_cast<uint32_t>(readUint(_datagram + 20, 4u));
+  const auto count = static_cast<uint32_t>(readUint(_datagram + 24, 4u));
+  const auto total = static_cast<std::size_t>(readUint(_datagram + 28, 4u));
+  const std::size_t payload = _size - kHeaderSize;
+
+  // Sanity checks, so a malformed datagram can't write out of bounds.
+  if (fragSize == 0 || total > kMaxMessageSize || count == 0 ||
+      index >= count ||
+      count != (total == 0 ? 1u : (total + fragSize - 1u) / fragSize) ||
+      static_cast<std::size_t>(index) * fragSize + payload > total ||
+      (index + 1u < count && payload != fragSize))
+  {
+    return false;
+  }
+
+  Assembly &assembly = this->assemblies[streamId];
+  if (assembly.seen)
+  {
+    // Signed distance, so the sequence numbers can wrap around.
+    const auto diff = static_cast<int32_t>(msgSeq - assembly.seq);
+    if (diff < 0 || (diff == 0 && !assembly.active))
+      return false;
+
+    if (diff > 0)
+    {
+      if (assembly.active)
+        ++this->dropped;
+      assembly.active = false;
+    }
+  }
+
+  if (!assembly.active)
+  {
+    assembly.seen = true;
+    assembly.active = true;
+    assembly.seq = msgSeq;
+    assembly.count = count;
+    assembly.received = 0;
+    assembly.fragSize = fragSize;
+    assembly.have.assign(count, false);
+    assembly.body.resize(total);
+  }
+  else if (assembly.count != count || assembly.fragSize != fragSize ||
+           assembly.body.size() != total)
+  {
+    return false;
+  }
+
+  if (assembly.have[index])
+    return false;
+
+  assembly.have[index] = true;
+  ++assembly.received;
+  if (payload > 0)
+  {
+    memcpy(&assembly.body[static_cast<std::size_t>(index) * fragSize],
+      _datagram + kHeaderSize, payload);
+  }
+
+  if (assembly.received < assembly.count)
+    return false;
+
+  assembly.active = false;
+
+  std::size_t pos = 0;
+  if (!readString(assembly.body, pos, _msg.topic) ||
+      !readString(assembly.body, pos, _msg.sender) ||
+      !readString(assembly.body, pos, _msg.msgType))
+  {
+    return false;
+  }
+  assembly.body.erase(0, pos);
+  _msg.data = std::move(assembly.body);
+  assembly.body.clear();
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+uint64_t MulticastTransport::DroppedMessages() const
+{
+  return this->dropped;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_MULTICASTTRANSPORT_HH_
+#define GZ_TRANSPORT_MULTICASTTRANSPORT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class MulticastTransport MulticastTransport.hh
+    /// \brief UDP multicast data path for topics advertised with
+    /// AdvertiseMessageOptions::SetMulticast(). A message is sent once to the
+    /// multicast group of its topic, whatever the number of subscribers.
+    ///
+    /// Messages are split in datagrams of at most kMaxDatagramSize bytes and
+    /// reassembled by the receivers. The delivery is best effort: a message
+    /// with a lost datagram is dropped, and there are no retransmissions.
+    ///
+    /// Each datagram starts with a header of kHeaderSize bytes, in network
+    /// byte order:
+    ///  * Magic number (4 bytes) and version (1 byte).
+    ///  * Reserved (1 byte).
+    ///  * Payload size of all the fragments but the last one (2 bytes).
+    ///  * Stream identifier, random for each sender (8 bytes).
+    ///  * Message sequence number within the stream (4 bytes).
+    ///  * Fragment index and number of fragments (4 bytes each).
+    ///  * Size of the message (4 bytes).
+    /// The message is made of the topic, the address of the sender and the
+    /// message type, each preceded by its size (2 bytes), followed by the
+    /// serialized data.
+    ///
+    /// This class is not thread safe.
+    class GZ_TRANSPORT_VISIBLE MulticastTransport
+    {
+      /// \brief A reassembled message.
+      public: struct Message
+      {
+        /// \brief Fully qualified topic name.
+        std::string topic;
+
+        /// \brief ZeroMQ address of the publishing process.
+        std::string sender;
+
+        /// \brief Message type name.
+        std::string msgType;
+
+        /// \brief Serialized data.
+        std::string data;
+      };
+
+      /// \brief Maximum size of a datagram, so it fits in a standard
+      /// Ethernet frame without IP fragmentation.
+      public: static constexpr std::size_t kMaxDatagramSize = 1472u;
+
+      /// \brief Size of the header of each datagram.
+      public: static constexpr std::size_t kHeaderSize = 32u;
+
+      /// \brief Largest message accepted by the receivers.
+      public: static constexpr std::size_t kMaxMessageSize =
+        512u * 1024u * 1024u;
+
+      /// \brief Default port of the multicast data, used unless
+      /// GZ_TRANSPORT_MULTICAST_PORT is set.
+      public: static constexpr int kDefaultPort = 10319;
+
+      /// \brief Constructor. Creates the sockets, check Valid() afterwards.
+      /// \param[in] _hostAddr IP address of the interface used to send.
+      /// \param[in] _interfaces IP addresses of the interfaces where the
+      /// groups are joined.
+      /// \param[in] _port UDP port of the multicast data.
+      public: MulticastTransport(const std::string &_hostAddr,
+                                 const std::vector<std::string> &_interfaces,
+                                 const int _port);
+
+      /// \brief Destructor.
+      public: ~MulticastTransport();
+
+      /// \brief Copy constructor (deleted).
+      public: MulticastTransport(const MulticastTransport &) = delete;
+
+      /// \brief Assignment operator (deleted).
+      /// \return A reference to this instance.
+      public: MulticastTransport &operator=(
+                  const MulticastTransport &) = delete;
+
+      /// \brief Whether the sockets were created.
+      /// \return True if the transport can be used.
+      public: bool Valid() const;
+
+      /// \brief Get the port of the multicast data.
+      /// \return The port.
+      public: int Port() const;
+
+      /// \brief Get the socket where the datagrams are received, to wait for
+      /// them with poll().
+      /// \return The file descriptor, or -1 if the transport isn't valid.
+      public: int Socket() const;
+
+      /// \brief Get the multicast group of a topic. It's derived from the
+      /// topic name, so topics may share a group.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return A group in 239.255.0.0/16, e.g. "239.255.12.34".
+      public: static std::string GroupFor(const std::string &_topic);
+
+      /// \brief Parse an endpoint such as "239.255.12.34:10319".
+      /// \param[in] _endpoint The endpoint.
+      /// \param[out] _group The multicast group.
+      /// \param[out] _port The port.
+      /// \return False if the endpoint is malformed.
+      public: static bool ParseEndpoint(const std::string &_endpoint,
+                                        std::string &_group, int &_port);
+
+      /// \brief Get the endpoint announced in the discovery information of a
+      /// topic published with this transport.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \return The endpoint, e.g. "239.255.12.34:10319".
+      public: std::string Endpoint(const std::string &_topic) const;
+
+      /// \brief Join a multicast group. Groups are reference counted.
+      /// \param[in] _group The group.
+      /// \return False if the group couldn't be joined.
+      public: bool Join(const std::string &_group);
+
+      /// \brief Leave a multicast group joined with Join().
+      /// \param[in] _group The group.
+      public: void Leave(const std::string &_group);
+
+      /// \brief Send a message to a multicast group.
+      /// \param[in] _group The group.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _sender ZeroMQ address of this process.
+      /// \param[in] _msgType Message type name.
+      /// \param[in] _data Serialized data.
+      /// \param[in] _size Size of the data.
+      /// \return False if a datagram couldn't be sent.
+      public: bool Send(const std::string &_group,
+                        const std::string &_topic,
+                        const std::string &_sender,
+                        const std::string &_msgType,
+                        const char *_data,
+                        const std::size_t _size);
+
+      /// \brief Read all the pending datagrams without blocking.
+      /// \param[out] _msgs The messages completed by these datagrams are
+      /// appended here.
+      public: void Receive(std::vector<Message> &_msgs);
+
+      /// \brief Split a message in datagrams.
+      /// \param[in] _stream Stream identifier.
+      /// \param[in] _seq Sequence number of the message.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _sender ZeroMQ address of the sender.
+      /// \param[in] _msgType Message type name.
+      /// \param[in] _data Serialized data.
+      /// \param[in] _size Size of the data.
+      /// \param[in] _cb Called with each datagram. Returning false stops.
+      /// \return False if the message is too large or _cb failed.
+      public: static bool Fragment(const uint64_t _stream,
+                  const uint32_t _seq,
+                  const std::string &_topic,
+                  const std::string &_sender,
+                  const std::string &_msgType,
+                  const char *_data,
+                  const std::size_t _size,
+                  const std::function<bool(const char *, std::size_t)> &_cb);
+
+      /// \brief Process a received datagram.
+      /// \param[in] _datagram The datagram.
+      /// \param[in] _size Size of the datagram.
+      /// \param[out] _msg The message, if this datagram completed it.
+      /// \return True if a message was completed.
+      public: bool Process(const char *_datagram, const std::size_t _size,
+                           Message &_msg);
+
+      /// \brief Get the number of messages that were dropped because some of
+      /// their datagrams were lost.
+      /// \return The number of messages.
+      public: uint64_t DroppedMessages() const;
+
+      /// \brief Message being reassembled for a stream.
+      private: struct Assembly
+      {
+        /// \brief Sequence number of the message.
+        uint32_t seq = 0;
+
+        /// \brief Number of fragments of the message.
+        uint32_t count = 0;
+
+        /// \brief Number of fragments received.
+        uint32_t received = 0;
+
+        /// \brief Payload size of the fragments.
+        uint16_t fragSize = 0;
+
+        /// \brief Received fragments.
+        std::vector<bool> have;
+
+        /// \brief The message being reassembled.
+        std::string body;
+
+        /// \brief Whether a message is being reassembled.
+        bool active = false;
+
+        /// \brief Whether a message of this stream has been seen.
+        bool seen = false;
+      };
+
+      /// \brief Socket used to send.
+      private: int sendSocket = -1;
+
+      /// \brief Socket used to receive.
+      private: int recvSocket = -1;
+
+      /// \brief Port of the multicast data.
+      private: int port;
+
+      /// \brief Interfaces where the groups are joined.
+      private: std::vector<std::string> interfaces;
+
+      /// \brief Reference count of the joined groups.
+      private: std::map<std::string, int> groups;
+
+      /// \brief Identifier of the messages sent by this transport.
+      private: uint64_t stream;
+
+      /// \brief Sequence number of the next message sent.
+      private: uint32_t seq = 0;
+
+      /// \brief Messages being reassembled, by stream.
+      private: std::map<uint64_t, Assembly> assemblies;
+
+      /// \brief Number of messages dropped.
+      private: uint64_t dropped = 0;
+
+      /// \brief Buffer used to receive datagrams.
+      private: std::vector<char> recvBuffer;
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_MULTICASTTRANSPORT_HH_
+#endif
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MulticastTransport.hh"
+#include "test_config.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Split a message in datagrams.
+  /// \param[in] _seq Sequence number of the message.
+  /// \param[in] _data Serialized data.
+  /// \return The datagrams.
+  std::vector<std::string> fragment(const uint32_t _seq,
+                                    const std::string &_data)
+  {
+    std::vector<std::string> datagrams;
+    EXPECT_TRUE(MulticastTransport::Fragment(1u, _seq, "@/p@/foo",
+      "tcp://127.0.0.1:1234", "gz.msgs.Bytes", _data.data(), _data.size(),
+      [&datagrams](const char *_datagram, const std::size_t _size)
+      {
+        datagrams.emplace_back(_datagram, _size);
+        return true;
+      }));
+    return datagrams;
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the groups and the endpoints.
+TEST(MulticastTransportTest, Endpoints)
+{
+  const std::string group = MulticastTransport::GroupFor("@/p@/foo");
+  EXPECT_EQ(group, MulticastTransport::GroupFor("@/p@/foo"));
+  EXPECT_EQ(0u, group.find("239.255."));
+
+  std::string parsedGroup;
+  int port = 0;
+  EXPECT_TRUE(MulticastTransport::ParseEndpoint(group + ":10319",
+    parsedGroup, port));
+  EXPECT_EQ(group, parsedGroup);
+  EXPECT_EQ(10319, port);
+
+  EXPECT_FALSE(MulticastTransport::ParseEndpoint("", parsedGroup, port));
+  EXPECT_FALSE(MulticastTransport::ParseEndpoint("239.255.1.1",
+    parsedGroup, port));
+  EXPECT_FALSE(MulticastTransport::ParseEndpoint("239.255.1.1:x",
+    parsedGroup, port));
+  EXPECT_FALSE(MulticastTransport::ParseEndpoint("10.0.0.1:10319",
+    parsedGroup, port));
+}
+
+//////////////////////////////////////////////////
+/// \brief Split messages in datagrams and reassemble them, with losses,
+/// duplicates and reordering.
+TEST(MulticastTransportTest, Reassembly)
+{
+  MulticastTransport transport("127.0.0.1", {}, 0);
+  MulticastTransport::Message msg;
+
+  // Small message.
+  auto datagrams = fragment(0u, "hello");
+  ASSERT_EQ(1u, datagrams.size());
+  EXPECT_TRUE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+  EXPECT_EQ("@/p@/foo", msg.topic);
+  EXPECT_EQ("tcp://127.0.0.1:1234", msg.sender);
+  EXPECT_EQ("gz.msgs.Bytes", msg.msgType);
+  EXPECT_EQ("hello", msg.data);
+
+  // Duplicates are ignored.
+  EXPECT_FALSE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+
+  // Large message received out of order.
+  std::string data(10 * MulticastTransport::kMaxDatagramSize, 'x');
+  for (std::size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i % 251);
+  datagrams = fragment(1u, data);
+  ASSERT_GT(datagrams.size(), 10u);
+  for (std::size_t i = datagrams.size(); i > 1; --i)
+  {
+    EXPECT_FALSE(transport.Process(datagrams[i - 1].data(),
+      datagrams[i - 1].size(), msg));
+  }
+  EXPECT_TRUE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+  EXPECT_EQ(data, msg.data);
+  EXPECT_EQ(0u, transport.DroppedMessages());
+
+  // A message with a lost datagram is dropped when the next one arrives.
+  datagrams = fragment(2u, data);
+  EXPECT_FALSE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+  datagrams = fragment(3u, "next");
+  EXPECT_TRUE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+  EXPECT_EQ("next", msg.data);
+  EXPECT_EQ(1u, transport.DroppedMessages());
+
+  // Old messages are ignored.
+  datagrams = fragment(2u, "old");
+  EXPECT_FALSE(transport.Process(datagrams[0].data(), datagrams[0].size(),
+    msg));
+
+  // Malformed datagrams are ignored.
+  std::string bad = fragment(4u, "bad")[0];
+  EXPECT_FALSE(transport.Process(bad.data(), 10u, msg));
+  bad[0] = 'x';
+  EXPECT_FALSE(transport.Process(bad.data(), bad.size(), msg));
+}
+
+//////////////////////////////////////////////////
+/// \brief Send a message through the loopback interface.
+TEST(MulticastTransportTest, Loopback)
+{
+  const int port = 11319;
+  MulticastTransport sender("127.0.0.1", {"127.0.0.1"}, port);
+  MulticastTransport receiver("127.0.0.1", {"127.0.0.1"}, port);
+  ASSERT_TRUE(sender.Valid());
+  ASSERT_TRUE(receiver.Valid());
+  EXPECT_EQ(port, receiver.Port());
+  EXPECT_GE(receiver.Socket(), 0);
+
+  const std::string topic = "@/p@/loopback";
+  const std::string group = MulticastTransport::GroupFor(topic);
+  if (!receiver.Join(group))
+    GTEST_SKIP() << "Multicast is not available on the loopback interface";
+
+  const std::string data(3 * MulticastTransport::kMaxDatagramSize, 'a');
+  std::vector<MulticastTransport::Message> msgs;
+  for (int i = 0; i < 50 && msgs.empty(); ++i)
+  {
+    EXPECT_TRUE(sender.Send(group, topic, "tcp://127.0.0.1:1", "type",
+      data.data(), data.size()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    receiver.Receive(msgs);
+  }
+
+  ASSERT_FALSE(msgs.empty());
+  EXPECT_EQ(topic, msgs[0].topic);
+  EXPECT_EQ("tcp://127.0.0.1:1", msgs[0].sender);
+  EXPECT_EQ("type", msgs[0].msgType);
+  EXPECT_EQ(data, msgs[0].data);
+
+  receiver.Leave(group);
+}
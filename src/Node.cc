@@ -18,9 +18,13 @@
 #include <gz/msgs/statistic.pb.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
 #include <csignal>
 #include <condition_variable>
+#include <cstdint>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -29,12 +33,15 @@
 #include <unordered_set>
 #include <vector>
 
+#include "gz/transport/BufferPool.hh"
 #include "gz/transport/Helpers.hh"
 #include "gz/transport/MessageInfo.hh"
+#include "gz/transport/MsgTypeId.hh"
 #include "gz/transport/Node.hh"
 #include "gz/transport/NodeOptions.hh"
 #include "gz/transport/NodeShared.hh"
 #include "gz/transport/TopicUtils.hh"
+#include "gz/transport/TransportContext.hh"
 #include "gz/transport/TransportTypes.hh"
 #include "gz/transport/Uuid.hh"
 
@@ -108,12 +115,25 @@ namespace gz
       {
       }
 
-      /// \brief Constructor
+      /// \brief Constructor. Only the information needed to publish is kept,
+      /// the rest of _publisher is already stored by the discovery service.
       /// \param[in] _publisher The message publisher.
       public: explicit PublisherPrivate(const MessagePublisher &_publisher)
         : shared(NodeShared::Instance()),
-          publisher(_publisher)
+          topic(_publisher.Topic()),
+          nUuid(_publisher.NodeKey()),
+          msgTypeId(transport::msgTypeId(_publisher.MsgTypeName())),
+          msgTypeName(&transport::msgTypeName(this->msgTypeId))
       {
+        if (_publisher.Options().Throttled())
+          this->periodNs = 1e9 / _publisher.Options().MsgsPerSec();
+      }
+
+      /// \brief Whether the publication is throttled.
+      /// \return True if the publication is throttled.
+      public: bool Throttled() const
+      {
+        return this->periodNs > 0.0;
       }
 
       /// \brief Check if this Publisher is ready to send an update based on
@@ -122,7 +142,7 @@ namespace gz
       /// \return True if it is okay to publish, false otherwise.
       public: bool ThrottledUpdateReady() const
       {
-        if (!this->publisher.Options().Throttled())
+        if (!this->Throttled())
           return true;
 
         Timestamp now = std::chrono::steady_clock::now();
@@ -141,7 +161,7 @@ namespace gz
       /// \return True if it is okay to publish, false otherwise.
       public: bool UpdateThrottling()
       {
-        if (!this->publisher.Options().Throttled())
+        if (!this->Throttled())
           return true;
 
         if (!this->ThrottledUpdateReady())
@@ -157,20 +177,29 @@ namespace gz
       /// \return True if we have a topic to publish to, otherwise false.
       public: bool Valid()
       {
-        return !this->publisher.Topic().empty();
+        return !this->topic.empty();
       }
 
       /// \brief Destructor.
       public: virtual ~PublisherPrivate()
       {
+        // Invalid publishers were never advertised.
+        if (!this->Valid())
+          return;
+
         std::lock_guard<std::recursive_mutex> lk(this->shared->mutex);
         // Notify the discovery service to unregister and unadvertise my topic.
         if (!this->shared->dataPtr->msgDiscovery->Unadvertise(
-               this->publisher.Topic(), this->publisher.NUuid()))
+               this->topic, this->nUuid))
         {
           std::cerr << "~PublisherPrivate() Error unadvertising topic ["
-                    << this->publisher.Topic() << "]" << std::endl;
+                    << this->topic << "]" << std::endl;
         }
+
+        // The last publisher of the topic in the process stops the delta
+        // encoding.
+        this->shared->dataPtr->RemoveDeltaTopic(this->topic,
+          this->shared->pUuidKey);
       }
 
       /// \brief Create a MessageInfo object for this Publisher
@@ -179,20 +208,36 @@ namespace gz
         MessageInfo info;
 
         // Set the topic and the partition at the same time
-        info.SetTopicAndPartition(this->publisher.Topic());
+        info.SetTopicAndPartition(this->topic);
 
         // Set the message type name
-        info.SetType(this->publisher.MsgTypeName());
+        info.SetType(*this->msgTypeName);
 
         return info;
       }
 
+      /// \brief Transport context of the node that advertised the topic, if
+      /// any. It keeps shared alive until the topic is unadvertised.
+      public: std::shared_ptr<TransportContext> context;
+
       /// \brief Pointer to the object shared between all the nodes within the
-      /// same process.
+      /// same process, or within the same transport context.
       public: NodeShared *shared = nullptr;
 
-      /// \brief The message publisher.
-      public: MessagePublisher publisher;
+      /// \brief Fully qualified topic name.
+      public: std::string topic;
+
+      /// \brief UUID of the node that advertised the topic.
+      public: Uuid nUuid;
+
+      /// \brief Identifier of the advertised message type.
+      public: MsgTypeId msgTypeId = kInvalidMsgTypeId;
+
+      /// \brief Name of the advertised message type. It points to the name
+      /// interned by msgTypeName(), which is shared by all the publishers of
+      /// the same type.
+      public: const std::string *msgTypeName =
+        &transport::msgTypeName(kInvalidMsgTypeId);
 
       /// \brief Timestamp of the last callback executed.
       public: Timestamp lastCbTimestamp;
@@ -204,6 +249,90 @@ namespace gz
       /// \brief Mutex to protect the node::publisher from race conditions.
       public: mutable std::mutex mutex;
     };
+
+    //////////////////////////////////////////////////
+    /// \internal
+    /// \brief Private data for Node::ServiceClient class.
+    class Node::ServiceClientPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in] _topic Fully qualified service name.
+      /// \param[in] _nUuid UUID of the node making the requests.
+      /// \param[in] _reqTypeName Message type name of the request.
+      /// \param[in] _repTypeName Message type name of the response.
+      public: ServiceClientPrivate(const std::string &_topic,
+                                   const std::string &_nUuid,
+                                   const std::string &_reqTypeName,
+                                   const std::string &_repTypeName)
+        : shared(NodeShared::Instance()),
+          topic(_topic),
+          nUuid(_nUuid),
+          reqTypeId(msgTypeId(_reqTypeName)),
+          repTypeId(msgTypeId(_repTypeName)),
+          reqTypeName(&msgTypeName(this->reqTypeId)),
+          repTypeName(&msgTypeName(this->repTypeId)),
+          id(NextId())
+      {
+      }
+
+      /// \brief Get a new client identifier.
+      /// \return The identifier, never 0.
+      public: static uint64_t NextId()
+      {
+        static std::atomic<uint64_t> lastId{0};
+        return ++lastId;
+      }
+
+      /// \brief Transport context of the node that created the client, if
+      /// any. It keeps shared alive.
+      public: std::shared_ptr<TransportContext> context;
+
+      /// \brief Pointer to the object shared between all the nodes within the
+      /// same process, or within the same transport context.
+      public: NodeShared *shared = nullptr;
+
+      /// \brief Fully qualified service name.
+      public: std::string topic;
+
+      /// \brief UUID of the node making the requests.
+      public: std::string nUuid;
+
+      /// \brief Identifier of the request type.
+      public: MsgTypeId reqTypeId = kInvalidMsgTypeId;
+
+      /// \brief Identifier of the response type.
+      public: MsgTypeId repTypeId = kInvalidMsgTypeId;
+
+      /// \brief Interned name of the request type.
+      public: const std::string *reqTypeName = nullptr;
+
+      /// \brief Interned name of the response type.
+      public: const std::string *repTypeName = nullptr;
+
+      /// \brief The responder chosen by a client for a version of the
+      /// responders. Copies of the client can be used from different threads,
+      /// so each thread keeps its own choices.
+      public: struct ResponderChoice
+      {
+        /// \brief Identifier of the client, or 0 if the choice is unused.
+        public: uint64_t clientId = 0;
+
+        /// \brief Version of the responders storage when the responder was
+        /// chosen. The choice is valid while the version doesn't change.
+        public: uint64_t version = 0;
+
+        /// \brief Responder within this process, or null if no responder of
+        /// this process accepts the types of the client.
+        public: IRepHandlerPtr responder;
+      };
+
+      /// \brief Number of clients whose choice is kept by each thread.
+      public: static constexpr std::size_t kResponderChoices = 8u;
+
+      /// \brief Identifier of the client in the choices kept by the threads.
+      /// Unlike its address, it's never reused.
+      public: const uint64_t id;
+    };
     }
   }
 }
@@ -218,11 +347,6 @@ Node::Publisher::Publisher()
 Node::Publisher::Publisher(const MessagePublisher &_publisher)
   : dataPtr(std::make_shared<PublisherPrivate>(_publisher))
 {
-  if (this->dataPtr->publisher.Options().Throttled())
-  {
-    this->dataPtr->periodNs =
-      1e9 / this->dataPtr->publisher.Options().MsgsPerSec();
-  }
 }
 
 //////////////////////////////////////////////////
@@ -251,9 +375,8 @@ bool Node::Publisher::Valid() const
 //////////////////////////////////////////////////
 bool Node::Publisher::HasConnections() const
 {
-  auto &publisher = this->dataPtr->publisher;
-  const std::string &topic = publisher.Topic();
-  const std::string &msgType = publisher.MsgTypeName();
+  const std::string &topic = this->dataPtr->topic;
+  const std::string &msgType = *this->dataPtr->msgTypeName;
 
   std::lock_guard<std::recursive_mutex> lk(this->dataPtr->shared->mutex);
 
@@ -267,20 +390,91 @@ bool Node::Publisher::HasConnections() const
      this->dataPtr->shared->remoteSubscribers.HasTopic(topic, msgType));
 }
 
+//////////////////////////////////////////////////
+std::size_t Node::Publisher::SubscriberCount() const
+{
+  if (!this->Valid())
+    return 0;
+
+  const std::string &topic = this->dataPtr->topic;
+  const std::string &msgType = *this->dataPtr->msgTypeName;
+  NodeShared *shared = this->dataPtr->shared;
+
+  std::lock_guard<std::recursive_mutex> lk(shared->mutex);
+
+  // A node might have normal and raw subscriptions.
+  const std::vector<std::string> localNodes =
+    shared->localSubscribers.NodeUuids(topic, msgType);
+  std::size_t count =
+    std::unordered_set<std::string>(localNodes.begin(), localNodes.end())
+      .size();
+
+  MsgAddresses_M remoteNodes;
+  shared->remoteSubscribers.Publishers(topic, remoteNodes);
+  for (const auto &proc : remoteNodes)
+  {
+    count += std::count_if(proc.second.begin(), proc.second.end(),
+      [&msgType](const MessagePublisher &_sub)
+      {
+        return _sub.MsgTypeName() == msgType ||
+               _sub.MsgTypeName() == kGenericMessageType;
+      });
+  }
+
+  return count;
+}
+
+//////////////////////////////////////////////////
+bool Node::Publisher::WaitForSubscribers(const std::size_t _count,
+  const std::chrono::milliseconds &_timeout) const
+{
+  if (!this->Valid())
+    return false;
+
+  NodeSharedPrivate *sharedPrivate = this->dataPtr->shared->dataPtr.get();
+  const auto deadline = std::chrono::steady_clock::now() + _timeout;
+
+  while (true)
+  {
+    uint64_t version;
+    {
+      std::lock_guard<std::mutex> lk(sharedPrivate->subscribersMutex);
+      version = sharedPrivate->subscribersVersion;
+    }
+
+    // Count without holding subscribersMutex, the discovery threads take it
+    // while holding the mutex of NodeShared.
+    if (this->SubscriberCount() >= _count)
+      return true;
+
+    std::unique_lock<std::mutex> lk(sharedPrivate->subscribersMutex);
+    if (!sharedPrivate->subscribersChanged.wait_until(lk, deadline,
+          [sharedPrivate, version]
+          {
+            return sharedPrivate->subscribersVersion != version;
+          }))
+    {
+      lk.unlock();
+      return this->SubscriberCount() >= _count;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 bool Node::Publisher::Publish(const ProtoMsg &_msg)
 {
   if (!this->Valid())
     return false;
 
-  const std::string &publisherMsgType = this->dataPtr->publisher.MsgTypeName();
+  const std::string &publisherMsgType = *this->dataPtr->msgTypeName;
 
   // Check that the msg type matches the topic type previously advertised.
-  if (publisherMsgType != _msg.GetTypeName())
+  // The descriptor gives access to the type name without building a string.
+  if (publisherMsgType != _msg.GetDescriptor()->full_name())
   {
     std::cerr << "Node::Publisher::Publish() Type mismatch.\n"
               << "\t* Type advertised: "
-              << this->dataPtr->publisher.MsgTypeName()
+              << *this->dataPtr->msgTypeName
               << "\n\t* Type published: " << _msg.GetTypeName() << std::endl;
     return false;
   }
@@ -289,11 +483,11 @@ bool Node::Publisher::Publish(const ProtoMsg &_msg)
   if (!this->UpdateThrottling())
     return true;
 
-  const std::string &publisherTopic = this->dataPtr->publisher.Topic();
+  const std::string &publisherTopic = this->dataPtr->topic;
 
   const NodeShared::SubscriberInfo &subscribers =
       this->dataPtr->shared->CheckSubscriberInfo(
-        publisherTopic, publisherMsgType);
+        publisherTopic, publisherMsgType, this->dataPtr->msgTypeId);
 
   // The serialized message size and buffer.
 #if GOOGLE_PROTOBUF_VERSION >= 3004000
@@ -307,14 +501,14 @@ bool Node::Publisher::Publish(const ProtoMsg &_msg)
   // subscriber.
   if (subscribers.haveRaw || subscribers.haveRemote)
   {
-    // Allocate the buffer to store the serialized data.
-    msgBuffer = static_cast<char *>(new char[msgSize]);
+    // Get a pooled buffer to store the serialized data.
+    msgBuffer = BufferPool::Allocate(msgSize);
 
     // Fail out early if we are unable to serialize the message. We do not
     // want to send a corrupt/bad message to some subscribers and not others.
     if (!_msg.SerializeToArray(msgBuffer, msgSize))
     {
-      delete[] msgBuffer;
+      BufferPool::Free(msgBuffer);
       std::cerr << "Node::Publisher::Publish(): Error serializing data"
                 << std::endl;
       return false;
@@ -331,72 +525,48 @@ bool Node::Publisher::Publish(const ProtoMsg &_msg)
     // This must be a shared pointer so that we can pass it to
     // multiple threads below, and then allow this function to go
     // out of scope.
-    pubMsgDetails->info.SetTopicAndPartition(this->dataPtr->publisher.Topic());
-    pubMsgDetails->info.SetType(this->dataPtr->publisher.MsgTypeName());
+    pubMsgDetails->info.SetTopicAndPartition(this->dataPtr->topic);
+    pubMsgDetails->info.SetType(*this->dataPtr->msgTypeName);
     pubMsgDetails->info.SetIntraProcess(true);
 
-    pubMsgDetails->msgCopy.reset(_msg.New());
-    pubMsgDetails->msgCopy->CopyFrom(_msg);
-
+    // Throttled handlers are dropped now, so the message is only copied
+    // when at least one local callback will run. The handlers that don't
+    // admit before decoding make their own decision later.
     if (subscribers.haveLocal)
     {
-      for (const auto &node : subscribers.localHandlers)
+      for (const auto &entry : *subscribers.localHandlers)
       {
-        for (const auto &handler : node.second)
+        if (entry.handler->AcceptsType(subscribers.msgTypeId) &&
+            (!entry.handler->AdmitsBeforeDecode() ||
+             entry.handler->AdmitMessage()))
         {
-          if (!handler.second)
-          {
-            std::cerr << "Node::Publisher::Publish(): "
-                      << "NULL local subscription handler" << std::endl;
-            continue;
-          }
-
-          if (handler.second->TypeName() != kGenericMessageType &&
-              handler.second->TypeName() != _msg.GetTypeName())
-          {
-            continue;
-          }
-
-          pubMsgDetails->localHandlers.push_back(handler.second);
+          pubMsgDetails->localHandlers.push_back(entry.handler);
         }
       }
     }
 
+    if (!pubMsgDetails->localHandlers.empty())
+    {
+      pubMsgDetails->msgCopy.reset(_msg.New());
+      pubMsgDetails->msgCopy->CopyFrom(_msg);
+    }
+
     if (subscribers.haveRaw)
     {
-      for (auto &node : subscribers.rawHandlers)
+      pubMsgDetails->msgSize = msgSize;
+      pubMsgDetails->sharedBuffer.reset(BufferPool::Allocate(msgSize));
+      memcpy(pubMsgDetails->sharedBuffer.get(), msgBuffer, msgSize);
+      for (const auto &entry : *subscribers.rawHandlers)
       {
-        for (auto &handler : node.second)
-        {
-          const RawSubscriptionHandlerPtr &rawHandler = handler.second;
-
-          if (!rawHandler)
-          {
-            std::cerr << "Node::Publisher::Publish(): "
-                      << "NULL raw subscription handler" << std::endl;
-            continue;
-          }
-
-          if (rawHandler->TypeName() != kGenericMessageType &&
-              rawHandler->TypeName() != _msg.GetTypeName())
-          {
-            continue;
-          }
-
-          if (!pubMsgDetails->sharedBuffer)
-          {
-            pubMsgDetails->msgSize = msgSize;
-            // If the sharedBuffer has not been created, do so now.
-            pubMsgDetails->sharedBuffer.reset(new char[msgSize]);
-            memcpy(pubMsgDetails->sharedBuffer.get(), msgBuffer, msgSize);
-          }
-          pubMsgDetails->rawHandlers.push_back(rawHandler);
-        }
+        if (entry.handler->AcceptsType(subscribers.msgTypeId))
+          pubMsgDetails->rawHandlers.push_back(entry.handler);
       }
     }
 
     // Add the publish message details to the publish queue. The message
     // will be published asynchronously to the local and raw callbacks.
+    if (!pubMsgDetails->localHandlers.empty() ||
+        !pubMsgDetails->rawHandlers.empty())
     {
       std::unique_lock<std::mutex> queueLock(
           this->dataPtr->shared->dataPtr->pubThreadMutex);
@@ -410,22 +580,16 @@ bool Node::Publisher::Publish(const ProtoMsg &_msg)
   // Handle remote subscribers.
   if (subscribers.haveRemote)
   {
-    // Zmq will call this lambda when the message is published.
-    // We use it to deallocate the buffer.
-    auto myDeallocator = [](void *_buffer, void *)
-    {
-      delete[] reinterpret_cast<char*>(_buffer);
-    };
-
-    if (!this->dataPtr->shared->Publish(this->dataPtr->publisher.Topic(),
-          msgBuffer, msgSize, myDeallocator, _msg.GetTypeName()))
+    // Zmq will return the buffer to the pool when the message is published.
+    if (!this->dataPtr->shared->Publish(this->dataPtr->topic,
+          msgBuffer, msgSize, BufferPool::ZmqFree, publisherMsgType))
     {
       return false;
     }
   }
   else
   {
-    delete[] msgBuffer;
+    BufferPool::Free(msgBuffer);
   }
 
   return true;
@@ -439,13 +603,13 @@ bool Node::Publisher::PublishRaw(
   if (!this->dataPtr->Valid())
     return false;
 
-  const std::string &publisherMsgType = this->dataPtr->publisher.MsgTypeName();
+  const std::string &publisherMsgType = *this->dataPtr->msgTypeName;
 
   if (publisherMsgType  != _msgType && publisherMsgType != kGenericMessageType)
   {
     std::cerr << "Node::Publisher::PublishRaw() type mismatch.\n"
               << "\t* Type advertised: "
-              << this->dataPtr->publisher.MsgTypeName()
+              << *this->dataPtr->msgTypeName
               << "\n\t* Type published: " << _msgType << std::endl;
     return false;
   }
@@ -453,10 +617,15 @@ bool Node::Publisher::PublishRaw(
   if (!this->dataPtr->UpdateThrottling())
     return true;
 
-  const std::string &topic = this->dataPtr->publisher.Topic();
+  const std::string &topic = this->dataPtr->topic;
+
+  // Generic publishers may publish any type, so only reuse the advertised
+  // type identifier when the types match.
+  const MsgTypeId typeId = publisherMsgType == _msgType ?
+    this->dataPtr->msgTypeId : msgTypeId(_msgType);
 
   const NodeShared::SubscriberInfo &subscribers =
-      this->dataPtr->shared->CheckSubscriberInfo(topic, _msgType);
+      this->dataPtr->shared->CheckSubscriberInfo(topic, _msgType, typeId);
 
   MessageInfo info;
   info.SetTopicAndPartition(topic);
@@ -471,17 +640,13 @@ bool Node::Publisher::PublishRaw(
   if (subscribers.haveRemote)
   {
     const std::size_t msgSize = _msgData.size();
-    char *msgBuffer = static_cast<char *>(new char[msgSize]);
+    char *msgBuffer = BufferPool::Allocate(msgSize);
     memcpy(msgBuffer, _msgData.c_str(), msgSize);
-    auto myDeallocator = [](void *_buffer, void * /*_hint*/)
-    {
-      delete[] reinterpret_cast<char*>(_buffer);
-    };
 
     // Note: This will copy _msgData (i.e. not zero copy)
     if (!this->dataPtr->shared->Publish(
-          this->dataPtr->publisher.Topic(),
-          msgBuffer, msgSize, myDeallocator, _msgType))
+          this->dataPtr->topic,
+          msgBuffer, msgSize, BufferPool::ZmqFree, _msgType))
     {
       return false;
     }
@@ -502,42 +667,297 @@ bool Node::Publisher::UpdateThrottling()
   return this->dataPtr->UpdateThrottling();
 }
 
+//////////////////////////////////////////////////
+Node::ServiceClient::ServiceClient()
+{
+}
+
+//////////////////////////////////////////////////
+Node::ServiceClient::ServiceClient(const std::string &_topic,
+  const std::string &_nUuid, const std::string &_reqTypeName,
+  const std::string &_repTypeName)
+  : dataPtr(std::make_shared<ServiceClientPrivate>(
+      _topic, _nUuid, _reqTypeName, _repTypeName))
+{
+}
+
+//////////////////////////////////////////////////
+Node::ServiceClient::~ServiceClient()
+{
+}
+
+//////////////////////////////////////////////////
+Node::ServiceClient::operator bool() const
+{
+  return this->Valid();
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::Valid() const
+{
+  return this->dataPtr && !this->dataPtr->topic.empty();
+}
+
+//////////////////////////////////////////////////
+const std::string &Node::ServiceClient::Service() const
+{
+  static const std::string kEmpty;
+  return this->dataPtr ? this->dataPtr->topic : kEmpty;
+}
+
+//////////////////////////////////////////////////
+const std::string &Node::ServiceClient::NodeUuid() const
+{
+  return this->dataPtr->nUuid;
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::CheckTypes(const MsgTypeId _reqTypeId,
+  const MsgTypeId _repTypeId) const
+{
+  if (!this->Valid())
+  {
+    std::cerr << "ServiceClient::Request(): Invalid client" << std::endl;
+    return false;
+  }
+
+  // A generic response takes the response type of the client.
+  if (_reqTypeId != this->dataPtr->reqTypeId ||
+      (_repTypeId != this->dataPtr->repTypeId &&
+       _repTypeId != kGenericMsgTypeId))
+  {
+    std::cerr << "ServiceClient::Request(): Type mismatch for service ["
+              << this->dataPtr->topic << "]. Expected ["
+              << *this->dataPtr->reqTypeName << "] -> ["
+              << *this->dataPtr->repTypeName << "] but got ["
+              << msgTypeName(_reqTypeId) << "] -> ["
+              << msgTypeName(_repTypeId) << "]" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::RequestGenericReply(const MsgTypeId _reqTypeId,
+  const google::protobuf::Message &_request,
+  const std::function<void(const google::protobuf::Message &_reply,
+                           const bool _result)> &_callback) const
+{
+  if (!this->CheckTypes(_reqTypeId, kGenericMsgTypeId))
+    return false;
+
+  std::unique_ptr<google::protobuf::Message> rep =
+    msgs::Factory::New(*this->dataPtr->repTypeName);
+  if (!rep)
+  {
+    std::cerr << "ServiceClient::Request(): Unable to create a response of "
+              << "type [" << *this->dataPtr->repTypeName << "]" << std::endl;
+    return false;
+  }
+
+  // If the responser is within my process.
+  IRepHandlerPtr repHandler;
+  if (this->LocalResponder(repHandler))
+  {
+    // There is a responser in my process, let's use it.
+    bool result = repHandler->RunLocalCallback(_request, *rep);
+
+    _callback(*rep, result);
+    return true;
+  }
+
+  // Create a new request handler. The response is only used to store its
+  // type.
+  auto reqHandlerPtr = std::make_shared<ReqHandler<
+    google::protobuf::Message, google::protobuf::Message>>(this->NodeUuid());
+  reqHandlerPtr->SetMessage(&_request);
+  reqHandlerPtr->SetResponse(rep.get());
+  reqHandlerPtr->SetCallback(_callback);
+
+  return this->SendRequest(reqHandlerPtr);
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::LocalResponder(IRepHandlerPtr &_handler) const
+{
+  thread_local std::array<ServiceClientPrivate::ResponderChoice,
+    ServiceClientPrivate::kResponderChoices> choices;
+  thread_local std::size_t next = 0;
+
+  auto &repliers = this->dataPtr->shared->repliers;
+
+  // Read the version before choosing the responder, so a concurrent change
+  // of the responders invalidates the choice.
+  const uint64_t version = repliers.Version();
+
+  ServiceClientPrivate::ResponderChoice *choice = nullptr;
+  for (auto &c : choices)
+  {
+    if (c.clientId == this->dataPtr->id)
+    {
+      choice = &c;
+      break;
+    }
+  }
+
+  // Choose a responder again only if the responders have changed. Neither
+  // the client nor the state shared between all the nodes is locked.
+  if (!choice || choice->version != version)
+  {
+    if (!choice)
+    {
+      choice = &choices[next];
+      next = (next + 1) % choices.size();
+      choice->clientId = this->dataPtr->id;
+    }
+    choice->version = version;
+    choice->responder.reset();
+    repliers.FirstHandler(this->dataPtr->topic, this->dataPtr->reqTypeId,
+      this->dataPtr->repTypeId, choice->responder);
+  }
+
+  _handler = choice->responder;
+  return _handler != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::SendRequest(const IReqHandlerPtr &_handler) const
+{
+  auto shared = this->dataPtr->shared;
+  const std::string &topic = this->dataPtr->topic;
+
+  shared->InitializeSrvTransport();
+
+  std::lock_guard<std::recursive_mutex> lk(shared->mutex);
+
+  // Store the request handler.
+  shared->requests.AddHandler(topic, _handler->NodeKey(), _handler);
+
+  // If the responser's address is known, make the request.
+  SrvAddresses_M addresses;
+  if (shared->TopicPublishers(topic, addresses))
+  {
+    shared->SendPendingRemoteReqs(topic, *this->dataPtr->reqTypeName,
+      *this->dataPtr->repTypeName);
+  }
+  // Discover the service responser.
+  else if (!shared->DiscoverService(topic))
+  {
+    std::cerr << "ServiceClient::Request(): Error discovering service ["
+              << topic << "]. Did you forget to start the discovery service?"
+              << std::endl;
+    shared->requests.RemoveHandler(topic, _handler->NodeKey(),
+      _handler->HandlerKey());
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Node::ServiceClient::SendRequestAndWait(const IReqHandlerPtr &_handler,
+  const unsigned int _timeout) const
+{
+  auto shared = this->dataPtr->shared;
+
+  std::unique_lock<std::recursive_mutex> lk(shared->mutex);
+
+  if (!this->SendRequest(_handler))
+    return false;
+
+  // Wait until the REP is available.
+  if (_handler->WaitUntil(lk, _timeout))
+    return true;
+
+  // Forget the request, a client making requests periodically would
+  // otherwise accumulate the handlers of the requests that timed out.
+  shared->AbandonRequest(this->dataPtr->topic, _handler->NodeKey(),
+    _handler->HandlerKey());
+  return false;
+}
+
 //////////////////////////////////////////////////
 Node::Node(const NodeOptions &_options)
-  : dataPtr(new NodePrivate())
+  : Node(std::make_shared<const NodeOptions>(_options))
 {
-  // Generate the node UUID.
-  Uuid uuid;
-  this->dataPtr->nUuid = uuid.ToString();
+}
+
+//////////////////////////////////////////////////
+Node::Node(std::shared_ptr<const NodeOptions> _options)
+  : dataPtr(std::make_shared<NodePrivate>())
+{
+  // The node UUID is generated with its private data.
+  this->dataPtr->nUuid = this->dataPtr->nUuidKey.ToString();
 
   // Save the options.
-  this->dataPtr->options = _options;
+  if (_options)
+    this->dataPtr->options = std::move(_options);
+  else
+    this->dataPtr->options = std::make_shared<const NodeOptions>();
+
+  // Use the transport of the context if there's one.
+  auto context = this->dataPtr->options->Context();
+  if (context)
+    this->dataPtr->shared = context->Shared();
+  else
+    this->dataPtr->shared = NodeShared::Instance();
+
+  this->dataPtr->shared->ConfigureThreads(*this->dataPtr->options);
+}
+
+//////////////////////////////////////////////////
+Node::Node(std::shared_ptr<NodePrivate> _dataPtr)
+  : dataPtr(std::move(_dataPtr))
+{
+  ++this->dataPtr->handles;
+}
+
+//////////////////////////////////////////////////
+std::unique_ptr<Node> Node::CreateHandle() const
+{
+  return std::unique_ptr<Node>(new Node(this->dataPtr));
 }
 
 //////////////////////////////////////////////////
 Node::~Node()
 {
+  // The other handles of the node keep its subscriptions and services.
+  if (--this->dataPtr->handles > 0)
+    return;
+
+  // The sets of subscribed topics and advertised services are only modified
+  // by this node and its handles, and this is the last one. A node that
+  // never subscribed nor advertised a service doesn't need to touch the
+  // state shared with the rest of the nodes.
+
   // Unsubscribe from all the topics.
-  auto subsTopics = this->SubscribedTopics();
-  for (auto const &topic : subsTopics)
-    this->Unsubscribe(topic);
+  if (!this->dataPtr->topicsSubscribed.empty())
+  {
+    auto subsTopics = this->SubscribedTopics();
+    for (auto const &topic : subsTopics)
+      this->Unsubscribe(topic);
 
-  // The list of subscribed topics should be empty.
-  assert(this->SubscribedTopics().empty());
+    // The list of subscribed topics should be empty.
+    assert(this->SubscribedTopics().empty());
+  }
 
   // Unadvertise all my services.
-  auto advServices = this->AdvertisedServices();
-  for (auto const &service : advServices)
+  if (!this->dataPtr->srvsAdvertised.empty())
   {
-    if (!this->UnadvertiseSrv(service))
+    auto advServices = this->AdvertisedServices();
+    for (auto const &service : advServices)
     {
-      std::cerr << "Node::~Node(): Error unadvertising service ["
-                << service << "]" << std::endl;
+      if (!this->UnadvertiseSrv(service))
+      {
+        std::cerr << "Node::~Node(): Error unadvertising service ["
+                  << service << "]" << std::endl;
+      }
     }
-  }
 
-  // The list of advertised services should be empty.
-  assert(this->AdvertisedServices().empty());
+    // The list of advertised services should be empty.
+    assert(this->AdvertisedServices().empty());
+  }
 }
 
 //////////////////////////////////////////////////
@@ -547,12 +967,17 @@ std::vector<std::string> Node::AdvertisedTopics() const
   std::unordered_set<std::string> result;
   std::vector<MessagePublisher> pubs;
 
+  // Nothing has been advertised if the transport of topics is not
+  // initialized.
+  if (!this->dataPtr->shared->dataPtr->msgTransportInitialized)
+    return v;
+
   {
     std::lock_guard<std::recursive_mutex> lk(this->dataPtr->shared->mutex);
 
-    auto pUUID = this->dataPtr->shared->pUuid;
     auto &info = this->dataPtr->shared->dataPtr->msgDiscovery->Info();
-    info.PublishersByNode(pUUID, this->NodeUuid(), pubs);
+    info.PublishersByNode(this->dataPtr->shared->pUuidKey, this->NodeKey(),
+      pubs);
   }
 
   // Copy the topics to a std::set for removing duplications.
@@ -615,13 +1040,16 @@ bool Node::Unsubscribe(const std::string &_topic)
 
   // Remove the subscribers for the given topic that belong to this node.
   this->dataPtr->shared->localSubscribers.RemoveHandlersForNode(
-        fullyQualifiedTopic, this->dataPtr->nUuid);
+        fullyQualifiedTopic, this->dataPtr->nUuidKey);
 
   // Remove the topic from the list of subscribed topics in this node.
   this->dataPtr->topicsSubscribed.erase(fullyQualifiedTopic);
 
+  this->dataPtr->shared->InitializeMsgTransport();
+
   // Remove the filter for this topic if I am the last subscriber.
-  if (!this->dataPtr->shared->localSubscribers
+  if (this->dataPtr->shared->dataPtr->msgSocketsReady &&
+      !this->dataPtr->shared->localSubscribers
       .HasSubscriber(fullyQualifiedTopic))
   {
 #ifdef GZ_CPPZMQ_POST_4_7_0
@@ -631,6 +1059,19 @@ bool Node::Unsubscribe(const std::string &_topic)
     this->dataPtr->shared->dataPtr->subscriber->setsockopt(
       ZMQ_UNSUBSCRIBE, fullyQualifiedTopic.data(), fullyQualifiedTopic.size());
 #endif
+    this->dataPtr->shared->dataPtr->LeaveMulticast(fullyQualifiedTopic);
+
+    // Remove the filter and the decoders of the deltas, if any.
+    const std::string deltaTopic =
+      DeltaEncoder::kTopicPrefix + fullyQualifiedTopic;
+#ifdef GZ_CPPZMQ_POST_4_7_0
+    this->dataPtr->shared->dataPtr->subscriber->set(
+      zmq::sockopt::unsubscribe, deltaTopic);
+#else
+    this->dataPtr->shared->dataPtr->subscriber->setsockopt(
+      ZMQ_UNSUBSCRIBE, deltaTopic.data(), deltaTopic.size());
+#endif
+    this->dataPtr->shared->dataPtr->deltaDecoders.erase(fullyQualifiedTopic);
   }
 
   // Notify to the publishers that I am no longer interested in the topic.
@@ -686,6 +1127,8 @@ bool Node::UnadvertiseSrv(const std::string &_topic)
     return false;
   }
 
+  this->dataPtr->shared->InitializeSrvTransport();
+
   std::lock_guard<std::recursive_mutex> lk(this->dataPtr->shared->mutex);
 
   // Remove the topic from the list of advertised topics in this node.
@@ -693,11 +1136,11 @@ bool Node::UnadvertiseSrv(const std::string &_topic)
 
   // Remove all the REP handlers for this node.
   this->dataPtr->shared->repliers.RemoveHandlersForNode(
-    fullyQualifiedTopic, this->dataPtr->nUuid);
+    fullyQualifiedTopic, this->dataPtr->nUuidKey);
 
   // Notify the discovery service to unregister and unadvertise my services.
   if (!this->dataPtr->shared->dataPtr->srvDiscovery->Unadvertise(
-        fullyQualifiedTopic, this->dataPtr->nUuid))
+        fullyQualifiedTopic, this->dataPtr->nUuidKey))
   {
     return false;
   }
@@ -705,12 +1148,66 @@ bool Node::UnadvertiseSrv(const std::string &_topic)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Node::InvalidateServiceCache(const std::string &_service)
+{
+  // Topic remapping.
+  std::string service = _service;
+  this->Options().TopicRemap(_service, service);
+
+  std::string fullyQualifiedTopic;
+  if (!TopicUtils::FullyQualifiedName(this->Options().Partition(),
+    this->Options().NameSpace(), service, fullyQualifiedTopic))
+  {
+    std::cerr << "Service [" << _service << "] is not valid." << std::endl;
+    return false;
+  }
+
+  this->dataPtr->shared->InitializeSrvTransport();
+  auto &srvDiscovery = this->dataPtr->shared->dataPtr->srvDiscovery;
+  ServicePublisher publisher;
+  {
+    std::lock_guard<std::recursive_mutex> lk(this->dataPtr->shared->mutex);
+
+    if (this->dataPtr->srvsAdvertised.find(fullyQualifiedTopic) ==
+        this->dataPtr->srvsAdvertised.end())
+    {
+      std::cerr << "Node::InvalidateServiceCache(): Service ["
+                << _service << "] is not advertised by this node" << std::endl;
+      return false;
+    }
+
+    if (!srvDiscovery->Info().Publisher(fullyQualifiedTopic,
+          this->dataPtr->shared->pUuidKey, this->dataPtr->nUuidKey, publisher))
+    {
+      return false;
+    }
+  }
+
+  AdvertiseServiceOptions opts = publisher.Options();
+  if (!opts.Cacheable())
+  {
+    std::cerr << "Node::InvalidateServiceCache(): Service ["
+              << _service << "] is not cacheable" << std::endl;
+    return false;
+  }
+
+  // The requesters of this process share the cache of NodeShared.
+  this->dataPtr->shared->dataPtr->srvResponseCache.Invalidate(
+    fullyQualifiedTopic);
+
+  opts.SetCacheVersion(opts.CacheVersion() + 1);
+  publisher.SetOptions(opts);
+  return srvDiscovery->UpdateAdvertisement(publisher);
+}
+
 //////////////////////////////////////////////////
 void Node::TopicList(std::vector<std::string> &_topics) const
 {
   std::vector<std::string> allTopics;
   _topics.clear();
 
+  this->dataPtr->shared->InitializeMsgTransport();
   this->dataPtr->shared->dataPtr->msgDiscovery->TopicList(allTopics);
 
   for (const auto &fullyQualifiedTopic : allTopics)
@@ -738,6 +1235,7 @@ void Node::ServiceList(std::vector<std::string> &_services) const
   std::vector<std::string> allServices;
   _services.clear();
 
+  this->dataPtr->shared->InitializeSrvTransport();
   this->dataPtr->shared->dataPtr->srvDiscovery->TopicList(allServices);
 
   for (auto &service : allServices)
@@ -771,8 +1269,8 @@ bool Node::SubscribeRaw(
   this->Options().TopicRemap(_topic, topic);
 
   std::string fullyQualifiedTopic;
-  if (!TopicUtils::FullyQualifiedName(this->dataPtr->options.Partition(),
-                                      this->dataPtr->options.NameSpace(),
+  if (!TopicUtils::FullyQualifiedName(this->Options().Partition(),
+                                      this->Options().NameSpace(),
                                       _topic, fullyQualifiedTopic))
   {
     std::cerr << "Topic [" << _topic << "] is not valid." << std::endl;
@@ -788,13 +1286,42 @@ bool Node::SubscribeRaw(
   std::lock_guard<std::recursive_mutex> lk(this->dataPtr->shared->mutex);
 
   this->dataPtr->shared->localSubscribers.raw.AddHandler(
-        fullyQualifiedTopic, this->dataPtr->nUuid, handlerPtr);
+        fullyQualifiedTopic, this->dataPtr->nUuidKey, handlerPtr);
 
   return this->dataPtr->SubscribeHelper(fullyQualifiedTopic);
 }
 
+//////////////////////////////////////////////////
+Node::ServiceClient Node::CreateServiceClient(const std::string &_topic,
+  const std::string &_reqTypeName, const std::string &_repTypeName)
+{
+  // Topic remapping.
+  std::string topic = _topic;
+  this->Options().TopicRemap(_topic, topic);
+
+  std::string fullyQualifiedTopic;
+  if (!TopicUtils::FullyQualifiedName(this->Options().Partition(),
+    this->Options().NameSpace(), topic, fullyQualifiedTopic))
+  {
+    std::cerr << "Service [" << topic << "] is not valid." << std::endl;
+    return ServiceClient();
+  }
+
+  ServiceClient client(fullyQualifiedTopic, this->NodeUuid(), _reqTypeName,
+    _repTypeName);
+  client.dataPtr->shared = this->Shared();
+  client.dataPtr->context = this->Options().Context();
+  return client;
+}
+
 //////////////////////////////////////////////////
 const NodeOptions &Node::Options() const
+{
+  return *this->dataPtr->options;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const NodeOptions> Node::SharedOptions() const
 {
   return this->dataPtr->options;
 }
@@ -867,6 +1394,12 @@ const std::string &Node::NodeUuid() const
   return this->dataPtr->nUuid;
 }
 
+//////////////////////////////////////////////////
+const Uuid &Node::NodeKey() const
+{
+  return this->dataPtr->nUuidKey;
+}
+
 //////////////////////////////////////////////////
 std::unordered_set<std::string> &Node::TopicsSubscribed() const
 {
@@ -883,6 +1416,7 @@ std::unordered_set<std::string> &Node::SrvsAdvertised() const
 bool Node::TopicInfo(const std::string &_topic,
                      std::vector<MessagePublisher> &_publishers) const
 {
+  this->dataPtr->shared->InitializeMsgTransport();
   this->dataPtr->shared->dataPtr->msgDiscovery->WaitForInit();
 
   // Construct a topic name with the partition and namespace
@@ -927,6 +1461,7 @@ bool Node::TopicInfo(const std::string &_topic,
 bool Node::ServiceInfo(const std::string &_service,
                        std::vector<ServicePublisher> &_publishers) const
 {
+  this->dataPtr->shared->InitializeSrvTransport();
   this->dataPtr->shared->dataPtr->srvDiscovery->WaitForInit();
 
   // Construct a topic name with the partition and namespace
@@ -983,6 +1518,8 @@ Node::Publisher Node::Advertise(const std::string &_topic,
     return Publisher();
   }
 
+  this->Shared()->InitializeMsgTransport();
+
   auto currentTopics = this->AdvertisedTopics();
 
   if (std::find(currentTopics.begin(), currentTopics.end(),
@@ -997,6 +1534,15 @@ Node::Publisher Node::Advertise(const std::string &_topic,
 
   std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
 
+  // All the publishers of a topic in a process share its delta encoding.
+  if (!this->Shared()->dataPtr->CheckDeltaTopic(fullyQualifiedTopic,
+        _options.DeltaKeyframeInterval()))
+  {
+    std::cerr << "Topic [" << topic << "] is already advertised with a "
+      << "different delta keyframe interval in this process." << std::endl;
+    return Publisher();
+  }
+
   // Notify the discovery service to register and advertise my topic.
   MessagePublisher publisher(fullyQualifiedTopic,
       this->Shared()->myAddress,
@@ -1004,6 +1550,11 @@ Node::Publisher Node::Advertise(const std::string &_topic,
       "unused",
       this->Shared()->pUuid, this->NodeUuid(), _msgTypeName, _options);
 
+  // Announce the multicast endpoint of the topic, if requested.
+  if (_options.Multicast())
+    publisher.SetMulticastAddr(
+      this->Shared()->AdvertiseMulticast(fullyQualifiedTopic));
+
   if (!this->Shared()->dataPtr->msgDiscovery->Advertise(publisher))
   {
     std::cerr << "Node::Advertise(): Error advertising topic ["
@@ -1013,7 +1564,110 @@ Node::Publisher Node::Advertise(const std::string &_topic,
     return Publisher();
   }
 
-  return Publisher(publisher);
+  // Prepare the delta encoding of the topic, if requested.
+  if (_options.DeltaKeyframeInterval() > 0)
+  {
+    this->Shared()->dataPtr->deltaTopics.try_emplace(fullyQualifiedTopic,
+      _options.DeltaKeyframeInterval());
+  }
+
+  Publisher pub(publisher);
+  pub.dataPtr->shared = this->Shared();
+  pub.dataPtr->context = this->Options().Context();
+  return pub;
+}
+
+//////////////////////////////////////////////////
+std::vector<Node::Publisher> Node::AdvertiseMany(
+    const std::vector<std::string> &_topics,
+    const std::string &_msgTypeName,
+    const AdvertiseMessageOptions &_options)
+{
+  std::vector<Node::Publisher> result(_topics.size());
+
+  // Fully qualified names of the valid topics and their index in _topics.
+  std::vector<MessagePublisher> publishers;
+  std::vector<std::size_t> indexes;
+  std::unordered_set<std::string> requested;
+  publishers.reserve(_topics.size());
+  indexes.reserve(_topics.size());
+
+  this->Shared()->InitializeMsgTransport();
+
+  std::lock_guard<std::recursive_mutex> lk(this->Shared()->mutex);
+
+  for (std::size_t i = 0; i < _topics.size(); ++i)
+  {
+    // Topic remapping.
+    std::string topic = _topics[i];
+    this->Options().TopicRemap(_topics[i], topic);
+
+    std::string fullyQualifiedTopic;
+    if (!TopicUtils::FullyQualifiedName(this->Options().Partition(),
+          this->Options().NameSpace(), topic, fullyQualifiedTopic))
+    {
+      std::cerr << "Topic [" << topic << "] is not valid." << std::endl;
+      continue;
+    }
+
+    if (!requested.insert(fullyQualifiedTopic).second)
+    {
+      std::cerr << "Topic [" << topic << "] already advertised. You cannot"
+        << " advertise the same topic twice on the same node." << std::endl;
+      continue;
+    }
+
+    if (!this->Shared()->dataPtr->CheckDeltaTopic(fullyQualifiedTopic,
+          _options.DeltaKeyframeInterval()))
+    {
+      std::cerr << "Topic [" << topic << "] is already advertised with a "
+        << "different delta keyframe interval in this process." << std::endl;
+      continue;
+    }
+
+    publishers.emplace_back(fullyQualifiedTopic,
+      this->Shared()->myAddress, "unused",
+      this->Shared()->pUuid, this->NodeUuid(), _msgTypeName, _options);
+    if (_options.Multicast())
+    {
+      publishers.back().SetMulticastAddr(
+        this->Shared()->AdvertiseMulticast(fullyQualifiedTopic));
+    }
+    indexes.push_back(i);
+  }
+
+  // Notify the discovery service to register and advertise my topics. Topics
+  // that this node already advertised are rejected by the discovery service.
+  std::vector<bool> advertised;
+  if (!this->Shared()->dataPtr->msgDiscovery->Advertise(
+        publishers, advertised))
+  {
+    std::cerr << "Node::AdvertiseMany(): Error advertising topics. Did you "
+      << "forget to start the discovery service?" << std::endl;
+    return result;
+  }
+
+  for (std::size_t i = 0; i < publishers.size(); ++i)
+  {
+    if (!advertised[i])
+    {
+      std::cerr << "Topic [" << _topics[indexes[i]] << "] already advertised."
+        << " You cannot advertise the same topic twice on the same node."
+        << std::endl;
+      continue;
+    }
+    if (_options.DeltaKeyframeInterval() > 0)
+    {
+      this->Shared()->dataPtr->deltaTopics.try_emplace(
+        publishers[i].Topic(), _options.DeltaKeyframeInterval());
+    }
+    Publisher pub(publishers[i]);
+    pub.dataPtr->shared = this->Shared();
+    pub.dataPtr->context = this->Options().Context();
+    result[indexes[i]] = pub;
+  }
+
+  return result;
 }
 
 //////////////////////////////////////////////////
@@ -1022,6 +1676,10 @@ bool NodePrivate::SubscribeHelper(const std::string &_fullyQualifiedTopic)
   // Add the topic to the list of subscribed topics (if it was not before).
   this->topicsSubscribed.insert(_fullyQualifiedTopic);
 
+  this->shared->dataPtr->NotifySubscribersChanged();
+
+  this->shared->InitializeMsgTransport();
+
   // Discover the list of nodes that publish on the topic.
   if (!this->shared->dataPtr->msgDiscovery->Discover(_fullyQualifiedTopic))
   {
@@ -1041,6 +1699,79 @@ bool Node::SubscribeHelper(const std::string &_fullyQualifiedTopic)
   return this->dataPtr->SubscribeHelper(_fullyQualifiedTopic);
 }
 
+//////////////////////////////////////////////////
+bool Node::RequestGenericReply(const std::string &_fullyQualifiedTopic,
+  const MsgTypeId _reqTypeId, const google::protobuf::Message &_request,
+  const std::function<void(const google::protobuf::Message &_reply,
+                           const bool _result)> &_callback)
+{
+  NodeShared *shared = this->Shared();
+
+  // If the responser is within my process, the response has its type.
+  IRepHandlerPtr repHandler;
+  if (shared->repliers.FirstHandler(_fullyQualifiedTopic, _reqTypeId,
+        kGenericMsgTypeId, repHandler))
+  {
+    std::unique_ptr<google::protobuf::Message> rep =
+      msgs::Factory::New(repHandler->RepTypeName());
+    if (!rep)
+    {
+      std::cerr << "Node::Request(): Unable to create a response of type ["
+                << repHandler->RepTypeName() << "]" << std::endl;
+      return false;
+    }
+
+    bool result = repHandler->RunLocalCallback(_request, *rep);
+    _callback(*rep, result);
+    return true;
+  }
+
+  // Create a new request handler. It accepts any response type until it
+  // is sent to a responder.
+  auto reqHandlerPtr = std::make_shared<ReqHandler<
+    google::protobuf::Message, google::protobuf::Message>>(this->NodeUuid());
+  reqHandlerPtr->SetMessage(&_request);
+  reqHandlerPtr->SetCallback(_callback);
+
+  shared->InitializeSrvTransport();
+
+  std::lock_guard<std::recursive_mutex> lk(shared->mutex);
+
+  // Store the request handler.
+  shared->requests.AddHandler(_fullyQualifiedTopic, this->NodeKey(),
+    reqHandlerPtr);
+
+  // If a responser accepting the request is known, make the request.
+  SrvAddresses_M addresses;
+  if (shared->TopicPublishers(_fullyQualifiedTopic, addresses))
+  {
+    const std::string &reqTypeName = msgTypeName(_reqTypeId);
+    for (const auto &proc : addresses)
+    {
+      for (const auto &pub : proc.second)
+      {
+        if (pub.ReqTypeName() == reqTypeName)
+        {
+          shared->SendPendingRemoteReqs(_fullyQualifiedTopic, reqTypeName,
+            pub.RepTypeName());
+          return true;
+        }
+      }
+    }
+  }
+  // Discover the service responser.
+  else if (!shared->DiscoverService(_fullyQualifiedTopic))
+  {
+    std::cerr << "Node::Request(): Error discovering service ["
+              << _fullyQualifiedTopic
+              << "]. Did you forget to start the discovery service?"
+              << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
 //////////////////////////////////////////////////
 bool NodePrivate::RemoveHandlersFromPubQueue(const std::string &_topic)
 {
@@ -1058,10 +1789,8 @@ bool NodePrivate::RemoveHandlersFromPubQueue(const std::string &_topic)
     for (auto handlerIt = msgDetails->localHandlers.begin();
          handlerIt != msgDetails->localHandlers.end();)
     {
-      if ((*handlerIt)->NodeUuid() == this->nUuid)
-      {
-        msgDetails->localHandlers.erase(handlerIt);
-      }
+      if ((*handlerIt)->NodeKey() == this->nUuidKey)
+        handlerIt = msgDetails->localHandlers.erase(handlerIt);
       else
         ++handlerIt;
     }
@@ -1070,10 +1799,8 @@ bool NodePrivate::RemoveHandlersFromPubQueue(const std::string &_topic)
     for (auto handlerIt = msgDetails->rawHandlers.begin();
          handlerIt != msgDetails->rawHandlers.end();)
     {
-      if ((*handlerIt)->NodeUuid() == this->nUuid)
-      {
-        msgDetails->rawHandlers.erase(handlerIt);
-      }
+      if ((*handlerIt)->NodeKey() == this->nUuidKey)
+        handlerIt = msgDetails->rawHandlers.erase(handlerIt);
       else
         ++handlerIt;
     }
@@ -16,7 +16,10 @@
 */
 
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "gz/transport/Helpers.hh"
 #include "gz/transport/NodeOptions.hh"
@@ -48,9 +51,8 @@ NodeOptions::NodeOptions()
 
 //////////////////////////////////////////////////
 NodeOptions::NodeOptions(const NodeOptions &_other)
-  : dataPtr(new NodeOptionsPrivate())
+  : dataPtr(new NodeOptionsPrivate(*_other.dataPtr))
 {
-  (*this) = _other;
 }
 
 //////////////////////////////////////////////////
@@ -64,6 +66,8 @@ NodeOptions &NodeOptions::operator=(const NodeOptions &_other)
   this->SetNameSpace(_other.NameSpace());
   this->SetPartition(_other.Partition());
   this->dataPtr->topicsRemap = _other.dataPtr->topicsRemap;
+  this->dataPtr->threadConfigs = _other.dataPtr->threadConfigs;
+  this->dataPtr->context = _other.dataPtr->context;
   return *this;
 }
 
@@ -143,3 +147,110 @@ bool NodeOptions::TopicRemap(const std::string &_fromTopic,
 
   return topicIt != this->dataPtr->topicsRemap.end();
 }
+
+//////////////////////////////////////////////////
+bool NodeOptions::SetThreadAffinity(const TransportThread _thread,
+  const std::vector<int> &_cpus)
+{
+  if (_thread == TransportThread::ZMQ_IO)
+  {
+    std::cerr << "The ZeroMQ I/O thread can only be configured with "
+              << "environment variables" << std::endl;
+    return false;
+  }
+
+  for (const int cpu : _cpus)
+  {
+    if (cpu < 0)
+    {
+      std::cerr << "Invalid CPU [" << cpu << "]" << std::endl;
+      return false;
+    }
+  }
+
+  this->dataPtr->threadConfigs[_thread].cpus = _cpus;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::vector<int> NodeOptions::ThreadAffinity(
+  const TransportThread _thread) const
+{
+  auto it = this->dataPtr->threadConfigs.find(_thread);
+  if (it == this->dataPtr->threadConfigs.end())
+    return {};
+  return it->second.cpus;
+}
+
+//////////////////////////////////////////////////
+bool NodeOptions::SetThreadPriority(const TransportThread _thread,
+  const int _priority)
+{
+  if (_thread == TransportThread::ZMQ_IO)
+  {
+    std::cerr << "The ZeroMQ I/O thread can only be configured with "
+              << "environment variables" << std::endl;
+    return false;
+  }
+
+  if (_priority < 1 || _priority > 99)
+  {
+    std::cerr << "Invalid priority [" << _priority << "], it should be in "
+              << "[1, 99]" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->threadConfigs[_thread].priority = _priority;
+  return true;
+}
+
+//////////////////////////////////////////////////
+int NodeOptions::ThreadPriority(const TransportThread _thread) const
+{
+  auto it = this->dataPtr->threadConfigs.find(_thread);
+  if (it == this->dataPtr->threadConfigs.end())
+    return 0;
+  return it->second.priority;
+}
+
+//////////////////////////////////////////////////
+bool NodeOptions::SetThreadName(const TransportThread _thread,
+  const std::string &_name)
+{
+  if (_thread == TransportThread::ZMQ_IO)
+  {
+    std::cerr << "The ZeroMQ I/O thread can only be configured with "
+              << "environment variables" << std::endl;
+    return false;
+  }
+
+  if (_name.empty())
+  {
+    std::cerr << "Invalid empty thread name" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->threadConfigs[_thread].name = _name;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::string NodeOptions::ThreadName(const TransportThread _thread) const
+{
+  auto it = this->dataPtr->threadConfigs.find(_thread);
+  if (it == this->dataPtr->threadConfigs.end())
+    return "";
+  return it->second.name;
+}
+
+//////////////////////////////////////////////////
+void NodeOptions::SetContext(std::shared_ptr<TransportContext> _context)
+{
+  this->dataPtr->context = std::move(_context);
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<TransportContext> NodeOptions::Context() const
+{
+  return this->dataPtr->context;
+}
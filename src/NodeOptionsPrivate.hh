@@ -19,10 +19,13 @@
 #define GZ_TRANSPORT_NODEOPTIONSPRIVATE_HH_
 
 #include <map>
+#include <memory>
 #include <string>
 
 #include "gz/transport/config.hh"
 #include "gz/transport/NetUtils.hh"
+#include "gz/transport/TransportContext.hh"
+#include "ThreadConfig.hh"
 
 namespace gz
 {
@@ -50,6 +53,14 @@ namespace gz
       /// \brief Table of remappings. The key is the original topic name and
       /// its value is the new topic name to be used instead.
       public: std::map<std::string, std::string> topicsRemap;
+
+      /// \brief Configuration of the transport threads set with these
+      /// options. Values not set are left to the environment.
+      public: std::map<TransportThread, ThreadConfig> threadConfigs;
+
+      /// \brief Transport context of the node, or nullptr to use the
+      /// transport of the process.
+      public: std::shared_ptr<TransportContext> context;
     };
     }
   }
@@ -16,6 +16,7 @@
 */
 
 #include <string>
+#include <vector>
 
 #include "gz/transport/NetUtils.hh"
 #include "gz/transport/NodeOptions.hh"
@@ -73,3 +74,50 @@ TEST(NodeOptionsTest, accessors)
   EXPECT_TRUE(opts.SetPartition(aPartition));
   EXPECT_EQ(opts.Partition(), aPartition);
 }
+
+//////////////////////////////////////////////////
+/// \brief Check the configuration of the transport threads.
+TEST(NodeOptionsTest, threads)
+{
+  transport::NodeOptions opts;
+  const auto kThread = transport::TransportThread::RECEPTION;
+
+  // Nothing is set by default.
+  EXPECT_TRUE(opts.ThreadAffinity(kThread).empty());
+  EXPECT_EQ(0, opts.ThreadPriority(kThread));
+  EXPECT_TRUE(opts.ThreadName(kThread).empty());
+
+  // Affinity.
+  EXPECT_FALSE(opts.SetThreadAffinity(kThread, {0, -1}));
+  EXPECT_TRUE(opts.ThreadAffinity(kThread).empty());
+  EXPECT_TRUE(opts.SetThreadAffinity(kThread, {0, 1}));
+  EXPECT_EQ(std::vector<int>({0, 1}), opts.ThreadAffinity(kThread));
+
+  // Priority.
+  EXPECT_FALSE(opts.SetThreadPriority(kThread, 0));
+  EXPECT_FALSE(opts.SetThreadPriority(kThread, 100));
+  EXPECT_TRUE(opts.SetThreadPriority(kThread, 10));
+  EXPECT_EQ(10, opts.ThreadPriority(kThread));
+
+  // Name.
+  EXPECT_FALSE(opts.SetThreadName(kThread, ""));
+  EXPECT_TRUE(opts.SetThreadName(kThread, "my-recv"));
+  EXPECT_EQ("my-recv", opts.ThreadName(kThread));
+
+  // The other threads are not affected.
+  EXPECT_TRUE(
+    opts.ThreadAffinity(transport::TransportThread::PUBLISH).empty());
+
+  // The ZeroMQ I/O thread can't be configured with the options.
+  const auto kZmqIo = transport::TransportThread::ZMQ_IO;
+  EXPECT_FALSE(opts.SetThreadAffinity(kZmqIo, {0}));
+  EXPECT_FALSE(opts.SetThreadPriority(kZmqIo, 10));
+  EXPECT_FALSE(opts.SetThreadName(kZmqIo, "zmq"));
+
+  // Copy and assignment.
+  transport::NodeOptions opts2(opts);
+  EXPECT_EQ(opts.ThreadAffinity(kThread), opts2.ThreadAffinity(kThread));
+  transport::NodeOptions opts3;
+  opts3 = opts;
+  EXPECT_EQ(opts.ThreadName(kThread), opts3.ThreadName(kThread));
+}
@@ -18,13 +18,16 @@
 #ifndef GZ_TRANSPORT_NODEPRIVATE_HH_
 #define GZ_TRANSPORT_NODEPRIVATE_HH_
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
-#include "gz/transport/NetUtils.hh"
 #include "gz/transport/NodeOptions.hh"
 #include "gz/transport/Node.hh"
 #include "gz/transport/NodeShared.hh"
+#include "gz/transport/Uuid.hh"
 
 namespace gz
 {
@@ -56,6 +59,10 @@ namespace gz
       /// \return True on success.
       public: bool RemoveHandlersFromPubQueue(const std::string &_topic);
 
+      /// \brief Number of Node objects sharing this private data, i.e. the
+      /// node and its handles.
+      public: std::atomic<std::size_t> handles{1};
+
       /// \brief The list of topics subscribed by this node.
       public: std::unordered_set<std::string> topicsSubscribed;
 
@@ -65,18 +72,17 @@ namespace gz
       /// \brief Node UUID. This ID is unique for each node.
       public: std::string nUuid;
 
-      /// \brief Pointer to the object shared between all the nodes within the
-      /// same process.
-      public: NodeShared *shared = NodeShared::Instance();
-
-      /// \brief Partition for this node.
-      public: std::string partition = hostname() + ":" + username();
+      /// \brief Node UUID as the 16 byte key used by the storages. nUuid is
+      /// its string representation.
+      public: Uuid nUuidKey;
 
-      /// \brief Default namespace for this node.
-      public: std::string ns = "";
+      /// \brief Pointer to the object shared between all the nodes within the
+      /// same process, or within the same transport context.
+      public: NodeShared *shared = nullptr;
 
-      /// \brief Custom options for this node.
-      public: NodeOptions options;
+      /// \brief Custom options for this node. They might be shared with
+      /// other nodes. They keep the transport context of the node alive.
+      public: std::shared_ptr<const NodeOptions> options;
 
       /// \brief Statistics publisher.
       public: Node::Publisher statPub;
@@ -15,23 +15,37 @@
  *
 */
 #include <gz/msgs/empty.pb.h>
+#include <gz/msgs/Factory.hh>
 
 #include <zmq.hpp>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>  //NOLINT
+#include <set>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 #include <unordered_map>
+#include <utility>
 
 #include "gz/transport/AdvertiseOptions.hh"
 #include "gz/transport/Discovery.hh"
 #include "gz/transport/Helpers.hh"
+#include "gz/transport/MsgTypeId.hh"
+#include "gz/transport/NetUtils.hh"
 #include "gz/transport/NodeShared.hh"
 #include "gz/transport/RepHandler.hh"
 #include "gz/transport/ReqHandler.hh"
@@ -40,6 +54,7 @@
 #include "gz/transport/Uuid.hh"
 
 #include "NodeSharedPrivate.hh"
+#include "ServiceBatch.hh"
 
 using namespace std::chrono_literals;
 using namespace gz;
@@ -89,6 +104,40 @@ bool userPass(std::string &_user, std::string &_pass)
   return true;
 }
 
+//////////////////////////////////////////////////
+// Helper to send a multipart message with one frame per string
+void sendFrames(zmq::socket_t &_socket,
+    std::initializer_list<const std::string *> _frames)
+{
+  std::size_t i = 0;
+  for (const std::string *frame : _frames)
+  {
+    zmq::message_t msg(frame->size());
+    memcpy(msg.data(), frame->data(), frame->size());
+    const bool last = ++i == _frames.size();
+#ifdef GZ_ZMQ_POST_4_3_1
+    _socket.send(msg, last ? zmq::send_flags::none : zmq::send_flags::sndmore);
+#else
+    _socket.send(msg, last ? 0 : ZMQ_SNDMORE);
+#endif
+  }
+}
+
+//////////////////////////////////////////////////
+// Helper to receive a frame of a multipart message
+bool recvFrame(zmq::socket_t &_socket, std::string &_frame)
+{
+  zmq::message_t msg(0);
+#ifdef GZ_ZMQ_POST_4_3_1
+  if (!_socket.recv(msg))
+#else
+  if (!_socket.recv(&msg, 0))
+#endif
+    return false;
+  _frame.assign(reinterpret_cast<char *>(msg.data()), msg.size());
+  return true;
+}
+
 //////////////////////////////////////////////////
 // Helper to send messages
 #ifdef GZ_ZMQ_POST_4_3_1
@@ -278,6 +327,14 @@ NodeShared::NodeShared()
     }
   }
 
+  // Set the window of pipelined service requests per responder.
+  this->dataPtr->srvWindow = this->dataPtr->NonNegativeEnvVar(
+    "GZ_TRANSPORT_SRV_WINDOW", kDefaultSrvWindow);
+
+  // Set the port of the topics published with multicast.
+  this->dataPtr->multicastPort = this->dataPtr->NonNegativeEnvVar(
+    "GZ_TRANSPORT_MULTICAST_PORT", MulticastTransport::kDefaultPort);
+
 
   // Sanity check: the discovery ports should be unique.
   if (this->msgDiscPort == this->srvDiscPort)
@@ -306,69 +363,32 @@ NodeShared::NodeShared()
     this->dataPtr->topicStatsEnabled = (gzStats == "1");
   }
 
-  // My process UUID.
-  Uuid uuid;
-  this->pUuid = uuid.ToString();
+  // Configuration of the transport threads.
+  for (auto thread : {TransportThread::RECEPTION, TransportThread::PUBLISH,
+                      TransportThread::ACCESS_CONTROL,
+                      TransportThread::MSG_DISCOVERY,
+                      TransportThread::SRV_DISCOVERY})
+  {
+    this->dataPtr->threadConfigs[thread] = ThreadConfig::FromEnv(thread);
+  }
 
-  // Initialize my discovery services.
-  this->dataPtr->msgDiscovery.reset(
-      new MsgDiscovery(this->pUuid, this->discoveryIP, this->msgDiscPort));
-  this->dataPtr->srvDiscovery.reset(
-      new SrvDiscovery(this->pUuid, this->discoveryIP, this->srvDiscPort));
+  // If GZ_TRANSPORT_INTRA_PROCESS=1 don't communicate with other processes.
+  std::string gzIntraProcess;
+  if (env("GZ_TRANSPORT_INTRA_PROCESS", gzIntraProcess))
+    this->dataPtr->intraProcess = (gzIntraProcess == "1");
 
-  // Initialize the 0MQ objects.
-  if (!this->InitializeSockets())
-    return;
+  // My process UUID.
+  this->pUuid = this->pUuidKey.ToString();
 
   if (this->verbose)
   {
-    std::cout << "Current host address: " << this->hostAddr << std::endl;
     std::cout << "Process UUID: " << this->pUuid << std::endl;
-    std::cout << "Bind at: [udp://" << this->discoveryIP << ":"
-              << this->msgDiscPort << "] for msg discovery\n";
-    std::cout << "Bind at: [udp://" << this->discoveryIP << ":"
-              << this->srvDiscPort << "] for srv discovery\n";
-    std::cout << "Bind at: [" << this->myAddress << "] for pub/sub\n";
-    std::cout << "Bind at: [" << this->myReplierAddress << "] for srv. calls\n";
-    std::cout << "Identity for receiving srv. requests: ["
-              << this->replierId.ToString() << "]" << std::endl;
-    std::cout << "Identity for receiving srv. responses: ["
-              << this->responseReceiverId.ToString() << "]" << std::endl;
+    if (this->dataPtr->intraProcess)
+      std::cout << "Intra-process mode enabled" << std::endl;
   }
 
-  // Start the service thread.
-  this->threadReception = std::thread(&NodeShared::RunReceptionTask, this);
-
-  // Set the callback to notify discovery updates (new topics).
-  this->dataPtr->msgDiscovery->ConnectionsCb(
-      std::bind(&NodeShared::OnNewConnection, this, std::placeholders::_1));
-
-  // Set the callback to notify discovery updates (invalid topics).
-  this->dataPtr->msgDiscovery->DisconnectionsCb(
-      std::bind(&NodeShared::OnNewDisconnection, this, std::placeholders::_1));
-
-  this->dataPtr->msgDiscovery->RegistrationsCb(
-      std::bind(&NodeShared::OnNewRegistration, this, std::placeholders::_1));
-
-  this->dataPtr->msgDiscovery->UnregistrationsCb(
-      std::bind(&NodeShared::OnEndRegistration, this, std::placeholders::_1));
-
-  // Set the callback to notify svc discovery updates (new services).
-  this->dataPtr->srvDiscovery->ConnectionsCb(
-      std::bind(&NodeShared::OnNewSrvConnection, this, std::placeholders::_1));
-
-  // Set the callback to notify svc discovery updates (invalid services).
-  this->dataPtr->srvDiscovery->DisconnectionsCb(
-      std::bind(&NodeShared::OnNewSrvDisconnection,
-        this, std::placeholders::_1));
-
-  // Start the discovery services.
-  this->dataPtr->msgDiscovery->Start();
-  this->dataPtr->srvDiscovery->Start();
-
-  // Create the local publish thread.
-  this->dataPtr->pubThread = std::thread(&NodeSharedPrivate::PublishThread,
-      this->dataPtr.get());
+  // The discovery services, the sockets and the threads are created on
+  // first use. See InitializeMsgTransport() and InitializeSrvTransport().
 }
 
 //////////////////////////////////////////////////
@@ -379,7 +399,8 @@ NodeShared::~NodeShared()
 
   // Notify the local pubthread and join.
   this->dataPtr->signalNewPub.notify_all();
-  this->dataPtr->pubThread.join();
+  if (this->dataPtr->pubThread.joinable())
+    this->dataPtr->pubThread.join();
 
   // Wait for the service thread before exit.
   if (this->threadReception.joinable())
@@ -388,6 +409,13 @@ NodeShared::~NodeShared()
   // Wait for the authentication thread before exit.
   if (this->dataPtr->accessControlThread.joinable())
     this->dataPtr->accessControlThread.join();
+
+  // Stop the discovery services while the rest of this object is alive,
+  // their callbacks use it. This also notifies the other processes that our
+  // topics and services are gone, which matters for the instances owned by
+  // a TransportContext.
+  this->dataPtr->msgDiscovery.reset();
+  this->dataPtr->srvDiscovery.reset();
 }
 
 //////////////////////////////////////////////////
@@ -395,16 +423,40 @@ void NodeShared::RunReceptionTask()
 {
   while (!this->dataPtr->exit)
   {
-    // Poll socket for a reply, with timeout.
-    zmq::pollitem_t items[] =
+    // The sockets of topics and services are created independently, so
+    // check which ones are ready in every iteration.
+    const bool msgReady = this->dataPtr->msgSocketsReady;
+    const bool srvReady = this->dataPtr->srvSocketsReady;
+
+    const int multicastSocket = this->dataPtr->multicastSocket;
+
+    zmq::pollitem_t items[4];
+    int numItems = 0;
+    if (msgReady)
     {
-      {static_cast<void*>(*this->dataPtr->subscriber), 0, ZMQ_POLLIN, 0},
-      {static_cast<void*>(*this->dataPtr->replier), 0, ZMQ_POLLIN, 0},
-      {static_cast<void*>(*this->dataPtr->responseReceiver), 0, ZMQ_POLLIN, 0}
-    };
+      items[numItems++] =
+        {static_cast<void*>(*this->dataPtr->subscriber), 0, ZMQ_POLLIN, 0};
+    }
+    if (srvReady)
+    {
+      items[numItems++] =
+        {static_cast<void*>(*this->dataPtr->replier), 0, ZMQ_POLLIN, 0};
+      items[numItems++] =
+        {static_cast<void*>(*this->dataPtr->responseReceiver), 0,
+         ZMQ_POLLIN, 0};
+    }
+    if (multicastSocket >= 0)
+    {
+      items[numItems].socket = nullptr;
+      items[numItems].fd = multicastSocket;
+      items[numItems].events = ZMQ_POLLIN;
+      items[numItems++].revents = 0;
+    }
+
+    // Poll socket for a reply, with timeout.
     try
     {
-      zmq::poll(&items[0], sizeof(items) / sizeof(items[0]),
+      zmq::poll(&items[0], numItems,
           std::chrono::milliseconds(NodeSharedPrivate::Timeout));
     }
     catch(...)
@@ -413,12 +465,37 @@ void NodeShared::RunReceptionTask()
     }
 
     //  If we got a reply, process it.
-    if (items[0].revents & ZMQ_POLLIN)
+    int index = 0;
+    if (msgReady && (items[index++].revents & ZMQ_POLLIN))
       this->RecvMsgUpdate();
-    if (items[1].revents & ZMQ_POLLIN)
-      this->RecvSrvRequest();
-    if (items[2].revents & ZMQ_POLLIN)
-      this->RecvSrvResponse();
+    if (srvReady)
+    {
+      if (items[index].revents & ZMQ_POLLIN)
+        this->RecvSrvRequest();
+      if (items[index + 1].revents & ZMQ_POLLIN)
+        this->RecvSrvResponse();
+      index += 2;
+    }
+    if (multicastSocket >= 0 && (items[index].revents & ZMQ_POLLIN))
+      this->RecvMulticastUpdate();
+
+    // In pipelining mode, the requests without a response for too long
+    // release their slot of the window, so the pending ones can be sent.
+    if (srvReady && this->dataPtr->srvWindow > 0)
+    {
+      const auto now = std::chrono::steady_clock::now();
+      std::lock_guard<std::recursive_mutex> lock(this->mutex);
+      const auto released = this->dataPtr->ReleaseSrvSlots(
+        [&now](const NodeSharedPrivate::InFlightRequest &_req)
+        {
+          return _req.expiration <= now;
+        });
+      for (const auto &srv : released)
+      {
+        this->SendPendingRemoteReqs(std::get<0>(srv), std::get<1>(srv),
+          std::get<2>(srv));
+      }
+    }
   }
 }
 
@@ -441,6 +518,26 @@ bool NodeShared::Publish(
     // Send the messages
     std::lock_guard<std::recursive_mutex> lock(this->mutex);
 
+    // The messages of topics advertised with multicast are only sent with
+    // TCP to the subscribers that can't receive multicast. If the data isn't
+    // sent, msg2 releases it.
+    if (!this->dataPtr->multicastRoutes.empty() &&
+        !this->PublishMulticast(_topic, _data, _dataSize, _msgType))
+    {
+      return true;
+    }
+
+    // Send a keyframe or a difference instead of the data, on a topic frame
+    // that only the subscribers that can decode it receive.
+    if (!this->dataPtr->deltaTopics.empty() &&
+        this->EncodeDelta(_topic, _data, _dataSize, this->dataPtr->deltaFrame))
+    {
+      const std::string deltaTopic = DeltaEncoder::kTopicPrefix + _topic;
+      msg0.rebuild(deltaTopic.data(), deltaTopic.size());
+      msg2.rebuild(this->dataPtr->deltaFrame.data(),
+        this->dataPtr->deltaFrame.size());
+    }
+
 #ifdef GZ_ZMQ_POST_4_3_1
     this->dataPtr->publisher->send(msg0, zmq::send_flags::sndmore);
     this->dataPtr->publisher->send(msg1, zmq::send_flags::sndmore);
@@ -488,6 +585,111 @@ bool NodeShared::Publish(
   return true;
 }
 
+//////////////////////////////////////////////////
+std::string NodeShared::AdvertiseMulticast(const std::string &_topic)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+  MulticastTransport *transport = nullptr;
+  if (!this->dataPtr->intraProcess && this->dataPtr->msgSocketsReady)
+    transport = this->dataPtr->Multicast(this->hostAddr);
+
+  if (!transport)
+  {
+    std::cerr << "Unable to publish topic [" << _topic << "] with multicast. "
+              << "Using TCP instead" << std::endl;
+    return "";
+  }
+
+  auto &route = this->dataPtr->multicastRoutes[_topic];
+  route.group = MulticastTransport::GroupFor(_topic);
+  route.version = std::numeric_limits<uint64_t>::max();
+  return transport->Endpoint(_topic);
+}
+
+//////////////////////////////////////////////////
+bool NodeShared::PublishMulticast(const std::string &_topic,
+    const char *_data, const size_t _dataSize, const std::string &_msgType)
+{
+  auto it = this->dataPtr->multicastRoutes.find(_topic);
+  if (it == this->dataPtr->multicastRoutes.end() || !this->dataPtr->multicast)
+    return true;
+
+  // Check how the remote subscribers receive the messages. This is only
+  // done after they change.
+  auto &route = it->second;
+  if (route.version != this->dataPtr->remoteSubscribersVersion)
+  {
+    route.haveMulticast = false;
+    route.haveTcp = false;
+
+    MsgAddresses_M subscribers;
+    this->remoteSubscribers.Publishers(_topic, subscribers);
+    for (const auto &proc : subscribers)
+    {
+      for (const auto &sub : proc.second)
+      {
+        if (sub.MulticastAddr().empty())
+          route.haveTcp = true;
+        else
+          route.haveMulticast = true;
+      }
+    }
+    route.version = this->dataPtr->remoteSubscribersVersion;
+  }
+
+  if (route.haveMulticast &&
+      !this->dataPtr->multicast->Send(route.group, _topic, this->myAddress,
+        _msgType, _data, _dataSize))
+  {
+    std::cerr << "NodeShared::Publish() Error: Unable to send a message of "
+              << "topic [" << _topic << "] with multicast" << std::endl;
+  }
+
+  return route.haveTcp;
+}
+
+//////////////////////////////////////////////////
+bool NodeShared::EncodeDelta(const std::string &_topic, const char *_data,
+  const size_t _dataSize, std::string &_frame)
+{
+  auto it = this->dataPtr->deltaTopics.find(_topic);
+  if (it == this->dataPtr->deltaTopics.end())
+    return false;
+
+  // Check whether the remote subscribers can decode the deltas. This is
+  // only done after they change.
+  auto &delta = it->second;
+  if (delta.version != this->dataPtr->remoteSubscribersVersion)
+  {
+    delta.enabled = true;
+
+    MsgAddresses_M subscribers;
+    this->remoteSubscribers.Publishers(_topic, subscribers);
+    for (const auto &proc : subscribers)
+    {
+      for (const auto &sub : proc.second)
+      {
+        if (sub.MulticastAddr().empty() &&
+            sub.Options().DeltaKeyframeInterval() == 0)
+        {
+          delta.enabled = false;
+        }
+      }
+    }
+    delta.version = this->dataPtr->remoteSubscribersVersion;
+
+    // New subscribers need a keyframe to start decoding.
+    delta.encoder.ForceKeyframe();
+  }
+
+  if (!delta.enabled)
+    return false;
+
+  delta.encoder.Encode(_data, _dataSize, _frame);
+  return true;
+}
+
 //////////////////////////////////////////////////
 void NodeShared::RecvMsgUpdate()
 {
@@ -496,6 +698,7 @@ void NodeShared::RecvMsgUpdate()
   std::string sender;
   std::string data;
   std::string msgType;
+  bool isDelta = false;
   HandlerInfo handlerInfo;
 
   {
@@ -511,6 +714,12 @@ void NodeShared::RecvMsgUpdate()
         return;
       topic = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
 
+      // Messages encoded with deltas are sent on a prefixed topic.
+      const std::size_t prefixSize = std::strlen(DeltaEncoder::kTopicPrefix);
+      isDelta = topic.compare(0, prefixSize, DeltaEncoder::kTopicPrefix) == 0;
+      if (isDelta)
+        topic.erase(0, prefixSize);
+
       // TODO(caguero): Use this as extra metadata for the subscriber.
 #ifdef GZ_ZMQ_POST_4_3_1
       if (!this->dataPtr->subscriber->recv(msg))
@@ -564,28 +773,99 @@ void NodeShared::RecvMsgUpdate()
       return;
     }
 
-    handlerInfo = this->CheckHandlerInfo(topic);
+    // This publisher's messages are received through multicast. They only
+    // arrive here because another subscriber of the topic uses TCP.
+    if (this->dataPtr->IsMulticastSource(topic, sender))
+      return;
+
+    // Reconstruct the message. Until a keyframe arrives it can't be done.
+    if (isDelta)
+    {
+      if (!this->localSubscribers.HasSubscriber(topic))
+        return;
+
+      const std::string frame = std::move(data);
+      if (!this->dataPtr->deltaDecoders[topic][sender].Decode(
+            frame.data(), frame.size(), data))
+      {
+        return;
+      }
+    }
   }
 
+  // The handler storage is safe to read without the mutex.
+  handlerInfo = this->CheckHandlerInfo(topic, msgTypeId(msgType));
+
   MessageInfo info;
   info.SetTopicAndPartition(topic);
   info.SetType(msgType);
   this->TriggerCallbacks(info, data, handlerInfo);
 }
 
+//////////////////////////////////////////////////
+void NodeShared::RecvMulticastUpdate()
+{
+  std::vector<MulticastTransport::Message> msgs;
+
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+    if (!this->dataPtr->multicast)
+      return;
+
+    this->dataPtr->multicast->Receive(msgs);
+
+    // Topics may share a group, so only keep the messages of the publishers
+    // that we receive through multicast.
+    msgs.erase(std::remove_if(msgs.begin(), msgs.end(),
+      [this](const MulticastTransport::Message &_msg)
+      {
+        return !this->dataPtr->IsMulticastSource(_msg.topic, _msg.sender);
+      }), msgs.end());
+  }
+
+  for (const auto &msg : msgs)
+  {
+    // The handler storage is safe to read without the mutex.
+    HandlerInfo handlerInfo =
+      this->CheckHandlerInfo(msg.topic, msgTypeId(msg.msgType));
+
+    MessageInfo info;
+    info.SetTopicAndPartition(msg.topic);
+    info.SetType(msg.msgType);
+    this->TriggerCallbacks(info, msg.data, handlerInfo);
+  }
+}
+
 //////////////////////////////////////////////////
 NodeShared::HandlerInfo NodeShared::CheckHandlerInfo(
-    const std::string &_topic) const
+    const std::string &_topic,
+    const MsgTypeId _msgTypeId) const
 {
   HandlerInfo info;
+  info.msgTypeId = _msgTypeId;
 
-  std::lock_guard<std::recursive_mutex> lk(this->mutex);
-
-  info.haveLocal = this->localSubscribers.normal.Handlers(
-        _topic, info.localHandlers);
+  info.localHandlers = this->localSubscribers.normal.TopicHandlers(_topic);
+  if (info.localHandlers)
+  {
+    info.haveLocal = std::any_of(
+      info.localHandlers->begin(), info.localHandlers->end(),
+      [_msgTypeId](const auto &_entry)
+      {
+        return _entry.handler->AcceptsType(_msgTypeId);
+      });
+  }
 
-  info.haveRaw = this->localSubscribers.raw.Handlers(
-        _topic, info.rawHandlers);
+  info.rawHandlers = this->localSubscribers.raw.TopicHandlers(_topic);
+  if (info.rawHandlers)
+  {
+    info.haveRaw = std::any_of(
+      info.rawHandlers->begin(), info.rawHandlers->end(),
+      [_msgTypeId](const auto &_entry)
+      {
+        return _entry.handler->AcceptsType(_msgTypeId);
+      });
+  }
 
   return info;
 }
@@ -593,18 +873,19 @@ NodeShared::HandlerInfo NodeShared::CheckHandlerInfo(
 //////////////////////////////////////////////////
 NodeShared::SubscriberInfo NodeShared::CheckSubscriberInfo(
     const std::string &_topic,
-    const std::string &_msgType) const
+    const std::string &_msgType,
+    const MsgTypeId _msgTypeId) const
 {
   SubscriberInfo info;
+  HandlerInfo handlerInfo = this->CheckHandlerInfo(_topic, _msgTypeId);
+  info.localHandlers = std::move(handlerInfo.localHandlers);
+  info.rawHandlers = std::move(handlerInfo.rawHandlers);
+  info.msgTypeId = handlerInfo.msgTypeId;
+  info.haveLocal = handlerInfo.haveLocal;
+  info.haveRaw = handlerInfo.haveRaw;
 
   std::lock_guard<std::recursive_mutex> lk(this->mutex);
 
-  info.haveLocal = this->localSubscribers.normal.Handlers(
-        _topic, info.localHandlers);
-
-  info.haveRaw = this->localSubscribers.raw.Handlers(
-        _topic, info.rawHandlers);
-
   info.haveRemote = this->remoteSubscribers.HasTopic(
         _topic, _msgType);
 
@@ -622,23 +903,12 @@ void NodeShared::TriggerCallbacks(
 
   if (_handlerInfo.haveRaw)
   {
-    for (const auto &node : _handlerInfo.rawHandlers)
+    for (const auto &entry : *_handlerInfo.rawHandlers)
     {
-      for (const auto &handler : node.second)
-      {
-        const RawSubscriptionHandlerPtr &rawHandler = handler.second;
-        if (rawHandler)
-        {
-          if (rawHandler->TypeName() == _info.Type() ||
-              rawHandler->TypeName() == kGenericMessageType)
-          {
-            rawHandler->RunRawCallback(_msgData.c_str(), _msgData.size(),
-                _info);
-          }
-        }
-        else
-          std::cerr << "Raw subscription handler is NULL" << std::endl;
-      }
+      if (!entry.handler->AcceptsType(_handlerInfo.msgTypeId))
+        continue;
+
+      entry.handler->RunRawCallback(_msgData.c_str(), _msgData.size(), _info);
     }
   }
 
@@ -649,40 +919,41 @@ void NodeShared::TriggerCallbacks(
     // deserializing the message altogether.
     std::shared_ptr<ProtoMsg> msg;
 
-    for (const auto &node : _handlerInfo.localHandlers)
+    for (const auto &entry : *_handlerInfo.localHandlers)
     {
-      for (const auto &handler : node.second)
+      const ISubscriptionHandlerPtr &localHandler = entry.handler;
+      if (!localHandler->AcceptsType(_handlerInfo.msgTypeId))
+        continue;
+
+      // Drop decisions that do not need the message content (e.g.
+      // throttling) are made first, so a message that every handler drops
+      // is never deserialized. Other handlers decide in RunLocalCallback().
+      const bool admitted = localHandler->AdmitsBeforeDecode();
+      if (admitted && !localHandler->AdmitMessage())
+        continue;
+
+      if (!msg)
       {
-        const ISubscriptionHandlerPtr &localHandler = handler.second;
-        if (localHandler)
+        // If the message has not been deserialized yet, do it now since
+        // we have allegedly found a subscriber which should be able to
+        // do it.
+        msg = localHandler->CreateMsg(_msgData, _info.Type());
+
+        if (!msg)
         {
-          if (localHandler->TypeName() == _info.Type() ||
-              localHandler->TypeName() == kGenericMessageType)
-          {
-            if (!msg)
-            {
-              // If the message has not been deserialized yet, do it now since
-              // we have allegedly found a subscriber which should be able to
-              // do it.
-              msg = localHandler->CreateMsg(_msgData, _info.Type());
-
-              if (!msg)
-              {
-                // If the message could not be created, then none of the
-                // handlers in this process will be able to create it, because
-                // protobuf has access to all message types that the current
-                // process is linked to. If CreateMsg(~,~) fails, then we may
-                // as well quit.
-                return;
-              }
-            }
-
-            localHandler->RunLocalCallback(*msg, _info);
-          }
+          // If the message could not be created, then none of the
+          // handlers in this process will be able to create it, because
+          // protobuf has access to all message types that the current
+          // process is linked to. If CreateMsg(~,~) fails, then we may
+          // as well quit.
+          return;
         }
-        else
-          std::cerr << "Local subscription handler is NULL" << std::endl;
       }
+
+      if (admitted)
+        localHandler->RunAdmittedCallback(*msg, _info);
+      else
+        localHandler->RunLocalCallback(*msg, _info);
     }
   }
 }
@@ -698,7 +969,6 @@ void NodeShared::RecvSrvRequest()
   if (verbose)
     std::cout << "Message received requesting a service call" << std::endl;
 
-  zmq::message_t msg(0);
   std::string topic;
   std::string sender;
   std::string nodeUuid;
@@ -718,76 +988,33 @@ void NodeShared::RecvSrvRequest()
 
     try
     {
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      topic = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      sender = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      dstId = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      nodeUuid = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      reqUuid = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
-        return;
-      req = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
+      // The first frame is the routing identity of the requester.
+      if (!recvFrame(*this->dataPtr->replier, sender) ||
+          !recvFrame(*this->dataPtr->replier, topic)  ||
+          !recvFrame(*this->dataPtr->replier, sender) ||
+          !recvFrame(*this->dataPtr->replier, dstId)  ||
+          !recvFrame(*this->dataPtr->replier, nodeUuid))
+      {
         return;
-      reqType = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
+      }
 
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->replier->recv(msg))
-#else
-      if (!this->dataPtr->replier->recv(&msg, 0))
-#endif
+      // Several requests batched in a single message.
+      if (nodeUuid == ServiceBatch::kMarker)
+      {
+        if (!recvFrame(*this->dataPtr->replier, reqType) ||
+            !recvFrame(*this->dataPtr->replier, repType) ||
+            !recvFrame(*this->dataPtr->replier, req))
+        {
+          return;
+        }
+      }
+      else if (!recvFrame(*this->dataPtr->replier, reqUuid) ||
+               !recvFrame(*this->dataPtr->replier, req)     ||
+               !recvFrame(*this->dataPtr->replier, reqType) ||
+               !recvFrame(*this->dataPtr->replier, repType))
+      {
         return;
-      repType = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
+      }
     }
     catch(const zmq::error_t &_error)
     {
@@ -803,6 +1030,13 @@ void NodeShared::RecvSrvRequest()
   // Get the REP handler.
   if (hasHandler)
   {
+    if (nodeUuid == ServiceBatch::kMarker)
+    {
+      this->ReplyBatchedSrvRequests(repHandler, topic, sender, dstId, repType,
+        req);
+      return;
+    }
+
     // Run the service call and get the results.
     bool result = repHandler->RunCallback(req, rep);
 
@@ -818,88 +1052,92 @@ void NodeShared::RecvSrvRequest()
     else
       resultStr = "0";
 
-    {
-      std::lock_guard<std::recursive_mutex> lock(this->mutex);
-      // I am still not connected to this address.
-      if (std::find(this->srvConnections.begin(), this->srvConnections.end(),
-            sender) == this->srvConnections.end())
-      {
-        this->dataPtr->replier->connect(sender.c_str());
-        this->srvConnections.push_back(sender);
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
-
-        if (this->verbose)
-        {
-          std::cout << "\t* Connected to [" << sender
-                    << "] for sending a response" << std::endl;
-        }
-      }
-    }
+    this->ConnectToSrvRequester(sender);
 
     // Send the reply.
     try
     {
       std::lock_guard<std::recursive_mutex> lock(this->mutex);
-      zmq::message_t response;
-
-      response.rebuild(dstId.size());
-      memcpy(response.data(), dstId.data(), dstId.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::sndmore);
-#else
-      this->dataPtr->replier->send(response, ZMQ_SNDMORE);
-#endif
+      sendFrames(*this->dataPtr->replier,
+        {&dstId, &topic, &nodeUuid, &reqUuid, &rep, &resultStr});
+    }
+    catch(const zmq::error_t &_error)
+    {
+      std::cerr << "NodeShared::RecvSrvRequest() error sending response: "
+                << _error.what() << std::endl;
+      return;
+    }
+  }
+  // else
+  //   std::cerr << "I do not have a service call registered for topic ["
+  //             << topic << "]\n";
+}
 
-      response.rebuild(topic.size());
-      memcpy(response.data(), topic.data(), topic.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::sndmore);
-#else
-      this->dataPtr->replier->send(response, ZMQ_SNDMORE);
-#endif
+//////////////////////////////////////////////////
+void NodeShared::ConnectToSrvRequester(const std::string &_sender)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  // I am still not connected to this address.
+  if (std::find(this->srvConnections.begin(), this->srvConnections.end(),
+        _sender) == this->srvConnections.end())
+  {
+    this->dataPtr->replier->connect(_sender.c_str());
+    this->srvConnections.push_back(_sender);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
-      response.rebuild(nodeUuid.size());
-      memcpy(response.data(), nodeUuid.data(), nodeUuid.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::sndmore);
-#else
-      this->dataPtr->replier->send(response, ZMQ_SNDMORE);
-#endif
+    if (this->verbose)
+    {
+      std::cout << "\t* Connected to [" << _sender
+                << "] for sending a response" << std::endl;
+    }
+  }
+}
 
-      response.rebuild(reqUuid.size());
-      memcpy(response.data(), reqUuid.data(), reqUuid.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::sndmore);
-#else
-      this->dataPtr->replier->send(response, ZMQ_SNDMORE);
-#endif
+//////////////////////////////////////////////////
+void NodeShared::ReplyBatchedSrvRequests(const IRepHandlerPtr &_handler,
+  const std::string &_topic, const std::string &_sender,
+  const std::string &_dstId, const std::string &_repType,
+  const std::string &_requests)
+{
+  std::vector<ServiceBatch::Request> requests;
+  if (!ServiceBatch::Decode(_requests.data(), _requests.size(), requests))
+  {
+    std::cerr << "NodeShared::RecvSrvRequest() error parsing a batch of "
+              << "requests for service [" << _topic << "]" << std::endl;
+    return;
+  }
 
-      response.rebuild(rep.size());
-      memcpy(response.data(), rep.data(), rep.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::sndmore);
-#else
-      this->dataPtr->replier->send(response, ZMQ_SNDMORE);
-#endif
+  // Run the service calls and get the results.
+  std::vector<ServiceBatch::Response> responses(requests.size());
+  for (std::size_t i = 0; i < requests.size(); ++i)
+  {
+    responses[i].nodeUuid = std::move(requests[i].nodeUuid);
+    responses[i].reqUuid = std::move(requests[i].reqUuid);
+    responses[i].result =
+      _handler->RunCallback(requests[i].data, responses[i].rep);
+  }
 
-      response.rebuild(resultStr.size());
-      memcpy(response.data(), resultStr.data(), resultStr.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-      this->dataPtr->replier->send(response, zmq::send_flags::none);
-#else
-      this->dataPtr->replier->send(response, 0);
-#endif
-    }
-    catch(const zmq::error_t &_error)
-    {
-      std::cerr << "NodeShared::RecvSrvRequest() error sending response: "
-                << _error.what() << std::endl;
-      return;
-    }
+  // Oneway requests don't have a response.
+  if (_repType == msgs::Empty().GetTypeName() || responses.empty())
+    return;
+
+  this->ConnectToSrvRequester(_sender);
+
+  std::string buffer;
+  ServiceBatch::Encode(responses, buffer);
+  const std::string marker = ServiceBatch::kMarker;
+
+  // Send the replies.
+  try
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    sendFrames(*this->dataPtr->replier, {&_dstId, &_topic, &marker, &buffer});
+  }
+  catch(const zmq::error_t &_error)
+  {
+    std::cerr << "NodeShared::RecvSrvRequest() error sending response: "
+              << _error.what() << std::endl;
   }
-  // else
-  //   std::cerr << "I do not have a service call registered for topic ["
-  //             << topic << "]\n";
 }
 
 //////////////////////////////////////////////////
@@ -908,69 +1146,39 @@ void NodeShared::RecvSrvResponse()
   if (verbose)
     std::cout << "Message received containing a service call REP" << std::endl;
 
-  zmq::message_t msg(0);
   std::string topic;
   std::string nodeUuid;
-  std::string reqUuid;
-  std::string rep;
+  std::string batch;
   std::string resultStr;
-  bool result;
-
-  IReqHandlerPtr reqHandlerPtr;
-  bool hasHandler;
+  std::vector<ServiceBatch::Response> responses(1);
 
   {
     std::lock_guard<std::recursive_mutex> lock(this->mutex);
 
     try
     {
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
-        return;
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
-        return;
-      topic = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
-        return;
-      nodeUuid = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
-        return;
-      reqUuid = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
+      // The first frame is the routing identity of the responder.
+      if (!recvFrame(*this->dataPtr->responseReceiver, topic) ||
+          !recvFrame(*this->dataPtr->responseReceiver, topic) ||
+          !recvFrame(*this->dataPtr->responseReceiver, nodeUuid))
+      {
         return;
-      rep = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
+      }
 
-#ifdef GZ_ZMQ_POST_4_3_1
-      if (!this->dataPtr->responseReceiver->recv(msg))
-#else
-      if (!this->dataPtr->responseReceiver->recv(&msg, 0))
-#endif
+      // Several responses batched in a single message.
+      if (nodeUuid == ServiceBatch::kMarker)
+      {
+        if (!recvFrame(*this->dataPtr->responseReceiver, batch))
+          return;
+      }
+      else if (!recvFrame(*this->dataPtr->responseReceiver,
+                          responses[0].reqUuid) ||
+               !recvFrame(*this->dataPtr->responseReceiver,
+                          responses[0].rep) ||
+               !recvFrame(*this->dataPtr->responseReceiver, resultStr))
+      {
         return;
-      resultStr = std::string(reinterpret_cast<char *>(msg.data()), msg.size());
-      result = resultStr == "1";
+      }
     }
     catch(const zmq::error_t &_error)
     {
@@ -978,30 +1186,91 @@ void NodeShared::RecvSrvResponse()
                 << _error.what() << std::endl;
       return;
     }
+  }
 
-    hasHandler =
-      this->requests.Handler(topic, nodeUuid, reqUuid, reqHandlerPtr);
+  if (nodeUuid == ServiceBatch::kMarker)
+  {
+    if (!ServiceBatch::Decode(batch.data(), batch.size(), responses))
+    {
+      std::cerr << "NodeShared::RecvSrvResponse() error parsing a batch of "
+                << "responses for service [" << topic << "]" << std::endl;
+      return;
+    }
+  }
+  else
+  {
+    responses[0].nodeUuid = nodeUuid;
+    responses[0].result = resultStr == "1";
   }
 
-  if (hasHandler)
+  // The identities of the responses are parsed once.
+  std::vector<Uuid> reqKeys;
+  reqKeys.reserve(responses.size());
+  for (const auto &response : responses)
+    reqKeys.push_back(Uuid::FromIdentifier(response.reqUuid));
+
+  for (std::size_t i = 0; i < responses.size(); ++i)
   {
-    // Notify the result.
-    reqHandlerPtr->NotifyResult(rep, result);
+    const auto &response = responses[i];
+    const Uuid nodeKey = Uuid::FromIdentifier(response.nodeUuid);
+    IReqHandlerPtr reqHandlerPtr;
+    bool hasHandler;
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->mutex);
+      hasHandler = this->requests.Handler(topic, nodeKey, reqKeys[i],
+        reqHandlerPtr);
+    }
 
-    // Remove the handler.
-    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    // Keep the response if the request was sent to a cacheable service.
+    this->dataPtr->srvResponseCache.Complete(response.reqUuid, response.rep,
+      response.result);
+
+    if (hasHandler)
     {
-      if (!this->requests.RemoveHandler(topic, nodeUuid, reqUuid))
+      // Notify the result.
+      reqHandlerPtr->NotifyResult(response.rep, response.result);
+
+      // Remove the handler.
+      std::lock_guard<std::recursive_mutex> lock(this->mutex);
       {
-        std::cerr << "NodeShare::RecvSrvResponse(): "
-                  << "Error removing request handler" << std::endl;
+        if (!this->requests.RemoveHandler(topic, nodeKey, reqKeys[i]))
+        {
+          std::cerr << "NodeShare::RecvSrvResponse(): "
+                    << "Error removing request handler" << std::endl;
+        }
       }
     }
+    else
+    {
+      std::cerr << "Received a service call response but I don't have a "
+                << "handler for it" << std::endl;
+    }
   }
-  else
+
+  // In pipelining mode, the responses free space in the window of the
+  // responder for the requests that are still pending. This includes the
+  // late responses of requests abandoned after a timeout.
+  if (this->dataPtr->srvWindow > 0)
   {
-    std::cerr << "Received a service call response but I don't have a handler"
-              << " for it" << std::endl;
+    std::set<NodeSharedPrivate::SrvTypes> released;
+    {
+      std::lock_guard<std::recursive_mutex> lock(this->mutex);
+      for (const auto &reqKey : reqKeys)
+      {
+        auto it = this->dataPtr->srvInFlight.find(reqKey);
+        if (it == this->dataPtr->srvInFlight.end())
+          continue;
+        released.emplace(it->second.topic, it->second.reqType,
+          it->second.repType);
+        this->dataPtr->srvInFlight.erase(it);
+      }
+    }
+
+    for (const auto &srv : released)
+    {
+      this->SendPendingRemoteReqs(std::get<0>(srv), std::get<1>(srv),
+        std::get<2>(srv));
+    }
   }
 }
 
@@ -1011,6 +1280,14 @@ void NodeShared::SendPendingRemoteReqs(const std::string &_topic,
 {
   std::string responserAddr;
   std::string responserId;
+  Uuid responserPUuid;
+  AdvertiseServiceOptions responserOpts;
+  bool responserBatches = false;
+
+  // Without sockets (e.g. in intra-process mode) requests can't be sent.
+  if (!this->dataPtr->srvSocketsReady)
+    return;
+
   SrvAddresses_M addresses;
   this->dataPtr->srvDiscovery->Publishers(_topic, addresses);
   if (addresses.empty())
@@ -1029,6 +1306,9 @@ void NodeShared::SendPendingRemoteReqs(const std::string &_topic,
         found = true;
         responserAddr = pub.Addr();
         responserId = pub.SocketId();
+        responserPUuid = pub.ProcessKey();
+        responserOpts = pub.Options();
+        responserBatches = pub.AcceptsBatches();
         break;
       }
     }
@@ -1045,7 +1325,21 @@ void NodeShared::SendPendingRemoteReqs(const std::string &_topic,
               << responserAddr << "]" << std::endl;
   }
 
-  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+  const std::string myId = this->responseReceiverId.ToString();
+
+  // Oneway requests don't have a response to cache.
+  const bool cacheable = responserOpts.Cacheable() &&
+    _repType != msgs::Empty().GetTypeName();
+
+  // Requests answered from the cache. They are notified after this function
+  // releases its own lock on the mutex. The mutex is recursive, so a caller
+  // that already holds it still does at that point: a blocking request
+  // waiting for its response, or an asynchronous request being sent. The
+  // callback of a cached asynchronous response then runs with the mutex
+  // held by its thread, as the callback of a local responder would.
+  std::vector<std::pair<IReqHandlerPtr, std::string>> cached;
+
+  std::unique_lock<std::recursive_mutex> lock(this->mutex);
 
   // I am still not connected to this address.
   if (std::find(this->srvConnections.begin(), this->srvConnections.end(),
@@ -1066,6 +1360,30 @@ void NodeShared::SendPendingRemoteReqs(const std::string &_topic,
   if (!this->requests.Handlers(_topic, reqs))
     return;
 
+  const MsgTypeId reqTypeId = msgTypeId(_reqType);
+  const MsgTypeId repTypeId = msgTypeId(_repType);
+  const bool oneway = _repType == msgs::Empty().GetTypeName();
+
+  // In pipelining mode only a window of requests can wait for a response
+  // from the responder. New requests are sent once half of the window is
+  // free, so they leave together in a single batch.
+  const int window = this->dataPtr->srvWindow;
+  std::size_t budget = std::numeric_limits<std::size_t>::max();
+  if (window > 0)
+  {
+    std::size_t inFlight = 0;
+    for (const auto &req : this->dataPtr->srvInFlight)
+    {
+      if (req.second.topic == _topic && req.second.addr == responserAddr)
+        ++inFlight;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(window);
+    budget = inFlight * 2 > size ? 0 : size - inFlight;
+  }
+  const bool batched = window > 0 && responserBatches;
+  std::vector<ServiceBatch::Request> batch;
+
   for (auto &node : reqs)
   {
     for (auto &req : node.second)
@@ -1075,114 +1393,147 @@ void NodeShared::SendPendingRemoteReqs(const std::string &_topic,
         continue;
 
       // Check that the pending service call has types that match the responser.
-      if (req.second->ReqTypeName() != _reqType ||
-          req.second->RepTypeName() != _repType)
+      if (req.second->ReqTypeId() != reqTypeId ||
+          !msgTypeMatches(req.second->RepTypeId(), repTypeId))
       {
         continue;
       }
 
-      // Mark the handler as requested.
-      req.second->Requested(true);
+      // A generic request takes the response type of the responser.
+      if (req.second->RepTypeId() == kGenericMsgTypeId)
+      {
+        auto generic = std::dynamic_pointer_cast<ReqHandler<
+          google::protobuf::Message, google::protobuf::Message>>(req.second);
+        std::unique_ptr<google::protobuf::Message> prototype =
+          msgs::Factory::New(_repType);
+        if (!generic || !prototype)
+          continue;
+        generic->SetResponse(prototype.get());
+      }
+
+      // The window is full, the request waits for the next responses.
+      if (budget == 0 && !cacheable)
+        continue;
 
       std::string data;
       if (!req.second->Serialize(data))
+      {
+        req.second->Requested(true);
         continue;
+      }
 
       auto nodeUuid = req.second->NodeUuid();
       auto reqUuid = req.second->HandlerUuid();
 
-      try
+      std::string key;
+      if (cacheable)
       {
-        zmq::message_t msg;
-
-        msg.rebuild(responserId.size());
-        memcpy(msg.data(), responserId.data(), responserId.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
-
-        msg.rebuild(_topic.size());
-        memcpy(msg.data(), _topic.data(), _topic.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+        key = ServiceResponseCache::Key(_reqType, _repType, data);
+        std::string rep;
+        bool result;
+        if (this->dataPtr->srvResponseCache.Lookup(_topic, key,
+              responserOpts.CacheVersion(), rep, result))
+        {
+          req.second->Requested(true);
+          cached.emplace_back(req.second, std::move(rep));
+          continue;
+        }
+      }
 
-        msg.rebuild(this->myRequesterAddress.size());
-        memcpy(msg.data(), this->myRequesterAddress.data(),
-          this->myRequesterAddress.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      if (budget == 0)
+        continue;
+      --budget;
 
-        std::string myId = this->responseReceiverId.ToString();
-        msg.rebuild(myId.size());
-        memcpy(msg.data(), myId.data(), myId.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      // Mark the handler as requested.
+      req.second->Requested(true);
 
-        msg.rebuild(nodeUuid.size());
-        memcpy(msg.data(), nodeUuid.data(), nodeUuid.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      if (cacheable)
+      {
+        this->dataPtr->srvResponseCache.Expect(reqUuid, _topic, key,
+          responserOpts.CacheVersion(), responserOpts.CacheTtl());
+      }
 
-        msg.rebuild(reqUuid.size());
-        memcpy(msg.data(), reqUuid.data(), reqUuid.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      // The request takes a slot of the window until its response arrives.
+      if (window > 0 && !oneway)
+      {
+        this->dataPtr->srvInFlight[req.second->HandlerKey()] = {_topic,
+          _reqType, _repType, responserAddr, responserPUuid,
+          std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(NodeSharedPrivate::SrvWindowTimeout)};
+      }
 
-        msg.rebuild(data.size());
-        memcpy(msg.data(), data.data(), data.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      // Remove the handler associated to this service request. We won't
+      // receive a response because this is a oneway request.
+      if (oneway)
+      {
+        this->requests.RemoveHandler(_topic, req.second->NodeKey(),
+          req.second->HandlerKey());
+      }
 
-        msg.rebuild(_reqType.size());
-        memcpy(msg.data(), _reqType.data(), _reqType.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::sndmore);
-#else
-        this->dataPtr->requester->send(msg, ZMQ_SNDMORE);
-#endif
+      if (batched)
+      {
+        batch.push_back({nodeUuid, reqUuid, std::move(data)});
+        continue;
+      }
 
-        msg.rebuild(_repType.size());
-        memcpy(msg.data(), _repType.data(), _repType.size());
-#ifdef GZ_ZMQ_POST_4_3_1
-        this->dataPtr->requester->send(msg, zmq::send_flags::none);
-#else
-        this->dataPtr->requester->send(msg, 0);
-#endif
+      try
+      {
+        sendFrames(*this->dataPtr->requester, {&responserId, &_topic,
+          &this->myRequesterAddress, &myId, &nodeUuid, &reqUuid, &data,
+          &_reqType, &_repType});
       }
       catch(const zmq::error_t& /*ze*/)
       {
         // Debug output.
         // std::cerr << "Error connecting [" << ze.what() << "]\n";
       }
+    }
+  }
 
-      // Remove the handler associated to this service request. We won't
-      // receive a response because this is a oneway request.
-      if (_repType == msgs::Empty().GetTypeName())
-      {
-        this->requests.RemoveHandler(_topic, nodeUuid, reqUuid);
-      }
+  if (!batch.empty())
+  {
+    std::string buffer;
+    ServiceBatch::Encode(batch, buffer);
+    const std::string marker = ServiceBatch::kMarker;
+    try
+    {
+      sendFrames(*this->dataPtr->requester, {&responserId, &_topic,
+        &this->myRequesterAddress, &myId, &marker, &_reqType, &_repType,
+        &buffer});
+    }
+    catch(const zmq::error_t& /*ze*/)
+    {
+      // Debug output.
+      // std::cerr << "Error connecting [" << ze.what() << "]\n";
     }
   }
+
+  for (const auto &hit : cached)
+  {
+    this->requests.RemoveHandler(_topic, hit.first->NodeKey(),
+      hit.first->HandlerKey());
+  }
+  lock.unlock();
+
+  for (const auto &hit : cached)
+    hit.first->NotifyResult(hit.second, true);
+}
+
+//////////////////////////////////////////////////
+void NodeShared::AbandonRequest(const std::string &_topic,
+  const Uuid &_nodeUuid, const Uuid &_reqUuid)
+{
+  std::lock_guard<std::recursive_mutex> lock(this->mutex);
+
+  this->requests.RemoveHandler(_topic, _nodeUuid, _reqUuid);
+
+  auto it = this->dataPtr->srvInFlight.find(_reqUuid);
+  if (it == this->dataPtr->srvInFlight.end())
+    return;
+
+  const NodeSharedPrivate::InFlightRequest req = it->second;
+  this->dataPtr->srvInFlight.erase(it);
+  this->SendPendingRemoteReqs(req.topic, req.reqType, req.repType);
 }
 
 //////////////////////////////////////////////////
@@ -1211,13 +1562,33 @@ void NodeShared::OnNewConnection(const MessagePublisher &_pub)
     if (!this->connections.HasPublisher(addr))
       this->dataPtr->subscriber->connect(addr.c_str());
 
-    // Add a new filter for the topic.
+    // Receive the messages through multicast if the publisher offers it.
+    const bool viaMulticast = !_pub.MulticastAddr().empty() &&
+      !this->dataPtr->intraProcess &&
+      this->dataPtr->JoinMulticast(topic, addr, _pub.MulticastAddr(),
+        this->hostAddr);
+
+    // Add a new filter for the topic, and another one for its deltas if
+    // the publisher sends them.
+    if (!viaMulticast)
+    {
 #ifdef GZ_CPPZMQ_POST_4_7_0
-    this->dataPtr->subscriber->set(zmq::sockopt::subscribe, topic);
+      this->dataPtr->subscriber->set(zmq::sockopt::subscribe, topic);
 #else
-    this->dataPtr->subscriber->setsockopt(ZMQ_SUBSCRIBE,
-        topic.data(), topic.size());
+      this->dataPtr->subscriber->setsockopt(ZMQ_SUBSCRIBE,
+          topic.data(), topic.size());
 #endif
+      if (_pub.Options().DeltaKeyframeInterval() > 0)
+      {
+        const std::string deltaTopic = DeltaEncoder::kTopicPrefix + topic;
+#ifdef GZ_CPPZMQ_POST_4_7_0
+        this->dataPtr->subscriber->set(zmq::sockopt::subscribe, deltaTopic);
+#else
+        this->dataPtr->subscriber->setsockopt(ZMQ_SUBSCRIBE,
+            deltaTopic.data(), deltaTopic.size());
+#endif
+      }
+    }
 
     // Register the new connection with the publisher.
     this->connections.AddPublisher(_pub);
@@ -1231,6 +1602,10 @@ void NodeShared::OnNewConnection(const MessagePublisher &_pub)
     // Hack: We use this field to store the PUuid of the topic publisher.
     pub.SetCtrl(_pub.PUuid());
 
+    // Tell the publisher whether we receive through multicast or TCP.
+    if (!viaMulticast)
+      pub.SetMulticastAddr("");
+
     std::vector<std::string> handlerNodeUuids =
         this->localSubscribers.NodeUuids(topic, _pub.MsgTypeName());
     for (const std::string &nodeUuid : handlerNodeUuids)
@@ -1250,19 +1625,20 @@ void NodeShared::OnNewDisconnection(const MessagePublisher &_pub)
   std::lock_guard<std::recursive_mutex> lock(this->mutex);
 
   std::string topic = _pub.Topic();
-  std::string procUuid = _pub.PUuid();
-  std::string nUuid = _pub.NUuid();
+  const Uuid &procUuid = _pub.ProcessKey();
+  const Uuid &nUuid = _pub.NodeKey();
 
   if (this->verbose)
   {
     std::cout << "New disconnection detected " << std::endl;
-    std::cout << "\tProcess UUID: " << procUuid << std::endl;
+    std::cout << "\tProcess UUID: " << _pub.PUuid() << std::endl;
   }
 
   // A remote subscriber[s] has been disconnected.
-  if (topic != "" && nUuid != "")
+  if (topic != "" && _pub.NUuid() != "")
   {
     this->remoteSubscribers.DelPublisherByNode(topic, procUuid, nUuid);
+    ++this->dataPtr->remoteSubscribersVersion;
 
     MessagePublisher connection;
     if (!this->connections.Publisher(topic, procUuid, nUuid, connection))
@@ -1270,6 +1646,19 @@ void NodeShared::OnNewDisconnection(const MessagePublisher &_pub)
 
     // I am no longer connected.
     this->connections.DelPublisherByNode(topic, procUuid, nUuid);
+
+    // Forget the decoder of the publisher, unless another node of its
+    // process still publishes the topic.
+    bool sameAddr = false;
+    MsgAddresses_M remaining;
+    this->connections.Publishers(topic, remaining);
+    for (const auto &proc : remaining)
+    {
+      for (const auto &pub : proc.second)
+        sameAddr = sameAddr || pub.Addr() == connection.Addr();
+    }
+    if (!sameAddr)
+      this->dataPtr->RemoveDeltaDecoder(topic, connection.Addr());
   }
   else
   {
@@ -1278,6 +1667,15 @@ void NodeShared::OnNewDisconnection(const MessagePublisher &_pub)
     // or traffic load) and if we remove them, they won't be able to receive
     // data anymore.
 
+    // Forget the decoders of the publishers of the process.
+    std::map<std::string, std::vector<MessagePublisher>> pubs;
+    this->connections.PublishersByProc(procUuid, pubs);
+    for (const auto &node : pubs)
+    {
+      for (const auto &pub : node.second)
+        this->dataPtr->RemoveDeltaDecoder(pub.Topic(), pub.Addr());
+    }
+
     MsgAddresses_M info;
     if (!this->connections.Publishers(topic, info))
       return;
@@ -1344,58 +1742,248 @@ void NodeShared::OnNewSrvDisconnection(const ServicePublisher &_pub)
     std::cout << "Service call disconnection callback" << std::endl;
     std::cout << _pub;
   }
+
+  // The requests sent to the responder won't be answered. A whole process
+  // goes away when the topic is empty.
+  const std::string topic = _pub.Topic();
+  const Uuid &procUuid = _pub.ProcessKey();
+  const auto released = this->dataPtr->ReleaseSrvSlots(
+    [&topic, &procUuid](const NodeSharedPrivate::InFlightRequest &_req)
+    {
+      return _req.pUuid == procUuid && (topic.empty() || _req.topic == topic);
+    });
+  for (const auto &srv : released)
+  {
+    this->SendPendingRemoteReqs(std::get<0>(srv), std::get<1>(srv),
+      std::get<2>(srv));
+  }
+}
+
+//////////////////////////////////////////////////
+void NodeShared::OnNewRegistration(const MessagePublisher &_pub)
+{
+  // Discard the message if the destination PUUID is not me.
+  if (_pub.Ctrl() != this->pUuid)
+    return;
+
+  std::string procUuid = _pub.PUuid();
+  std::string nodeUuid = _pub.NUuid();
+
+  if (this->verbose)
+  {
+    std::cout << "Registering a new remote connection" << std::endl;
+    std::cout << "\tProc UUID: [" << procUuid << "]" << std::endl;
+    std::cout << "\tNode UUID: [" << nodeUuid << "]" << std::endl;
+  }
+
+  // Add a remote subscriber.
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    this->remoteSubscribers.AddPublisher(_pub);
+    ++this->dataPtr->remoteSubscribersVersion;
+  }
+
+  this->dataPtr->NotifySubscribersChanged();
+}
+
+//////////////////////////////////////////////////
+void NodeShared::OnEndRegistration(const MessagePublisher &_pub)
+{
+  // Discard the message if the destination PUUID is not me.
+  if (_pub.Ctrl() != this->pUuid)
+    return;
+
+  std::string topic = _pub.Topic();
+  std::string procUuid = _pub.PUuid();
+  std::string nodeUuid = _pub.NUuid();
+
+  if (this->verbose)
+  {
+    std::cout << "Registering the end of a remote connection" << std::endl;
+    std::cout << "\tProc UUID: " << procUuid << std::endl;
+    std::cout << "\tNode UUID: [" << nodeUuid << "]" << std::endl;
+  }
+
+  // Delete a remote subscriber.
+  {
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    this->remoteSubscribers.DelPublisherByNode(topic, _pub.ProcessKey(),
+      _pub.NodeKey());
+    ++this->dataPtr->remoteSubscribersVersion;
+  }
+
+  this->dataPtr->NotifySubscribersChanged();
+}
+
+//////////////////////////////////////////////////
+void NodeShared::InitializeMsgTransport()
+{
+  // Fast path once the transport is initialized.
+  if (this->dataPtr->msgTransportInitialized)
+    return;
+
+  std::lock_guard<std::mutex> lk(this->dataPtr->initMutex);
+  if (this->dataPtr->msgTransportInitialized)
+    return;
+
+  if (this->dataPtr->intraProcess)
+  {
+    this->dataPtr->msgDiscovery.reset(new MsgDiscovery(this->pUuid));
+  }
+  else
+  {
+    this->dataPtr->msgDiscovery.reset(
+        new MsgDiscovery(this->pUuid, this->discoveryIP, this->msgDiscPort));
+  }
+
+  if (!this->dataPtr->intraProcess)
+  {
+    // Initialize the 0MQ objects.
+    if (!this->InitializeMsgSockets())
+    {
+      this->dataPtr->msgTransportInitialized = true;
+      return;
+    }
+
+    if (this->verbose)
+    {
+      std::cout << "Current host address: " << this->hostAddr << std::endl;
+      std::cout << "Bind at: [udp://" << this->discoveryIP << ":"
+                << this->msgDiscPort << "] for msg discovery\n";
+      std::cout << "Bind at: [" << this->myAddress << "] for pub/sub"
+                << std::endl;
+    }
+
+    this->dataPtr->msgSocketsReady = true;
+    this->StartReceptionTask();
+
+    // Set the callback to notify discovery updates (new topics).
+    this->dataPtr->msgDiscovery->ConnectionsCb(
+        std::bind(&NodeShared::OnNewConnection, this, std::placeholders::_1));
+
+    // Set the callback to notify discovery updates (invalid topics).
+    this->dataPtr->msgDiscovery->DisconnectionsCb(
+        std::bind(&NodeShared::OnNewDisconnection, this,
+          std::placeholders::_1));
+
+    this->dataPtr->msgDiscovery->RegistrationsCb(
+        std::bind(&NodeShared::OnNewRegistration, this,
+          std::placeholders::_1));
+
+    this->dataPtr->msgDiscovery->UnregistrationsCb(
+        std::bind(&NodeShared::OnEndRegistration, this,
+          std::placeholders::_1));
+  }
+
+  // Start the discovery service.
+  this->dataPtr->msgDiscovery->Start();
+  std::thread::native_handle_type handle;
+  if (this->dataPtr->msgDiscovery->ReceptionThreadHandle(handle))
+    this->dataPtr->ConfigureThread(TransportThread::MSG_DISCOVERY, handle);
+
+  // Create the local publish thread.
+  this->dataPtr->pubThread = std::thread(&NodeSharedPrivate::PublishThread,
+      this->dataPtr.get());
+  this->dataPtr->ConfigureThread(TransportThread::PUBLISH,
+    this->dataPtr->pubThread.native_handle());
+
+  this->dataPtr->msgTransportInitialized = true;
 }
 
 //////////////////////////////////////////////////
-void NodeShared::OnNewRegistration(const MessagePublisher &_pub)
+void NodeShared::InitializeSrvTransport()
 {
-  // Discard the message if the destination PUUID is not me.
-  if (_pub.Ctrl() != this->pUuid)
+  // Fast path once the transport is initialized.
+  if (this->dataPtr->srvTransportInitialized)
     return;
 
-  std::string procUuid = _pub.PUuid();
-  std::string nodeUuid = _pub.NUuid();
+  std::lock_guard<std::mutex> lk(this->dataPtr->initMutex);
+  if (this->dataPtr->srvTransportInitialized)
+    return;
 
-  if (this->verbose)
+  if (this->dataPtr->intraProcess)
   {
-    std::cout << "Registering a new remote connection" << std::endl;
-    std::cout << "\tProc UUID: [" << procUuid << "]" << std::endl;
-    std::cout << "\tNode UUID: [" << nodeUuid << "]" << std::endl;
+    this->dataPtr->srvDiscovery.reset(new SrvDiscovery(this->pUuid));
+  }
+  else
+  {
+    this->dataPtr->srvDiscovery.reset(
+        new SrvDiscovery(this->pUuid, this->discoveryIP, this->srvDiscPort));
   }
 
-  // Add a remote subscriber.
-  std::lock_guard<std::recursive_mutex> lock(this->mutex);
-  this->remoteSubscribers.AddPublisher(_pub);
+  if (!this->dataPtr->intraProcess)
+  {
+    // Initialize the 0MQ objects.
+    if (!this->InitializeSrvSockets())
+    {
+      this->dataPtr->srvTransportInitialized = true;
+      return;
+    }
+
+    if (this->verbose)
+    {
+      std::cout << "Current host address: " << this->hostAddr << std::endl;
+      std::cout << "Bind at: [udp://" << this->discoveryIP << ":"
+                << this->srvDiscPort << "] for srv discovery\n";
+      std::cout << "Bind at: [" << this->myReplierAddress
+                << "] for srv. calls\n";
+      std::cout << "Identity for receiving srv. requests: ["
+                << this->replierId.ToString() << "]" << std::endl;
+      std::cout << "Identity for receiving srv. responses: ["
+                << this->responseReceiverId.ToString() << "]" << std::endl;
+    }
+
+    this->dataPtr->srvSocketsReady = true;
+    this->StartReceptionTask();
+
+    // Set the callback to notify svc discovery updates (new services).
+    this->dataPtr->srvDiscovery->ConnectionsCb(
+        std::bind(&NodeShared::OnNewSrvConnection, this,
+          std::placeholders::_1));
+
+    // Set the callback to notify svc discovery updates (invalid services).
+    this->dataPtr->srvDiscovery->DisconnectionsCb(
+        std::bind(&NodeShared::OnNewSrvDisconnection,
+          this, std::placeholders::_1));
+  }
+
+  // Start the discovery service.
+  this->dataPtr->srvDiscovery->Start();
+  std::thread::native_handle_type handle;
+  if (this->dataPtr->srvDiscovery->ReceptionThreadHandle(handle))
+    this->dataPtr->ConfigureThread(TransportThread::SRV_DISCOVERY, handle);
+
+  this->dataPtr->srvTransportInitialized = true;
 }
 
 //////////////////////////////////////////////////
-void NodeShared::OnEndRegistration(const MessagePublisher &_pub)
+bool NodeShared::IntraProcess() const
 {
-  // Discard the message if the destination PUUID is not me.
-  if (_pub.Ctrl() != this->pUuid)
-    return;
-
-  std::string topic = _pub.Topic();
-  std::string procUuid = _pub.PUuid();
-  std::string nodeUuid = _pub.NUuid();
+  return this->dataPtr->intraProcess;
+}
 
-  if (this->verbose)
-  {
-    std::cout << "Registering the end of a remote connection" << std::endl;
-    std::cout << "\tProc UUID: " << procUuid << std::endl;
-    std::cout << "\tNode UUID: [" << nodeUuid << "]" << std::endl;
-  }
+//////////////////////////////////////////////////
+void NodeShared::StartReceptionTask()
+{
+  if (this->threadReception.joinable())
+    return;
 
-  // Delete a remote subscriber.
-  std::lock_guard<std::recursive_mutex> lock(this->mutex);
-  this->remoteSubscribers.DelPublisherByNode(topic, procUuid, nodeUuid);
+  // Start the service thread.
+  this->threadReception = std::thread(&NodeShared::RunReceptionTask, this);
+  this->dataPtr->ConfigureThread(TransportThread::RECEPTION,
+    this->threadReception.native_handle());
 }
 
 //////////////////////////////////////////////////
-bool NodeShared::InitializeSockets()
+bool NodeShared::InitializeMsgSockets()
 {
   try
   {
+    this->dataPtr->publisher.reset(
+        new zmq::socket_t(*this->dataPtr->context, ZMQ_PUB));
+    this->dataPtr->subscriber.reset(
+        new zmq::socket_t(*this->dataPtr->context, ZMQ_SUB));
+
     // Set the hostname's ip address.
     this->hostAddr = this->dataPtr->msgDiscovery->HostAddr();
 
@@ -1458,7 +2046,49 @@ bool NodeShared::InitializeSockets()
     this->dataPtr->publisher->bind(anyTcpEp.c_str());
     this->myAddress =
         this->dataPtr->publisher->get(zmq::sockopt::last_endpoint);
+#else
+    char bindEndPoint[1024];
+    this->dataPtr->publisher->setsockopt(ZMQ_SNDHWM,
+        &sndQueueVal, sizeof(sndQueueVal));
+
+    this->dataPtr->publisher->bind(anyTcpEp.c_str());
+    size_t size = sizeof(bindEndPoint);
+    this->dataPtr->publisher->getsockopt(ZMQ_LAST_ENDPOINT,
+        &bindEndPoint, &size);
+    this->myAddress = bindEndPoint;
+#endif
+  }
+  catch(const zmq::error_t& ze)
+  {
+    std::cerr << "InitializeMsgSockets() Error: " << ze.what() << std::endl;
+    std::cerr << "Gazebo Transport has not been correctly initialized"
+              << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool NodeShared::InitializeSrvSockets()
+{
+  try
+  {
+    this->dataPtr->requester.reset(
+        new zmq::socket_t(*this->dataPtr->context, ZMQ_ROUTER));
+    this->dataPtr->responseReceiver.reset(
+        new zmq::socket_t(*this->dataPtr->context, ZMQ_ROUTER));
+    this->dataPtr->replier.reset(
+        new zmq::socket_t(*this->dataPtr->context, ZMQ_ROUTER));
+
+    // Set the hostname's ip address.
+    this->hostAddr = this->dataPtr->srvDiscovery->HostAddr();
+
+    // Sockets listening in a random port.
+    std::string anyTcpEp = "tcp://" + this->hostAddr + ":*";
 
+    int lingerVal = 0;
+#ifdef GZ_CPPZMQ_POST_4_7_0
     // ResponseReceiver socket listening in a random port.
     std::string id = this->responseReceiverId.ToString();
     this->dataPtr->responseReceiver->set(zmq::sockopt::routing_id, id);
@@ -1480,14 +2110,7 @@ bool NodeShared::InitializeSockets()
     this->dataPtr->requester->set(zmq::sockopt::router_mandatory, routeOn);
 #else
     char bindEndPoint[1024];
-    this->dataPtr->publisher->setsockopt(ZMQ_SNDHWM,
-        &sndQueueVal, sizeof(sndQueueVal));
-
-    this->dataPtr->publisher->bind(anyTcpEp.c_str());
     size_t size = sizeof(bindEndPoint);
-    this->dataPtr->publisher->getsockopt(ZMQ_LAST_ENDPOINT,
-        &bindEndPoint, &size);
-    this->myAddress = bindEndPoint;
 
     // ResponseReceiver socket listening in a random port.
     std::string id = this->responseReceiverId.ToString();
@@ -1507,6 +2130,7 @@ bool NodeShared::InitializeSockets()
     this->dataPtr->replier->setsockopt(ZMQ_ROUTER_MANDATORY,
         &RouteOn, sizeof(RouteOn));
     this->dataPtr->replier->bind(anyTcpEp.c_str());
+    size = sizeof(bindEndPoint);
     this->dataPtr->replier->getsockopt(ZMQ_LAST_ENDPOINT, &bindEndPoint, &size);
     this->myReplierAddress = bindEndPoint;
 
@@ -1518,7 +2142,7 @@ bool NodeShared::InitializeSockets()
   }
   catch(const zmq::error_t& ze)
   {
-    std::cerr << "InitializeSockets() Error: " << ze.what() << std::endl;
+    std::cerr << "InitializeSrvSockets() Error: " << ze.what() << std::endl;
     std::cerr << "Gazebo Transport has not been correctly initialized"
               << std::endl;
     return false;
@@ -1531,24 +2155,37 @@ bool NodeShared::InitializeSockets()
 bool NodeShared::TopicPublishers(const std::string &_topic,
                                  SrvAddresses_M &_publishers) const
 {
+  if (!this->dataPtr->srvTransportInitialized)
+    return false;
+
   return this->dataPtr->srvDiscovery->Publishers(_topic, _publishers);
 }
 
 /////////////////////////////////////////////////
 bool NodeShared::DiscoverService(const std::string &_topic) const
 {
+  if (!this->dataPtr->srvTransportInitialized)
+    return false;
+
   return this->dataPtr->srvDiscovery->Discover(_topic);
 }
 
 /////////////////////////////////////////////////
 bool NodeShared::AdvertisePublisher(const ServicePublisher &_publisher)
 {
+  if (!this->dataPtr->srvTransportInitialized)
+    return false;
+
   return this->dataPtr->srvDiscovery->Advertise(_publisher);
 }
 
 /////////////////////////////////////////////////
 int NodeShared::RcvHwm()
 {
+  this->InitializeMsgTransport();
+  if (!this->dataPtr->msgSocketsReady)
+    return -1;
+
   int rcvHwm;
   try
   {
@@ -1570,6 +2207,10 @@ int NodeShared::RcvHwm()
 /////////////////////////////////////////////////
 int NodeShared::SndHwm()
 {
+  this->InitializeMsgTransport();
+  if (!this->dataPtr->msgSocketsReady)
+    return -1;
+
   int sndHwm;
   try
   {
@@ -1588,6 +2229,87 @@ int NodeShared::SndHwm()
   return sndHwm;
 }
 
+/////////////////////////////////////////////////
+int NodeShared::SrvRequestWindow() const
+{
+  return this->dataPtr->srvWindow;
+}
+
+/////////////////////////////////////////////////
+void NodeShared::ConfigureThreads(const NodeOptions &_options)
+{
+  std::map<TransportThread, ThreadConfig> configs;
+  for (auto thread : {TransportThread::RECEPTION, TransportThread::PUBLISH,
+                      TransportThread::ACCESS_CONTROL,
+                      TransportThread::MSG_DISCOVERY,
+                      TransportThread::SRV_DISCOVERY})
+  {
+    ThreadConfig config;
+    config.cpus = _options.ThreadAffinity(thread);
+    config.priority = _options.ThreadPriority(thread);
+    config.name = _options.ThreadName(thread);
+    if (!config.cpus.empty() || config.priority > 0 || !config.name.empty())
+      configs[thread] = config;
+  }
+
+  // Most nodes don't configure the threads.
+  if (configs.empty())
+    return;
+
+  {
+    std::lock_guard<std::mutex> lk(this->dataPtr->threadConfigsMutex);
+    for (const auto &[thread, config] : configs)
+      this->dataPtr->threadConfigs[thread].Merge(config);
+  }
+
+  // The threads are started when the transports are initialized.
+  std::lock_guard<std::mutex> lk(this->dataPtr->initMutex);
+  std::thread::native_handle_type handle;
+  for (const auto &entry : configs)
+  {
+    switch (entry.first)
+    {
+      case TransportThread::RECEPTION:
+        if (this->threadReception.joinable())
+        {
+          this->dataPtr->ConfigureThread(entry.first,
+            this->threadReception.native_handle());
+        }
+        break;
+      case TransportThread::PUBLISH:
+        if (this->dataPtr->pubThread.joinable())
+        {
+          this->dataPtr->ConfigureThread(entry.first,
+            this->dataPtr->pubThread.native_handle());
+        }
+        break;
+      case TransportThread::ACCESS_CONTROL:
+        if (this->dataPtr->accessControlThread.joinable())
+        {
+          this->dataPtr->ConfigureThread(entry.first,
+            this->dataPtr->accessControlThread.native_handle());
+        }
+        break;
+      case TransportThread::MSG_DISCOVERY:
+        if (this->dataPtr->msgDiscovery &&
+            this->dataPtr->msgDiscovery->ReceptionThreadHandle(handle))
+        {
+          this->dataPtr->ConfigureThread(entry.first, handle);
+        }
+        break;
+      case TransportThread::SRV_DISCOVERY:
+        if (this->dataPtr->srvDiscovery &&
+            this->dataPtr->srvDiscovery->ReceptionThreadHandle(handle))
+        {
+          this->dataPtr->ConfigureThread(entry.first, handle);
+        }
+        break;
+      default:
+        break;
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 bool NodeShared::HandlerWrapper::HasSubscriber(
     const std::string &_fullyQualifiedTopic,
@@ -1617,23 +2339,11 @@ static void AppendNodeUuids(const HandlerStorage<HandlerT> &_handlerStorage,
                             const std::string &_msgTypeName,
                             std::vector<std::string> &_uuids)
 {
-  using HandlerTPtr = std::shared_ptr<HandlerT>;
-  std::map<std::string, std::map<std::string, HandlerTPtr>> handlers;
-
-  _handlerStorage.Handlers(_fullyQualifiedTopic, handlers);
-  for (const auto &collection : handlers)
-  {
-    for (const auto &collectionEntry : collection.second)
-    {
-      const HandlerTPtr &handler = collectionEntry.second;
-      const std::string &handlerMsgType = handler->TypeName();
-      if (handlerMsgType == _msgTypeName
-          || handlerMsgType == kGenericMessageType)
-      {
-        _uuids.push_back(handler->NodeUuid());
-      }
-    }
-  }
+  std::vector<std::shared_ptr<HandlerT>> handlers;
+  _handlerStorage.Handlers(
+    _fullyQualifiedTopic, msgTypeId(_msgTypeName), handlers);
+  for (const auto &handler : handlers)
+    _uuids.push_back(handler->NodeUuid());
 }
 
 //////////////////////////////////////////////////
@@ -1652,6 +2362,15 @@ std::vector<std::string> NodeShared::HandlerWrapper::NodeUuids(
 bool NodeShared::HandlerWrapper::RemoveHandlersForNode(
     const std::string &_fullyQualifiedTopic,
     const std::string &_nUuid)
+{
+  return this->RemoveHandlersForNode(_fullyQualifiedTopic,
+    Uuid::FromIdentifier(_nUuid));
+}
+
+//////////////////////////////////////////////////
+bool NodeShared::HandlerWrapper::RemoveHandlersForNode(
+    const std::string &_fullyQualifiedTopic,
+    const Uuid &_nUuid)
 {
   bool removed = false;
   removed |= this->normal.RemoveHandlersForNode(_fullyQualifiedTopic, _nUuid);
@@ -1695,6 +2414,8 @@ void NodeSharedPrivate::SecurityInit()
     // Create the access control thread.
     this->accessControlThread = std::thread(
         &NodeSharedPrivate::AccessControlHandler, this);
+    this->ConfigureThread(TransportThread::ACCESS_CONTROL,
+      this->accessControlThread.native_handle());
 
     int asPlainSecurityServer = static_cast<int>(
         ZmqPlainSecurityServerOptions::ZMQ_PLAIN_SECURITY_SERVER_ENABLED);
@@ -1896,8 +2617,18 @@ void NodeSharedPrivate::PublishThread()
     {
       try
       {
-        handler->RunLocalCallback(*(msgDetails->msgCopy.get()),
-            msgDetails->info);
+        // The handlers that admit before decoding were admitted when the
+        // message was published.
+        if (handler->AdmitsBeforeDecode())
+        {
+          handler->RunAdmittedCallback(*(msgDetails->msgCopy.get()),
+              msgDetails->info);
+        }
+        else
+        {
+          handler->RunLocalCallback(*(msgDetails->msgCopy.get()),
+              msgDetails->info);
+        }
       }
       catch (...)
       {
@@ -1917,10 +2648,12 @@ void NodeSharedPrivate::PublishThread()
       }
       catch (...)
       {
+        // The message is only copied when there are local handlers.
         std::cerr << "Exception occured in a local raw callback "
           << "on topic [" << msgDetails->info.Topic() << "] with "
-          << "message [" << msgDetails->msgCopy->DebugString() << "]"
-          << std::endl;
+          << "message ["
+          << (msgDetails->msgCopy ? msgDetails->msgCopy->DebugString() : "")
+          << "]" << std::endl;
       }
     }
   }
@@ -1950,6 +2683,209 @@ void NodeShared::EnableStats(const std::string &_topic, bool _enable,
   }
 }
 
+//////////////////////////////////////////////////
+void NodeSharedPrivate::NotifySubscribersChanged()
+{
+  {
+    std::lock_guard<std::mutex> lk(this->subscribersMutex);
+    ++this->subscribersVersion;
+  }
+  this->subscribersChanged.notify_all();
+}
+
+//////////////////////////////////////////////////
+MulticastTransport *NodeSharedPrivate::Multicast(const std::string &_hostAddr)
+{
+  if (this->multicastInitialized)
+    return this->multicast.get();
+
+  this->multicastInitialized = true;
+
+  // Join the groups on the same interfaces as the discovery.
+  std::vector<std::string> interfaces;
+  std::string gzIp;
+  if (env("GZ_IP", gzIp) && !gzIp.empty())
+    interfaces.push_back(gzIp);
+  else
+    interfaces = determineInterfaces();
+
+  std::unique_ptr<MulticastTransport> transport(
+    new MulticastTransport(_hostAddr, interfaces, this->multicastPort));
+  if (!transport->Valid())
+    return nullptr;
+
+  this->multicast = std::move(transport);
+  this->multicastSocket = this->multicast->Socket();
+  return this->multicast.get();
+}
+
+//////////////////////////////////////////////////
+bool NodeSharedPrivate::JoinMulticast(const std::string &_topic,
+    const std::string &_sender, const std::string &_endpoint,
+    const std::string &_hostAddr)
+{
+  std::string group;
+  int port = 0;
+  if (!MulticastTransport::ParseEndpoint(_endpoint, group, port) ||
+      port != this->multicastPort)
+  {
+    return false;
+  }
+
+  MulticastTransport *transport = this->Multicast(_hostAddr);
+  if (!transport)
+    return false;
+
+  auto it = this->multicastGroups.find(_topic);
+  if (it == this->multicastGroups.end())
+  {
+    if (!transport->Join(group))
+      return false;
+    this->multicastGroups[_topic] = group;
+  }
+  else if (it->second != group)
+  {
+    return false;
+  }
+
+  this->multicastSources[_topic].insert(_sender);
+  return true;
+}
+
+//////////////////////////////////////////////////
+void NodeSharedPrivate::LeaveMulticast(const std::string &_topic)
+{
+  auto it = this->multicastGroups.find(_topic);
+  if (it != this->multicastGroups.end())
+  {
+    if (this->multicast)
+      this->multicast->Leave(it->second);
+    this->multicastGroups.erase(it);
+  }
+  this->multicastSources.erase(_topic);
+}
+
+//////////////////////////////////////////////////
+bool NodeSharedPrivate::IsMulticastSource(const std::string &_topic,
+    const std::string &_sender) const
+{
+  auto it = this->multicastSources.find(_topic);
+  return it != this->multicastSources.end() && it->second.count(_sender) > 0;
+}
+
+//////////////////////////////////////////////////
+zmq::context_t *NodeSharedPrivate::CreateContext()
+{
+  auto *context = new zmq::context_t(1);
+
+  const ThreadConfig config = ThreadConfig::FromEnv(TransportThread::ZMQ_IO);
+  if (config.cpus.empty() && config.priority <= 0)
+    return context;
+
+#if defined(ZMQ_THREAD_AFFINITY_CPU_ADD) && defined(__linux__)
+#ifdef GZ_CPPZMQ_POST_4_7_0
+  void *handle = context->handle();
+#else
+  void *handle = static_cast<void *>(*context);
+#endif
+
+  for (const int cpu : config.cpus)
+  {
+    if (zmq_ctx_set(handle, ZMQ_THREAD_AFFINITY_CPU_ADD, cpu) != 0)
+    {
+      std::cerr << "Unable to set the CPU affinity of the ZMQ_IO thread: "
+                << zmq_strerror(zmq_errno()) << std::endl;
+    }
+  }
+
+  if (config.priority > 0 &&
+      (zmq_ctx_set(handle, ZMQ_THREAD_SCHED_POLICY, SCHED_FIFO) != 0 ||
+       zmq_ctx_set(handle, ZMQ_THREAD_PRIORITY, config.priority) != 0))
+  {
+    std::cerr << "Unable to set the SCHED_FIFO priority of the ZMQ_IO "
+              << "thread: " << zmq_strerror(zmq_errno()) << std::endl;
+  }
+#else
+  std::cerr << "The affinity and priority of the ZMQ_IO thread require "
+            << "ZeroMQ 4.3 on Linux. Ignoring them" << std::endl;
+#endif
+
+  return context;
+}
+
+//////////////////////////////////////////////////
+void NodeSharedPrivate::ConfigureThread(const TransportThread _thread,
+  std::thread::native_handle_type _handle)
+{
+  ThreadConfig config;
+  {
+    std::lock_guard<std::mutex> lk(this->threadConfigsMutex);
+    auto it = this->threadConfigs.find(_thread);
+    if (it != this->threadConfigs.end())
+      config = it->second;
+  }
+  config.Apply(_handle, _thread);
+}
+
+//////////////////////////////////////////////////
+bool NodeSharedPrivate::CheckDeltaTopic(const std::string &_topic,
+    const uint32_t _keyframeInterval) const
+{
+  auto it = this->deltaTopics.find(_topic);
+  return _keyframeInterval == 0 || it == this->deltaTopics.end() ||
+    it->second.keyframeInterval == _keyframeInterval;
+}
+
+//////////////////////////////////////////////////
+void NodeSharedPrivate::RemoveDeltaTopic(const std::string &_topic,
+    const Uuid &_pUuid)
+{
+  auto it = this->deltaTopics.find(_topic);
+  if (it == this->deltaTopics.end())
+    return;
+
+  // Other publishers of the process keep using the encoder.
+  if (this->msgDiscovery &&
+      this->msgDiscovery->HasAnyPublishers(_topic, _pUuid))
+  {
+    return;
+  }
+
+  this->deltaTopics.erase(it);
+}
+
+//////////////////////////////////////////////////
+void NodeSharedPrivate::RemoveDeltaDecoder(const std::string &_topic,
+    const std::string &_sender)
+{
+  auto it = this->deltaDecoders.find(_topic);
+  if (it == this->deltaDecoders.end())
+    return;
+
+  it->second.erase(_sender);
+  if (it->second.empty())
+    this->deltaDecoders.erase(it);
+}
+
+/////////////////////////////////////////////////
+std::set<NodeSharedPrivate::SrvTypes> NodeSharedPrivate::ReleaseSrvSlots(
+  const std::function<bool(const InFlightRequest &)> &_release)
+{
+  std::set<SrvTypes> released;
+  for (auto it = this->srvInFlight.begin(); it != this->srvInFlight.end();)
+  {
+    if (_release(it->second))
+    {
+      released.emplace(it->second.topic, it->second.reqType,
+        it->second.repType);
+      it = this->srvInFlight.erase(it);
+    }
+    else
+      ++it;
+  }
+  return released;
+}
+
 /////////////////////////////////////////////////
 int NodeSharedPrivate::NonNegativeEnvVar(const std::string &_envVar,
     int _defaultValue) const
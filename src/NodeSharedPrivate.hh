@@ -21,14 +21,28 @@
 #include <zmq.hpp>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
+#include "gz/transport/BufferPool.hh"
 #include "gz/transport/Discovery.hh"
 #include "gz/transport/Node.hh"
+#include "gz/transport/Uuid.hh"
+#include "DeltaEncoding.hh"
+#include "MulticastTransport.hh"
+#include "ServiceResponseCache.hh"
+#include "ThreadConfig.hh"
 
 namespace gz
 {
@@ -53,16 +67,25 @@ namespace gz
     class NodeSharedPrivate
     {
       // Constructor
+      // The sockets are created when the transport of topics or services is
+      // initialized.
       public: NodeSharedPrivate() :
-                context(new zmq::context_t(1)),
-                publisher(new zmq::socket_t(*context, ZMQ_PUB)),
-                subscriber(new zmq::socket_t(*context, ZMQ_SUB)),
-                requester(new zmq::socket_t(*context, ZMQ_ROUTER)),
-                responseReceiver(new zmq::socket_t(*context, ZMQ_ROUTER)),
-                replier(new zmq::socket_t(*context, ZMQ_ROUTER))
+                context(CreateContext())
       {
       }
 
+      /// \brief Create the ZMQ context, configuring its I/O thread with the
+      /// GZ_TRANSPORT_THREAD_*_ZMQ_IO environment variables. The options
+      /// have to be set before the first socket starts the I/O thread.
+      /// \return The context.
+      public: static zmq::context_t *CreateContext();
+
+      /// \brief Apply the configuration of a transport thread.
+      /// \param[in] _thread The thread.
+      /// \param[in] _handle Native handle of the running thread.
+      public: void ConfigureThread(const TransportThread _thread,
+                                   std::thread::native_handle_type _handle);
+
       /// \brief Initialize security
       public: void SecurityInit();
 
@@ -83,6 +106,42 @@ namespace gz
       public: int NonNegativeEnvVar(const std::string &_envVar,
                                     int _defaultValue) const;
 
+      /// \brief A service request that occupies a slot of the window of its
+      /// responder in pipelining mode.
+      public: struct InFlightRequest
+      {
+        /// \brief Service name.
+        std::string topic;
+
+        /// \brief Type of the request.
+        std::string reqType;
+
+        /// \brief Type of the response.
+        std::string repType;
+
+        /// \brief Address of the responder.
+        std::string addr;
+
+        /// \brief Process UUID of the responder.
+        Uuid pUuid;
+
+        /// \brief Time when the slot is released if no response arrives.
+        std::chrono::steady_clock::time_point expiration;
+      };
+
+      /// \brief A service with a pair of request/response types.
+      public: using SrvTypes = std::tuple<std::string, std::string,
+                                          std::string>;
+
+      /// \brief Release the window slots of some requests in flight. The
+      /// caller must hold the mutex of NodeShared.
+      /// \param[in] _release Function returning true for the requests whose
+      /// slot is released.
+      /// \return The services with released slots, where pending requests
+      /// can be sent now.
+      public: std::set<SrvTypes> ReleaseSrvSlots(
+        const std::function<bool(const InFlightRequest &)> &_release);
+
       //////////////////////////////////////////////////
       ///////    Declare here the ZMQ Context    ///////
       //////////////////////////////////////////////////
@@ -95,7 +154,8 @@ namespace gz
       ///////     Declare here all ZMQ sockets   ///////
       //////////////////////////////////////////////////
 
-      /// \brief ZMQ socket to send topic updates.
+      /// \brief ZMQ socket to send topic updates. The sockets are null until
+      /// the transport of topics or services is initialized.
       public: std::unique_ptr<zmq::socket_t> publisher;
 
       /// \brief ZMQ socket to receive topic updates.
@@ -123,6 +183,33 @@ namespace gz
       /// \brief Discovery service (services).
       public: std::unique_ptr<SrvDiscovery> srvDiscovery;
 
+      //////////////////////////////////////////////////
+      ///////     Lazy initialization state      ///////
+      //////////////////////////////////////////////////
+
+      /// \brief When true, the process doesn't communicate with other
+      /// processes (GZ_TRANSPORT_INTRA_PROCESS=1). The discovery services
+      /// only keep the local information and no sockets are created.
+      public: bool intraProcess = false;
+
+      /// \brief Mutex to serialize the initialization of the transports.
+      public: std::mutex initMutex;
+
+      /// \brief Set when the initialization of the transport of topics has
+      /// been done, even if it failed. msgDiscovery is valid after that.
+      public: std::atomic<bool> msgTransportInitialized = false;
+
+      /// \brief Set when the initialization of the transport of services
+      /// has been done, even if it failed. srvDiscovery is valid after that.
+      public: std::atomic<bool> srvTransportInitialized = false;
+
+      /// \brief Set when the publisher and subscriber sockets are ready.
+      public: std::atomic<bool> msgSocketsReady = false;
+
+      /// \brief Set when the replier, requester and response receiver
+      /// sockets are ready.
+      public: std::atomic<bool> srvSocketsReady = false;
+
       //////////////////////////////////////////////////
       /////// Other private member variables     ///////
       //////////////////////////////////////////////////
@@ -133,6 +220,30 @@ namespace gz
       /// \brief Timeout used for receiving messages (ms.).
       public: inline static const int Timeout = 250;
 
+      /// \brief Responses received from cacheable services.
+      public: ServiceResponseCache srvResponseCache;
+
+      /// \brief Maximum number of service requests waiting for a response
+      /// from a responder, or 0 to disable pipelining.
+      public: int srvWindow = kDefaultSrvWindow;
+
+      /// \brief Requests sent in pipelining mode that wait for a response,
+      /// indexed by request UUID. A slot of the window is released when the
+      /// response arrives, when the request times out or when the responder
+      /// goes away. Protected by the mutex of NodeShared.
+      public: std::unordered_map<Uuid, InFlightRequest> srvInFlight;
+
+      /// \brief Time after which a request without response releases its
+      /// slot of the window (ms.).
+      public: inline static const int SrvWindowTimeout = 1000;
+
+      /// \brief Configuration of the transport threads, read from the
+      /// environment and updated with the options of the nodes.
+      public: std::map<TransportThread, ThreadConfig> threadConfigs;
+
+      /// \brief Mutex to protect threadConfigs.
+      public: std::mutex threadConfigsMutex;
+
       ////////////////////////////////////////////////////////////////
       /////// The following is for asynchronous publication of ///////
       /////// messages to local subscribers.                    ///////
@@ -156,7 +267,7 @@ namespace gz
                 public: std::vector<RawSubscriptionHandlerPtr> rawHandlers;
 
                 /// \brief Buffer for the raw handlers.
-                public: std::unique_ptr<char[]> sharedBuffer = nullptr;
+                public: BufferPool::Ptr sharedBuffer = nullptr;
 
                 /// \brief Msg copy for the local handlers.
                 public: std::unique_ptr<ProtoMsg> msgCopy = nullptr;
@@ -199,6 +310,168 @@ namespace gz
       public: std::map<std::string,
               std::function<void(const TopicStatistics &_stats)>>
                 enabledTopicStatistics;
+
+      /// \brief Wake up the threads waiting for subscribers. Call this
+      /// function after a local or remote subscriber is added or removed.
+      public: void NotifySubscribersChanged();
+
+      /// \brief Mutex to protect subscribersVersion.
+      public: std::mutex subscribersMutex;
+
+      /// \brief Increased every time that the subscribers change.
+      public: uint64_t subscribersVersion = 0;
+
+      /// \brief Used to signal when the subscribers change.
+      public: std::condition_variable subscribersChanged;
+
+      /// \brief Increased every time that the remote subscribers change, so
+      /// the multicast routes and the delta encoding of the topics are
+      /// checked again. Protected by the mutex of NodeShared.
+      public: uint64_t remoteSubscribersVersion = 0;
+
+      //////////////////////////////////////////////////
+      ///////        Multicast data path         ///////
+      //////////////////////////////////////////////////
+
+      /// \brief Get the multicast transport, creating it on first use.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _hostAddr IP address of the interface used to send.
+      /// \return The transport, or nullptr if multicast can't be used.
+      public: MulticastTransport *Multicast(const std::string &_hostAddr);
+
+      /// \brief Receive the messages of a topic from a publisher through
+      /// multicast, joining the group of its endpoint if needed.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _sender ZeroMQ address of the publisher.
+      /// \param[in] _endpoint Multicast endpoint announced by the publisher.
+      /// \param[in] _hostAddr IP address of the interface used to send.
+      /// \return False if the messages must be received through TCP.
+      public: bool JoinMulticast(const std::string &_topic,
+                                 const std::string &_sender,
+                                 const std::string &_endpoint,
+                                 const std::string &_hostAddr);
+
+      /// \brief Stop receiving the messages of a topic through multicast.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      public: void LeaveMulticast(const std::string &_topic);
+
+      /// \brief Whether the messages of a topic from a publisher are
+      /// received through multicast.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _sender ZeroMQ address of the publisher.
+      /// \return True if they are received through multicast.
+      public: bool IsMulticastSource(const std::string &_topic,
+                                     const std::string &_sender) const;
+
+      /// \brief Destination of the messages of a topic advertised with
+      /// multicast by this process.
+      public: struct MulticastRoute
+      {
+        /// \brief Multicast group of the topic.
+        std::string group;
+
+        /// \brief Value of remoteSubscribersVersion when the route was
+        /// computed.
+        uint64_t version = UINT64_MAX;
+
+        /// \brief Whether a remote subscriber receives through multicast.
+        bool haveMulticast = false;
+
+        /// \brief Whether a remote subscriber receives through TCP.
+        bool haveTcp = false;
+      };
+
+      /// \brief Multicast transport, created on first use.
+      public: std::unique_ptr<MulticastTransport> multicast;
+
+      /// \brief Whether the creation of the multicast transport was tried.
+      public: bool multicastInitialized = false;
+
+      /// \brief Socket of the multicast transport polled by the reception
+      /// thread, or -1 while there's none.
+      public: std::atomic<int> multicastSocket{-1};
+
+      /// \brief Port of the multicast data (GZ_TRANSPORT_MULTICAST_PORT).
+      public: int multicastPort = MulticastTransport::kDefaultPort;
+
+      /// \brief Routes of the topics advertised with multicast, by topic.
+      public: std::map<std::string, MulticastRoute> multicastRoutes;
+
+      /// \brief Groups joined for the subscribed topics, by topic.
+      public: std::map<std::string, std::string> multicastGroups;
+
+      /// \brief ZeroMQ addresses of the publishers whose messages are
+      /// received through multicast, by topic.
+      public: std::map<std::string, std::set<std::string>> multicastSources;
+
+      //////////////////////////////////////////////////
+      ///////          Delta encoding            ///////
+      //////////////////////////////////////////////////
+
+      /// \brief Delta encoding of a topic advertised by this process.
+      public: struct DeltaTopic
+      {
+        /// \brief Constructor.
+        /// \param[in] _keyframeInterval Number of messages between
+        /// keyframes.
+        explicit DeltaTopic(const uint32_t _keyframeInterval)
+          : keyframeInterval(_keyframeInterval),
+            encoder(_keyframeInterval)
+        {
+        }
+
+        /// \brief Number of messages between keyframes.
+        uint32_t keyframeInterval;
+
+        /// \brief Encoder of the messages.
+        DeltaEncoder encoder;
+
+        /// \brief Value of remoteSubscribersVersion when enabled was
+        /// computed.
+        uint64_t version = UINT64_MAX;
+
+        /// \brief Whether all the remote subscribers that receive through
+        /// TCP can decode the deltas.
+        bool enabled = false;
+      };
+
+      /// \brief Topics advertised with delta encoding, by topic.
+      public: std::map<std::string, DeltaTopic> deltaTopics;
+
+      /// \brief Buffer of the frames encoded by Publish().
+      public: std::string deltaFrame;
+
+      /// \brief Decoders of the topics received with delta encoding, by
+      /// topic and ZeroMQ address of the publisher.
+      public: std::map<std::string, std::map<std::string, DeltaDecoder>>
+                deltaDecoders;
+
+      /// \brief Check that the delta encoding requested by a new publisher
+      /// of a topic matches the one of the other publishers of the process.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _keyframeInterval Interval requested, 0 for none.
+      /// \return False if the topic is already encoded with another interval.
+      public: bool CheckDeltaTopic(const std::string &_topic,
+                                   const uint32_t _keyframeInterval) const;
+
+      /// \brief Stop the delta encoding of a topic if the process doesn't
+      /// publish it anymore.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _pUuid UUID of this process.
+      public: void RemoveDeltaTopic(const std::string &_topic,
+                                    const Uuid &_pUuid);
+
+      /// \brief Remove the decoder of a topic from a publisher.
+      /// Must be called with the mutex of NodeShared locked.
+      /// \param[in] _topic Fully qualified topic name.
+      /// \param[in] _sender ZeroMQ address of the publisher.
+      public: void RemoveDeltaDecoder(const std::string &_topic,
+                                      const std::string &_sender);
     };
     }
   }
@@ -18,22 +18,33 @@
 #include <gz/msgs/stringmsg.pb.h>
 #include <gz/msgs/vector3d.pb.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <csignal>
 #include <cstdlib>
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "gz/transport/AdvertiseOptions.hh"
 #include "gz/transport/MessageInfo.hh"
 #include "gz/transport/Node.hh"
 #include "gz/transport/NodeOptions.hh"
+#include "gz/transport/NodeShared.hh"
+#include "gz/transport/SubscriptionHandler.hh"
 #include "gz/transport/TopicStatistics.hh"
 #include "gz/transport/TopicUtils.hh"
+#include "gz/transport/TransportContext.hh"
 #include "gz/transport/TransportTypes.hh"
+#include "gz/transport/Uuid.hh"
+#include "MulticastTransport.hh"
 #include "test_config.hh"
 
 using namespace gz;
@@ -940,6 +951,202 @@ TEST(NodeTest, AdvertiseTwoEqualTopics)
   EXPECT_TRUE(pub3);
 }
 
+//////////////////////////////////////////////////
+/// \brief Advertise several topics at once.
+TEST(NodeTest, AdvertiseMany)
+{
+  reset();
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+
+  transport::Node node;
+
+  auto single = node.Advertise<msgs::Int32>(g_topic);
+  EXPECT_TRUE(single);
+
+  // The already advertised topic, an invalid name and a repeated topic are
+  // rejected without affecting the rest.
+  std::vector<std::string> topics =
+    {"/many/a", g_topic, "invalid topic", "/many/b", "/many/a"};
+  auto pubs = node.AdvertiseMany<msgs::Int32>(topics);
+  ASSERT_EQ(topics.size(), pubs.size());
+  EXPECT_TRUE(pubs[0]);
+  EXPECT_FALSE(pubs[1]);
+  EXPECT_FALSE(pubs[2]);
+  EXPECT_TRUE(pubs[3]);
+  EXPECT_FALSE(pubs[4]);
+
+  auto advertisedTopics = node.AdvertisedTopics();
+  EXPECT_EQ(3u, advertisedTopics.size());
+
+  // The publishers behave like the ones returned by Advertise().
+  EXPECT_TRUE(node.Subscribe("/many/b", cb));
+  EXPECT_TRUE(pubs[3].Publish(msg));
+  {
+    std::unique_lock<std::mutex> lk(cbMutex);
+    cbCondition.wait_for(lk, std::chrono::seconds(5),
+      []{return counter >= 1;});
+  }
+  EXPECT_TRUE(cbExecuted);
+  EXPECT_EQ(1, counter);
+
+  // Destroying the publishers unadvertises the topics.
+  pubs.clear();
+  advertisedTopics = node.AdvertisedTopics();
+  ASSERT_EQ(1u, advertisedTopics.size());
+  EXPECT_EQ(g_topic, advertisedTopics[0]);
+
+  reset();
+}
+
+//////////////////////////////////////////////////
+/// \brief Wait for the subscribers of a publisher.
+TEST(NodeTest, WaitForSubscribers)
+{
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>(g_topic);
+  ASSERT_TRUE(pub);
+  EXPECT_EQ(0u, pub.SubscriberCount());
+
+  // Nobody subscribes.
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(pub.WaitForSubscribers(1u, std::chrono::milliseconds(50)));
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(50));
+
+  // The subscriber arrives while waiting.
+  transport::Node subNode;
+  std::thread subscriber([&subNode]()
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(subNode.Subscribe(g_topic, cb));
+  });
+  start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(pub.WaitForSubscribers(1u, std::chrono::seconds(5)));
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::seconds(5));
+  subscriber.join();
+  EXPECT_EQ(1u, pub.SubscriberCount());
+
+  // Already satisfied.
+  EXPECT_TRUE(pub.WaitForSubscribers(1u, std::chrono::milliseconds(0)));
+  EXPECT_FALSE(pub.WaitForSubscribers(2u, std::chrono::milliseconds(10)));
+
+  // Invalid publisher.
+  transport::Node::Publisher invalid;
+  EXPECT_FALSE(invalid.WaitForSubscribers(0u, std::chrono::milliseconds(0)));
+  EXPECT_EQ(0u, invalid.SubscriberCount());
+}
+
+//////////////////////////////////////////////////
+/// \brief Create many nodes sharing the same options.
+TEST(NodeTest, SharedOptions)
+{
+  reset();
+
+  auto options = std::make_shared<transport::NodeOptions>();
+  options->SetPartition(partition);
+  EXPECT_TRUE(options->AddTopicRemap("/remapped", g_topic));
+
+  std::vector<std::unique_ptr<transport::Node>> nodes;
+  for (int i = 0; i < 100; ++i)
+    nodes.push_back(std::make_unique<transport::Node>(options));
+
+  // The nodes don't copy the options.
+  for (const auto &node : nodes)
+  {
+    EXPECT_EQ(options.get(), &node->Options());
+    EXPECT_EQ(options, node->SharedOptions());
+  }
+
+  // A node without options uses the default ones.
+  std::shared_ptr<const transport::NodeOptions> noOptions;
+  transport::Node defaultNode(noOptions);
+  EXPECT_TRUE(defaultNode.Options().NameSpace().empty());
+  EXPECT_FALSE(defaultNode.Options().Partition().empty());
+
+  // The remapping and partition are applied.
+  auto pub = nodes.front()->Advertise<msgs::Int32>("/remapped");
+  ASSERT_TRUE(pub);
+  EXPECT_TRUE(nodes.back()->Subscribe(g_topic, cb));
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+
+  std::unique_lock<std::mutex> lk(cbMutex);
+  EXPECT_TRUE(pub.Publish(msg));
+  cbCondition.wait_for(lk, std::chrono::seconds(1), []{return cbExecuted;});
+  EXPECT_TRUE(cbExecuted);
+  lk.unlock();
+
+  // Destroying the nodes that didn't subscribe doesn't affect the rest.
+  nodes.erase(nodes.begin() + 1, nodes.end() - 1);
+  EXPECT_EQ(1u, nodes.back()->SubscribedTopics().size());
+  nodes.clear();
+
+  reset();
+}
+
+//////////////////////////////////////////////////
+/// \brief Handles of a node share its subscriptions and services, which
+/// are removed with the last handle.
+TEST(NodeTest, NodeHandles)
+{
+  reset();
+
+  transport::NodeOptions options;
+  options.SetPartition(partition);
+  auto node = std::make_unique<transport::Node>(options);
+  auto handle = node->CreateHandle();
+  ASSERT_NE(nullptr, handle);
+  EXPECT_EQ(&node->Options(), &handle->Options());
+
+  // The subscriptions and services of a handle belong to the node.
+  EXPECT_TRUE(handle->Subscribe(g_topic, cb));
+  EXPECT_TRUE(handle->Advertise(g_topic, srvEcho));
+  EXPECT_EQ(handle->SubscribedTopics(), node->SubscribedTopics());
+  EXPECT_EQ(handle->AdvertisedServices(), node->AdvertisedServices());
+  ASSERT_EQ(1u, node->SubscribedTopics().size());
+  ASSERT_EQ(1u, node->AdvertisedServices().size());
+
+  // Destroying the other handles of the node keeps them.
+  auto other = handle->CreateHandle();
+  other.reset();
+  node.reset();
+  EXPECT_EQ(1u, handle->SubscribedTopics().size());
+  EXPECT_EQ(1u, handle->AdvertisedServices().size());
+
+  transport::Node pubNode(options);
+  auto pub = pubNode.Advertise<msgs::Int32>(g_topic);
+  ASSERT_TRUE(pub);
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+  {
+    std::unique_lock<std::mutex> lk(cbMutex);
+    EXPECT_TRUE(pub.Publish(msg));
+    cbCondition.wait_for(lk, std::chrono::seconds(1), []{return cbExecuted;});
+    EXPECT_TRUE(cbExecuted);
+  }
+
+  msgs::Int32 rep;
+  bool result = false;
+  EXPECT_TRUE(pubNode.Request(g_topic, msg, 1000u, rep, result));
+  EXPECT_TRUE(result);
+  EXPECT_TRUE(srvExecuted);
+
+  // The last handle removes them.
+  handle.reset();
+  reset();
+  EXPECT_TRUE(pub.Publish(msg));
+  EXPECT_FALSE(pubNode.Request(g_topic, msg, 100u, rep, result));
+  EXPECT_FALSE(cbExecuted);
+  EXPECT_FALSE(srvExecuted);
+
+  reset();
+}
+
 //////////////////////////////////////////////////
 /// \brief Use two threads using their own transport nodes. One thread
 /// will publish a message, whereas the other thread is subscribed to the topic.
@@ -1239,6 +1446,43 @@ TEST(NodeTest, ServiceCallAsync)
   reset();
 }
 
+//////////////////////////////////////////////////
+/// \brief Make an asynchronous service call with a generic response, which
+/// has the response type of the responder.
+TEST(NodeTest, ServiceCallAsyncGenericReply)
+{
+  reset();
+
+  msgs::Int32 req;
+  req.set_data(data);
+
+  transport::Node node;
+  EXPECT_TRUE(node.Advertise(g_topic, srvEcho));
+
+  std::function<void(const google::protobuf::Message &, const bool)> cb =
+    [](const google::protobuf::Message &_rep, const bool _result)
+    {
+      EXPECT_TRUE(_result);
+      ASSERT_EQ(msgs::Int32().GetTypeName(), _rep.GetTypeName());
+      msgs::Int32 rep;
+      rep.CopyFrom(_rep);
+      EXPECT_EQ(data, rep.data());
+
+      responseExecuted = true;
+      ++counter;
+    };
+  EXPECT_TRUE(node.Request(g_topic, req, cb));
+
+  // Check that the service call response was executed.
+  EXPECT_TRUE(responseExecuted);
+  EXPECT_TRUE(srvExecuted);
+  EXPECT_EQ(counter, 1);
+
+  EXPECT_TRUE(node.UnadvertiseSrv(g_topic));
+
+  reset();
+}
+
 //////////////////////////////////////////////////
 /// \brief Make an asynchronous service call without input using free function.
 TEST(NodeTest, ServiceCallWithoutInputAsync)
@@ -1637,6 +1881,127 @@ TEST(NodeTest, ServiceCallSync)
   reset();
 }
 
+//////////////////////////////////////////////////
+/// \brief Make service calls with a service client.
+TEST(NodeTest, ServiceClient)
+{
+  reset();
+
+  msgs::Int32 req;
+  msgs::Int32 rep;
+  bool result = false;
+  unsigned int timeout = 1000;
+
+  req.set_data(data);
+
+  transport::Node node;
+
+  // Invalid service name.
+  auto invalid = node.CreateServiceClient<msgs::Int32, msgs::Int32>(
+    "invalid service");
+  EXPECT_FALSE(invalid);
+  EXPECT_FALSE(invalid.Request(req, timeout, rep, result));
+
+  auto client = node.CreateServiceClient<msgs::Int32, msgs::Int32>(g_topic);
+  ASSERT_TRUE(client);
+  EXPECT_EQ("@" + g_FQNPartition + "@" + g_topic, client.Service());
+
+  EXPECT_TRUE(node.Advertise(g_topic, srvEcho));
+
+  // Repeated synchronous calls.
+  for (int i = 0; i < 3; ++i)
+  {
+    srvExecuted = false;
+    rep.Clear();
+    EXPECT_TRUE(client.Request(req, timeout, rep, result));
+    EXPECT_TRUE(result);
+    EXPECT_TRUE(srvExecuted);
+    EXPECT_EQ(req.data(), rep.data());
+  }
+
+  // Asynchronous call.
+  std::function<void(const msgs::Int32 &, const bool)> f = response;
+  EXPECT_TRUE(client.Request(req, f));
+  EXPECT_TRUE(responseExecuted);
+
+  // Asynchronous call with a generic response, which is created with the
+  // response type of the client.
+  bool genericExecuted = false;
+  std::function<void(const google::protobuf::Message &, const bool)> g =
+    [&](const google::protobuf::Message &_rep, const bool _result)
+    {
+      EXPECT_TRUE(_result);
+      EXPECT_EQ(rep.GetTypeName(), _rep.GetTypeName());
+      EXPECT_EQ(req.SerializeAsString(), _rep.SerializeAsString());
+      genericExecuted = true;
+    };
+  EXPECT_TRUE(client.Request(req, g));
+  EXPECT_TRUE(genericExecuted);
+
+  // The types of the request must match the types of the client.
+  msgs::Vector3d wrongRep;
+  EXPECT_FALSE(client.Request(req, timeout, wrongRep, result));
+
+  // A copy of the client picks the new responder once the service is
+  // advertised again.
+  auto copy = client;
+  EXPECT_TRUE(node.UnadvertiseSrv(g_topic));
+  std::function<bool(const msgs::Int32 &, msgs::Int32 &)> doubler =
+    [](const msgs::Int32 &_req, msgs::Int32 &_rep)
+    {
+      _rep.set_data(_req.data() * 2);
+      return true;
+    };
+  EXPECT_TRUE(node.Advertise(g_topic, doubler));
+  EXPECT_TRUE(copy.Request(req, timeout, rep, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(req.data() * 2, rep.data());
+
+  // Each thread chooses the responder of the client on its own.
+  std::thread other([&]()
+  {
+    msgs::Int32 otherRep;
+    bool otherResult = false;
+    EXPECT_TRUE(client.Request(req, timeout, otherRep, otherResult));
+    EXPECT_TRUE(otherResult);
+    EXPECT_EQ(req.data() * 2, otherRep.data());
+  });
+  other.join();
+
+  // Oneway requests.
+  EXPECT_TRUE(node.UnadvertiseSrv(g_topic));
+  EXPECT_TRUE(node.Advertise(g_topic, srvWithoutOutput));
+  auto oneway = node.CreateServiceClient<msgs::Int32, msgs::Empty>(g_topic);
+  counter = 0;
+  EXPECT_TRUE(oneway.Request(req));
+  EXPECT_EQ(1, counter);
+
+  reset();
+}
+
+//////////////////////////////////////////////////
+/// \brief Invalidate the responses of a cacheable service.
+TEST(NodeTest, InvalidateServiceCache)
+{
+  transport::Node node;
+
+  // Not advertised.
+  EXPECT_FALSE(node.InvalidateServiceCache(g_topic));
+
+  // Not cacheable.
+  EXPECT_TRUE(node.Advertise(g_topic, srvEcho));
+  EXPECT_FALSE(node.InvalidateServiceCache(g_topic));
+  EXPECT_TRUE(node.UnadvertiseSrv(g_topic));
+
+  transport::AdvertiseServiceOptions opts;
+  opts.SetCacheable(true);
+  EXPECT_TRUE(node.Advertise(g_topic, srvEcho, opts));
+  EXPECT_TRUE(node.InvalidateServiceCache(g_topic));
+  EXPECT_TRUE(node.InvalidateServiceCache(g_topic));
+
+  EXPECT_FALSE(node.InvalidateServiceCache("invalid service"));
+}
+
 //////////////////////////////////////////////////
 /// \brief Make a synchronous service call without input.
 TEST(NodeTest, ServiceCallWithoutInputSync)
@@ -2283,6 +2648,452 @@ TEST(NodePubTest, DestructionOrder)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief A subscription handler written for the original interface, which
+/// throttles itself in RunLocalCallback().
+class ThrottledLegacyHandler : public transport::ISubscriptionHandler
+{
+  /// \brief Constructor.
+  /// \param[in] _nUuid UUID of the node.
+  /// \param[in] _opts Subscription options.
+  public: ThrottledLegacyHandler(const std::string &_nUuid,
+    const transport::SubscribeOptions &_opts)
+    : transport::ISubscriptionHandler(_nUuid, _opts)
+  {
+  }
+
+  // Documentation inherited.
+  public: bool RunLocalCallback(const transport::ProtoMsg &,
+    const transport::MessageInfo &) override
+  {
+    if (this->UpdateThrottling())
+      ++this->counter;
+    return true;
+  }
+
+  // Documentation inherited.
+  public: const std::shared_ptr<transport::ProtoMsg> CreateMsg(
+    const std::string &_data, const std::string &) const override
+  {
+    auto msg = std::make_shared<msgs::Int32>();
+    msg->ParseFromString(_data);
+    return msg;
+  }
+
+  // Documentation inherited.
+  public: std::string TypeName() override
+  {
+    return msgs::Int32().GetTypeName();
+  }
+
+  /// \brief Number of messages delivered.
+  public: std::atomic<int> counter{0};
+};
+
+//////////////////////////////////////////////////
+/// \brief A handler that throttles itself in RunLocalCallback() receives
+/// the messages that its own throttling lets through.
+TEST(NodeTest, LegacyThrottledHandler)
+{
+  const std::string topic = "/legacy_foo";
+  std::string fullyQualifiedTopic;
+  ASSERT_TRUE(transport::TopicUtils::FullyQualifiedName(partition, "",
+    topic, fullyQualifiedTopic));
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>(topic);
+  ASSERT_TRUE(pub);
+
+  transport::SubscribeOptions opts;
+  opts.SetMsgsPerSec(1u);
+  const std::string nUuid = transport::Uuid().ToString();
+  auto handler = std::make_shared<ThrottledLegacyHandler>(nUuid, opts);
+  auto shared = transport::NodeShared::Instance();
+  {
+    std::lock_guard<std::recursive_mutex> lk(shared->mutex);
+    shared->localSubscribers.normal.AddHandler(fullyQualifiedTopic, nUuid,
+      handler);
+  }
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_TRUE(pub.Publish(msg));
+
+  for (int i = 0; i < 50 && handler->counter == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(1, handler->counter);
+
+  std::lock_guard<std::recursive_mutex> lk(shared->mutex);
+  shared->localSubscribers.normal.RemoveHandlersForNode(fullyQualifiedTopic,
+    nUuid);
+}
+
+//////////////////////////////////////////////////
+/// \brief A node attached to a transport context communicates with the
+/// nodes of the process as if it was in another process, and the context is
+/// kept alive by its publishers.
+TEST(NodeTest, TransportContext)
+{
+  reset();
+
+  auto context = std::make_shared<transport::TransportContext>();
+  EXPECT_FALSE(context->ProcessUuid().empty());
+
+  transport::NodeOptions opts;
+  opts.SetContext(context);
+  EXPECT_EQ(context, opts.Context());
+
+  transport::Node::Publisher pub;
+  {
+    transport::Node contextNode(opts);
+    pub = contextNode.Advertise<msgs::Int32>(g_topic);
+    ASSERT_TRUE(pub);
+  }
+  context.reset();
+
+  transport::Node node;
+  EXPECT_TRUE(node.Subscribe(g_topic, cb));
+
+  // Wait for the publisher in the context to discover the subscriber.
+  ASSERT_TRUE(pub.WaitForSubscribers(1u, std::chrono::seconds(5)));
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+  EXPECT_TRUE(pub.Publish(msg));
+
+  std::unique_lock<std::mutex> lk(cbMutex);
+  cbCondition.wait_for(lk, std::chrono::milliseconds(500),
+    [] { return cbExecuted; });
+  EXPECT_TRUE(cbExecuted);
+
+  reset();
+}
+
+//////////////////////////////////////////////////
+/// \brief Count the entries of a directory of /proc/self, e.g. "task" for
+/// the threads of the process or "fd" for its file descriptors.
+/// \param[in] _dir Name of the directory.
+/// \return The number of entries.
+std::size_t procEntries(const std::string &_dir)
+{
+  std::size_t count = 0;
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it("/proc/self/" + _dir, ec);
+       !ec && it != std::filesystem::directory_iterator(); it.increment(ec))
+  {
+    ++count;
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+/// \brief A node doesn't create sockets or threads until it advertises or
+/// subscribes. The node uses its own transport context, so the transport
+/// already initialized by other tests doesn't matter.
+TEST(NodeTest, LazyInitialization)
+{
+  if (!std::filesystem::exists("/proc/self/task"))
+    GTEST_SKIP() << "Threads can't be counted on this platform";
+
+  auto context = std::make_shared<transport::TransportContext>();
+  transport::NodeOptions opts;
+  opts.SetContext(context);
+  transport::Node node(opts);
+
+  const std::size_t threads = procEntries("task");
+  const std::size_t fds = procEntries("fd");
+
+  // Queries about the node itself don't need the transport.
+  EXPECT_TRUE(node.SubscribedTopics().empty());
+  EXPECT_TRUE(node.AdvertisedTopics().empty());
+  EXPECT_TRUE(node.AdvertisedServices().empty());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(threads, procEntries("task"));
+  EXPECT_EQ(fds, procEntries("fd"));
+
+  // The first subscription creates the transport of topics.
+  EXPECT_TRUE(node.Subscribe(g_topic, cb));
+  EXPECT_GT(procEntries("task"), threads);
+  EXPECT_GT(procEntries("fd"), fds);
+
+  // The first service creates the transport of services.
+  const std::size_t msgFds = procEntries("fd");
+  EXPECT_TRUE(node.Advertise(g_topic, srvEcho));
+  EXPECT_GT(procEntries("fd"), msgFds);
+
+  // The same for a context whose first operation is an advertisement.
+  auto otherContext = std::make_shared<transport::TransportContext>();
+  opts.SetContext(otherContext);
+  transport::Node otherNode(opts);
+  const std::size_t otherThreads = procEntries("task");
+  const std::size_t otherFds = procEntries("fd");
+  auto pub = otherNode.Advertise<msgs::Int32>(g_topic);
+  ASSERT_TRUE(pub);
+  EXPECT_GT(procEntries("task"), otherThreads);
+  EXPECT_GT(procEntries("fd"), otherFds);
+}
+
+//////////////////////////////////////////////////
+/// \brief With GZ_TRANSPORT_INTRA_PROCESS=1 the nodes of a process exchange
+/// messages and service calls without creating any socket.
+TEST(NodeTest, IntraProcessMode)
+{
+  reset();
+
+  // The variable is read when the transport context is created.
+  setenv("GZ_TRANSPORT_INTRA_PROCESS", "1", 1);
+  auto context = std::make_shared<transport::TransportContext>();
+  unsetenv("GZ_TRANSPORT_INTRA_PROCESS");
+
+  transport::NodeOptions opts;
+  opts.SetContext(context);
+  transport::Node pubNode(opts);
+  transport::Node subNode(opts);
+
+  const std::size_t fds = procEntries("fd");
+
+  // Publish and subscribe.
+  auto pub = pubNode.Advertise<msgs::Int32>(g_topic);
+  ASSERT_TRUE(pub);
+  EXPECT_TRUE(subNode.Subscribe(g_topic, cb));
+  EXPECT_TRUE(pub.HasConnections());
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+  EXPECT_TRUE(pub.Publish(msg));
+  {
+    std::unique_lock<std::mutex> lk(cbMutex);
+    cbCondition.wait_for(lk, std::chrono::milliseconds(500),
+      [] { return cbExecuted; });
+  }
+  EXPECT_TRUE(cbExecuted);
+
+  std::vector<std::string> topics;
+  subNode.TopicList(topics);
+  EXPECT_NE(topics.end(), std::find(topics.begin(), topics.end(), g_topic));
+
+  // Blocking and asynchronous service calls.
+  EXPECT_TRUE(pubNode.Advertise(g_topic, srvEcho));
+
+  msgs::Int32 req;
+  msgs::Int32 rep;
+  bool result = false;
+  req.set_data(data);
+  EXPECT_TRUE(subNode.Request(g_topic, req, 500u, rep, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(data, rep.data());
+  EXPECT_TRUE(srvExecuted);
+
+  EXPECT_TRUE(subNode.Request(g_topic, req, response));
+  EXPECT_TRUE(responseExecuted);
+
+  // A service that doesn't exist fails after the timeout.
+  EXPECT_FALSE(subNode.Request("/unknown_service", req, 100u, rep, result));
+
+  // No socket was created.
+  if (std::filesystem::exists("/proc/self/fd"))
+  {
+    EXPECT_EQ(fds, procEntries("fd"));
+  }
+
+  reset();
+}
+
+//////////////////////////////////////////////////
+/// \brief A topic advertised with multicast reaches a subscriber that joins
+/// its group and another one that can't, through TCP. The transport
+/// contexts communicate as separate processes. Each subscriber receives
+/// every message exactly once.
+TEST(NodeTest, MulticastPubSub)
+{
+  const std::string topic = "/multicast_foo";
+  const int numMessages = 10;
+
+  auto pubContext = std::make_shared<transport::TransportContext>();
+  auto multicastContext = std::make_shared<transport::TransportContext>();
+
+  // A different multicast port prevents joining the group of the publisher.
+  setenv("GZ_TRANSPORT_MULTICAST_PORT",
+    std::to_string(transport::MulticastTransport::kDefaultPort + 1).c_str(), 1);
+  auto tcpContext = std::make_shared<transport::TransportContext>();
+  unsetenv("GZ_TRANSPORT_MULTICAST_PORT");
+
+  transport::NodeOptions opts;
+  opts.SetContext(pubContext);
+  transport::Node pubNode(opts);
+  opts.SetContext(multicastContext);
+  transport::Node multicastNode(opts);
+  opts.SetContext(tcpContext);
+  transport::Node tcpNode(opts);
+
+  transport::AdvertiseMessageOptions advOpts;
+  advOpts.SetMulticast(true);
+  auto pub = pubNode.Advertise<msgs::Int32>(topic, advOpts);
+  ASSERT_TRUE(pub);
+
+  std::atomic<int> multicastCount(0);
+  std::atomic<int> tcpCount(0);
+  std::function<void(const msgs::Int32 &)> multicastCb =
+    [&multicastCount](const msgs::Int32 &_msg)
+    {
+      EXPECT_EQ(data, _msg.data());
+      ++multicastCount;
+    };
+  std::function<void(const msgs::Int32 &)> tcpCb =
+    [&tcpCount](const msgs::Int32 &_msg)
+    {
+      EXPECT_EQ(data, _msg.data());
+      ++tcpCount;
+    };
+  ASSERT_TRUE(multicastNode.Subscribe(topic, multicastCb));
+  ASSERT_TRUE(tcpNode.Subscribe(topic, tcpCb));
+
+  // The group of the topic is announced in the discovery information.
+  std::vector<transport::MessagePublisher> publishers;
+  for (int i = 0; i < 50 && publishers.empty(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    multicastNode.TopicInfo(topic, publishers);
+  }
+  ASSERT_EQ(1u, publishers.size());
+  EXPECT_FALSE(publishers.front().MulticastAddr().empty());
+
+  // Wait for the registration of both subscribers.
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  ASSERT_TRUE(pub.HasConnections());
+
+  msgs::Int32 msg;
+  msg.set_data(data);
+  for (int i = 0; i < numMessages; ++i)
+  {
+    EXPECT_TRUE(pub.Publish(msg));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  for (int i = 0; i < 100 &&
+       (multicastCount < numMessages || tcpCount < numMessages); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // Give duplicates time to arrive.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(numMessages, multicastCount);
+  EXPECT_EQ(numMessages, tcpCount);
+}
+
+//////////////////////////////////////////////////
+/// \brief A topic advertised with delta encoding delivers the same bytes
+/// that were published, through keyframes and differences, also to a
+/// subscriber that joins in the middle of the stream. The transport
+/// contexts communicate as separate processes.
+TEST(NodeTest, DeltaEncodedPubSub)
+{
+  const std::string topic = "/delta_foo";
+  const int numMessages = 12;
+
+  auto pubContext = std::make_shared<transport::TransportContext>();
+  auto subContext = std::make_shared<transport::TransportContext>();
+  auto lateContext = std::make_shared<transport::TransportContext>();
+
+  transport::NodeOptions opts;
+  opts.SetContext(pubContext);
+  transport::Node pubNode(opts);
+  transport::Node otherPubNode(opts);
+  opts.SetContext(subContext);
+  transport::Node subNode(opts);
+  opts.SetContext(lateContext);
+  transport::Node lateNode(opts);
+
+  transport::AdvertiseMessageOptions advOpts;
+  advOpts.SetDeltaKeyframeInterval(4u);
+  auto pub = pubNode.Advertise<msgs::StringMsg>(topic, advOpts);
+  ASSERT_TRUE(pub);
+
+  // The publishers of a topic in a process share the keyframe interval.
+  transport::AdvertiseMessageOptions otherOpts;
+  otherOpts.SetDeltaKeyframeInterval(8u);
+  EXPECT_FALSE(otherPubNode.Advertise<msgs::StringMsg>(topic, otherOpts));
+
+  std::mutex mutex;
+  std::vector<std::string> received;
+  std::vector<std::string> lateReceived;
+  transport::RawCallback subCb =
+    [&](const char *_data, const size_t _size,
+        const transport::MessageInfo &)
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      received.emplace_back(_data, _size);
+    };
+  transport::RawCallback lateCb =
+    [&](const char *_data, const size_t _size,
+        const transport::MessageInfo &)
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      lateReceived.emplace_back(_data, _size);
+    };
+  ASSERT_TRUE(subNode.SubscribeRaw(topic, subCb));
+
+  // Wait for the registration of the subscriber.
+  for (int i = 0; i < 50 && !pub.HasConnections(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(pub.HasConnections());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Messages that change a little, so most of them are sent as differences.
+  std::vector<std::string> sent;
+  msgs::StringMsg msg;
+  std::string content(2000, 'a');
+  auto publish = [&](const int _index)
+  {
+    content[static_cast<std::size_t>(_index) * 37 % content.size()] = 'b';
+    msg.set_data(content);
+    sent.emplace_back();
+    ASSERT_TRUE(msg.SerializeToString(&sent.back()));
+    EXPECT_TRUE(pub.Publish(msg));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  };
+
+  for (int i = 0; i < numMessages / 2; ++i)
+    publish(i);
+
+  // A subscriber joins in the middle of the stream.
+  ASSERT_TRUE(lateNode.SubscribeRaw(topic, lateCb));
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+  for (int i = numMessages / 2; i < numMessages; ++i)
+    publish(i);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lk(mutex);
+      if (received.size() >= sent.size() && !lateReceived.empty() &&
+          lateReceived.back() == sent.back())
+      {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::lock_guard<std::mutex> lk(mutex);
+  EXPECT_EQ(sent, received);
+
+  // The late subscriber receives the end of the stream.
+  ASSERT_FALSE(lateReceived.empty());
+  ASSERT_LE(lateReceived.size(), sent.size());
+  EXPECT_TRUE(std::equal(lateReceived.begin(), lateReceived.end(),
+    sent.end() - static_cast<std::ptrdiff_t>(lateReceived.size())));
+
+  // Once the last publisher of the topic is gone, it can be advertised with
+  // another interval.
+  pub = transport::Node::Publisher();
+  EXPECT_TRUE(otherPubNode.Advertise<msgs::StringMsg>(topic, otherOpts));
+}
+
 //////////////////////////////////////////////////
 /// \brief Create a separate thread, block it calling waitForShutdown() and
 /// emit a SIGINT signal. Check that the transport library captures the signal
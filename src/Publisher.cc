@@ -17,7 +17,10 @@
 
 #include <cstdint>
 #include <cstring>
+#include <exception>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
 #include <string>
 
 #include "gz/transport/AdvertiseOptions.hh"
@@ -29,6 +32,24 @@
 using namespace gz;
 using namespace transport;
 
+/// \brief Key of the header entry that carries the cache options of a
+/// service in a discovery message. Its values are the TTL and the version.
+/// Peers that don't know it ignore it.
+static const char kSrvCacheKey[] = "gz_transport_srv_cache";
+
+/// \brief Key of the header entry that announces that a service accepts
+/// batched requests. It has no values.
+static const char kSrvBatchKey[] = "gz_transport_srv_batch";
+
+/// \brief Key of the header entry that carries the multicast endpoint of a
+/// topic. Its value is the endpoint, e.g. "239.255.12.34:10319".
+static const char kMsgMulticastKey[] = "gz_transport_msg_multicast";
+
+/// \brief Key of the header entry that announces the delta encoding of a
+/// topic. Its value is the keyframe interval. Subscribers echo it in their
+/// registration when they can decode deltas.
+static const char kMsgDeltaKey[] = "gz_transport_msg_delta";
+
 //////////////////////////////////////////////////
 Publisher::Publisher(const std::string &_topic, const std::string &_addr,
   const std::string &_pUuid, const std::string &_nUuid,
@@ -37,7 +58,9 @@ Publisher::Publisher(const std::string &_topic, const std::string &_addr,
     addr(_addr),
     pUuid(_pUuid),
     nUuid(_nUuid),
-    opts(_opts)
+    opts(_opts),
+    pUuidKey(Uuid::FromIdentifier(_pUuid)),
+    nUuidKey(Uuid::FromIdentifier(_nUuid))
 {
 }
 
@@ -65,6 +88,18 @@ std::string Publisher::NUuid() const
   return this->nUuid;
 }
 
+//////////////////////////////////////////////////
+const Uuid &Publisher::ProcessKey() const
+{
+  return this->pUuidKey;
+}
+
+//////////////////////////////////////////////////
+const Uuid &Publisher::NodeKey() const
+{
+  return this->nUuidKey;
+}
+
 //////////////////////////////////////////////////
 const AdvertiseOptions& Publisher::Options() const
 {
@@ -87,12 +122,14 @@ void Publisher::SetAddr(const std::string &_addr)
 void Publisher::SetPUuid(const std::string &_pUuid)
 {
   this->pUuid = _pUuid;
+  this->pUuidKey = Uuid::FromIdentifier(_pUuid);
 }
 
 //////////////////////////////////////////////////
 void Publisher::SetNUuid(const std::string &_nUuid)
 {
   this->nUuid = _nUuid;
+  this->nUuidKey = Uuid::FromIdentifier(_nUuid);
 }
 
 //////////////////////////////////////////////////
@@ -130,8 +167,8 @@ void Publisher::SetFromDiscovery(const msgs::Discovery &_msg)
 {
   this->topic = _msg.pub().topic();
   this->addr = _msg.pub().address();
-  this->pUuid = _msg.pub().process_uuid();
-  this->nUuid = _msg.pub().node_uuid();
+  this->SetPUuid(_msg.pub().process_uuid());
+  this->SetNUuid(_msg.pub().node_uuid());
 
   switch (_msg.pub().scope())
   {
@@ -210,6 +247,18 @@ void MessagePublisher::SetOptions(const AdvertiseMessageOptions &_opts)
   this->msgOpts = _opts;
 }
 
+//////////////////////////////////////////////////
+const std::string &MessagePublisher::MulticastAddr() const
+{
+  return this->multicastAddr;
+}
+
+//////////////////////////////////////////////////
+void MessagePublisher::SetMulticastAddr(const std::string &_addr)
+{
+  this->multicastAddr = _addr;
+}
+
 //////////////////////////////////////////////////
 void MessagePublisher::FillDiscovery(msgs::Discovery &_msg) const
 {
@@ -221,6 +270,22 @@ void MessagePublisher::FillDiscovery(msgs::Discovery &_msg) const
   pub->mutable_msg_pub()->set_msg_type(this->MsgTypeName());
   pub->mutable_msg_pub()->set_throttled(this->msgOpts.Throttled());
   pub->mutable_msg_pub()->set_msgs_per_sec(this->msgOpts.MsgsPerSec());
+
+  // Multicast endpoint.
+  if (!this->multicastAddr.empty())
+  {
+    auto data = _msg.mutable_header()->add_data();
+    data->set_key(kMsgMulticastKey);
+    data->add_value(this->multicastAddr);
+  }
+
+  // Delta encoding.
+  if (this->msgOpts.DeltaKeyframeInterval() > 0)
+  {
+    auto data = _msg.mutable_header()->add_data();
+    data->set_key(kMsgDeltaKey);
+    data->add_value(std::to_string(this->msgOpts.DeltaKeyframeInterval()));
+  }
 }
 
 //////////////////////////////////////////////////
@@ -234,6 +299,34 @@ void MessagePublisher::SetFromDiscovery(const msgs::Discovery &_msg)
     this->msgOpts.SetMsgsPerSec(kUnthrottled);
   else
     this->msgOpts.SetMsgsPerSec(_msg.pub().msg_pub().msgs_per_sec());
+
+  // Multicast endpoint and delta encoding.
+  this->multicastAddr.clear();
+  this->msgOpts.SetDeltaKeyframeInterval(0);
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == kMsgMulticastKey && data.value_size() == 1)
+      this->multicastAddr = data.value(0);
+
+    if (data.key() != kMsgDeltaKey || data.value_size() != 1)
+      continue;
+
+    try
+    {
+      const uint64_t interval = std::stoull(data.value(0));
+      if (interval > std::numeric_limits<uint32_t>::max())
+        throw std::out_of_range("Keyframe interval out of range");
+      this->msgOpts.SetDeltaKeyframeInterval(
+        static_cast<uint32_t>(interval));
+    }
+    catch(const std::exception &/*_e*/)
+    {
+      std::cerr << "MessagePublisher::SetFromDiscovery(): Invalid delta "
+                << "encoding options for topic [" << this->Topic() << "]"
+                << std::endl;
+    }
+  }
+  this->msgOpts.SetMulticast(!this->multicastAddr.empty());
 }
 
 //////////////////////////////////////////////////
@@ -241,7 +334,8 @@ bool MessagePublisher::operator==(const MessagePublisher &_pub) const
 {
   return Publisher::operator==(_pub)      &&
     this->ctrl == _pub.ctrl               &&
-    this->msgTypeName == _pub.msgTypeName;
+    this->msgTypeName == _pub.msgTypeName &&
+    this->multicastAddr == _pub.multicastAddr;
 }
 
 //////////////////////////////////////////////////
@@ -313,6 +407,18 @@ void ServicePublisher::SetOptions(const AdvertiseServiceOptions &_opts)
   this->srvOpts = _opts;
 }
 
+//////////////////////////////////////////////////
+bool ServicePublisher::AcceptsBatches() const
+{
+  return this->acceptsBatches;
+}
+
+//////////////////////////////////////////////////
+void ServicePublisher::SetAcceptsBatches(const bool _accepts)
+{
+  this->acceptsBatches = _accepts;
+}
+
 //////////////////////////////////////////////////
 void ServicePublisher::FillDiscovery(msgs::Discovery &_msg) const
 {
@@ -323,6 +429,18 @@ void ServicePublisher::FillDiscovery(msgs::Discovery &_msg) const
   pub->mutable_srv_pub()->set_socket_id(this->SocketId());
   pub->mutable_srv_pub()->set_request_type(this->ReqTypeName());
   pub->mutable_srv_pub()->set_response_type(this->RepTypeName());
+
+  // Cache options.
+  if (this->srvOpts.Cacheable())
+  {
+    auto data = _msg.mutable_header()->add_data();
+    data->set_key(kSrvCacheKey);
+    data->add_value(std::to_string(this->srvOpts.CacheTtl()));
+    data->add_value(std::to_string(this->srvOpts.CacheVersion()));
+  }
+
+  if (this->acceptsBatches)
+    _msg.mutable_header()->add_data()->set_key(kSrvBatchKey);
 }
 
 //////////////////////////////////////////////////
@@ -333,6 +451,33 @@ void ServicePublisher::SetFromDiscovery(const msgs::Discovery &_msg)
   this->socketId = _msg.pub().srv_pub().socket_id();
   this->reqTypeName = _msg.pub().srv_pub().request_type();
   this->repTypeName = _msg.pub().srv_pub().response_type();
+
+  // Cache options.
+  this->srvOpts.SetCacheable(false);
+  this->srvOpts.SetCacheTtl(0);
+  this->srvOpts.SetCacheVersion(0);
+  this->acceptsBatches = false;
+  for (const auto &data : _msg.header().data())
+  {
+    if (data.key() == kSrvBatchKey)
+      this->acceptsBatches = true;
+
+    if (data.key() != kSrvCacheKey || data.value_size() != 2)
+      continue;
+
+    try
+    {
+      this->srvOpts.SetCacheTtl(std::stoull(data.value(0)));
+      this->srvOpts.SetCacheVersion(std::stoull(data.value(1)));
+      this->srvOpts.SetCacheable(true);
+    }
+    catch(const std::exception &/*_e*/)
+    {
+      std::cerr << "ServicePublisher::SetFromDiscovery(): Invalid cache "
+                << "options for service [" << this->Topic() << "]"
+                << std::endl;
+    }
+  }
 }
 
 //////////////////////////////////////////////////
@@ -341,7 +486,9 @@ bool ServicePublisher::operator==(const ServicePublisher &_srv) const
   return Publisher::operator==(_srv)      &&
     this->socketId == _srv.socketId       &&
     this->reqTypeName == _srv.reqTypeName &&
-    this->repTypeName == _srv.repTypeName;
+    this->repTypeName == _srv.repTypeName &&
+    this->srvOpts == _srv.srvOpts         &&
+    this->acceptsBatches == _srv.acceptsBatches;
 }
 
 //////////////////////////////////////////////////
@@ -106,6 +106,37 @@ TEST(PublisherTest, Publisher)
   EXPECT_EQ(publisher.Options(), g_opts2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that the parsed UUIDs follow the string UUIDs.
+TEST(PublisherTest, PublisherKeys)
+{
+  init();
+
+  const std::string pUuid = Uuid().ToString();
+  const std::string nUuid = Uuid().ToString();
+
+  Publisher publisher(g_topic, g_addr, pUuid, nUuid, g_opts1);
+  EXPECT_EQ(pUuid, publisher.ProcessKey().ToString());
+  EXPECT_EQ(nUuid, publisher.NodeKey().ToString());
+
+  // Identifiers that aren't UUIDs get a stable key.
+  publisher.SetPUuid(g_newPUuid);
+  publisher.SetNUuid(g_newNUuid);
+  EXPECT_EQ(Uuid::FromIdentifier(g_newPUuid), publisher.ProcessKey());
+  EXPECT_EQ(Uuid::FromIdentifier(g_newNUuid), publisher.NodeKey());
+
+  // The keys are copied and received with the publisher.
+  Publisher copy(publisher);
+  EXPECT_EQ(publisher.ProcessKey(), copy.ProcessKey());
+  EXPECT_EQ(publisher.NodeKey(), copy.NodeKey());
+
+  msgs::Discovery msg;
+  Publisher(g_topic, g_addr, pUuid, nUuid, g_opts1).FillDiscovery(msg);
+  publisher.SetFromDiscovery(msg);
+  EXPECT_EQ(pUuid, publisher.ProcessKey().ToString());
+  EXPECT_EQ(nUuid, publisher.NodeKey().ToString());
+}
+
 //////////////////////////////////////////////////
 /// \brief Check the Publisher Pack()/Unpack().
 TEST(PublisherTest, PublisherIO)
@@ -223,6 +254,69 @@ TEST(PublisherTest, MessagePublisherIO)
   EXPECT_EQ(publisher.Options(),     otherPublisher.Options());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that the multicast endpoint is announced.
+TEST(PublisherTest, MessagePublisherMulticastIO)
+{
+  init();
+
+  MessagePublisher publisher(g_topic, g_addr, g_ctrl, g_puuid, g_nuuid,
+    g_msgTypeName, g_msgOpts1);
+  publisher.SetMulticastAddr("239.255.1.2:10319");
+
+  msgs::Discovery msg;
+  publisher.FillDiscovery(msg);
+
+  MessagePublisher otherPublisher;
+  otherPublisher.SetFromDiscovery(msg);
+  EXPECT_EQ("239.255.1.2:10319", otherPublisher.MulticastAddr());
+  EXPECT_TRUE(otherPublisher.Options().Multicast());
+  EXPECT_EQ(publisher, otherPublisher);
+
+  // A publisher without multicast.
+  publisher.SetMulticastAddr("");
+  EXPECT_NE(publisher, otherPublisher);
+  msgs::Discovery tcpMsg;
+  publisher.FillDiscovery(tcpMsg);
+  EXPECT_EQ(0, tcpMsg.header().data_size());
+  otherPublisher.SetFromDiscovery(tcpMsg);
+  EXPECT_TRUE(otherPublisher.MulticastAddr().empty());
+  EXPECT_FALSE(otherPublisher.Options().Multicast());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the delta encoding options are sent in the discovery
+/// messages.
+TEST(PublisherTest, MessagePublisherDeltaIO)
+{
+  init();
+
+  AdvertiseMessageOptions opts;
+  opts.SetDeltaKeyframeInterval(25u);
+  MessagePublisher publisher(g_topic, g_addr, g_ctrl, g_puuid, g_nuuid,
+    g_msgTypeName, opts);
+
+  msgs::Discovery msg;
+  publisher.FillDiscovery(msg);
+
+  MessagePublisher otherPublisher;
+  otherPublisher.SetFromDiscovery(msg);
+  EXPECT_EQ(25u, otherPublisher.Options().DeltaKeyframeInterval());
+
+  // Peers that don't announce it don't use deltas.
+  msgs::Discovery plainMsg;
+  MessagePublisher(g_topic, g_addr, g_ctrl, g_puuid, g_nuuid,
+    g_msgTypeName, g_msgOpts1).FillDiscovery(plainMsg);
+  EXPECT_EQ(0, plainMsg.header().data_size());
+  otherPublisher.SetFromDiscovery(plainMsg);
+  EXPECT_EQ(0u, otherPublisher.Options().DeltaKeyframeInterval());
+
+  // Malformed values are ignored.
+  msg.mutable_header()->mutable_data(0)->set_value(0, "x");
+  otherPublisher.SetFromDiscovery(msg);
+  EXPECT_EQ(0u, otherPublisher.Options().DeltaKeyframeInterval());
+}
+
 //////////////////////////////////////////////////
 /// \brief Check the << operator
 TEST(PublisherTest, MessagePublisherStreamInsertion)
@@ -329,6 +423,74 @@ TEST(PublisherTest, ServicePublisherIO)
   EXPECT_EQ(publisher.Options(), otherPublisher.Options());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that the cache options of a ServicePublisher are packed.
+TEST(PublisherTest, ServicePublisherCacheIO)
+{
+  init();
+
+  AdvertiseServiceOptions opts;
+  opts.SetCacheable(true);
+  opts.SetCacheTtl(250u);
+  opts.SetCacheVersion(7u);
+
+  ServicePublisher publisher(g_topic, g_addr, g_socketId, g_puuid, g_nuuid,
+    g_reqTypeName, g_repTypeName, opts);
+
+  msgs::Discovery msg;
+  publisher.FillDiscovery(msg);
+
+  ServicePublisher otherPublisher;
+  otherPublisher.SetFromDiscovery(msg);
+  EXPECT_TRUE(otherPublisher.Options().Cacheable());
+  EXPECT_EQ(250u, otherPublisher.Options().CacheTtl());
+  EXPECT_EQ(7u, otherPublisher.Options().CacheVersion());
+  EXPECT_EQ(publisher, otherPublisher);
+
+  // A different version makes the publishers different.
+  opts.SetCacheVersion(8u);
+  otherPublisher.SetOptions(opts);
+  EXPECT_NE(publisher, otherPublisher);
+
+  // A non cacheable service doesn't carry cache options.
+  ServicePublisher plain(g_topic, g_addr, g_socketId, g_puuid, g_nuuid,
+    g_reqTypeName, g_repTypeName, g_srvOpts1);
+  msgs::Discovery plainMsg;
+  plain.FillDiscovery(plainMsg);
+  for (const auto &data : plainMsg.header().data())
+    EXPECT_NE("gz_transport_srv_cache", data.key());
+  otherPublisher.SetFromDiscovery(plainMsg);
+  EXPECT_FALSE(otherPublisher.Options().Cacheable());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the support for batched requests is announced.
+TEST(PublisherTest, ServicePublisherBatchesIO)
+{
+  init();
+
+  ServicePublisher publisher(g_topic, g_addr, g_socketId, g_puuid, g_nuuid,
+    g_reqTypeName, g_repTypeName, g_srvOpts1);
+  EXPECT_TRUE(publisher.AcceptsBatches());
+
+  msgs::Discovery msg;
+  publisher.FillDiscovery(msg);
+
+  ServicePublisher otherPublisher;
+  otherPublisher.SetFromDiscovery(msg);
+  EXPECT_TRUE(otherPublisher.AcceptsBatches());
+  EXPECT_EQ(publisher, otherPublisher);
+
+  // A peer that doesn't announce it.
+  publisher.SetAcceptsBatches(false);
+  EXPECT_NE(publisher, otherPublisher);
+  msgs::Discovery oldMsg;
+  publisher.FillDiscovery(oldMsg);
+  EXPECT_EQ(0, oldMsg.header().data_size());
+  otherPublisher.SetFromDiscovery(oldMsg);
+  EXPECT_FALSE(otherPublisher.AcceptsBatches());
+}
+
 //////////////////////////////////////////////////
 /// \brief Check the << operator
 TEST(PublisherTest, ServicePublisherStreamInsertion)
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ServiceBatch.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Append a string preceded by its size (32 bit, little endian).
+  /// \param[in] _str String to append.
+  /// \param[out] _buffer Buffer.
+  void appendString(const std::string &_str, std::string &_buffer)
+  {
+    const uint32_t size = static_cast<uint32_t>(_str.size());
+    for (int i = 0; i < 4; ++i)
+      _buffer.push_back(static_cast<char>((size >> (8 * i)) & 0xFF));
+    _buffer.append(_str);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read a string written by appendString().
+  /// \param[in] _data Encoded data.
+  /// \param[in] _size Size of the encoded data.
+  /// \param[in, out] _pos Position of the string, updated to the position
+  /// after the string.
+  /// \param[out] _str String read.
+  /// \return False if there is not enough data.
+  bool readString(const char *_data, const std::size_t _size,
+                  std::size_t &_pos, std::string &_str)
+  {
+    if (_size - _pos < 4u)
+      return false;
+
+    uint32_t size = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+      size |= static_cast<uint32_t>(
+        static_cast<unsigned char>(_data[_pos + i])) << (8 * i);
+    }
+    _pos += 4u;
+
+    if (_size - _pos < size)
+      return false;
+
+    _str.assign(_data + _pos, size);
+    _pos += size;
+    return true;
+  }
+}
+
+//////////////////////////////////////////////////
+void ServiceBatch::Encode(const std::vector<Request> &_requests,
+  std::string &_buffer)
+{
+  std::size_t size = 0;
+  for (const auto &req : _requests)
+    size += 12u + req.nodeUuid.size() + req.reqUuid.size() + req.data.size();
+
+  _buffer.clear();
+  _buffer.reserve(size);
+  for (const auto &req : _requests)
+  {
+    appendString(req.nodeUuid, _buffer);
+    appendString(req.reqUuid, _buffer);
+    appendString(req.data, _buffer);
+  }
+}
+
+//////////////////////////////////////////////////
+void ServiceBatch::Encode(const std::vector<Response> &_responses,
+  std::string &_buffer)
+{
+  std::size_t size = 0;
+  for (const auto &rep : _responses)
+    size += 13u + rep.nodeUuid.size() + rep.reqUuid.size() + rep.rep.size();
+
+  _buffer.clear();
+  _buffer.reserve(size);
+  for (const auto &rep : _responses)
+  {
+    appendString(rep.nodeUuid, _buffer);
+    appendString(rep.reqUuid, _buffer);
+    appendString(rep.rep, _buffer);
+    _buffer.push_back(rep.result ? '1' : '0');
+  }
+}
+
+//////////////////////////////////////////////////
+bool ServiceBatch::Decode(const char *_data, const std::size_t _size,
+  std::vector<Request> &_requests)
+{
+  _requests.clear();
+  std::size_t pos = 0;
+  while (pos < _size)
+  {
+    Request req;
+    if (!readString(_data, _size, pos, req.nodeUuid) ||
+        !readString(_data, _size, pos, req.reqUuid) ||
+        !readString(_data, _size, pos, req.data))
+    {
+      return false;
+    }
+    _requests.push_back(std::move(req));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ServiceBatch::Decode(const char *_data, const std::size_t _size,
+  std::vector<Response> &_responses)
+{
+  _responses.clear();
+  std::size_t pos = 0;
+  while (pos < _size)
+  {
+    Response rep;
+    if (!readString(_data, _size, pos, rep.nodeUuid) ||
+        !readString(_data, _size, pos, rep.reqUuid) ||
+        !readString(_data, _size, pos, rep.rep) ||
+        pos >= _size)
+    {
+      return false;
+    }
+    rep.result = _data[pos++] == '1';
+    _responses.push_back(std::move(rep));
+  }
+  return true;
+}
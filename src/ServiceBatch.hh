@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_SERVICEBATCH_HH_
+#define GZ_TRANSPORT_SERVICEBATCH_HH_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class ServiceBatch ServiceBatch.hh
+    /// \brief Encoding of several service requests or responses in a single
+    /// frame. A batched request is sent as
+    /// [topic, sender, receiver id, marker, request type, response type,
+    /// requests] and a batched response as [topic, marker, responses], where
+    /// marker is ServiceBatch::kMarker. The marker takes the place of the
+    /// node UUID of the regular messages, so both can be told apart.
+    /// Batches are only sent to peers that announce support for them.
+    class GZ_TRANSPORT_VISIBLE ServiceBatch
+    {
+      /// \brief Frame that identifies a batched message.
+      public: static constexpr const char *kMarker = "gz_transport_batch";
+
+      /// \brief A service request of a batch.
+      public: struct Request
+      {
+        /// \brief UUID of the node that made the request.
+        std::string nodeUuid;
+
+        /// \brief UUID of the request.
+        std::string reqUuid;
+
+        /// \brief Serialized request.
+        std::string data;
+      };
+
+      /// \brief A service response of a batch.
+      public: struct Response
+      {
+        /// \brief UUID of the node that made the request.
+        std::string nodeUuid;
+
+        /// \brief UUID of the request.
+        std::string reqUuid;
+
+        /// \brief Serialized response.
+        std::string rep;
+
+        /// \brief Result of the service call.
+        bool result = false;
+      };
+
+      /// \brief Encode requests.
+      /// \param[in] _requests Requests to encode.
+      /// \param[out] _buffer Encoded requests.
+      public: static void Encode(const std::vector<Request> &_requests,
+                                 std::string &_buffer);
+
+      /// \brief Encode responses.
+      /// \param[in] _responses Responses to encode.
+      /// \param[out] _buffer Encoded responses.
+      public: static void Encode(const std::vector<Response> &_responses,
+                                 std::string &_buffer);
+
+      /// \brief Decode requests.
+      /// \param[in] _data Pointer to the encoded requests.
+      /// \param[in] _size Size of the encoded requests.
+      /// \param[out] _requests Decoded requests.
+      /// \return False if the data is malformed.
+      public: static bool Decode(const char *_data, const std::size_t _size,
+                                 std::vector<Request> &_requests);
+
+      /// \brief Decode responses.
+      /// \param[in] _data Pointer to the encoded responses.
+      /// \param[in] _size Size of the encoded responses.
+      /// \param[out] _responses Decoded responses.
+      /// \return False if the data is malformed.
+      public: static bool Decode(const char *_data, const std::size_t _size,
+                                 std::vector<Response> &_responses);
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_SERVICEBATCH_HH_
+#endif
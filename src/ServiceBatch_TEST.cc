@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+#include <vector>
+
+#include "ServiceBatch.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+//////////////////////////////////////////////////
+/// \brief Encode and decode requests.
+TEST(ServiceBatchTest, Requests)
+{
+  std::vector<ServiceBatch::Request> requests(3);
+  requests[0] = {"node1", "req1", "data1"};
+  requests[1] = {"node1", "req2", ""};
+  requests[2] = {"node2", "req3", std::string("a\0b", 3)};
+
+  std::string buffer;
+  ServiceBatch::Encode(requests, buffer);
+
+  std::vector<ServiceBatch::Request> decoded;
+  ASSERT_TRUE(ServiceBatch::Decode(buffer.data(), buffer.size(), decoded));
+  ASSERT_EQ(requests.size(), decoded.size());
+  for (std::size_t i = 0; i < requests.size(); ++i)
+  {
+    EXPECT_EQ(requests[i].nodeUuid, decoded[i].nodeUuid);
+    EXPECT_EQ(requests[i].reqUuid, decoded[i].reqUuid);
+    EXPECT_EQ(requests[i].data, decoded[i].data);
+  }
+
+  // Empty batch.
+  ServiceBatch::Encode(std::vector<ServiceBatch::Request>(), buffer);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_TRUE(ServiceBatch::Decode(buffer.data(), buffer.size(), decoded));
+  EXPECT_TRUE(decoded.empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Encode and decode responses.
+TEST(ServiceBatchTest, Responses)
+{
+  std::vector<ServiceBatch::Response> responses(2);
+  responses[0] = {"node1", "req1", "rep1", true};
+  responses[1] = {"node2", "req2", "", false};
+
+  std::string buffer;
+  ServiceBatch::Encode(responses, buffer);
+
+  std::vector<ServiceBatch::Response> decoded;
+  ASSERT_TRUE(ServiceBatch::Decode(buffer.data(), buffer.size(), decoded));
+  ASSERT_EQ(responses.size(), decoded.size());
+  for (std::size_t i = 0; i < responses.size(); ++i)
+  {
+    EXPECT_EQ(responses[i].nodeUuid, decoded[i].nodeUuid);
+    EXPECT_EQ(responses[i].reqUuid, decoded[i].reqUuid);
+    EXPECT_EQ(responses[i].rep, decoded[i].rep);
+    EXPECT_EQ(responses[i].result, decoded[i].result);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Malformed data is rejected.
+TEST(ServiceBatchTest, Malformed)
+{
+  std::vector<ServiceBatch::Request> requests(1);
+  requests[0] = {"node1", "req1", "data1"};
+  std::string buffer;
+  ServiceBatch::Encode(requests, buffer);
+
+  std::vector<ServiceBatch::Request> decoded;
+  for (std::size_t size = 1; size < buffer.size(); ++size)
+    EXPECT_FALSE(ServiceBatch::Decode(buffer.data(), size, decoded));
+
+  std::vector<ServiceBatch::Response> responses(1);
+  responses[0] = {"node1", "req1", "rep1", true};
+  ServiceBatch::Encode(responses, buffer);
+
+  std::vector<ServiceBatch::Response> decodedResponses;
+  for (std::size_t size = 1; size < buffer.size(); ++size)
+  {
+    EXPECT_FALSE(
+      ServiceBatch::Decode(buffer.data(), size, decodedResponses));
+  }
+}
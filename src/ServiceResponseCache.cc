@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "ServiceResponseCache.hh"
+
+using namespace gz;
+using namespace transport;
+
+//////////////////////////////////////////////////
+std::string ServiceResponseCache::Key(const std::string &_reqType,
+  const std::string &_repType, const std::string &_data)
+{
+  // Type names never contain a null character, so the separators keep
+  // the keys unambiguous.
+  std::string key;
+  key.reserve(_reqType.size() + _repType.size() + _data.size() + 2u);
+  key.append(_reqType).push_back('\0');
+  key.append(_repType).push_back('\0');
+  key.append(_data);
+  return key;
+}
+
+//////////////////////////////////////////////////
+bool ServiceResponseCache::Lookup(const std::string &_service,
+  const std::string &_key, const uint64_t _version, std::string &_rep,
+  bool &_result)
+{
+  std::lock_guard<std::mutex> lk(this->mutex);
+
+  auto serviceIt = this->entries.find(_service);
+  if (serviceIt == this->entries.end())
+    return false;
+
+  auto &responses = serviceIt->second;
+  auto entryIt = responses.find(_key);
+  if (entryIt == responses.end())
+    return false;
+
+  const Entry &entry = entryIt->second;
+  if (entry.version != _version ||
+      (entry.expires && std::chrono::steady_clock::now() >= entry.expiration))
+  {
+    responses.erase(entryIt);
+    if (responses.empty())
+      this->entries.erase(serviceIt);
+    return false;
+  }
+
+  _rep = entry.rep;
+  _result = true;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ServiceResponseCache::Expect(const std::string &_reqUuid,
+  const std::string &_service, const std::string &_key,
+  const uint64_t _version, const uint64_t _ttl)
+{
+  std::lock_guard<std::mutex> lk(this->mutex);
+
+  auto pendingIt = this->pending.find(_reqUuid);
+  if (pendingIt != this->pending.end())
+  {
+    this->pendingOrder.erase(pendingIt->second.order);
+  }
+  // Responses that never arrive (e.g. timed out requests) would otherwise
+  // accumulate here, forget the oldest request.
+  else if (this->pending.size() >= kMaxPending)
+  {
+    this->pending.erase(this->pendingOrder.front());
+    this->pendingOrder.pop_front();
+  }
+
+  Pending &p = this->pending[_reqUuid];
+  p.order = this->pendingOrder.insert(this->pendingOrder.end(), _reqUuid);
+  p.service = _service;
+  p.key = _key;
+  p.version = _version;
+  p.ttl = _ttl;
+}
+
+//////////////////////////////////////////////////
+bool ServiceResponseCache::Complete(const std::string &_reqUuid,
+  const std::string &_rep, const bool _result)
+{
+  std::lock_guard<std::mutex> lk(this->mutex);
+
+  auto pendingIt = this->pending.find(_reqUuid);
+  if (pendingIt == this->pending.end())
+    return false;
+
+  Pending p = std::move(pendingIt->second);
+  this->pendingOrder.erase(p.order);
+  this->pending.erase(pendingIt);
+
+  if (!_result)
+    return false;
+
+  auto &responses = this->entries[p.service];
+  if (responses.size() >= kMaxEntriesPerService &&
+      responses.find(p.key) == responses.end())
+  {
+    // Drop the responses of older versions first.
+    for (auto it = responses.begin(); it != responses.end();)
+    {
+      if (it->second.version != p.version)
+        it = responses.erase(it);
+      else
+        ++it;
+    }
+
+    if (responses.size() >= kMaxEntriesPerService)
+      responses.erase(responses.begin());
+  }
+
+  Entry &entry = responses[p.key];
+  entry.rep = _rep;
+  entry.version = p.version;
+  entry.expires = p.ttl > 0;
+  if (entry.expires)
+  {
+    entry.expiration = std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(p.ttl);
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ServiceResponseCache::Invalidate(const std::string &_service)
+{
+  std::lock_guard<std::mutex> lk(this->mutex);
+  this->entries.erase(_service);
+}
+
+//////////////////////////////////////////////////
+std::size_t ServiceResponseCache::Size(const std::string &_service) const
+{
+  std::lock_guard<std::mutex> lk(this->mutex);
+
+  auto serviceIt = this->entries.find(_service);
+  if (serviceIt == this->entries.end())
+    return 0u;
+  return serviceIt->second.size();
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_SERVICERESPONSECACHE_HH_
+#define GZ_TRANSPORT_SERVICERESPONSECACHE_HH_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class ServiceResponseCache ServiceResponseCache.hh
+    /// \brief Responses of cacheable services kept by the requester side.
+    /// A response is stored under the service name and a key built from the
+    /// request and response types and the serialized request. A stored
+    /// response is valid while the responder advertises the same cache
+    /// version and, if the responder set a time to live, until it expires.
+    /// This class is thread safe.
+    class GZ_TRANSPORT_VISIBLE ServiceResponseCache
+    {
+      /// \brief Maximum number of responses stored per service.
+      public: static constexpr std::size_t kMaxEntriesPerService = 256;
+
+      /// \brief Maximum number of requests waiting for a response. When it
+      /// is reached, the oldest request is forgotten.
+      public: static constexpr std::size_t kMaxPending = 1024;
+
+      /// \brief Build the key of a request.
+      /// \param[in] _reqType Request type name.
+      /// \param[in] _repType Response type name.
+      /// \param[in] _data Serialized request.
+      /// \return The key.
+      public: static std::string Key(const std::string &_reqType,
+                                     const std::string &_repType,
+                                     const std::string &_data);
+
+      /// \brief Get a valid response.
+      /// \param[in] _service Service name.
+      /// \param[in] _key Key of the request.
+      /// \param[in] _version Cache version currently advertised by the
+      /// responder. Responses stored with another version are discarded.
+      /// \param[out] _rep Serialized response.
+      /// \param[out] _result Result of the service call.
+      /// \return True if a valid response was found.
+      public: bool Lookup(const std::string &_service,
+                          const std::string &_key,
+                          const uint64_t _version,
+                          std::string &_rep,
+                          bool &_result);
+
+      /// \brief Register a request sent to a cacheable service, so its
+      /// response can be stored when it arrives.
+      /// \param[in] _reqUuid UUID of the request.
+      /// \param[in] _service Service name.
+      /// \param[in] _key Key of the request.
+      /// \param[in] _version Cache version advertised by the responder.
+      /// \param[in] _ttl Time to live of the response in milliseconds, or 0
+      /// if the response is valid until the version changes.
+      public: void Expect(const std::string &_reqUuid,
+                          const std::string &_service,
+                          const std::string &_key,
+                          const uint64_t _version,
+                          const uint64_t _ttl);
+
+      /// \brief Store the response of a request registered with Expect().
+      /// Failed service calls are not stored.
+      /// \param[in] _reqUuid UUID of the request.
+      /// \param[in] _rep Serialized response.
+      /// \param[in] _result Result of the service call.
+      /// \return True if the response was stored.
+      public: bool Complete(const std::string &_reqUuid,
+                            const std::string &_rep,
+                            const bool _result);
+
+      /// \brief Remove all the responses of a service.
+      /// \param[in] _service Service name.
+      public: void Invalidate(const std::string &_service);
+
+      /// \brief Number of responses stored for a service.
+      /// \param[in] _service Service name.
+      /// \return The number of responses.
+      public: std::size_t Size(const std::string &_service) const;
+
+      /// \brief A stored response.
+      private: struct Entry
+      {
+        /// \brief Serialized response.
+        std::string rep;
+
+        /// \brief Cache version advertised when the response was requested.
+        uint64_t version = 0;
+
+        /// \brief Whether the response expires.
+        bool expires = false;
+
+        /// \brief Expiration time.
+        std::chrono::steady_clock::time_point expiration;
+      };
+
+      /// \brief A request waiting for its response.
+      private: struct Pending
+      {
+        /// \brief Service name.
+        std::string service;
+
+        /// \brief Key of the request.
+        std::string key;
+
+        /// \brief Cache version advertised when the request was sent.
+        uint64_t version = 0;
+
+        /// \brief Time to live of the response in milliseconds.
+        uint64_t ttl = 0;
+
+        /// \brief Position of the request in pendingOrder.
+        std::list<std::string>::iterator order;
+      };
+
+      /// \brief Mutex to protect the members.
+      private: mutable std::mutex mutex;
+
+      /// \brief Stored responses. The key is the service name and the value
+      /// is a map with the request keys and their responses.
+      private: std::unordered_map<std::string,
+        std::map<std::string, Entry>> entries;
+
+      /// \brief Requests waiting for a response, indexed by request UUID.
+      private: std::unordered_map<std::string, Pending> pending;
+
+      /// \brief UUIDs of the requests in 'pending', from the oldest to the
+      /// newest.
+      private: std::list<std::string> pendingOrder;
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_SERVICERESPONSECACHE_HH_
+#endif
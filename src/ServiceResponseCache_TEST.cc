@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "ServiceResponseCache.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+static const std::string g_service = "/foo"; // NOLINT(*)
+
+//////////////////////////////////////////////////
+/// \brief Check that the keys depend on the types and the request.
+TEST(ServiceResponseCacheTest, Key)
+{
+  EXPECT_EQ(ServiceResponseCache::Key("a", "b", "data"),
+            ServiceResponseCache::Key("a", "b", "data"));
+  EXPECT_NE(ServiceResponseCache::Key("a", "b", "data"),
+            ServiceResponseCache::Key("a", "c", "data"));
+  EXPECT_NE(ServiceResponseCache::Key("a", "b", "data"),
+            ServiceResponseCache::Key("a", "b", "other"));
+  EXPECT_NE(ServiceResponseCache::Key("ab", "c", ""),
+            ServiceResponseCache::Key("a", "bc", ""));
+}
+
+//////////////////////////////////////////////////
+/// \brief Store a response and invalidate it with a new version.
+TEST(ServiceResponseCacheTest, Version)
+{
+  ServiceResponseCache cache;
+  const std::string key = ServiceResponseCache::Key("req", "rep", "data");
+  std::string rep;
+  bool result = false;
+
+  EXPECT_FALSE(cache.Lookup(g_service, key, 0u, rep, result));
+
+  // Unknown request.
+  EXPECT_FALSE(cache.Complete("uuid0", "response", true));
+
+  cache.Expect("uuid1", g_service, key, 0u, 0u);
+  EXPECT_TRUE(cache.Complete("uuid1", "response", true));
+  EXPECT_EQ(1u, cache.Size(g_service));
+
+  // A response is only stored once.
+  EXPECT_FALSE(cache.Complete("uuid1", "response", true));
+
+  EXPECT_TRUE(cache.Lookup(g_service, key, 0u, rep, result));
+  EXPECT_EQ("response", rep);
+  EXPECT_TRUE(result);
+
+  // The responder advertised a new version.
+  EXPECT_FALSE(cache.Lookup(g_service, key, 1u, rep, result));
+  EXPECT_EQ(0u, cache.Size(g_service));
+}
+
+//////////////////////////////////////////////////
+/// \brief Failed service calls are not stored.
+TEST(ServiceResponseCacheTest, Failure)
+{
+  ServiceResponseCache cache;
+  const std::string key = ServiceResponseCache::Key("req", "rep", "data");
+  std::string rep;
+  bool result = false;
+
+  cache.Expect("uuid1", g_service, key, 0u, 0u);
+  EXPECT_FALSE(cache.Complete("uuid1", "", false));
+  EXPECT_FALSE(cache.Lookup(g_service, key, 0u, rep, result));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the expiration of responses with a time to live.
+TEST(ServiceResponseCacheTest, Ttl)
+{
+  ServiceResponseCache cache;
+  const std::string key = ServiceResponseCache::Key("req", "rep", "data");
+  std::string rep;
+  bool result = false;
+
+  cache.Expect("uuid1", g_service, key, 0u, 20u);
+  EXPECT_TRUE(cache.Complete("uuid1", "response", true));
+  EXPECT_TRUE(cache.Lookup(g_service, key, 0u, rep, result));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  EXPECT_FALSE(cache.Lookup(g_service, key, 0u, rep, result));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the invalidation and the size limit.
+TEST(ServiceResponseCacheTest, InvalidateAndLimit)
+{
+  ServiceResponseCache cache;
+  const std::size_t kTotal = ServiceResponseCache::kMaxEntriesPerService + 10;
+
+  for (std::size_t i = 0; i < kTotal; ++i)
+  {
+    const std::string id = std::to_string(i);
+    cache.Expect(id, g_service,
+      ServiceResponseCache::Key("req", "rep", id), 0u, 0u);
+    EXPECT_TRUE(cache.Complete(id, "response", true));
+  }
+  EXPECT_EQ(ServiceResponseCache::kMaxEntriesPerService,
+            cache.Size(g_service));
+
+  cache.Invalidate(g_service);
+  EXPECT_EQ(0u, cache.Size(g_service));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that only the oldest request is forgotten when too many
+/// requests are waiting for a response.
+TEST(ServiceResponseCacheTest, PendingLimit)
+{
+  ServiceResponseCache cache;
+  const std::size_t kTotal = ServiceResponseCache::kMaxPending + 1;
+
+  for (std::size_t i = 0; i < kTotal; ++i)
+  {
+    const std::string id = std::to_string(i);
+    cache.Expect(id, g_service,
+      ServiceResponseCache::Key("req", "rep", id), 0u, 0u);
+  }
+
+  // The oldest request was forgotten, the others are still waiting.
+  EXPECT_FALSE(cache.Complete("0", "response", true));
+  EXPECT_TRUE(cache.Complete("1", "response", true));
+  EXPECT_TRUE(cache.Complete(std::to_string(kTotal - 1), "response", true));
+
+  // Registering a request again makes it the newest one.
+  cache.Expect("2", g_service, ServiceResponseCache::Key("req", "rep", "2"),
+    0u, 0u);
+  cache.Expect("a", g_service, ServiceResponseCache::Key("req", "rep", "a"),
+    0u, 0u);
+  cache.Expect("b", g_service, ServiceResponseCache::Key("req", "rep", "b"),
+    0u, 0u);
+  cache.Expect("c", g_service, ServiceResponseCache::Key("req", "rep", "c"),
+    0u, 0u);
+  EXPECT_FALSE(cache.Complete("3", "response", true));
+  EXPECT_TRUE(cache.Complete("2", "response", true));
+  EXPECT_TRUE(cache.Complete("c", "response", true));
+}
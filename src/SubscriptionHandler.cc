@@ -31,12 +31,35 @@ namespace gz
         periodNs(0.0),
         hUuid(Uuid().ToString()),
         lastCbTimestamp(std::chrono::seconds{0}),
-        nUuid(_nUuid)
+        nUuid(_nUuid),
+        hUuidKey(Uuid::FromIdentifier(this->hUuid)),
+        nUuidKey(Uuid::FromIdentifier(_nUuid))
     {
       if (this->opts.Throttled())
         this->periodNs = 1e9 / this->opts.MsgsPerSec();
     }
 
+    /////////////////////////////////////////////////
+    MsgTypeId SubscriptionHandlerBase::TypeId() const
+    {
+      return this->typeId;
+    }
+
+    /////////////////////////////////////////////////
+    bool SubscriptionHandlerBase::AcceptsType(const MsgTypeId _msgTypeId) const
+    {
+      // Handlers written before the type identifiers existed don't set
+      // typeId, their type name is used instead.
+      if (this->typeId == kInvalidMsgTypeId)
+      {
+        return msgTypeMatches(msgTypeId(
+          const_cast<SubscriptionHandlerBase *>(this)->TypeName()),
+          _msgTypeId);
+      }
+
+      return msgTypeMatches(this->typeId, _msgTypeId);
+    }
+
     /////////////////////////////////////////////////
     std::string SubscriptionHandlerBase::NodeUuid() const
     {
@@ -49,12 +72,31 @@ namespace gz
       return this->hUuid;
     }
 
+    /////////////////////////////////////////////////
+    const Uuid &SubscriptionHandlerBase::NodeKey() const
+    {
+      return this->nUuidKey;
+    }
+
+    /////////////////////////////////////////////////
+    const Uuid &SubscriptionHandlerBase::HandlerKey() const
+    {
+      return this->hUuidKey;
+    }
+
+    /////////////////////////////////////////////////
+    bool SubscriptionHandlerBase::AdmitMessage()
+    {
+      return this->UpdateThrottling();
+    }
+
     /////////////////////////////////////////////////
     bool SubscriptionHandlerBase::UpdateThrottling()
     {
       if (!this->opts.Throttled())
         return true;
 
+      std::lock_guard<std::mutex> lk(this->throttleMutex);
       Timestamp now = std::chrono::steady_clock::now();
 
       // Elapsed time since the last callback execution.
@@ -80,6 +122,19 @@ namespace gz
       // Do nothing
     }
 
+    /////////////////////////////////////////////////
+    bool ISubscriptionHandler::AdmitsBeforeDecode() const
+    {
+      return false;
+    }
+
+    /////////////////////////////////////////////////
+    bool ISubscriptionHandler::RunAdmittedCallback(const ProtoMsg &_msg,
+                                                   const MessageInfo &_info)
+    {
+      return this->RunLocalCallback(_msg, _info);
+    }
+
     /////////////////////////////////////////////////
     class RawSubscriptionHandler::Implementation
     {
@@ -102,7 +157,7 @@ namespace gz
       : SubscriptionHandlerBase(_nUuid, _opts),
         pimpl(new Implementation(_msgType))
     {
-      // Do nothing
+      this->typeId = msgTypeId(_msgType);
     }
 
     /////////////////////////////////////////////////
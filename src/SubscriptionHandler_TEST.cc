@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <gz/msgs/int32.pb.h>
+#include <gz/msgs/stringmsg.pb.h>
+
+#include <memory>
+#include <string>
+
+#include "gz/transport/MessageInfo.hh"
+#include "gz/transport/MsgTypeId.hh"
+#include "gz/transport/SubscribeOptions.hh"
+#include "gz/transport/SubscriptionHandler.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+//////////////////////////////////////////////////
+/// \brief Check that an unthrottled handler admits every message.
+TEST(SubscriptionHandlerTest, AdmitUnthrottled)
+{
+  SubscriptionHandler<msgs::Int32> handler("node-UUID");
+  for (int i = 0; i < 10; ++i)
+    EXPECT_TRUE(handler.AdmitMessage());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a throttled handler drops messages before they are
+/// delivered, and that RunLocalCallback() applies the same decision.
+TEST(SubscriptionHandlerTest, AdmitThrottled)
+{
+  SubscribeOptions opts;
+  opts.SetMsgsPerSec(1u);
+  SubscriptionHandler<msgs::Int32> handler("node-UUID", opts);
+
+  int counter = 0;
+  handler.SetCallback([&counter](const msgs::Int32 &, const MessageInfo &)
+  {
+    ++counter;
+  });
+
+  // Only the first message in the period is admitted.
+  EXPECT_TRUE(handler.AdmitMessage());
+  EXPECT_FALSE(handler.AdmitMessage());
+  EXPECT_FALSE(handler.AdmitMessage());
+
+  // Admitted messages are always delivered.
+  msgs::Int32 msg;
+  EXPECT_TRUE(handler.RunAdmittedCallback(msg, MessageInfo()));
+  EXPECT_EQ(1, counter);
+
+  // The period has not elapsed, so RunLocalCallback() drops the message.
+  EXPECT_TRUE(handler.RunLocalCallback(msg, MessageInfo()));
+  EXPECT_EQ(1, counter);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the generic handler shares the admission logic.
+TEST(SubscriptionHandlerTest, AdmitGeneric)
+{
+  SubscribeOptions opts;
+  opts.SetMsgsPerSec(1u);
+  SubscriptionHandler<ProtoMsg> handler("node-UUID", opts);
+
+  int counter = 0;
+  handler.SetCallback([&counter](const ProtoMsg &, const MessageInfo &)
+  {
+    ++counter;
+  });
+
+  msgs::Int32 msg;
+  EXPECT_TRUE(handler.RunLocalCallback(msg, MessageInfo()));
+  EXPECT_TRUE(handler.RunLocalCallback(msg, MessageInfo()));
+  EXPECT_EQ(1, counter);
+  EXPECT_FALSE(handler.AdmitMessage());
+}
+
+//////////////////////////////////////////////////
+/// \brief A handler without callback fails to deliver admitted messages.
+TEST(SubscriptionHandlerTest, NoCallback)
+{
+  SubscriptionHandler<msgs::Int32> handler("node-UUID");
+  msgs::Int32 msg;
+  EXPECT_TRUE(handler.AdmitMessage());
+  EXPECT_FALSE(handler.RunAdmittedCallback(msg, MessageInfo()));
+  EXPECT_FALSE(handler.RunLocalCallback(msg, MessageInfo()));
+}
+
+//////////////////////////////////////////////////
+/// \brief A handler that only implements the original interface.
+class LegacyHandler : public ISubscriptionHandler
+{
+  /// \brief Constructor.
+  /// \param[in] _opts Subscription options.
+  public: explicit LegacyHandler(
+    const SubscribeOptions &_opts = SubscribeOptions())
+    : ISubscriptionHandler("node-UUID", _opts)
+  {
+  }
+
+  // Documentation inherited.
+  public: bool RunLocalCallback(const ProtoMsg &, const MessageInfo &) override
+  {
+    ++this->counter;
+    return true;
+  }
+
+  // Documentation inherited.
+  public: const std::shared_ptr<ProtoMsg> CreateMsg(const std::string &,
+    const std::string &) const override
+  {
+    return std::make_shared<msgs::Int32>();
+  }
+
+  // Documentation inherited.
+  public: std::string TypeName() override
+  {
+    return msgs::Int32().GetTypeName();
+  }
+
+  /// \brief Number of messages delivered.
+  public: int counter = 0;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check that admitted messages reach the handlers that only override
+/// RunLocalCallback().
+TEST(SubscriptionHandlerTest, LegacyHandler)
+{
+  LegacyHandler handler;
+  EXPECT_FALSE(handler.AdmitsBeforeDecode());
+  msgs::Int32 msg;
+  EXPECT_TRUE(handler.RunAdmittedCallback(msg, MessageInfo()));
+  EXPECT_EQ(1, handler.counter);
+
+  // The type is taken from the type name of the handler.
+  EXPECT_TRUE(handler.AcceptsType(msgTypeId(msg.GetTypeName())));
+  EXPECT_FALSE(handler.AcceptsType(
+    msgTypeId(msgs::StringMsg().GetTypeName())));
+
+  // The handlers of this library admit messages before decoding them.
+  EXPECT_TRUE(SubscriptionHandler<msgs::Int32>("node-UUID")
+    .AdmitsBeforeDecode());
+  EXPECT_TRUE(SubscriptionHandler<ProtoMsg>("node-UUID")
+    .AdmitsBeforeDecode());
+}
+
+//////////////////////////////////////////////////
+/// \brief A handler that throttles itself in RunLocalCallback(), as the
+/// handlers written for the original interface do.
+class ThrottledLegacyHandler : public LegacyHandler
+{
+  /// \brief Constructor.
+  /// \param[in] _opts Subscription options.
+  public: explicit ThrottledLegacyHandler(const SubscribeOptions &_opts)
+    : LegacyHandler(_opts)
+  {
+  }
+
+  // Documentation inherited.
+  public: bool RunLocalCallback(const ProtoMsg &_msg,
+    const MessageInfo &_info) override
+  {
+    if (!this->UpdateThrottling())
+      return true;
+    return LegacyHandler::RunLocalCallback(_msg, _info);
+  }
+};
+
+//////////////////////////////////////////////////
+/// \brief A legacy handler that throttles itself isn't admitted by the
+/// library, so its own throttling lets the first message through.
+TEST(SubscriptionHandlerTest, LegacyThrottledHandler)
+{
+  SubscribeOptions opts;
+  opts.SetMsgsPerSec(1u);
+  ThrottledLegacyHandler handler(opts);
+  EXPECT_FALSE(handler.AdmitsBeforeDecode());
+
+  msgs::Int32 msg;
+  EXPECT_TRUE(handler.RunLocalCallback(msg, MessageInfo()));
+  EXPECT_TRUE(handler.RunLocalCallback(msg, MessageInfo()));
+  EXPECT_EQ(1, handler.counter);
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/transport/Helpers.hh"
+#include "ThreadConfig.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace
+{
+  /// \brief Maximum length of a thread name, without the terminating null
+  /// character.
+  constexpr std::size_t kMaxThreadNameLength = 15u;
+
+  //////////////////////////////////////////////////
+  /// \brief Read a per thread environment variable, or the variable shared
+  /// by all the threads if there's no per thread value.
+  /// \param[in] _name Name of the shared variable.
+  /// \param[in] _thread The thread.
+  /// \param[in] _shared Whether to fall back to the shared variable.
+  /// \param[out] _value The value.
+  /// \return True if the variable is set and not empty.
+  bool threadEnv(const std::string &_name, const TransportThread _thread,
+                 const bool _shared, std::string &_value)
+  {
+    const std::string specific =
+      _name + "_" + ThreadConfig::EnvSuffix(_thread);
+    if (env(specific, _value) && !_value.empty())
+      return true;
+    return _shared && env(_name, _value) && !_value.empty();
+  }
+}
+
+//////////////////////////////////////////////////
+ThreadConfig ThreadConfig::FromEnv(const TransportThread _thread)
+{
+  ThreadConfig config;
+  std::string value;
+
+  if (threadEnv("GZ_TRANSPORT_THREAD_AFFINITY", _thread, true, value) &&
+      !ParseCpus(value, config.cpus))
+  {
+    std::cerr << "Invalid CPU list [" << value << "] for the "
+              << EnvSuffix(_thread) << " thread, ignoring it" << std::endl;
+    config.cpus.clear();
+  }
+
+  if (threadEnv("GZ_TRANSPORT_THREAD_PRIORITY", _thread, true, value))
+  {
+    try
+    {
+      config.priority = std::stoi(value);
+    }
+    catch (...)
+    {
+      config.priority = -1;
+    }
+
+    if (config.priority < 1 || config.priority > 99)
+    {
+      std::cerr << "Invalid priority [" << value << "] for the "
+                << EnvSuffix(_thread) << " thread, it should be in [1, 99]. "
+                << "Ignoring it" << std::endl;
+      config.priority = 0;
+    }
+  }
+
+  if (threadEnv("GZ_TRANSPORT_THREAD_NAME", _thread, false, value))
+    config.name = value;
+
+  return config;
+}
+
+//////////////////////////////////////////////////
+std::string ThreadConfig::EnvSuffix(const TransportThread _thread)
+{
+  switch (_thread)
+  {
+    case TransportThread::RECEPTION:
+      return "RECEPTION";
+    case TransportThread::PUBLISH:
+      return "PUBLISH";
+    case TransportThread::ACCESS_CONTROL:
+      return "ACCESS_CONTROL";
+    case TransportThread::MSG_DISCOVERY:
+      return "MSG_DISCOVERY";
+    case TransportThread::SRV_DISCOVERY:
+      return "SRV_DISCOVERY";
+    case TransportThread::ZMQ_IO:
+      return "ZMQ_IO";
+    default:
+      return "";
+  }
+}
+
+//////////////////////////////////////////////////
+std::string ThreadConfig::DefaultName(const TransportThread _thread)
+{
+  switch (_thread)
+  {
+    case TransportThread::RECEPTION:
+      return "gz-recv";
+    case TransportThread::PUBLISH:
+      return "gz-pub";
+    case TransportThread::ACCESS_CONTROL:
+      return "gz-access";
+    case TransportThread::MSG_DISCOVERY:
+      return "gz-msg-disc";
+    case TransportThread::SRV_DISCOVERY:
+      return "gz-srv-disc";
+    case TransportThread::ZMQ_IO:
+    default:
+      return "";
+  }
+}
+
+//////////////////////////////////////////////////
+bool ThreadConfig::ParseCpus(const std::string &_str, std::vector<int> &_cpus)
+{
+  _cpus.clear();
+
+  // std::getline() doesn't return the empty item after a trailing comma.
+  if (_str.empty() || _str.back() == ',')
+    return false;
+
+  std::stringstream ss(_str);
+  std::string item;
+  while (std::getline(ss, item, ','))
+  {
+    int first = 0;
+    int last = 0;
+    try
+    {
+      std::size_t pos = 0;
+      first = std::stoi(item, &pos);
+      last = first;
+      if (pos < item.size())
+      {
+        if (item[pos] != '-')
+          return false;
+        const std::string rest = item.substr(pos + 1);
+        last = std::stoi(rest, &pos);
+        if (pos != rest.size())
+          return false;
+      }
+    }
+    catch (...)
+    {
+      return false;
+    }
+
+    if (first < 0 || last < first)
+      return false;
+
+    for (int cpu = first; cpu <= last; ++cpu)
+      _cpus.push_back(cpu);
+  }
+
+  return !_cpus.empty();
+}
+
+//////////////////////////////////////////////////
+void ThreadConfig::Merge(const ThreadConfig &_other)
+{
+  if (!_other.cpus.empty())
+    this->cpus = _other.cpus;
+  if (_other.priority > 0)
+    this->priority = _other.priority;
+  if (!_other.name.empty())
+    this->name = _other.name;
+}
+
+//////////////////////////////////////////////////
+bool ThreadConfig::Apply(std::thread::native_handle_type _handle,
+  const TransportThread _thread) const
+{
+  const std::string threadName = this->name.empty() ?
+    DefaultName(_thread) : this->name;
+  bool result = true;
+
+#ifdef __linux__
+  if (!threadName.empty())
+  {
+    const std::string truncated = threadName.substr(0, kMaxThreadNameLength);
+    pthread_setname_np(_handle, truncated.c_str());
+  }
+
+  if (!this->cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const int cpu : this->cpus)
+    {
+      if (cpu < CPU_SETSIZE)
+        CPU_SET(cpu, &set);
+    }
+
+    const int error = pthread_setaffinity_np(_handle, sizeof(set), &set);
+    if (error != 0)
+    {
+      std::cerr << "Unable to set the CPU affinity of the "
+                << EnvSuffix(_thread) << " thread: " << std::strerror(error)
+                << std::endl;
+      result = false;
+    }
+  }
+
+  if (this->priority > 0)
+  {
+    sched_param param;
+    std::memset(&param, 0, sizeof(param));
+    param.sched_priority = this->priority;
+    const int error = pthread_setschedparam(_handle, SCHED_FIFO, &param);
+    if (error != 0)
+    {
+      std::cerr << "Unable to set the SCHED_FIFO priority of the "
+                << EnvSuffix(_thread) << " thread: " << std::strerror(error)
+                << std::endl;
+      result = false;
+    }
+  }
+#else
+  (void)_handle;
+  if (!this->cpus.empty() || this->priority > 0)
+  {
+    std::cerr << "Thread affinity and priority are only supported on Linux. "
+              << "Ignoring the configuration of the " << EnvSuffix(_thread)
+              << " thread" << std::endl;
+    result = false;
+  }
+#endif
+
+  return result;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_TRANSPORT_THREADCONFIG_HH_
+#define GZ_TRANSPORT_THREADCONFIG_HH_
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gz/transport/config.hh"
+#include "gz/transport/Export.hh"
+#include "gz/transport/NodeOptions.hh"
+
+namespace gz
+{
+  namespace transport
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE {
+    //
+    /// \class ThreadConfig ThreadConfig.hh
+    /// \brief CPU affinity, real-time priority and name of a thread created
+    /// by the transport library.
+    ///
+    /// The configuration of each thread can be read from the environment:
+    ///  * GZ_TRANSPORT_THREAD_AFFINITY_<THREAD>: List of CPUs, e.g. "0,2-3".
+    ///  * GZ_TRANSPORT_THREAD_PRIORITY_<THREAD>: SCHED_FIFO priority.
+    ///  * GZ_TRANSPORT_THREAD_NAME_<THREAD>: Thread name.
+    /// where <THREAD> is the value returned by EnvSuffix(). The affinity and
+    /// the priority of the threads without a specific value are taken from
+    /// GZ_TRANSPORT_THREAD_AFFINITY and GZ_TRANSPORT_THREAD_PRIORITY.
+    class GZ_TRANSPORT_VISIBLE ThreadConfig
+    {
+      /// \brief CPUs where the thread can run. Empty means any CPU.
+      public: std::vector<int> cpus;
+
+      /// \brief SCHED_FIFO priority, or 0 to keep the default scheduling.
+      public: int priority = 0;
+
+      /// \brief Thread name, or empty to use DefaultName().
+      public: std::string name;
+
+      /// \brief Read the configuration of a thread from the environment.
+      /// Invalid values are reported and ignored.
+      /// \param[in] _thread The thread.
+      /// \return The configuration.
+      public: static ThreadConfig FromEnv(const TransportThread _thread);
+
+      /// \brief Get the suffix of the environment variables of a thread.
+      /// \param[in] _thread The thread.
+      /// \return The suffix, e.g. "RECEPTION".
+      public: static std::string EnvSuffix(const TransportThread _thread);
+
+      /// \brief Get the name given to a thread when no name is configured.
+      /// \param[in] _thread The thread.
+      /// \return The name, e.g. "gz-recv".
+      public: static std::string DefaultName(const TransportThread _thread);
+
+      /// \brief Parse a list of CPUs such as "0,2-3".
+      /// \param[in] _str The list.
+      /// \param[out] _cpus The CPUs.
+      /// \return False if the list is malformed.
+      public: static bool ParseCpus(const std::string &_str,
+                                    std::vector<int> &_cpus);
+
+      /// \brief Replace the values of this configuration with the values
+      /// set in another one.
+      /// \param[in] _other The other configuration.
+      public: void Merge(const ThreadConfig &_other);
+
+      /// \brief Apply this configuration to a running thread. Only Linux is
+      /// supported, on other platforms only an error is reported if there is
+      /// something to apply besides the name.
+      /// \param[in] _handle Native handle of the thread.
+      /// \param[in] _thread Which transport thread it is, used for the
+      /// default name and the error messages.
+      /// \return False if some value couldn't be applied (e.g. missing
+      /// privileges for the priority).
+      public: bool Apply(std::thread::native_handle_type _handle,
+                         const TransportThread _thread) const;
+    };
+    }
+  }
+}
+
+// GZ_TRANSPORT_THREADCONFIG_HH_
+#endif
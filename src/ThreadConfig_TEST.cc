@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "ThreadConfig.hh"
+#include "test_config.hh"
+#include "gtest/gtest.h"
+
+using namespace gz;
+using namespace transport;
+
+//////////////////////////////////////////////////
+/// \brief Check the parsing of CPU lists.
+TEST(ThreadConfigTest, ParseCpus)
+{
+  std::vector<int> cpus;
+  EXPECT_TRUE(ThreadConfig::ParseCpus("3", cpus));
+  EXPECT_EQ(std::vector<int>({3}), cpus);
+
+  EXPECT_TRUE(ThreadConfig::ParseCpus("0,2-4,7", cpus));
+  EXPECT_EQ(std::vector<int>({0, 2, 3, 4, 7}), cpus);
+
+  EXPECT_FALSE(ThreadConfig::ParseCpus("", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("a", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("1,", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("-1", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("3-1", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("1-2x", cpus));
+  EXPECT_FALSE(ThreadConfig::ParseCpus("1x", cpus));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the configuration read from the environment.
+TEST(ThreadConfigTest, FromEnv)
+{
+  unsetenv("GZ_TRANSPORT_THREAD_AFFINITY");
+  unsetenv("GZ_TRANSPORT_THREAD_PRIORITY");
+  ThreadConfig config = ThreadConfig::FromEnv(TransportThread::RECEPTION);
+  EXPECT_TRUE(config.cpus.empty());
+  EXPECT_EQ(0, config.priority);
+  EXPECT_TRUE(config.name.empty());
+
+  // Values shared by all the threads.
+  setenv("GZ_TRANSPORT_THREAD_AFFINITY", "1-2", 1);
+  setenv("GZ_TRANSPORT_THREAD_PRIORITY", "20", 1);
+  config = ThreadConfig::FromEnv(TransportThread::PUBLISH);
+  EXPECT_EQ(std::vector<int>({1, 2}), config.cpus);
+  EXPECT_EQ(20, config.priority);
+
+  // Per thread values take precedence.
+  setenv("GZ_TRANSPORT_THREAD_AFFINITY_RECEPTION", "3", 1);
+  setenv("GZ_TRANSPORT_THREAD_PRIORITY_RECEPTION", "30", 1);
+  setenv("GZ_TRANSPORT_THREAD_NAME_RECEPTION", "my-recv", 1);
+  config = ThreadConfig::FromEnv(TransportThread::RECEPTION);
+  EXPECT_EQ(std::vector<int>({3}), config.cpus);
+  EXPECT_EQ(30, config.priority);
+  EXPECT_EQ("my-recv", config.name);
+
+  // Invalid values are ignored.
+  setenv("GZ_TRANSPORT_THREAD_AFFINITY_RECEPTION", "x", 1);
+  setenv("GZ_TRANSPORT_THREAD_PRIORITY_RECEPTION", "100", 1);
+  config = ThreadConfig::FromEnv(TransportThread::RECEPTION);
+  EXPECT_TRUE(config.cpus.empty());
+  EXPECT_EQ(0, config.priority);
+
+  unsetenv("GZ_TRANSPORT_THREAD_AFFINITY");
+  unsetenv("GZ_TRANSPORT_THREAD_PRIORITY");
+  unsetenv("GZ_TRANSPORT_THREAD_AFFINITY_RECEPTION");
+  unsetenv("GZ_TRANSPORT_THREAD_PRIORITY_RECEPTION");
+  unsetenv("GZ_TRANSPORT_THREAD_NAME_RECEPTION");
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that values set in another configuration replace the
+/// current ones.
+TEST(ThreadConfigTest, Merge)
+{
+  ThreadConfig config;
+  config.cpus = {1};
+  config.priority = 10;
+  config.name = "a";
+
+  ThreadConfig other;
+  other.priority = 20;
+  config.Merge(other);
+  EXPECT_EQ(std::vector<int>({1}), config.cpus);
+  EXPECT_EQ(20, config.priority);
+  EXPECT_EQ("a", config.name);
+}
+
+#ifdef __linux__
+//////////////////////////////////////////////////
+/// \brief Apply a configuration to a running thread.
+TEST(ThreadConfigTest, Apply)
+{
+  std::atomic<bool> stop(false);
+  std::thread thread([&stop]()
+  {
+    while (!stop)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  });
+
+  // The default name is used when there's no name.
+  ThreadConfig config;
+  EXPECT_TRUE(config.Apply(thread.native_handle(),
+    TransportThread::RECEPTION));
+  char name[16];
+  ASSERT_EQ(0, pthread_getname_np(thread.native_handle(), name,
+    sizeof(name)));
+  EXPECT_STREQ("gz-recv", name);
+
+  // Long names are truncated.
+  config.name = "a-very-long-thread-name";
+  EXPECT_TRUE(config.Apply(thread.native_handle(),
+    TransportThread::RECEPTION));
+  ASSERT_EQ(0, pthread_getname_np(thread.native_handle(), name,
+    sizeof(name)));
+  EXPECT_STREQ("a-very-long-thr", name);
+
+  // Restrict the thread to one of the CPUs it can use.
+  cpu_set_t set;
+  ASSERT_EQ(0, pthread_getaffinity_np(thread.native_handle(), sizeof(set),
+    &set));
+  int cpu = 0;
+  while (cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &set))
+    ++cpu;
+  ASSERT_LT(cpu, CPU_SETSIZE);
+
+  config.cpus = {cpu};
+  EXPECT_TRUE(config.Apply(thread.native_handle(),
+    TransportThread::RECEPTION));
+  ASSERT_EQ(0, pthread_getaffinity_np(thread.native_handle(), sizeof(set),
+    &set));
+  EXPECT_EQ(1, CPU_COUNT(&set));
+  EXPECT_TRUE(CPU_ISSET(cpu, &set));
+
+  stop = true;
+  thread.join();
+}
+#endif
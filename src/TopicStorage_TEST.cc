@@ -479,6 +479,59 @@ TEST(TopicStorageTest, PublishersByNode)
   EXPECT_EQ(pubs.at(0).Addr(), g_addr1);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the methods taking parsed UUIDs.
+TEST(TopicStorageTest, UuidKeys)
+{
+  init();
+
+  Publisher publisher1(g_topic1, g_addr1, g_pUuid1, g_nUuid1, g_opts1);
+  Publisher publisher2(g_topic1, g_addr1, g_pUuid1, g_nUuid2, g_opts2);
+  Publisher publisher3(g_topic2, g_addr2, g_pUuid2, g_nUuid3, g_opts3);
+
+  TopicStorage<Publisher> test;
+
+  EXPECT_TRUE(test.AddPublisher(publisher1));
+  EXPECT_TRUE(test.AddPublisher(publisher2));
+  EXPECT_TRUE(test.AddPublisher(publisher3));
+
+  const Uuid &pUuid1 = publisher1.ProcessKey();
+  const Uuid &pUuid2 = publisher3.ProcessKey();
+  const Uuid &nUuid1 = publisher1.NodeKey();
+  const Uuid &nUuid3 = publisher3.NodeKey();
+
+  EXPECT_TRUE(test.HasAnyPublishers(g_topic1, pUuid1));
+  EXPECT_FALSE(test.HasAnyPublishers(g_topic1, pUuid2));
+  EXPECT_FALSE(test.HasAnyPublishers(g_topic1, Uuid()));
+
+  Publisher info;
+  EXPECT_TRUE(test.Publisher(g_topic1, pUuid1, nUuid1, info));
+  EXPECT_EQ(publisher1, info);
+  EXPECT_FALSE(test.Publisher(g_topic1, pUuid1, nUuid3, info));
+
+  std::vector<Publisher> byNode;
+  test.PublishersByNode(pUuid1, nUuid1, byNode);
+  ASSERT_EQ(1u, byNode.size());
+  EXPECT_EQ(publisher1, byNode.at(0));
+
+  // The maps of publishers are indexed by the string form of the UUIDs.
+  std::map<std::string, std::vector<Publisher>> byProc;
+  test.PublishersByProc(pUuid1, byProc);
+  EXPECT_EQ(2u, byProc.size());
+  EXPECT_TRUE(byProc.find(g_nUuid1) != byProc.end());
+  EXPECT_TRUE(byProc.find(g_nUuid2) != byProc.end());
+
+  EXPECT_FALSE(test.DelPublisherByNode(g_topic1, pUuid2, nUuid1));
+  EXPECT_TRUE(test.DelPublisherByNode(g_topic1, pUuid1, nUuid1));
+  EXPECT_FALSE(test.Publisher(g_topic1, g_pUuid1, g_nUuid1, info));
+  EXPECT_TRUE(test.HasAnyPublishers(g_topic1, g_pUuid1));
+
+  EXPECT_TRUE(test.DelPublishersByProc(pUuid2));
+  EXPECT_FALSE(test.HasTopic(g_topic2));
+  EXPECT_FALSE(test.DelPublishersByProc(pUuid2));
+  EXPECT_TRUE(test.HasTopic(g_topic1));
+}
+
 //////////////////////////////////////////////////
 /// \brief Check HasTopic(<topic>, <type>).
 TEST(TopicStorageTest, HasTopicWithType)
@@ -501,3 +554,38 @@ TEST(TopicStorageTest, HasTopicWithType)
   EXPECT_TRUE(test.AddPublisher(publisher2));
   EXPECT_TRUE(test.HasTopic(g_topic1));
 }
+
+//////////////////////////////////////////////////
+/// \brief Check that the information of a stored publisher can be updated.
+TEST(TopicStorageTest, UpdatePublisher)
+{
+  init();
+
+  AdvertiseServiceOptions opts;
+  opts.SetCacheable(true);
+  ServicePublisher publisher(g_topic1, g_addr1, "socket", g_pUuid1, g_nUuid1,
+    "req", "rep", opts);
+
+  TopicStorage<ServicePublisher> test;
+
+  // The publisher is not stored yet.
+  EXPECT_FALSE(test.UpdatePublisher(publisher));
+  EXPECT_TRUE(test.AddPublisher(publisher));
+
+  // Same information.
+  EXPECT_FALSE(test.UpdatePublisher(publisher));
+
+  opts.SetCacheVersion(1u);
+  publisher.SetOptions(opts);
+  EXPECT_FALSE(test.AddPublisher(publisher));
+  EXPECT_TRUE(test.UpdatePublisher(publisher));
+
+  ServicePublisher stored;
+  ASSERT_TRUE(test.Publisher(g_topic1, g_pUuid1, g_nUuid1, stored));
+  EXPECT_EQ(1u, stored.Options().CacheVersion());
+
+  // A publisher of another node is not updated.
+  ServicePublisher other(g_topic1, g_addr1, "socket", g_pUuid1, g_nUuid2,
+    "req", "rep", opts);
+  EXPECT_FALSE(test.UpdatePublisher(other));
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "gz/transport/NodeShared.hh"
+#include "gz/transport/TransportContext.hh"
+
+using namespace gz;
+using namespace transport;
+
+namespace gz
+{
+  namespace transport
+  {
+    inline namespace GZ_TRANSPORT_VERSION_NAMESPACE
+    {
+    /// \internal
+    /// \brief Private data for TransportContext class.
+    class TransportContextPrivate
+    {
+      /// \brief Constructor.
+      public: TransportContextPrivate()
+        : shared(new NodeShared())
+      {
+      }
+
+      /// \brief Destructor.
+      public: ~TransportContextPrivate()
+      {
+        delete this->shared;
+      }
+
+      /// \brief Transport state of the context. It's not a unique_ptr
+      /// because the destructor of NodeShared is only accessible to friends.
+      public: NodeShared *shared = nullptr;
+    };
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TransportContext::TransportContext()
+  : dataPtr(new TransportContextPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+TransportContext::~TransportContext()
+{
+}
+
+//////////////////////////////////////////////////
+const std::string &TransportContext::ProcessUuid() const
+{
+  return this->dataPtr->shared->pUuid;
+}
+
+//////////////////////////////////////////////////
+NodeShared *TransportContext::Shared() const
+{
+  return this->dataPtr->shared;
+}
@@ -15,6 +15,8 @@
  *
 */
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -23,6 +25,84 @@
 using namespace gz;
 using namespace transport;
 
+//////////////////////////////////////////////////
+Uuid::Uuid(const Uuid &_other)
+{
+  memcpy(&this->data, &_other.data, sizeof(this->data));
+}
+
+//////////////////////////////////////////////////
+Uuid &Uuid::operator=(const Uuid &_other)
+{
+  memcpy(&this->data, &_other.data, sizeof(this->data));
+  return *this;
+}
+
+//////////////////////////////////////////////////
+bool Uuid::operator==(const Uuid &_other) const
+{
+  return memcmp(&this->data, &_other.data, sizeof(this->data)) == 0;
+}
+
+//////////////////////////////////////////////////
+bool Uuid::operator!=(const Uuid &_other) const
+{
+  return !(*this == _other);
+}
+
+//////////////////////////////////////////////////
+bool Uuid::operator<(const Uuid &_other) const
+{
+  return memcmp(&this->data, &_other.data, sizeof(this->data)) < 0;
+}
+
+//////////////////////////////////////////////////
+std::size_t Uuid::Hash() const
+{
+  // The bytes of a UUID are random, so folding the two halves is enough.
+  static_assert(sizeof(portable_uuid_t) == 16, "Unexpected UUID size");
+  uint64_t halves[2];
+  memcpy(halves, &this->data, sizeof(halves));
+  return static_cast<std::size_t>(halves[0] ^ (halves[1] * 0x9e3779b97f4a7c15));
+}
+
+//////////////////////////////////////////////////
+Uuid::Uuid(const unsigned char *_bytes)
+{
+  static_assert(sizeof(portable_uuid_t) == 16, "Unexpected UUID size");
+  memcpy(&this->data, _bytes, sizeof(this->data));
+}
+
+//////////////////////////////////////////////////
+Uuid Uuid::FromIdentifier(const std::string &_id)
+{
+  const unsigned char zeros[16] = {};
+  Uuid uuid(zeros);
+  if (Uuid::FromString(_id, uuid))
+    return uuid;
+
+  // Not a UUID, e.g. a name used in a test. Derive the 16 bytes from two
+  // FNV-1a hashes of the identifier.
+  uint64_t halves[2] = {0xcbf29ce484222325ull, 0x84222325cbf29ce4ull};
+  for (auto &half : halves)
+  {
+    for (const char c : _id)
+    {
+      half ^= static_cast<unsigned char>(c);
+      half *= 0x100000001b3ull;
+    }
+  }
+
+  unsigned char bytes[16];
+  memcpy(bytes, halves, sizeof(bytes));
+
+  // Mark it as a custom (version 8) UUID, so it never matches a random
+  // (version 4) UUID.
+  bytes[6] = static_cast<unsigned char>((bytes[6] & 0x0f) | 0x80);
+  bytes[8] = static_cast<unsigned char>((bytes[8] & 0x3f) | 0x80);
+  return Uuid(bytes);
+}
+
 #ifdef _WIN32
 /* Windows implementation using libuuid library */
 //////////////////////////////////////////////////
@@ -56,6 +136,23 @@ std::string Uuid::ToString() const
 
   return uuidStr;
 }
+
+//////////////////////////////////////////////////
+bool Uuid::FromString(const std::string &_str, Uuid &_uuid)
+{
+  if (_str.size() != static_cast<std::size_t>(Uuid::UuidStrLen - 1))
+    return false;
+
+  UUID parsed;
+  if (::UuidFromStringA(reinterpret_cast<RPC_CSTR>(
+        const_cast<char *>(_str.c_str())), &parsed) != RPC_S_OK)
+  {
+    return false;
+  }
+
+  _uuid.data = parsed;
+  return true;
+}
 #else
 /* Unix implementation using libuuid library */
 
@@ -87,4 +184,18 @@ std::string Uuid::ToString() const
   return std::string(uuidStr.begin(), uuidStr.end() - 1);
 }
 
+//////////////////////////////////////////////////
+bool Uuid::FromString(const std::string &_str, Uuid &_uuid)
+{
+  if (_str.size() != static_cast<std::size_t>(Uuid::UuidStrLen - 1))
+    return false;
+
+  portable_uuid_t parsed;
+  if (uuid_parse(_str.c_str(), parsed) != 0)
+    return false;
+
+  uuid_copy(_uuid.data, parsed);
+  return true;
+}
+
 #endif
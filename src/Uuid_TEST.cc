@@ -17,7 +17,9 @@
 
 #include <cctype>
 #include <iostream>
+#include <set>
 #include <string>
+#include <unordered_set>
 
 #include "gz/transport/Uuid.hh"
 #include "gtest/gtest.h"
@@ -51,3 +53,85 @@ TEST(UuidTest, testToString)
   for (auto i = 24; i < 36; ++i)
     EXPECT_GT(isxdigit(output.str()[i]), 0);
 }
+
+//////////////////////////////////////////////////
+/// \brief Check the value semantics of Uuid.
+TEST(UuidTest, testValue)
+{
+  transport::Uuid uuid1;
+  transport::Uuid uuid2;
+  EXPECT_FALSE(uuid1 == uuid2);
+  EXPECT_TRUE(uuid1 != uuid2);
+  EXPECT_NE(uuid1 < uuid2, uuid2 < uuid1);
+
+  transport::Uuid copy(uuid1);
+  EXPECT_TRUE(copy == uuid1);
+  EXPECT_FALSE(copy < uuid1);
+  EXPECT_EQ(copy.Hash(), uuid1.Hash());
+  EXPECT_EQ(copy.ToString(), uuid1.ToString());
+
+  copy = uuid2;
+  EXPECT_TRUE(copy == uuid2);
+  EXPECT_EQ(copy.ToString(), uuid2.ToString());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the conversion from string.
+TEST(UuidTest, testFromString)
+{
+  transport::Uuid uuid1;
+  transport::Uuid parsed;
+  EXPECT_TRUE(transport::Uuid::FromString(uuid1.ToString(), parsed));
+  EXPECT_TRUE(parsed == uuid1);
+  EXPECT_EQ(uuid1.ToString(), parsed.ToString());
+
+  // Invalid strings leave the output untouched.
+  transport::Uuid untouched(parsed);
+  EXPECT_FALSE(transport::Uuid::FromString("", parsed));
+  EXPECT_FALSE(transport::Uuid::FromString("not-a-uuid", parsed));
+  EXPECT_FALSE(transport::Uuid::FromString(
+    "zzzzzzzz-zzzz-zzzz-zzzz-zzzzzzzzzzzz", parsed));
+  EXPECT_FALSE(transport::Uuid::FromString(uuid1.ToString() + "0", parsed));
+  EXPECT_TRUE(parsed == untouched);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that Uuid can be used as a container key.
+TEST(UuidTest, testContainers)
+{
+  std::set<transport::Uuid> ordered;
+  std::unordered_set<transport::Uuid> unordered;
+
+  transport::Uuid uuid1;
+  transport::Uuid uuid2;
+  for (const auto &uuid : {uuid1, uuid2, uuid1})
+  {
+    ordered.insert(uuid);
+    unordered.insert(uuid);
+  }
+
+  EXPECT_EQ(2u, ordered.size());
+  EXPECT_EQ(2u, unordered.size());
+  EXPECT_EQ(1u, unordered.count(uuid1));
+  EXPECT_EQ(1u, unordered.count(uuid2));
+  EXPECT_EQ(0u, unordered.count(transport::Uuid()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the keys of the identifiers.
+TEST(UuidTest, testFromIdentifier)
+{
+  // A UUID string is parsed.
+  transport::Uuid uuid1;
+  EXPECT_TRUE(transport::Uuid::FromIdentifier(uuid1.ToString()) == uuid1);
+
+  // Other identifiers always get the same key, and different identifiers
+  // get different keys.
+  const auto key1 = transport::Uuid::FromIdentifier("node-UUID-1");
+  EXPECT_TRUE(key1 == transport::Uuid::FromIdentifier("node-UUID-1"));
+  EXPECT_TRUE(key1 != transport::Uuid::FromIdentifier("node-UUID-2"));
+  EXPECT_TRUE(transport::Uuid::FromIdentifier("") ==
+              transport::Uuid::FromIdentifier(""));
+  EXPECT_TRUE(transport::Uuid::FromIdentifier("") != key1);
+  EXPECT_TRUE(key1 != uuid1);
+}
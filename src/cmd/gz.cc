@@ -15,10 +15,21 @@
  *
 */
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdint>
+#include <fstream>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #ifdef _MSC_VER
@@ -30,6 +41,7 @@
 #pragma warning(pop)
 #endif
 
+#include <gz/msgs/bytes.pb.h>
 #include <gz/msgs/Factory.hh>
 
 #include "gz.hh"
@@ -40,6 +52,192 @@
 using namespace gz;
 using namespace transport;
 
+namespace
+{
+  /// \brief Bytes at the beginning of a raw capture file. The file
+  /// continues with frames made of the reception time (nanoseconds since
+  /// the start of the capture, 64 bits), the sizes of the message type and
+  /// of the message (32 bits each), the message type and the message. All
+  /// the integers are little endian.
+  const std::string kRawCaptureMagic = "GZRAWCP1";
+
+  /// \brief Size of the fixed part of a frame.
+  constexpr std::size_t kRawFrameHeaderSize = 16u;
+
+  /// \brief Maximum number of bytes waiting to be written to a capture
+  /// file. Messages received while the buffer is full are dropped.
+  constexpr std::size_t kRawCaptureMaxBuffered = 64u * 1024u * 1024u;
+
+  //////////////////////////////////////////////////
+  /// \brief Append an unsigned integer in little endian order.
+  /// \param[in] _value Value to append.
+  /// \param[in] _bytes Number of bytes to append.
+  /// \param[out] _buffer Buffer.
+  void appendLE(const uint64_t _value, const std::size_t _bytes,
+                std::string &_buffer)
+  {
+    for (std::size_t i = 0; i < _bytes; ++i)
+      _buffer.push_back(static_cast<char>((_value >> (8 * i)) & 0xFF));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Read an unsigned integer in little endian order.
+  /// \param[in] _data Pointer to the integer.
+  /// \param[in] _bytes Size of the integer.
+  /// \return The integer.
+  uint64_t readLE(const char *_data, const std::size_t _bytes)
+  {
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < _bytes; ++i)
+    {
+      value |= static_cast<uint64_t>(
+        static_cast<unsigned char>(_data[i])) << (8 * i);
+    }
+    return value;
+  }
+
+  /// \brief Writes the frames of a raw capture from its own thread. Frames
+  /// are appended to a buffer that the thread swaps and writes, so the
+  /// subscription callback never waits for the storage.
+  class RawCaptureWriter
+  {
+    /// \brief Constructor.
+    /// \param[in] _stream Open output stream. The magic bytes have to be
+    /// written already.
+    public: explicit RawCaptureWriter(std::ofstream &_stream)
+      : stream(_stream),
+        thread(&RawCaptureWriter::Run, this)
+    {
+    }
+
+    /// \brief Destructor.
+    public: ~RawCaptureWriter()
+    {
+      this->Stop();
+    }
+
+    /// \brief Queue a frame.
+    /// \param[in] _time Reception time (nanoseconds).
+    /// \param[in] _type Message type.
+    /// \param[in] _data Serialized message.
+    /// \return False if the frame was dropped because the buffer is full.
+    public: bool Write(const uint64_t _time, const std::string &_type,
+                       const std::string &_data)
+    {
+      const std::size_t size =
+        kRawFrameHeaderSize + _type.size() + _data.size();
+      {
+        std::lock_guard<std::mutex> lk(this->mutex);
+        if (!this->pending.empty() &&
+            this->pending.size() + size > kRawCaptureMaxBuffered)
+        {
+          ++this->dropped;
+          return false;
+        }
+
+        appendLE(_time, 8u, this->pending);
+        appendLE(_type.size(), 4u, this->pending);
+        appendLE(_data.size(), 4u, this->pending);
+        this->pending.append(_type);
+        this->pending.append(_data);
+        ++this->frames;
+        this->bytes += size;
+      }
+      this->condition.notify_one();
+      return true;
+    }
+
+    /// \brief Write the pending frames and stop the thread.
+    public: void Stop()
+    {
+      {
+        std::lock_guard<std::mutex> lk(this->mutex);
+        this->stop = true;
+      }
+      this->condition.notify_one();
+      if (this->thread.joinable())
+        this->thread.join();
+      this->stream.flush();
+    }
+
+    /// \brief Number of frames queued.
+    /// \return Frames.
+    public: uint64_t Frames() const
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      return this->frames;
+    }
+
+    /// \brief Number of bytes queued.
+    /// \return Bytes.
+    public: uint64_t Bytes() const
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      return this->bytes;
+    }
+
+    /// \brief Number of frames dropped.
+    /// \return Dropped frames.
+    public: uint64_t Dropped() const
+    {
+      std::lock_guard<std::mutex> lk(this->mutex);
+      return this->dropped;
+    }
+
+    /// \brief Thread function that writes the frames.
+    private: void Run()
+    {
+      std::string writing;
+      std::unique_lock<std::mutex> lk(this->mutex);
+      while (true)
+      {
+        this->condition.wait(lk, [this]
+        {
+          return this->stop || !this->pending.empty();
+        });
+
+        if (this->pending.empty())
+          break;
+
+        std::swap(writing, this->pending);
+        lk.unlock();
+        this->stream.write(writing.data(),
+          static_cast<std::streamsize>(writing.size()));
+        writing.clear();
+        lk.lock();
+      }
+    }
+
+    /// \brief Output stream.
+    private: std::ofstream &stream;
+
+    /// \brief Mutex to protect the members below.
+    private: mutable std::mutex mutex;
+
+    /// \brief Signaled when there are frames to write or on stop.
+    private: std::condition_variable condition;
+
+    /// \brief Frames waiting to be written.
+    private: std::string pending;
+
+    /// \brief Whether the thread should stop.
+    private: bool stop = false;
+
+    /// \brief Number of frames queued.
+    private: uint64_t frames = 0;
+
+    /// \brief Number of bytes queued.
+    private: uint64_t bytes = 0;
+
+    /// \brief Number of frames dropped.
+    private: uint64_t dropped = 0;
+
+    /// \brief Writer thread. It has to be the last member, so it starts
+    /// once the others are initialized.
+    private: std::thread thread;
+  };
+}
+
 //////////////////////////////////////////////////
 extern "C" void cmdTopicList()
 {
@@ -134,9 +332,29 @@ extern "C" void cmdServiceInfo(const char *_service)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Set when the user interrupts a publication without limits.
+static std::atomic<bool> g_stopPublishing(false);
+
+//////////////////////////////////////////////////
+/// \brief Signal handler that stops a publication without limits.
+/// \param[in] _signal Signal received.
+static void stopPublishing(int /*_signal*/)
+{
+  g_stopPublishing = true;
+}
+
 //////////////////////////////////////////////////
 extern "C" void cmdTopicPub(const char *_topic,
   const char *_msgType, const char *_msgData)
+{
+  cmdTopicPubRepeated(_topic, _msgType, _msgData, 0, 1, -1, -1);
+}
+
+//////////////////////////////////////////////////
+extern "C" void cmdTopicPubRepeated(const char *_topic,
+  const char *_msgType, const char *_msgData, const double _rate,
+  const int _count, const double _duration, const int64_t _payloadSize)
 {
   if (!_topic)
   {
@@ -144,45 +362,147 @@ extern "C" void cmdTopicPub(const char *_topic,
     return;
   }
 
-  if (!_msgType)
+  const bool synthetic = _payloadSize >= 0;
+  const std::string bytesType = msgs::Bytes().GetTypeName();
+
+  if (synthetic)
+  {
+    if (_msgType && !std::string(_msgType).empty() && _msgType != bytesType)
+    {
+      std::cerr << "A payload size can only be used with messages of type ["
+                << bytesType << "].\n";
+      return;
+    }
+  }
+  else if (!_msgType)
   {
     std::cerr << "Message type is null\n";
     return;
   }
-
-  if (!_msgData)
+  else if (!_msgData)
   {
     std::cerr << "Message data is null\n";
     return;
   }
 
   // Create the message, and populate the field with _msgData
-  auto msg = msgs::Factory::New(_msgType, _msgData);
-  if (msg)
+  std::unique_ptr<google::protobuf::Message> msg;
+  if (synthetic)
   {
-    // Create the node and advertise the topic
-    Node node;
-    auto pub = node.Advertise(_topic, msg->GetTypeName());
-
-    // Publish the message
-    if (pub)
-    {
-      // \todo(anyone) Change this sleep to a WaitForSubscribers() call.
-      // See issue #47.
-      std::this_thread::sleep_for(std::chrono::milliseconds(800));
-      pub.Publish(*msg);
-    }
-    else
-    {
-      std::cerr << "Unable to publish on topic[" << _topic << "] "
-        << "with message type[" << _msgType << "].\n";
-    }
+    auto bytes = std::make_unique<msgs::Bytes>();
+    std::string data(static_cast<std::size_t>(_payloadSize), '\0');
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>(i);
+    bytes->set_data(std::move(data));
+    msg = std::move(bytes);
   }
   else
+  {
+    msg = msgs::Factory::New(_msgType, _msgData);
+  }
+
+  if (!msg)
   {
     std::cerr << "Unable to create message of type[" << _msgType << "] "
       << "with data[" << _msgData << "].\n";
+    return;
+  }
+
+  // Create the node and advertise the topic
+  Node node;
+  auto pub = node.Advertise(_topic, msg->GetTypeName());
+  if (!pub)
+  {
+    std::cerr << "Unable to publish on topic[" << _topic << "] "
+      << "with message type[" << msg->GetTypeName() << "].\n";
+    return;
+  }
+
+  // Give the subscribers time to connect before publishing.
+  pub.WaitForSubscribers(1u, std::chrono::milliseconds(800));
+
+  // A single message, as it has always been.
+  const bool repeated = _rate > 0 || _count > 1 || _duration > 0;
+  if (!repeated)
+  {
+    pub.Publish(*msg);
+    return;
+  }
+
+  // Publish until the user stops us if there is no limit.
+  const bool unlimited = _count <= 0 && _duration <= 0;
+  void (*previousHandler)(int) = SIG_DFL;
+  if (unlimited)
+  {
+    g_stopPublishing = false;
+    previousHandler = std::signal(SIGINT, stopPublishing);
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const auto period = _rate > 0 ?
+    std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / _rate)) : Clock::duration::zero();
+  const auto start = Clock::now();
+  const auto end = _duration > 0 ?
+    start + std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(_duration)) : Clock::time_point::max();
+
+  uint64_t sent = 0;
+  uint64_t failed = 0;
+  uint64_t blocked = 0;
+  Clock::duration maxPublishTime = Clock::duration::zero();
+  auto next = start;
+
+  while (!g_stopPublishing && (_count <= 0 || sent + failed <
+         static_cast<uint64_t>(_count)))
+  {
+    if (period > Clock::duration::zero())
+    {
+      std::this_thread::sleep_until(next);
+      next += period;
+    }
+
+    const auto before = Clock::now();
+    if (before >= end)
+      break;
+
+    if (pub.Publish(*msg))
+      ++sent;
+    else
+      ++failed;
+
+    const auto publishTime = Clock::now() - before;
+    maxPublishTime = std::max(maxPublishTime, publishTime);
+
+    // The publication took longer than the period, we can't keep the rate.
+    if (period > Clock::duration::zero() && publishTime > period)
+      ++blocked;
+
+    // Don't try to catch up after falling behind.
+    if (period > Clock::duration::zero() && Clock::now() > next + period)
+      next = Clock::now();
   }
+
+  if (unlimited)
+    std::signal(SIGINT, previousHandler);
+
+  const double elapsed =
+    std::chrono::duration<double>(Clock::now() - start).count();
+  const double achievedRate = elapsed > 0 ? sent / elapsed : 0;
+  const double bytesPerSec = achievedRate * msg->ByteSizeLong();
+
+  std::cout << std::fixed << std::setprecision(2)
+            << "Published " << sent << " messages of "
+            << msg->ByteSizeLong() << " bytes in " << elapsed << " s\n"
+            << "Rate: " << achievedRate << " msgs/s ("
+            << bytesPerSec / (1024 * 1024) << " MiB/s)";
+  if (_rate > 0)
+    std::cout << ", requested " << _rate << " msgs/s";
+  std::cout << "\n"
+            << "Failed sends: " << failed << "\n"
+            << "Blocked sends: " << blocked << " (max publish time "
+            << std::chrono::duration<double, std::milli>(
+                 maxPublishTime).count() << " ms)" << std::endl;
 }
 
 //////////////////////////////////////////////////
@@ -248,6 +568,175 @@ extern "C" void cmdServiceReq(const char *_service,
     std::cerr << "Service call timed out" << std::endl;
 }
 
+//////////////////////////////////////////////////
+extern "C" void cmdServiceBench(const char *_service,
+  const char *_reqType, const char *_repType, const int _timeout,
+  const char *_reqData, const int _count, const int _concurrency,
+  const int64_t _payloadSize)
+{
+  if (!_service)
+  {
+    std::cerr << "Service name is null\n";
+    return;
+  }
+
+  const bool synthetic = _payloadSize >= 0;
+  const std::string bytesType = msgs::Bytes().GetTypeName();
+  std::string reqType = _reqType ? _reqType : "";
+
+  if (synthetic)
+  {
+    if (!reqType.empty() && reqType != bytesType)
+    {
+      std::cerr << "A payload size can only be used with requests of type ["
+                << bytesType << "].\n";
+      return;
+    }
+    reqType = bytesType;
+  }
+  else if (!_reqType)
+  {
+    std::cerr << "Request type is null\n";
+    return;
+  }
+  else if (!_reqData)
+  {
+    std::cerr << "Request data is null\n";
+    return;
+  }
+
+  if (!_repType)
+  {
+    std::cerr << "Response type is null\n";
+    return;
+  }
+
+  if (_count <= 0 || _concurrency <= 0)
+  {
+    std::cerr << "The number of requests and the concurrency must be "
+              << "positive.\n";
+    return;
+  }
+
+  // Create the request, either synthetic or populated with _reqData.
+  std::unique_ptr<google::protobuf::Message> req;
+  if (synthetic)
+  {
+    auto bytes = std::make_unique<msgs::Bytes>();
+    std::string data(static_cast<std::size_t>(_payloadSize), '\0');
+    for (std::size_t i = 0; i < data.size(); ++i)
+      data[i] = static_cast<char>(i);
+    bytes->set_data(std::move(data));
+    req = std::move(bytes);
+  }
+  else
+  {
+    req = msgs::Factory::New(_reqType, _reqData);
+  }
+
+  if (!req)
+  {
+    std::cerr << "Unable to create request of type[" << _reqType << "] "
+              << "with data[" << _reqData << "].\n";
+    return;
+  }
+
+  // Check the response type once, each request creates its own response.
+  if (!msgs::Factory::New(_repType))
+  {
+    std::cerr << "Unable to create response of type[" << _repType << "].\n";
+    return;
+  }
+
+  using Clock = std::chrono::steady_clock;
+  using Ms = std::chrono::duration<double, std::milli>;
+  Node node;
+
+  // The first call includes the discovery of the service and the
+  // connection to the responder, so it's reported apart.
+  auto rep = msgs::Factory::New(_repType);
+  bool result = false;
+  auto before = Clock::now();
+  if (!node.Request(_service, *req, _timeout, *rep, result))
+  {
+    std::cerr << "Service call timed out" << std::endl;
+    return;
+  }
+  const double firstCall = Ms(Clock::now() - before).count();
+
+  std::atomic<int> next(1);
+  std::atomic<uint64_t> failed(result ? 0u : 1u);
+  std::atomic<uint64_t> timedOut(0);
+  std::vector<std::vector<double>> latencies(
+    static_cast<std::size_t>(_concurrency));
+
+  auto worker = [&](std::vector<double> &_latencies)
+  {
+    auto workerRep = msgs::Factory::New(_repType);
+    while (next++ < _count)
+    {
+      bool workerResult = false;
+      const auto start = Clock::now();
+      if (!node.Request(_service, *req, _timeout, *workerRep, workerResult))
+      {
+        ++timedOut;
+        continue;
+      }
+      _latencies.push_back(Ms(Clock::now() - start).count());
+      if (!workerResult)
+        ++failed;
+    }
+  };
+
+  const auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (auto &workerLatencies : latencies)
+    threads.emplace_back(worker, std::ref(workerLatencies));
+  for (auto &thread : threads)
+    thread.join();
+  const double elapsed =
+    std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::vector<double> all;
+  for (const auto &workerLatencies : latencies)
+    all.insert(all.end(), workerLatencies.begin(), workerLatencies.end());
+  std::sort(all.begin(), all.end());
+
+  auto percentile = [&all](const double _p)
+  {
+    const std::size_t index = static_cast<std::size_t>(
+      _p / 100.0 * static_cast<double>(all.size() - 1) + 0.5);
+    return all[std::min(index, all.size() - 1)];
+  };
+
+  std::cout << std::fixed << std::setprecision(3)
+            << "First call: " << firstCall << " ms (includes discovery and "
+            << "connection setup)\n"
+            << "Requests: " << _count << ", concurrency: " << _concurrency
+            << ", request size: " << req->ByteSizeLong() << " bytes\n"
+            << "Failed: " << failed << ", timed out: " << timedOut << "\n";
+
+  if (all.empty())
+  {
+    std::cout << "No responses to report after the first call" << std::endl;
+    return;
+  }
+
+  double sum = 0;
+  for (const double latency : all)
+    sum += latency;
+
+  std::cout << "Throughput: "
+            << (elapsed > 0 ? static_cast<double>(all.size()) / elapsed : 0)
+            << " requests/s\n"
+            << "Latency (ms): min " << all.front()
+            << ", mean " << sum / static_cast<double>(all.size())
+            << ", p50 " << percentile(50)
+            << ", p90 " << percentile(90)
+            << ", p99 " << percentile(99)
+            << ", max " << all.back() << std::endl;
+}
+
 //////////////////////////////////////////////////
 extern "C" void cmdTopicEcho(const char *_topic,
   const double _duration, int _count, MsgOutputFormat _outputFormat)
@@ -321,6 +810,188 @@ extern "C" void cmdTopicEcho(const char *_topic,
   }
 }
 
+//////////////////////////////////////////////////
+extern "C" void cmdTopicEchoRaw(const char *_topic, const char *_file,
+  const double _duration, int _count)
+{
+  if (!_topic || std::string(_topic).empty())
+  {
+    std::cerr << "Invalid topic. Topic must not be empty.\n";
+    return;
+  }
+
+  if (!_file || std::string(_file).empty())
+  {
+    std::cerr << "Invalid file. File must not be empty.\n";
+    return;
+  }
+
+  std::ofstream stream(_file, std::ios::binary | std::ios::trunc);
+  if (!stream)
+  {
+    std::cerr << "Unable to open file [" << _file << "] for writing.\n";
+    return;
+  }
+  stream.write(kRawCaptureMagic.data(),
+    static_cast<std::streamsize>(kRawCaptureMagic.size()));
+
+  RawCaptureWriter writer(stream);
+  std::mutex mutex;
+  std::condition_variable condition;
+  int count = 0;
+  const auto start = std::chrono::steady_clock::now();
+
+  RawCallback cb = [&](const char *_msgData, const std::size_t _size,
+                       const MessageInfo &_info)
+  {
+    const uint64_t time = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    writer.Write(time, _info.Type(), std::string(_msgData, _size));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++count;
+    condition.notify_one();
+  };
+
+  Node node;
+  if (!node.SubscribeRaw(_topic, cb))
+    return;
+
+  if (_duration >= 0)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+      static_cast<int64_t>(_duration * 1000)));
+  }
+  else if (_count <= 0)
+  {
+    waitForShutdown();
+  }
+  else
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&]{return count >= _count;});
+  }
+
+  // Stop receiving before writing the remaining frames.
+  node.Unsubscribe(_topic);
+  writer.Stop();
+
+  if (!stream)
+    std::cerr << "Error writing to file [" << _file << "].\n";
+
+  std::cout << "Captured " << writer.Frames() << " messages ("
+            << writer.Bytes() << " bytes) to [" << _file << "]";
+  if (writer.Dropped() > 0)
+    std::cout << ", dropped " << writer.Dropped();
+  std::cout << std::endl;
+}
+
+//////////////////////////////////////////////////
+extern "C" void cmdTopicPubFromFile(const char *_topic, const char *_file)
+{
+  if (!_topic || std::string(_topic).empty())
+  {
+    std::cerr << "Topic name is null\n";
+    return;
+  }
+
+  if (!_file || std::string(_file).empty())
+  {
+    std::cerr << "Invalid file. File must not be empty.\n";
+    return;
+  }
+
+  std::ifstream stream(_file, std::ios::binary);
+  if (!stream)
+  {
+    std::cerr << "Unable to open file [" << _file << "] for reading.\n";
+    return;
+  }
+
+  std::string magic(kRawCaptureMagic.size(), '\0');
+  stream.read(&magic[0], static_cast<std::streamsize>(magic.size()));
+  if (!stream || magic != kRawCaptureMagic)
+  {
+    std::cerr << "File [" << _file << "] is not a raw capture.\n";
+    return;
+  }
+
+  // Bytes left in the file, to reject frames with corrupt lengths before
+  // allocating them.
+  const std::streamoff begin = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  uint64_t remaining = static_cast<uint64_t>(stream.tellg() - begin);
+  stream.seekg(begin);
+
+  using Clock = std::chrono::steady_clock;
+  Node node;
+  Node::Publisher pub;
+  std::string pubType;
+  std::string type;
+  std::string data;
+  char header[kRawFrameHeaderSize];
+  uint64_t published = 0;
+  uint64_t skipped = 0;
+  Clock::time_point start;
+
+  while (stream.read(header, sizeof(header)))
+  {
+    remaining -= std::min<uint64_t>(remaining, sizeof(header));
+    const uint64_t time = readLE(header, 8u);
+    const uint64_t typeLen = readLE(header + 8, 4u);
+    const uint64_t dataLen = readLE(header + 12, 4u);
+    if (typeLen > remaining || dataLen > remaining - typeLen)
+    {
+      std::cerr << "File [" << _file << "] has a corrupt frame.\n";
+      break;
+    }
+    remaining -= typeLen + dataLen;
+
+    type.resize(typeLen);
+    data.resize(dataLen);
+    if (!stream.read(&type[0], static_cast<std::streamsize>(type.size())) ||
+        !stream.read(&data[0], static_cast<std::streamsize>(data.size())))
+    {
+      std::cerr << "File [" << _file << "] is truncated.\n";
+      break;
+    }
+
+    // The topic is advertised with the type of the first message.
+    if (!pub)
+    {
+      pub = node.Advertise(_topic, type);
+      if (!pub)
+      {
+        std::cerr << "Unable to publish on topic[" << _topic << "] "
+          << "with message type[" << type << "].\n";
+        return;
+      }
+      pubType = type;
+
+      // Give the subscribers time to connect before publishing.
+      pub.WaitForSubscribers(1u, std::chrono::milliseconds(800));
+      start = Clock::now() - std::chrono::nanoseconds(time);
+    }
+
+    if (type != pubType)
+    {
+      ++skipped;
+      continue;
+    }
+
+    std::this_thread::sleep_until(start + std::chrono::nanoseconds(time));
+    if (pub.PublishRaw(data, type))
+      ++published;
+  }
+
+  std::cout << "Published " << published << " messages from ["
+            << _file << "]";
+  if (skipped > 0)
+    std::cout << ", skipped " << skipped << " of other types";
+  std::cout << std::endl;
+}
+
 //////////////////////////////////////////////////
 extern "C" const char *gzVersion()
 {
@@ -18,6 +18,7 @@
 #ifndef GZ_TRANSPORT_GZ_HH_
 #define GZ_TRANSPORT_GZ_HH_
 
+#include <cstdint>
 #include <cstring>
 
 #include "gz/transport/Export.hh"
@@ -47,6 +48,33 @@ extern "C" void cmdTopicPub(const char *_topic,
                                                        const char *_msgType,
                                                        const char *_msgData);
 
+/// \brief External hook to execute 'gz topic -p' from the command line,
+/// publishing repeatedly to generate load. When publishing more than one
+/// message, a summary with the achieved rate and the failed and blocked
+/// sends is printed at the end.
+/// \param[in] _topic Topic name.
+/// \param[in] _msgType Message type. It can be null if _payloadSize is not
+/// negative.
+/// \param[in] _msgData The format expected is the same used by Protobuf
+/// DebugString(). It is ignored if _payloadSize is not negative.
+/// \param[in] _rate Messages per second. A value <= 0 publishes as fast as
+/// possible.
+/// \param[in] _count Number of messages to publish. A value <= 0
+/// indicates no limit.
+/// \param[in] _duration Duration (seconds) to publish. A value <= 0
+/// indicates no time limit. If there are no limits and _rate is positive,
+/// messages are published until the process is interrupted (SIGINT).
+/// \param[in] _payloadSize If not negative, publish a gz.msgs.Bytes message
+/// with this number of bytes instead of _msgData.
+/// E.g.: cmdTopicPubRepeated("/foo", nullptr, nullptr, 100, 1000, -1, 1024);
+extern "C" void cmdTopicPubRepeated(const char *_topic,
+                                    const char *_msgType,
+                                    const char *_msgData,
+                                    const double _rate,
+                                    const int _count,
+                                    const double _duration,
+                                    const int64_t _payloadSize);
+
 /// \brief External hook to execute 'gz service -r' from the command line.
 /// \param[in] _service Service name.
 /// \param[in] _reqType Message type used in the request.
@@ -63,6 +91,33 @@ extern "C" void cmdServiceReq(const char *_service,
                                                          const int _timeout,
                                                          const char *_reqData);
 
+/// \brief External hook to execute 'gz service --bench' from the command
+/// line. Issue a number of requests to a service and print the throughput
+/// and the latency percentiles. The first call, which includes the
+/// discovery of the service and the connection setup, is reported apart
+/// and not included in the statistics.
+/// \param[in] _service Service name.
+/// \param[in] _reqType Message type used in the request. It can be null if
+/// _payloadSize is not negative.
+/// \param[in] _repType Message type used in the response.
+/// \param[in] _timeout Each request will timeout after '_timeout' ms.
+/// \param[in] _reqData Input data sent in the requests. It is ignored if
+/// _payloadSize is not negative.
+/// \param[in] _count Total number of requests, including the first call.
+/// \param[in] _concurrency Number of requests in flight at the same time.
+/// \param[in] _payloadSize If not negative, send gz.msgs.Bytes requests
+/// with this number of bytes instead of _reqData.
+/// E.g.: cmdServiceBench("/echo", nullptr, "gz.msgs.Bytes", 1000, nullptr,
+///                       10000, 4, 1024);
+extern "C" void cmdServiceBench(const char *_service,
+                                const char *_reqType,
+                                const char *_repType,
+                                const int _timeout,
+                                const char *_reqData,
+                                const int _count,
+                                const int _concurrency,
+                                const int64_t _payloadSize);
+
 extern "C" {
   /// \brief Enum used for specifing the message output format for functions
   /// like cmdTopicEcho.
@@ -90,6 +145,27 @@ extern "C" {
 extern "C" void cmdTopicEcho(const char *_topic, const double _duration,
                              int _count, MsgOutputFormat _outputFormat);
 
+/// \brief External hook to execute 'gz topic -e --raw-out' from the
+/// command line. The serialized messages are written without parsing them,
+/// each one preceded by its reception time, message type and size. The
+/// file is written from a separate thread, so slow storage doesn't block
+/// the subscription. The capture can be replayed with cmdTopicPubFromFile.
+/// \param[in] _topic Topic name.
+/// \param[in] _file Path of the capture file. It's overwritten if it exists.
+/// \param[in] _duration Duration (seconds) to run. A value <= 0 indicates
+/// no time limit. The _duration parameter overrides the _count parameter.
+/// \param[in] _count Number of messages to capture and then stop. A value
+/// <= 0 indicates no limit.
+extern "C" void cmdTopicEchoRaw(const char *_topic, const char *_file,
+                                const double _duration, int _count);
+
+/// \brief External hook to execute 'gz topic -p --from' from the command
+/// line. Publish the messages of a capture written by cmdTopicEchoRaw,
+/// keeping their original timing.
+/// \param[in] _topic Topic name.
+/// \param[in] _file Path of the capture file.
+extern "C" void cmdTopicPubFromFile(const char *_topic, const char *_file);
+
 /// \brief External hook to read the library version.
 /// \return C-string representing the version. Ex.: 0.1.2
 extern "C" const char *gzVersion();
@@ -15,10 +15,16 @@
  *
 */
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
 #include <future>
 #include <string>
 #include <iostream>
 #include <sstream>
+#include <thread>
 #ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable: 4251)
@@ -153,6 +159,39 @@ TEST(gzTest, cmdTopicPub)
   restoreIO();
 }
 
+//////////////////////////////////////////////////
+/// \brief Check cmdTopicPubRepeated publishing several messages.
+TEST(gzTest, cmdTopicPubRepeated)
+{
+  std::stringstream stdOutBuffer;
+  std::stringstream stdErrBuffer;
+  redirectIO(stdOutBuffer, stdErrBuffer);
+
+  // A payload size can't be used with other message types.
+  cmdTopicPubRepeated(g_topic.c_str(), g_intType.c_str(), g_reqData.c_str(),
+    -1, 3, -1, 16);
+  EXPECT_EQ(stdErrBuffer.str(), "A payload size can only be used with "
+    "messages of type [gz.msgs.Bytes].\n");
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // Publish a few synthetic messages.
+  cmdTopicPubRepeated(g_topic.c_str(), nullptr, nullptr, 1000, 3, -1, 16);
+  EXPECT_TRUE(stdErrBuffer.str().empty());
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Published 3 messages"));
+  EXPECT_NE(std::string::npos, stdOutBuffer.str().find("Failed sends: 0"));
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // Publish a few regular messages.
+  cmdTopicPubRepeated(g_topic.c_str(), g_intType.c_str(), g_reqData.c_str(),
+    -1, 3, -1, -1);
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Published 3 messages"));
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  restoreIO();
+}
+
 //////////////////////////////////////////////////
 /// \brief Check cmdServiceReq running the advertiser on a the same process.
 TEST(gzTest, cmdServiceReq)
@@ -226,6 +265,47 @@ TEST(gzTest, cmdServiceReq)
   restoreIO();
 }
 
+//////////////////////////////////////////////////
+/// \brief Check cmdServiceBench running the advertiser on a the same
+/// process.
+TEST(gzTest, cmdServiceBench)
+{
+  std::stringstream  stdOutBuffer;
+  std::stringstream  stdErrBuffer;
+  redirectIO(stdOutBuffer, stdErrBuffer);
+
+  const int kTimeout = 1000;
+
+  transport::Node node;
+  EXPECT_TRUE(node.Advertise(g_service, srvEcho));
+
+  // Invalid number of requests.
+  cmdServiceBench(g_service.c_str(), g_intType.c_str(), g_intType.c_str(),
+    kTimeout, g_reqData.c_str(), 0, 1, -1);
+  EXPECT_EQ(stdErrBuffer.str(), "The number of requests and the concurrency "
+    "must be positive.\n");
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // A payload size can't be used with other request types.
+  cmdServiceBench(g_service.c_str(), g_intType.c_str(), g_intType.c_str(),
+    kTimeout, g_reqData.c_str(), 10, 1, 16);
+  EXPECT_EQ(stdErrBuffer.str(), "A payload size can only be used with "
+    "requests of type [gz.msgs.Bytes].\n");
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // Benchmark the service. It always returns a "false" result.
+  cmdServiceBench(g_service.c_str(), g_intType.c_str(), g_intType.c_str(),
+    kTimeout, g_reqData.c_str(), 20, 2, -1);
+  EXPECT_TRUE(stdErrBuffer.str().empty());
+  EXPECT_NE(std::string::npos, stdOutBuffer.str().find("First call: "));
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Failed: 20, timed out: 0"));
+  EXPECT_NE(std::string::npos, stdOutBuffer.str().find(", p99 "));
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  restoreIO();
+}
+
 //////////////////////////////////////////////////
 /// \brief Check cmdTopicEcho running the advertiser on a the same process.
 TEST(gzTest, cmdTopicEcho)
@@ -288,6 +368,85 @@ TEST(gzTest, cmdTopicEchoOutputFormats)
   restoreIO();
 }
 
+/////////////////////////////////////////////////
+/// \brief Capture a topic with cmdTopicEchoRaw and replay it with
+/// cmdTopicPubFromFile.
+TEST(gzTest, cmdTopicEchoRawAndPubFromFile)
+{
+  std::stringstream  stdOutBuffer;
+  std::stringstream  stdErrBuffer;
+  redirectIO(stdOutBuffer, stdErrBuffer);
+
+  const std::string file = "gz_src_TEST_" + g_partition + ".raw";
+
+  // Invalid arguments.
+  cmdTopicEchoRaw(g_topic.c_str(), nullptr, -1, 1);
+  EXPECT_EQ(stdErrBuffer.str(), "Invalid file. File must not be empty.\n");
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  cmdTopicPubFromFile(g_topic.c_str(), "_unknown_file_");
+  EXPECT_EQ(stdErrBuffer.str(),
+    "Unable to open file [_unknown_file_] for reading.\n");
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // Capture two messages.
+  auto capture = std::async(std::launch::async, [&]()
+  {
+    cmdTopicEchoRaw(g_topic.c_str(), file.c_str(), -1, 2);
+  });
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>(g_topic);
+  ASSERT_TRUE(pub);
+  msgs::Int32 msg;
+  msg.set_data(5);
+  while (capture.wait_for(std::chrono::milliseconds(100)) !=
+         std::future_status::ready)
+  {
+    pub.Publish(msg);
+  }
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Captured 2 messages"));
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // Replay them.
+  std::atomic<int> received(0);
+  std::function<void(const msgs::Int32&)> cb = [&](const msgs::Int32 &_msg)
+  {
+    EXPECT_EQ(5, _msg.data());
+    ++received;
+  };
+  transport::Node subNode;
+  ASSERT_TRUE(subNode.Subscribe("/replay", cb));
+
+  cmdTopicPubFromFile("/replay", file.c_str());
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Published 2 messages"));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(2, received);
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  // A frame whose lengths don't fit in the file is rejected. The type
+  // length follows the 8 bytes of the magic and the 8 bytes of the time.
+  {
+    std::fstream stream(file, std::ios::in | std::ios::out |
+      std::ios::binary);
+    ASSERT_TRUE(stream);
+    stream.seekp(16);
+    const char huge[4] = {'\xff', '\xff', '\xff', '\x7f'};
+    stream.write(huge, sizeof(huge));
+  }
+  cmdTopicPubFromFile("/replay", file.c_str());
+  EXPECT_EQ(stdErrBuffer.str(),
+    "File [" + file + "] has a corrupt frame.\n");
+  EXPECT_NE(std::string::npos,
+    stdOutBuffer.str().find("Published 0 messages"));
+  clearIOStreams(stdOutBuffer, stdErrBuffer);
+
+  std::remove(file.c_str());
+  restoreIO();
+}
+
 /////////////////////////////////////////////////
 /// Main
 int main(int argc, char **argv)
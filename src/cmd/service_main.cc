@@ -30,6 +30,7 @@ enum class ServiceCommand
   kServiceList,
   kServiceInfo,
   kServiceReq,
+  kServiceBench,
 };
 
 //////////////////////////////////////////////////
@@ -53,6 +54,15 @@ struct ServiceOptions
 
   /// \brief Timeout to use when requesting (in milliseconds)
   int timeout{-1};
+
+  /// \brief Number of requests to benchmark
+  int count{1000};
+
+  /// \brief Number of concurrent requests to benchmark
+  int concurrency{1};
+
+  /// \brief Size of the synthetic request payload (bytes)
+  int64_t payloadSize{-1};
 };
 
 //////////////////////////////////////////////////
@@ -72,6 +82,12 @@ void runServiceCommand(const ServiceOptions &_opt)
           _opt.reqType.c_str(), _opt.repType.c_str(),
           _opt.timeout, _opt.reqData.c_str());
       break;
+    case ServiceCommand::kServiceBench:
+      cmdServiceBench(_opt.service.c_str(),
+          _opt.reqType.c_str(), _opt.repType.c_str(),
+          _opt.timeout, _opt.reqData.c_str(), _opt.count,
+          _opt.concurrency, _opt.payloadSize);
+      break;
     case ServiceCommand::kNone:
     default:
       // In the event that there is no command, display help
@@ -93,6 +109,24 @@ void addServiceFlags(CLI::App &_app)
                                     opt->repType, "Type of a response.");
   auto timeoutOpt = _app.add_option("--timeout",
                                     opt->timeout, "Timeout in milliseconds.");
+  auto reqDataOpt = _app.add_option("--data",
+                                    opt->reqData,
+                                    "Request data used by --bench.");
+  _app.add_option("-n,--num",
+                  opt->count,
+                  "Number of requests issued by --bench.")
+    ->check(CLI::PositiveNumber);
+  _app.add_option("--concurrency",
+                  opt->concurrency,
+                  "Number of concurrent requests issued by --bench.")
+    ->check(CLI::PositiveNumber);
+  auto payloadOpt = _app.add_option("--payload-size",
+                                    opt->payloadSize,
+R"(Size (bytes) of the gz.msgs.Bytes requests issued
+by --bench, instead of --reqtype and --data.)")
+    ->check(CLI::NonNegativeNumber);
+
+  reqDataOpt->excludes(payloadOpt);
 
   auto command = _app.add_option_group("command", "Command to be executed.");
 
@@ -127,6 +161,22 @@ the same used by Protobuf DebugString(). E.g.:
     ->needs(repTypeOpt)
     ->needs(timeoutOpt);
 
+  command->add_flag_callback("--bench",
+      [opt](){
+        opt->command = ServiceCommand::kServiceBench;
+      },
+R"(Benchmark a service. Issue requests and report
+the throughput and the latency percentiles. E.g.:
+  gz service -s /echo \
+    --reptype gz.msgs.Bytes \
+    --timeout 2000 \
+    --payload-size 1024 \
+    -n 10000 --concurrency 4
+)")
+    ->needs(serviceOpt)
+    ->needs(repTypeOpt)
+    ->needs(timeoutOpt);
+
   _app.callback([opt](){runServiceCommand(*opt); });
 }
 
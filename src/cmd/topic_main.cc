@@ -52,9 +52,21 @@ struct TopicOptions
   /// \brief Amount of time to echo (in seconds)
   double duration{-1};
 
-  /// \brief Number of messages to echo
+  /// \brief Number of messages to echo or publish
   int count{-1};
 
+  /// \brief Messages per second to publish
+  double rate{-1};
+
+  /// \brief Size of the synthetic payload to publish (bytes)
+  int64_t payloadSize{-1};
+
+  /// \brief File where the raw messages are captured
+  std::string rawOut{""};
+
+  /// \brief Capture file to publish
+  std::string fromFile{""};
+
   /// \brief Message output format
   MsgOutputFormat msgOutputFormat {MsgOutputFormat::kDefault};
 };
@@ -72,11 +84,26 @@ void runTopicCommand(const TopicOptions &_opt)
       cmdTopicInfo(_opt.topic.c_str());
       break;
     case TopicCommand::kTopicPub:
-      cmdTopicPub(_opt.topic.c_str(),
-                  _opt.msgType.c_str(),
-                  _opt.msgData.c_str());
+      if (!_opt.fromFile.empty())
+      {
+        cmdTopicPubFromFile(_opt.topic.c_str(), _opt.fromFile.c_str());
+        break;
+      }
+      cmdTopicPubRepeated(_opt.topic.c_str(),
+                          _opt.msgType.c_str(),
+                          _opt.msgData.c_str(),
+                          _opt.rate,
+                          _opt.count,
+                          _opt.duration,
+                          _opt.payloadSize);
       break;
     case TopicCommand::kTopicEcho:
+      if (!_opt.rawOut.empty())
+      {
+        cmdTopicEchoRaw(_opt.topic.c_str(), _opt.rawOut.c_str(),
+                        _opt.duration, _opt.count);
+        break;
+      }
       cmdTopicEcho(_opt.topic.c_str(), _opt.duration, _opt.count,
                    _opt.msgOutputFormat);
       break;
@@ -101,7 +128,12 @@ void addTopicFlags(CLI::App &_app)
                                      "Duration (seconds) to run.");
   auto countOpt = _app.add_option("-n,--num",
                                   opt->count,
-                                  "Number of messages to echo and then exit.");
+                                  "Number of messages to echo or publish and "
+                                  "then exit.");
+  _app.add_option("-r,--rate",
+                  opt->rate,
+                  "Messages per second to publish. By default only one "
+                  "message is published, unless -n or -d are used.");
 
   durationOpt->excludes(countOpt);
   countOpt->excludes(durationOpt);
@@ -122,7 +154,7 @@ R"(Get info about a topic. E.g.:
   gz topic -i -t /foo)")
     ->needs(topicOpt);
 
-  command->add_flag_callback("-e,--echo",
+  auto echoOpt = command->add_flag_callback("-e,--echo",
     [opt](){
       opt->command = TopicCommand::kTopicEcho;
     },
@@ -134,6 +166,13 @@ R"(Output data to screen. E.g.:
       [opt]() { opt->msgOutputFormat = MsgOutputFormat::kJSON; },
       "Output messages in JSON format.");
 
+  command->add_option("--raw-out",
+                      opt->rawOut,
+R"(Write the serialized messages to a file instead
+of the screen, with their reception time. E.g.:
+  gz topic -e -t /foo --raw-out foo.raw)")
+    ->needs(echoOpt);
+
   command->add_option_function<std::string>("-p,--pub",
       [opt](const std::string &_msgData){
         opt->command = TopicCommand::kTopicPub;
@@ -147,6 +186,27 @@ the same used by Protobuf DebugString(). E.g.:
     ->needs(topicOpt)
     ->needs(msgTypeOpt);
 
+  command->add_option_function<int64_t>("--payload-size",
+      [opt](const int64_t &_size){
+        opt->command = TopicCommand::kTopicPub;
+        opt->payloadSize = _size;
+      },
+R"(Publish gz.msgs.Bytes messages with a payload
+of INT bytes, to generate load. E.g.:
+  gz topic -t /foo --payload-size 1024 -r 100 -n 1000)")
+    ->needs(topicOpt)
+    ->check(CLI::NonNegativeNumber);
+
+  command->add_option_function<std::string>("--from",
+      [opt](const std::string &_file){
+        opt->command = TopicCommand::kTopicPub;
+        opt->fromFile = _file;
+      },
+R"(Publish the messages captured with --raw-out,
+keeping their original timing. E.g.:
+  gz topic -t /foo --from foo.raw)")
+    ->needs(topicOpt);
+
   _app.callback([opt](){runTopicCommand(*opt); });
 }
 
@@ -30,6 +30,11 @@ GZ_SERVICE_COMPLETION_LIST="
   -l --list
   -i --info
   -r --req
+  -n --num
+  --data
+  --concurrency
+  --payload-size
+  --bench
 "
 
 GZ_TOPIC_COMPLETION_LIST="
@@ -42,8 +47,12 @@ GZ_TOPIC_COMPLETION_LIST="
   -i --info
   -e --echo
   -p --pub
+  -r --rate
   -v --version
   --json-output
+  --payload-size
+  --raw-out
+  --from
 "
 
 function _gz_service
@@ -116,6 +116,109 @@ TEST(twoProcSrvCall, SrvTwoProcs)
   testing::waitAndCleanupFork(pi);
 }
 
+//////////////////////////////////////////////////
+/// \brief A service client in another process makes an asynchronous request
+/// with a generic response. The response is created with the response type
+/// of the client.
+TEST(twoProcSrvCall, SrvTwoProcsGenericReply)
+{
+  std::string responser_path = testing::portablePathUnion(
+    GZ_TRANSPORT_TEST_DIR,
+    "INTEGRATION_twoProcsSrvCallReplier_aux");
+
+  testing::forkHandlerType pi = testing::forkAndRun(responser_path.c_str(),
+    partition.c_str());
+
+  reset();
+
+  msgs::Int32 req;
+  req.set_data(data);
+
+  transport::Node node;
+  auto client = node.CreateServiceClient<msgs::Int32, msgs::Int32>(g_topic);
+  ASSERT_TRUE(client);
+
+  std::function<void(const google::protobuf::Message &, const bool)> cb =
+    [](const google::protobuf::Message &_rep, const bool _result)
+    {
+      EXPECT_TRUE(_result);
+      ASSERT_EQ(msgs::Int32().GetTypeName(), _rep.GetTypeName());
+      msgs::Int32 rep;
+      rep.CopyFrom(_rep);
+      EXPECT_EQ(data, rep.data());
+
+      responseExecuted = true;
+      ++counter;
+    };
+  EXPECT_TRUE(client.Request(req, cb));
+
+  int i = 0;
+  while (i < 300 && !responseExecuted)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++i;
+  }
+
+  // Check that the service call response was executed.
+  EXPECT_TRUE(responseExecuted);
+  EXPECT_EQ(counter, 1);
+
+  reset();
+
+  // Wait for the child process to return.
+  testing::waitAndCleanupFork(pi);
+}
+
+//////////////////////////////////////////////////
+/// \brief A node in another process makes an asynchronous request with a
+/// generic response. The response has the response type of the responder.
+TEST(twoProcSrvCall, SrvTwoProcsNodeGenericReply)
+{
+  std::string responser_path = testing::portablePathUnion(
+    GZ_TRANSPORT_TEST_DIR,
+    "INTEGRATION_twoProcsSrvCallReplier_aux");
+
+  testing::forkHandlerType pi = testing::forkAndRun(responser_path.c_str(),
+    partition.c_str());
+
+  reset();
+
+  msgs::Int32 req;
+  req.set_data(data);
+
+  std::function<void(const google::protobuf::Message &, const bool)> cb =
+    [](const google::protobuf::Message &_rep, const bool _result)
+    {
+      EXPECT_TRUE(_result);
+      ASSERT_EQ(msgs::Int32().GetTypeName(), _rep.GetTypeName());
+      msgs::Int32 rep;
+      rep.CopyFrom(_rep);
+      EXPECT_EQ(data, rep.data());
+
+      responseExecuted = true;
+      ++counter;
+    };
+
+  transport::Node node;
+  EXPECT_TRUE(node.Request(g_topic, req, cb));
+
+  int i = 0;
+  while (i < 300 && !responseExecuted)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ++i;
+  }
+
+  // Check that the service call response was executed.
+  EXPECT_TRUE(responseExecuted);
+  EXPECT_EQ(counter, 1);
+
+  reset();
+
+  // Wait for the child process to return.
+  testing::waitAndCleanupFork(pi);
+}
+
 //////////////////////////////////////////////////
 /// \brief This test spawns a service responser and a service requester. The
 /// requester uses a wrong type for the request argument. The test should verify
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/int32.pb.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
+#include "gz/transport/Node.hh"
+#include "gtest/gtest.h"
+#include "test_config.hh"
+
+using namespace gz;
+
+static std::string partition; // NOLINT(*)
+static std::string g_topic = "/foo"; // NOLINT(*)
+static std::string g_invalidateTopic = "/foo_invalidate"; // NOLINT(*)
+static int data = 5;
+
+//////////////////////////////////////////////////
+/// \brief A cacheable service in another process answers with the number of
+/// times it has been called. Repeated requests are answered from the cache
+/// without reaching the responder, until the responder invalidates its
+/// cached responses.
+TEST(twoProcSrvCallCache, CachedResponses)
+{
+  std::string responser_path = testing::portablePathUnion(
+     GZ_TRANSPORT_TEST_DIR,
+     "INTEGRATION_twoProcsSrvCallCacheableReplier_aux");
+
+  testing::forkHandlerType pi = testing::forkAndRun(responser_path.c_str(),
+    partition.c_str());
+
+  const unsigned int timeout = 1000;
+  msgs::Int32 req;
+  msgs::Int32 rep;
+  bool result;
+
+  req.set_data(data);
+
+  transport::Node node;
+  auto pub = node.Advertise<msgs::Int32>(g_invalidateTopic);
+  ASSERT_TRUE(pub);
+
+  // Make sure that the address of the service call provider is known.
+  std::this_thread::sleep_for(std::chrono::milliseconds(3000));
+
+  // The first request reaches the responder.
+  ASSERT_TRUE(node.Request(g_topic, req, timeout, rep, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(1, rep.data());
+
+  // The next requests are answered from the cache.
+  for (int i = 0; i < 3; ++i)
+  {
+    rep.Clear();
+    ASSERT_TRUE(node.Request(g_topic, req, timeout, rep, result));
+    EXPECT_TRUE(result);
+    EXPECT_EQ(1, rep.data());
+  }
+
+  // A different request is not cached.
+  msgs::Int32 otherReq;
+  otherReq.set_data(data + 1);
+  ASSERT_TRUE(node.Request(g_topic, otherReq, timeout, rep, result));
+  EXPECT_EQ(2, rep.data());
+
+  // Ask the responder to invalidate its cache.
+  for (int i = 0; i < 100 && !pub.HasConnections(); ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  ASSERT_TRUE(pub.HasConnections());
+  EXPECT_TRUE(pub.Publish(req));
+
+  // The new cache version reaches this process with the next advertisement,
+  // then the request reaches the responder again.
+  bool miss = false;
+  for (int i = 0; i < 50 && !miss; ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_TRUE(node.Request(g_topic, req, timeout, rep, result));
+    EXPECT_TRUE(result);
+    miss = rep.data() != 1;
+  }
+  ASSERT_TRUE(miss);
+  EXPECT_EQ(3, rep.data());
+
+  // The new response is cached.
+  rep.Clear();
+  ASSERT_TRUE(node.Request(g_topic, req, timeout, rep, result));
+  EXPECT_EQ(3, rep.data());
+
+  // Wait for the child process to return.
+  testing::waitAndCleanupFork(pi);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  // Get a random partition name.
+  partition = testing::getRandomNumber();
+
+  // Set the partition name for this process.
+  setenv("GZ_PARTITION", partition.c_str(), 1);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
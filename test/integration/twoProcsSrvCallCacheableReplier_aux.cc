@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/int32.pb.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+#include "gz/transport/AdvertiseOptions.hh"
+#include "gz/transport/Node.hh"
+#include "gtest/gtest.h"
+#include "test_config.hh"
+
+using namespace gz;
+
+static std::string g_topic = "/foo"; // NOLINT(*)
+static std::string g_invalidateTopic = "/foo_invalidate"; // NOLINT(*)
+static std::atomic<int> calls{0};
+static std::atomic<bool> invalidate{false};
+
+//////////////////////////////////////////////////
+/// \brief Provide a cacheable service. The response is the number of times
+/// the service has been called.
+bool srvCount(const msgs::Int32 &/*_req*/, msgs::Int32 &_rep)
+{
+  _rep.set_data(++calls);
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Request the invalidation of the cached responses.
+void cbInvalidate(const msgs::Int32 &/*_msg*/)
+{
+  invalidate = true;
+}
+
+//////////////////////////////////////////////////
+void runReplier()
+{
+  transport::Node node;
+  transport::AdvertiseServiceOptions opts;
+  opts.SetCacheable(true);
+  EXPECT_TRUE(node.Advertise(g_topic, srvCount, opts));
+  EXPECT_TRUE(node.Subscribe(g_invalidateTopic, cbInvalidate));
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    if (invalidate.exchange(false))
+    {
+      EXPECT_TRUE(node.InvalidateServiceCache(g_topic));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    std::cerr << "Partition name has not be passed as argument" << std::endl;
+    return -1;
+  }
+
+  // Set the partition name for this test.
+  setenv("GZ_PARTITION", argv[1], 1);
+
+  runReplier();
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gz/msgs/int32.pb.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+#include "gz/transport/Node.hh"
+#include "gz/transport/NodeShared.hh"
+#include "gtest/gtest.h"
+#include "test_config.hh"
+
+using namespace gz;
+
+static std::string partition; // NOLINT(*)
+static std::string g_topic = "/foo"; // NOLINT(*)
+static const int kWindow = 4;
+static const int kBurst = 50;
+
+static std::mutex g_mutex;
+static std::multiset<int> g_responses; // NOLINT(*)
+static int g_failures = 0;
+
+//////////////////////////////////////////////////
+/// \brief Service call response callback.
+void response(const msgs::Int32 &_rep, const bool _result)
+{
+  std::lock_guard<std::mutex> lk(g_mutex);
+  if (_result)
+    g_responses.insert(_rep.data());
+  else
+    ++g_failures;
+}
+
+//////////////////////////////////////////////////
+/// \brief Send a burst of asynchronous requests.
+/// \param[in] _node Node making the requests.
+/// \param[in] _first Data of the first request.
+void sendBurst(transport::Node &_node, const int _first)
+{
+  msgs::Int32 req;
+  for (int i = 0; i < kBurst; ++i)
+  {
+    req.set_data(_first + i);
+    EXPECT_TRUE(_node.Request(g_topic, req, response));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Wait until a number of responses are received.
+/// \param[in] _count Number of responses.
+/// \return True if all the responses were received.
+bool waitForResponses(const std::size_t _count)
+{
+  for (int i = 0; i < 500; ++i)
+  {
+    {
+      std::lock_guard<std::mutex> lk(g_mutex);
+      if (g_responses.size() >= _count)
+        return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+/// \brief A burst of asynchronous requests to a responder in another process
+/// is sent in batches that fit the window of pipelined requests. Every
+/// request is answered exactly once.
+TEST(twoProcSrvCallWindow, BatchedBurst)
+{
+  ASSERT_EQ(kWindow, transport::NodeShared::Instance()->SrvRequestWindow());
+
+  std::string responser_path = testing::portablePathUnion(
+     GZ_TRANSPORT_TEST_DIR,
+     "INTEGRATION_twoProcsSrvCallReplier_aux");
+
+  testing::forkHandlerType pi = testing::forkAndRun(responser_path.c_str(),
+    partition.c_str());
+
+  transport::Node node;
+
+  // The requests wait for the discovery of the responder.
+  sendBurst(node, 0);
+  ASSERT_TRUE(waitForResponses(kBurst));
+
+  // The responder is known now, the requests are sent right away.
+  sendBurst(node, kBurst);
+  ASSERT_TRUE(waitForResponses(2 * kBurst));
+
+  {
+    std::lock_guard<std::mutex> lk(g_mutex);
+    EXPECT_EQ(0, g_failures);
+    ASSERT_EQ(static_cast<std::size_t>(2 * kBurst), g_responses.size());
+    for (int i = 0; i < 2 * kBurst; ++i)
+      EXPECT_EQ(1u, g_responses.count(i)) << i;
+  }
+
+  // Blocking requests share the window with the asynchronous ones.
+  const unsigned int timeout = 1000;
+  msgs::Int32 req;
+  msgs::Int32 rep;
+  bool result;
+  req.set_data(-1);
+  sendBurst(node, 2 * kBurst);
+  ASSERT_TRUE(node.Request(g_topic, req, timeout, rep, result));
+  EXPECT_TRUE(result);
+  EXPECT_EQ(-1, rep.data());
+  EXPECT_TRUE(waitForResponses(3 * kBurst));
+
+  // Wait for the child process to return.
+  testing::waitAndCleanupFork(pi);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  // Get a random partition name.
+  partition = testing::getRandomNumber();
+
+  // Set the partition name for this process.
+  setenv("GZ_PARTITION", partition.c_str(), 1);
+
+  // Enable pipelining before the transport is created.
+  setenv("GZ_TRANSPORT_SRV_WINDOW", std::to_string(kWindow).c_str(), 1);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}